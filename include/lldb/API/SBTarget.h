@@ -734,6 +734,9 @@ public:
     bool
     GetDescription (lldb::SBStream &description, lldb::DescriptionLevel description_level);
 
+    bool
+    GetStatistics (lldb::SBStream &stream);
+
 protected:
     friend class SBAddress;
     friend class SBBlock;
@@ -80,6 +80,17 @@ public:
     bool
     GetValueDidChange ();
 
+    //------------------------------------------------------------------
+    /// Get the children whose bytes or value changed when they were
+    /// last updated.
+    ///
+    /// Only children that have already been fetched are checked, so a
+    /// UI that keeps its expanded values around can redraw just the
+    /// ones in this list after each stop.
+    //------------------------------------------------------------------
+    lldb::SBValueList
+    GetChangedChildren ();
+
     const char *
     GetSummary ();
     
@@ -148,6 +159,31 @@ public:
                          lldb::SBData data,
                          lldb::SBType type);
 
+    //------------------------------------------------------------------
+    /// Create a value for each item in an array of \a type items.
+    ///
+    /// This lets synthetic children providers read the memory for many
+    /// children at once (see GetPointeeData()) and turn it into values
+    /// without a call per child.
+    ///
+    /// @param[in] data
+    ///     The contents of the items, a trailing partial item is ignored.
+    ///
+    /// @param[in] type
+    ///     The type of each item.
+    ///
+    /// @param[in] start_idx
+    ///     The index of the first item, the values are named "[idx]".
+    ///
+    /// @return
+    ///     The new values, which like CreateValueFromData() values have
+    ///     no address.
+    //------------------------------------------------------------------
+    lldb::SBValueList
+    CreateValuesFromData (lldb::SBData data,
+                          lldb::SBType type,
+                          uint32_t start_idx = 0);
+
     //------------------------------------------------------------------
     /// Get a child value by index from a value.
     ///
@@ -272,6 +308,34 @@ public:
     uint32_t
     GetNumChildren ();
 
+    //------------------------------------------------------------------
+    /// Get the number of children, but stop counting at \a max.
+    ///
+    /// Synthetic children providers for large containers may be able to
+    /// answer this without counting every element, which lets a UI show
+    /// the first page of a container with millions of elements quickly.
+    ///
+    /// @return
+    ///     The number of children, or \a max if there are at least
+    ///     \a max children.
+    //------------------------------------------------------------------
+    uint32_t
+    GetNumChildren (uint32_t max);
+
+    //------------------------------------------------------------------
+    /// Get up to \a count children starting at index \a start_idx.
+    ///
+    /// Children are fetched one index at a time up to the first one
+    /// that doesn't exist, so the total number of children never needs
+    /// to be known.
+    ///
+    /// @return
+    ///     A list with the children that were found, which has less
+    ///     than \a count values if the end of the children was reached.
+    //------------------------------------------------------------------
+    lldb::SBValueList
+    GetChildrenInRange (uint32_t start_idx, uint32_t count);
+
     void *
     GetOpaqueType();
 
@@ -221,11 +221,16 @@ public:
     ///    If \b true then the modules were loaded, if \b false, unloaded.
     /// @param[in] delete_locations
     ///    If \b true then the modules were unloaded delete any locations in the changed modules.
+    /// @param[in] modules_to_search
+    ///    If not NULL, loaded modules in which this breakpoint has no
+    ///    locations yet are only searched for new locations if they are
+    ///    also in this list.
     //------------------------------------------------------------------
     void
     ModulesChanged (ModuleList &changed_modules,
                     bool load_event,
-                    bool delete_locations = false);
+                    bool delete_locations = false,
+                    ModuleList *modules_to_search = NULL);
 
 
     //------------------------------------------------------------------
@@ -488,6 +493,12 @@ public:
     void
     GetResolverDescription (Stream *s);
 
+    lldb::BreakpointResolverSP
+    GetResolver ()
+    {
+        return m_resolver_sp;
+    }
+
     //------------------------------------------------------------------
     /// Find breakpoint locations which match the (filename, line_number) description.
     /// The breakpoint location collection is to be filled with the matching locations.
@@ -13,6 +13,9 @@
 // C Includes
 // C++ Includes
 #include <list>
+#include <map>
+#include <set>
+#include <vector>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/Breakpoint.h"
@@ -179,10 +182,42 @@ protected:
     bp_collection::const_iterator
     GetBreakpointIDConstIterator(lldb::break_id_t breakID) const;
 
+    //------------------------------------------------------------------
+    // The reverse index from the function names and source file base
+    // names the breakpoint resolvers look for to the breakpoints, see
+    // BreakpointResolver::GetModuleKeys(). It is rebuilt the first time
+    // it is needed after the list changed.
+    //------------------------------------------------------------------
+    struct FunctionNameEntry
+    {
+        FunctionNameEntry () :
+            name_type_mask (0),
+            breakpoints ()
+        {
+        }
+
+        uint32_t name_type_mask;    // All name types the breakpoints look up
+        std::vector<Breakpoint *> breakpoints;
+    };
+
+    typedef std::map<ConstString, FunctionNameEntry> function_name_index;
+    typedef std::map<ConstString, std::vector<Breakpoint *> > file_basename_index;
+
+    void
+    UpdateModuleKeyIndex ();
+
+    void
+    FindBreakpointsForModule (const lldb::ModuleSP &module_sp,
+                              std::set<Breakpoint *> &breakpoints);
+
     mutable Mutex m_mutex;
     bp_collection m_breakpoints;  // The breakpoint list, currently a list.
     lldb::break_id_t m_next_break_id;
     bool m_is_internal;
+    function_name_index m_function_name_index;
+    file_basename_index m_file_basename_index;
+    std::set<Breakpoint *> m_indexed_breakpoints; // Breakpoints that only need to search modules that match their keys
+    bool m_module_key_index_valid;
 
 private:
     DISALLOW_COPY_AND_ASSIGN (BreakpointList);
@@ -12,9 +12,12 @@
 
 // C Includes
 // C++ Includes
+#include <vector>
+
 // Other libraries and framework includes
 // Project includes
 #include "lldb/lldb-private.h"
+#include "lldb/Core/ConstString.h"
 #include "lldb/Core/Address.h"
 #include "lldb/Breakpoint/Breakpoint.h"
 #include "lldb/Breakpoint/BreakpointResolver.h"
@@ -97,6 +100,30 @@ public:
     ResolveBreakpointInModules (SearchFilter &filter,
                                 ModuleList &modules);
 
+    //------------------------------------------------------------------
+    /// Get the function names and source file base names of which a
+    /// module must contain at least one for this resolver to find any
+    /// locations in it. BreakpointList uses these to search a newly
+    /// loaded module once for all breakpoints instead of running every
+    /// resolver on it.
+    ///
+    /// @param[out] func_names
+    ///   Function names that are looked up with \a func_name_type_mask.
+    /// @param[out] file_basenames
+    ///   Base names of source files.
+    ///
+    /// @result
+    ///   \b true if the keys describe every module this resolver can
+    ///   find locations in, \b false if it needs to search all modules.
+    //------------------------------------------------------------------
+    virtual bool
+    GetModuleKeys (std::vector<ConstString> &func_names,
+                   uint32_t &func_name_type_mask,
+                   std::vector<ConstString> &file_basenames)
+    {
+        return false;
+    }
+
     //------------------------------------------------------------------
     /// Prints a canonical description for the breakpoint to the stream \a s.
     ///
@@ -46,6 +46,11 @@ public:
     virtual Searcher::Depth
     GetDepth ();
 
+    virtual bool
+    GetModuleKeys (std::vector<ConstString> &func_names,
+                   uint32_t &func_name_type_mask,
+                   std::vector<ConstString> &file_basenames);
+
     virtual void
     GetDescription (Stream *s);
 
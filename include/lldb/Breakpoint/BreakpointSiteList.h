@@ -12,7 +12,7 @@
 
 // C Includes
 // C++ Includes
-#include <map>
+#include <vector>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Breakpoint/BreakpointSite.h"
@@ -22,15 +22,21 @@ namespace lldb_private {
 //----------------------------------------------------------------------
 /// @class BreakpointSiteList BreakpointSiteList.h "lldb/Breakpoint/BreakpointSiteList.h"
 /// @brief Class that manages lists of BreakpointSite shared pointers.
+///
+/// Breakpoint sites are looked up by address and by ID on every stop,
+/// and by address range on every memory read and write, so a process
+/// with tens of thousands of sites needs all of these to be cheap.
+/// Sites are kept in an unordered array, two open addressing hash
+/// tables index that array by load address and by ID, and a flat array
+/// sorted by load address answers range queries. Sites that were added
+/// recently are kept in a short unsorted tail of the flat array which
+/// is merged into the sorted part once it grows too long.
 //----------------------------------------------------------------------
 class BreakpointSiteList
 {
-// At present Process directly accesses the map of BreakpointSites so it can
-// do quick lookups into the map (using GetMap).
-// FIXME: Find a better interface for this.
-friend class Process;
-
 public:
+    typedef std::vector<lldb::BreakpointSiteSP> collection;
+
     //------------------------------------------------------------------
     /// Default constructor makes an empty list.
     //------------------------------------------------------------------
@@ -180,12 +186,50 @@ public:
     bool
     RemoveByAddress (lldb::addr_t addr);
 
+    //------------------------------------------------------------------
+    /// Add many breakpoint sites to the list at once. The hash tables
+    /// are grown and the sorted array is merged only once.
+    ///
+    /// @param[in] bp_sites
+    ///    The breakpoint sites to add. Sites whose address is already
+    ///    in the list are skipped.
+    ///
+    /// @return
+    ///    The number of breakpoint sites that were added.
+    //------------------------------------------------------------------
+    size_t
+    AddSites (const collection &bp_sites);
+
+    //------------------------------------------------------------------
+    /// Remove all breakpoint sites at the addresses in \a addrs from
+    /// this list, compacting the sorted array only once.
+    ///
+    /// @return
+    ///    The number of breakpoint sites that were removed.
+    //------------------------------------------------------------------
+    size_t
+    RemoveByAddresses (const std::vector<lldb::addr_t> &addrs);
+
     void
     SetEnabledForAll(const bool enable, const lldb::break_id_t except_id = LLDB_INVALID_BREAK_ID);
     
     bool
     FindInRange (lldb::addr_t lower_bound, lldb::addr_t upper_bound, BreakpointSiteList &bp_site_list) const;
 
+    //------------------------------------------------------------------
+    /// Find all breakpoint sites that overlap the address range
+    /// [\a lower_bound, \a upper_bound).
+    ///
+    /// @param[out] bp_sites
+    ///    The overlapping breakpoint sites are appended to this, in
+    ///    order of increasing load address.
+    ///
+    /// @return
+    ///    The number of breakpoint sites that were appended.
+    //------------------------------------------------------------------
+    size_t
+    FindInRange (lldb::addr_t lower_bound, lldb::addr_t upper_bound, collection &bp_sites) const;
+
     typedef void (*BreakpointSiteSPMapFunc) (lldb::BreakpointSiteSP &bp, void *baton);
 
     //------------------------------------------------------------------
@@ -211,25 +255,68 @@ public:
     ///   The number of elements.
     //------------------------------------------------------------------
     size_t
-    GetSize() const { return m_bp_site_list.size(); }
+    GetSize() const { return m_sites.size(); }
 
 protected:
-    typedef std::map<lldb::addr_t, lldb::BreakpointSiteSP> collection;
+    // A slot in one of the open addressing hash tables. The tables use
+    // linear probing and are never more than half full.
+    struct HashSlot
+    {
+        uint64_t key;
+        uint32_t site_idx;  // Index into m_sites, UINT32_MAX if the slot is empty
+    };
+
+    typedef std::vector<HashSlot> hash_table;
+
+    struct SortedSite
+    {
+        lldb::addr_t addr;
+        BreakpointSite *site;   // Owned by a shared pointer in m_sites
+
+        bool
+        operator < (const SortedSite &rhs) const
+        {
+            return addr < rhs.addr;
+        }
+    };
+
+    typedef std::vector<SortedSite> sorted_collection;
+
+    static uint32_t
+    HashFind (const hash_table &table, uint64_t key);
 
-    collection::iterator
-    GetIDIterator(lldb::break_id_t breakID);
+    static void
+    HashInsert (hash_table &table, uint64_t key, uint32_t site_idx);
 
-    collection::const_iterator
-    GetIDConstIterator(lldb::break_id_t breakID) const;
+    static void
+    HashRemove (hash_table &table, uint64_t key);
 
-    // This function exposes the m_bp_site_list.  I use the in Process because there
-    // are places there where you want to iterate over the list, and it is less efficient
-    // to do it by index.  FIXME: Find a better way to do this.
+    static void
+    HashUpdate (hash_table &table, uint64_t key, uint32_t site_idx);
 
-    const collection *
-    GetMap ();
+    uint32_t
+    FindIndexByAddress (lldb::addr_t addr) const;
+
+    uint32_t
+    FindIndexByID (lldb::break_id_t break_id) const;
+
+    bool
+    AddSite (const lldb::BreakpointSiteSP &bp_site_sp);
+
+    void
+    RemoveSiteAtIndex (uint32_t site_idx);
+
+    void
+    ReserveHashTables (size_t num_sites);
+
+    void
+    MergeUnsortedSites ();
 
-    collection m_bp_site_list;  // The breakpoint site list.
+    collection m_sites;                 // All breakpoint sites, in no particular order
+    hash_table m_addr_table;            // Indexes m_sites by load address
+    hash_table m_id_table;              // Indexes m_sites by breakpoint site ID
+    sorted_collection m_sorted_sites;   // Sorted by address up to m_num_sorted, unsorted after that
+    size_t m_num_sorted;
 };
 
 } // namespace lldb_private
@@ -0,0 +1,70 @@
+//===-- CXXFormatterFunctions.h ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_CXXFormatterFunctions_h_
+#define liblldb_CXXFormatterFunctions_h_
+#if defined(__cplusplus)
+
+// C Includes
+#include <stdint.h>
+
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/FormatClasses.h"
+
+namespace lldb_private {
+namespace formatters {
+
+//----------------------------------------------------------------------
+// Synthetic children front ends for the containers of the GNU C++
+// library (libstdc++) and of libc++. These are used with
+// CXXSyntheticChildren and work without Python.
+//
+// The front ends read the container bookkeeping (node links, deque
+// block maps) straight from process memory instead of building a value
+// object for every node they walk, and stop walking if a node is seen
+// twice or an inconsistent node is found, so a corrupted or
+// uninitialized container shows a truncated list of children instead
+// of hanging the debugger.
+//----------------------------------------------------------------------
+
+SyntheticChildrenFrontEnd *
+LibstdcppVectorSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibstdcppListSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibstdcppMapSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibstdcppDequeSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibcxxVectorSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibcxxListSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibcxxMapSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibcxxDequeSyntheticFrontEndCreator (ValueObject &backend);
+
+SyntheticChildrenFrontEnd *
+LibcxxUnorderedSyntheticFrontEndCreator (ValueObject &backend);
+
+} // namespace formatters
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_CXXFormatterFunctions_h_
@@ -36,6 +36,22 @@ public:
     static uint32_t
     GetCurrentRevision ();
     
+    // number of formatter lookups answered by the FormatManager cache, and that
+    // had to search the enabled categories
+    static uint64_t
+    GetFormatCacheHits ();
+    
+    static uint64_t
+    GetFormatCacheMisses ();
+    
+    // counters of the time spent running Python summaries and synthetic
+    // children providers, kept per function or class name
+    static FormatterStatistics *
+    GetScriptedFormatterStatistics (const ConstString &name);
+    
+    static void
+    DumpScriptedFormatterStatistics (Stream &s);
+    
     class ValueFormats
     {
     public:
@@ -12,6 +12,8 @@
 
 // C Includes
 // C++ Includes
+#include <list>
+#include <map>
 #include <vector>
 
 // Other libraries and framework includes
@@ -19,9 +21,11 @@
 #include "lldb/lldb-private.h"
 #include "lldb/Core/Address.h"
 #include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/ConstString.h"
 #include "lldb/Core/EmulateInstruction.h"
 #include "lldb/Core/Opcode.h"
 #include "lldb/Core/PluginInterface.h"
+#include "lldb/Host/Mutex.h"
 #include "lldb/Interpreter/NamedOptionValue.h"
 
 namespace lldb_private {
@@ -353,6 +357,20 @@ public:
                         uint32_t num_instructions,
                         bool append) = 0;
     
+    //------------------------------------------------------------------
+    /// Replace the instruction list with copies of the instructions
+    /// that \a source, another instance of this plug-in, decoded. The
+    /// copies share no state with the originals, so their mnemonic,
+    /// operand and comment strings are calculated on their own.
+    ///
+    /// @return
+    ///     The number of bytes the copied instructions cover, or zero if
+    ///     this plug-in can't copy instructions and they need to be
+    ///     decoded again.
+    //------------------------------------------------------------------
+    virtual size_t
+    CopyInstructions (Disassembler &source);
+    
     InstructionList &
     GetInstructionList ();
 
@@ -380,6 +398,108 @@ private:
     DISALLOW_COPY_AND_ASSIGN (Disassembler);
 };
 
+//----------------------------------------------------------------------
+/// @class DisassemblyCache Disassembler.h "lldb/Core/Disassembler.h"
+/// @brief Decoded instructions for code in a module.
+///
+/// Stepping, unwinding and the stop display disassemble the same
+/// functions over and over again. Each Module keeps one of these
+/// caches so that code in the module only needs to be decoded once.
+/// Entries are keyed by file address and hold on to the bytes they
+/// were decoded from: a lookup whose bytes differ (the code was
+/// patched, or a different file was loaded) is a miss and the entry
+/// is replaced. The cached instructions are never handed out, every
+/// hit copies them into the caller's own disassembler. Mnemonic,
+/// operand and comment strings depend on the execution context they
+/// are calculated in, so each copy calculates its own. The least
+/// recently used entries are dropped once the cache grows past its
+/// memory limit.
+//----------------------------------------------------------------------
+class DisassemblyCache
+{
+public:
+    DisassemblyCache ();
+
+    ~DisassemblyCache ();
+
+    //------------------------------------------------------------------
+    /// Fill in \a disasm with copies of the instructions decoded from
+    /// \a data at \a file_addr.
+    ///
+    /// @return
+    ///     True if there was a matching entry and \a disasm now holds
+    ///     copies of its instructions, false if the caller needs to
+    ///     decode them.
+    //------------------------------------------------------------------
+    bool
+    CopyInstructions (const ArchSpec &arch,
+                      const char *plugin_name,
+                      lldb::addr_t file_addr,
+                      uint32_t num_instructions,
+                      const DataExtractor &data,
+                      Disassembler &disasm);
+
+    //------------------------------------------------------------------
+    /// Cache the instructions of \a disasm_sp. The caller must not use
+    /// \a disasm_sp afterwards, it belongs to the cache.
+    //------------------------------------------------------------------
+    void
+    Insert (const ArchSpec &arch,
+            const char *plugin_name,
+            lldb::addr_t file_addr,
+            uint32_t num_instructions,
+            const DataExtractor &data,
+            const lldb::DisassemblerSP &disasm_sp);
+
+    void
+    Clear ();
+
+    size_t
+    GetByteSize () const;
+
+protected:
+    struct Key
+    {
+        lldb::addr_t file_addr;
+        lldb::addr_t byte_size;
+        uint32_t num_instructions;
+
+        bool
+        operator < (const Key &rhs) const
+        {
+            if (file_addr != rhs.file_addr)
+                return file_addr < rhs.file_addr;
+            if (byte_size != rhs.byte_size)
+                return byte_size < rhs.byte_size;
+            return num_instructions < rhs.num_instructions;
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        ArchSpec arch;
+        ConstString plugin_name;
+        std::vector<uint8_t> bytes;     // The bytes the instructions were decoded from
+        lldb::DisassemblerSP disasm_sp;
+        size_t accounted_size;          // Approximate memory used by this entry
+    };
+
+    typedef std::list<Entry> EntryList;     // Most recently used first
+    typedef std::map<Key, EntryList::iterator> EntryMap;
+
+    void
+    RemoveEntry (EntryMap::iterator pos);
+
+    mutable Mutex m_mutex;
+    EntryList m_entries;
+    EntryMap m_entry_map;
+    size_t m_byte_size;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (DisassemblyCache);
+};
+
 } // namespace lldb_private
 
 #endif  // liblldb_Disassembler_h_
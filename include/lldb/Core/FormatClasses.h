@@ -24,6 +24,7 @@
 #include "lldb/lldb-public.h"
 #include "lldb/lldb-enumerations.h"
 
+#include "lldb/Core/Statistics.h"
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Interpreter/ScriptInterpreterPython.h"
 #include "lldb/Symbol/Type.h"
@@ -240,6 +241,14 @@ public:
     virtual uint32_t
     CalculateNumChildren() = 0;
     
+    // front-ends for containers that are expensive to count can stop at max
+    // and return max, anything less than max must be the exact count
+    virtual uint32_t
+    CalculateNumChildrenUpTo (uint32_t max)
+    {
+        return CalculateNumChildren();
+    }
+    
     virtual lldb::ValueObjectSP
     GetChildAtIndex (uint32_t idx, bool can_create) = 0;
     
@@ -427,6 +436,14 @@ public:
     virtual bool
     IsScripted () = 0;
     
+    // true for synthetic children that LLDB implements in C++, which are
+    // neither Python classes nor a TypeFilterImpl
+    virtual bool
+    IsNative ()
+    {
+        return false;
+    }
+    
     virtual std::string
     GetDescription () = 0;
     
@@ -660,9 +677,20 @@ public:
     class FrontEnd : public SyntheticChildrenFrontEnd
     {
     private:
+        enum
+        {
+            // Number of children requested from providers that implement
+            // get_child_range() in each call
+            kChildBatchSize = 64
+        };
+        
         std::string m_python_class;
         lldb::ScriptInterpreterObjectSP m_wrapper_sp;
         ScriptInterpreter *m_interpreter;
+        FormatterStatistics *m_stats;
+        std::vector<lldb::ValueObjectSP> m_child_batch;   // Children [m_child_batch_start, m_child_batch_start + m_child_batch.size())
+        uint32_t m_child_batch_start;
+        bool m_can_batch;                                   // False once the provider turned out not to implement get_child_range()
     public:
         
         FrontEnd(std::string pclass,
@@ -674,30 +702,20 @@ public:
         virtual uint32_t
         CalculateNumChildren()
         {
-            if (!m_wrapper_sp || m_interpreter == NULL)
-                return 0;
-            return m_interpreter->CalculateNumChildren(m_wrapper_sp);
+            return CalculateNumChildrenUpTo(UINT32_MAX);
         }
         
+        virtual uint32_t
+        CalculateNumChildrenUpTo (uint32_t max);
+        
         virtual lldb::ValueObjectSP
         GetChildAtIndex (uint32_t idx, bool can_create);
         
         virtual bool
-        Update()
-        {
-            if (!m_wrapper_sp || m_interpreter == NULL)
-                return false;
-            
-            return m_interpreter->UpdateSynthProviderInstance(m_wrapper_sp);
-        }
+        Update();
                 
         virtual uint32_t
-        GetIndexOfChildWithName (const ConstString &name)
-        {
-            if (!m_wrapper_sp || m_interpreter == NULL)
-                return UINT32_MAX;
-            return m_interpreter->GetIndexOfChildWithName(m_wrapper_sp, name.GetCString());
-        }
+        GetIndexOfChildWithName (const ConstString &name);
         
         typedef STD_SHARED_PTR(SyntheticChildrenFrontEnd) SharedPointer;
 
@@ -920,6 +938,52 @@ private:
     DISALLOW_COPY_AND_ASSIGN(SyntheticArrayView);
 };
 
+// synthetic children whose front end is implemented in C++, these need
+// no Python class and are used for the containers of the C++ standard
+// libraries (see CXXFormatterFunctions.h)
+class CXXSyntheticChildren : public SyntheticChildren
+{
+public:
+    typedef SyntheticChildrenFrontEnd* (*CreateFrontEndCallback) (ValueObject &backend);
+    
+    CXXSyntheticChildren (const SyntheticChildren::Flags& flags,
+                          const char* description,
+                          CreateFrontEndCallback callback) :
+        SyntheticChildren(flags),
+        m_create_callback(callback),
+        m_description(description ? description : "")
+    {
+    }
+    
+    bool
+    IsScripted()
+    {
+        return false;
+    }
+    
+    bool
+    IsNative()
+    {
+        return true;
+    }
+    
+    std::string
+    GetDescription();
+    
+    virtual SyntheticChildrenFrontEnd::AutoPointer
+    GetFrontEnd(ValueObject &backend)
+    {
+        return SyntheticChildrenFrontEnd::AutoPointer(m_create_callback(backend));
+    }
+    
+protected:
+    CreateFrontEndCallback m_create_callback;
+    std::string m_description;
+    
+private:
+    DISALLOW_COPY_AND_ASSIGN(CXXSyntheticChildren);
+};
+
 
 class TypeSummaryImpl
 {
@@ -1277,6 +1341,7 @@ struct ScriptSummaryFormat : public TypeSummaryImpl
     std::string m_function_name;
     std::string m_python_script;
     lldb::ScriptInterpreterObjectSP m_script_function_sp;
+    FormatterStatistics *m_stats;   // Counters for m_function_name, looked up on first use
     
     ScriptSummaryFormat(const TypeSummaryImpl::Flags& flags,
                         const char *function_name,
@@ -1302,6 +1367,7 @@ struct ScriptSummaryFormat : public TypeSummaryImpl
         else
                 m_function_name.clear();
         m_python_script.clear();
+        m_stats = NULL;
     }
     
     void
@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <map>
 
 // Other libraries and framework includes
 // Project includes
@@ -19,6 +20,7 @@
 #include "lldb/lldb-enumerations.h"
 
 #include "lldb/Core/FormatNavigator.h"
+#include "lldb/Core/Statistics.h"
 #include "lldb/Interpreter/ScriptInterpreterPython.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Platform.h"
@@ -646,12 +648,19 @@ public:
     GetCategory (const ConstString& category_name,
                  bool can_create = true);
     
+    //------------------------------------------------------------------
+    /// Get the value format, summary or synthetic children provider
+    /// for \a valobj. Results are cached per type and dynamic value
+    /// mode until the next change to any formatter or category, so
+    /// the children of a large array only search the categories once.
+    //------------------------------------------------------------------
+    lldb::TypeFormatImplSP
+    GetFormat (ValueObject& valobj,
+               lldb::DynamicValueType use_dynamic);
+    
     lldb::TypeSummaryImplSP
     GetSummaryFormat (ValueObject& valobj,
-                      lldb::DynamicValueType use_dynamic)
-    {
-        return m_categories_map.GetSummaryFormat(valobj, use_dynamic);
-    }
+                      lldb::DynamicValueType use_dynamic);
     
     lldb::TypeSummaryImplSP
     GetSummaryForType (lldb::TypeNameSpecifierImplSP type_sp);
@@ -672,10 +681,7 @@ public:
 #ifndef LLDB_DISABLE_PYTHON
     lldb::SyntheticChildrenSP
     GetSyntheticChildren (ValueObject& valobj,
-                          lldb::DynamicValueType use_dynamic)
-    {
-        return m_categories_map.GetSyntheticChildren(valobj, use_dynamic);
-    }
+                          lldb::DynamicValueType use_dynamic);
 #endif
     
     bool
@@ -727,20 +733,114 @@ public:
         return m_last_revision;
     }
     
+    // Number of GetFormat/GetSummaryFormat/GetSyntheticChildren calls
+    // that were answered from the formatter cache, and that had to search
+    // the categories
+    uint64_t
+    GetFormatCacheHits () const
+    {
+        return m_format_cache_hits;
+    }
+    
+    uint64_t
+    GetFormatCacheMisses () const
+    {
+        return m_format_cache_misses;
+    }
+    
+    // Get the counters for the Python summary function or synthetic
+    // children provider class called name. The counters live as long as
+    // the FormatManager, so formatters can hold on to them.
+    FormatterStatistics *
+    GetScriptedFormatterStatistics (const ConstString &name);
+    
+    // Write the counters of all scripted formatters as a JSON array
+    void
+    DumpScriptedFormatterStatistics (Stream &s);
+    
     ~FormatManager ()
     {
     }
     
 private:    
+    struct FormatCacheKey
+    {
+        void *clang_type;
+        uint32_t bitfield_bit_size;
+        lldb::DynamicValueType use_dynamic;
+        
+        bool
+        operator < (const FormatCacheKey &rhs) const
+        {
+            if (clang_type != rhs.clang_type)
+                return clang_type < rhs.clang_type;
+            if (bitfield_bit_size != rhs.bitfield_bit_size)
+                return bitfield_bit_size < rhs.bitfield_bit_size;
+            return use_dynamic < rhs.use_dynamic;
+        }
+    };
+    
+    struct FormatCacheEntry
+    {
+        FormatCacheEntry () :
+            type_name (),
+            format_sp (),
+            summary_sp (),
+            synthetic_sp (),
+            has_format (false),
+            has_summary (false),
+            has_synthetic (false)
+        {
+        }
+        
+        ConstString type_name;
+        lldb::TypeFormatImplSP format_sp;
+        lldb::TypeSummaryImplSP summary_sp;
+        lldb::SyntheticChildrenSP synthetic_sp;
+        bool has_format;
+        bool has_summary;
+        bool has_synthetic;
+    };
+    
+    typedef std::map<FormatCacheKey, FormatCacheEntry> FormatCache;
+    
+    // Fills in the cache key for valobj, returns false if the formatters
+    // for valobj may depend on more than its type and can't be cached
+    static bool
+    GetFormatCacheKey (ValueObject& valobj,
+                       lldb::DynamicValueType use_dynamic,
+                       FormatCacheKey &key);
+    
+    // Get the cache entry for key, or NULL if there isn't one. Lookups
+    // flush the cache if it was filled at a revision other than revision,
+    // with can_create a missing entry gets added unless the cache has been
+    // flushed since revision. m_format_cache_mutex must be locked.
+    FormatCacheEntry *
+    FindFormatCacheEntry (const FormatCacheKey &key,
+                          const ConstString &type_name,
+                          uint32_t revision,
+                          bool can_create);
+    
     ValueNavigator m_value_nav;
     NamedSummariesMap m_named_summaries_map;
     uint32_t m_last_revision;
     CategoryMap m_categories_map;
     
+    Mutex m_format_cache_mutex;
+    FormatCache m_format_cache;
+    uint32_t m_format_cache_revision;   // The revision m_format_cache entries were resolved at
+    uint64_t m_format_cache_hits;
+    uint64_t m_format_cache_misses;
+    
+    Mutex m_formatter_stats_mutex;
+    std::map<ConstString, FormatterStatistics> m_formatter_stats;
+    
     ConstString m_default_category_name;
     ConstString m_system_category_name;
     ConstString m_gnu_cpp_category_name;
     ConstString m_libcxx_category_name;
+    ConstString m_gnu_cpp_python_category_name;   // Python versions of the STL synthetic children
+    ConstString m_libcxx_python_category_name;
     ConstString m_objc_category_name;
     ConstString m_corefoundation_category_name;
     ConstString m_coregraphics_category_name;
@@ -24,6 +24,7 @@
 #include "lldb/Core/FormatClasses.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/RegularExpression.h"
+#include "lldb/Core/RegularExpressionSet.h"
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Target/ObjCLanguageRuntime.h"
 #include "lldb/Target/Process.h"
@@ -113,7 +114,8 @@ public:
     FormatMap(IFormatChangeListener* lst) :
     m_map(),
     m_map_mutex(Mutex::eMutexTypeRecursive),
-    listener(lst)
+    listener(lst),
+    m_generation(0)
     {
     }
     
@@ -128,6 +130,7 @@ public:
 
         Mutex::Locker(m_map_mutex);
         m_map[name] = entry;
+        m_generation++;
         if (listener)
             listener->Changed();
     }
@@ -140,6 +143,7 @@ public:
         if (iter == m_map.end())
             return false;
         m_map.erase(name);
+        m_generation++;
         if (listener)
             listener->Changed();
         return true;
@@ -150,6 +154,7 @@ public:
     {
         Mutex::Locker(m_map_mutex);
         m_map.clear();
+        m_generation++;
         if (listener)
             listener->Changed();
     }
@@ -224,6 +229,7 @@ protected:
     MapType m_map;    
     Mutex m_map_mutex;
     IFormatChangeListener* listener;
+    uint32_t m_generation; // Bumped whenever m_map changes
     
     MapType&
     map ()
@@ -266,7 +272,10 @@ public:
                     IFormatChangeListener* lst) :
     m_format_map(lst),
     m_name(name),
-    m_id_cs(ConstString("id"))
+    m_id_cs(ConstString("id")),
+    m_regex_set(),
+    m_regex_set_values(),
+    m_regex_set_generation(UINT32_MAX)
     {
     }
     
@@ -351,6 +360,12 @@ protected:
     DISALLOW_COPY_AND_ASSIGN(FormatNavigator);
     
     ConstString m_id_cs;
+    
+    // For regex navigators, all the keys of m_format_map in map order so
+    // that Get() doesn't have to run every regular expression in turn
+    RegularExpressionSet m_regex_set;
+    std::vector<MapValueType> m_regex_set_values;
+    uint32_t m_regex_set_generation;
                            
     void
     Add_Impl (const MapKeyType &type, const MapValueType& entry, lldb::RegularExpressionSP *dummy)
@@ -381,6 +396,7 @@ protected:
            if ( ::strcmp(type.AsCString(),regex->GetText()) == 0)
            {
                m_format_map.map().erase(pos);
+               m_format_map.m_generation++;
                if (m_format_map.listener)
                    m_format_map.listener->Changed();
                return true;
@@ -427,17 +443,23 @@ protected:
     {
        Mutex& x_mutex = m_format_map.mutex();
        lldb_private::Mutex::Locker locker(x_mutex);
-       MapIterator pos, end = m_format_map.map().end();
-       for (pos = m_format_map.map().begin(); pos != end; pos++)
+       if (m_regex_set_generation != m_format_map.m_generation)
        {
-           lldb::RegularExpressionSP regex = pos->first;
-           if (regex->Execute(key.AsCString()))
+           m_regex_set.Clear();
+           m_regex_set_values.clear();
+           MapIterator pos, end = m_format_map.map().end();
+           for (pos = m_format_map.map().begin(); pos != end; pos++)
            {
-               value = pos->second;
-               return true;
+               m_regex_set.Append(pos->first);
+               m_regex_set_values.push_back(pos->second);
            }
+           m_regex_set_generation = m_format_map.m_generation;
        }
-       return false;
+       const uint32_t match_idx = m_regex_set.FindFirstMatch(key.AsCString());
+       if (match_idx >= m_regex_set_values.size())
+           return false;
+       value = m_regex_set_values[match_idx];
+       return true;
     }
     
     bool
@@ -136,10 +136,48 @@ protected:
         void *callback_user_data;
     };
 
+    struct QueuedEvent
+    {
+        QueuedEvent (uint64_t seq, const lldb::EventSP &sp) :
+            sequence (seq),
+            broadcaster (sp->GetBroadcaster()),
+            event_type (sp->GetType()),
+            event_sp (sp)
+        {
+        }
+
+        uint64_t sequence;          // Order in which the event was queued
+        Broadcaster *broadcaster;   // Broadcaster and type the event was indexed with
+        uint32_t event_type;
+        lldb::EventSP event_sp;
+    };
+
+    // Events added by AddEvent() that haven't been moved into m_events yet
+    struct PendingEvent
+    {
+        lldb::EventSP event_sp;
+        PendingEvent *next;
+    };
+
     typedef std::multimap<Broadcaster*, BroadcasterInfo> broadcaster_collection;
-    typedef std::list<lldb::EventSP> event_collection;
+    typedef std::list<QueuedEvent> event_collection;
+    // The events of one broadcaster are kept in a list for each event type
+    // so that a lookup by broadcaster and event type mask only needs to
+    // look at the first event of each matching list
+    typedef std::list<event_collection::iterator> event_position_list;
+    typedef std::map<uint32_t, event_position_list> event_type_index;
+    typedef std::map<Broadcaster*, event_type_index> event_broadcaster_index;
     typedef std::vector<BroadcasterManager *> broadcaster_manager_collection;
 
+    void
+    MovePendingEvents ();
+
+    void
+    RemoveQueuedEvent (event_collection::iterator pos);
+
+    void
+    ResetEventCondition ();
+
     bool
     FindNextEventInternal (Broadcaster *broadcaster,   // NULL for any broadcaster
                            const ConstString *sources, // NULL for any event
@@ -167,7 +205,10 @@ protected:
     broadcaster_collection m_broadcasters;
     Mutex m_broadcasters_mutex; // Protects m_broadcasters
     event_collection m_events;
-    Mutex m_events_mutex; // Protects m_broadcasters and m_events
+    event_broadcaster_index m_events_index;
+    uint64_t m_next_event_sequence;
+    PendingEvent *m_pending_events; // Pushed to by AddEvent() without taking m_events_mutex
+    Mutex m_events_mutex; // Protects m_events and m_events_index
     Predicate<bool> m_cond_wait;
     broadcaster_manager_collection m_broadcaster_managers;
 
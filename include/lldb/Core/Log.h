@@ -46,6 +46,8 @@
 #define LLDB_LOG_OPTION_PREPEND_TIMESTAMP       (1u << 4)
 #define LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD (1u << 5)
 #define LLDB_LOG_OPTION_PREPEND_THREAD_NAME     (1U << 6)
+#define LLDB_LOG_OPTION_ASYNC                   (1u << 7)   // Write log records on a background thread
+#define LLDB_LOG_OPTION_BINARY                  (1u << 8)   // Write compact binary records, see "log decode"
 
 //----------------------------------------------------------------------
 // Logging Functions
@@ -183,10 +185,14 @@ protected:
     lldb::StreamSP m_stream_sp;
     Flags m_options;
     Flags m_mask_bits;
+    uint32_t m_writer_stream_idx; // The LogWriter stream index for m_stream_sp if it has been registered
 
     void
     PrintfWithFlagsVarArg (uint32_t flags, const char *format, va_list args);
 
+    void
+    WriteRecordVarArg (const char *format, va_list args);
+
 private:
     DISALLOW_COPY_AND_ASSIGN (Log);
 };
@@ -0,0 +1,218 @@
+//===-- LogWriter.h ---------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_LogWriter_h_
+#define liblldb_LogWriter_h_
+#if defined(__cplusplus)
+
+// C Includes
+#include <stdarg.h>
+#include <stdint.h>
+
+// C++ Includes
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Host/Condition.h"
+#include "lldb/Host/Mutex.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class LogWriter LogWriter.h "lldb/Core/LogWriter.h"
+/// @brief Writes log records to their streams on a background thread.
+///
+/// Log objects that have LLDB_LOG_OPTION_ASYNC set hand their records
+/// to the shared LogWriter instead of writing to their stream. Each
+/// logging thread gets its own single producer/single consumer ring
+/// buffer, so enqueuing a record never takes a lock or makes a system
+/// call. A writer thread periodically drains all ring buffers, orders
+/// the records by their global sequence number and writes them out.
+///
+/// This class also knows how to encode log records in a compact binary
+/// form (LLDB_LOG_OPTION_BINARY) where the printf style arguments are
+/// captured instead of formatted, and how to decode a file of binary
+/// records back into text (see "log decode").
+//----------------------------------------------------------------------
+class LogWriter
+{
+public:
+    class RingBuffer;
+    struct FormatTable;
+    struct StreamInfo;
+
+    enum
+    {
+        kMaxStreams = 64    // Maximum number of streams that can be registered
+    };
+
+    //------------------------------------------------------------------
+    /// Get the shared log writer. The writer thread is started lazily
+    /// the first time a stream gets registered.
+    //------------------------------------------------------------------
+    static LogWriter &
+    GetSharedInstance ();
+
+    //------------------------------------------------------------------
+    /// Register a stream that records can be enqueued for.
+    ///
+    /// @return
+    ///     A stream index for use with Enqueue(), registering the same
+    ///     stream more than once returns the same index but forgets which
+    ///     format strings were written to it, since the stream might have
+    ///     been reopened or truncated in the meantime. UINT32_MAX is
+    ///     returned if too many streams have been registered, in which
+    ///     case the caller should write to the stream directly.
+    //------------------------------------------------------------------
+    uint32_t
+    RegisterStream (const lldb::StreamSP &stream_sp);
+
+    //------------------------------------------------------------------
+    /// Undo one RegisterStream() call for the stream at \a stream_idx.
+    /// When the last log using the stream unregisters, the records that
+    /// are still queued get written, the stream is released and its
+    /// index can be handed out to another stream.
+    //------------------------------------------------------------------
+    void
+    UnregisterStream (uint32_t stream_idx);
+
+    //------------------------------------------------------------------
+    /// Returns true if there is room to register another stream.
+    //------------------------------------------------------------------
+    bool
+    HasFreeStream ();
+
+    //------------------------------------------------------------------
+    /// Get the next global log sequence number. Sequence numbers are
+    /// used to order records that were logged from different threads.
+    //------------------------------------------------------------------
+    static uint32_t
+    GetNextSequenceID ();
+
+    //------------------------------------------------------------------
+    /// Enqueue \a length bytes from \a bytes to be written to the stream
+    /// at \a stream_idx. Records that are too large to fit in the ring
+    /// buffer get written synchronously after the pending records have
+    /// been flushed, while holding the same lock the writer thread holds
+    /// while writing.
+    //------------------------------------------------------------------
+    void
+    Enqueue (uint32_t stream_idx,
+             uint32_t sequence_id,
+             const void *bytes,
+             size_t length);
+
+    //------------------------------------------------------------------
+    /// Wait until all records that were enqueued before this call have
+    /// been written to their streams.
+    //------------------------------------------------------------------
+    void
+    Flush ();
+
+    //------------------------------------------------------------------
+    /// Flush all pending records and stop the writer thread. Records
+    /// that are enqueued after this get written by the next Flush().
+    //------------------------------------------------------------------
+    void
+    Terminate ();
+
+    //------------------------------------------------------------------
+    /// Encode a binary log record into \a record.
+    ///
+    /// @param[in] stream_idx
+    ///     The registered stream the record will be written to. Format
+    ///     strings are only written out once per stream registration,
+    ///     after that the record refers to the format by index. Pass
+    ///     UINT32_MAX for unregistered streams to always include the
+    ///     format string.
+    ///
+    /// @return
+    ///     True if the record was encoded, false if \a format contains
+    ///     a conversion that can't be captured and the caller should
+    ///     log the formatted text instead.
+    //------------------------------------------------------------------
+    bool
+    EncodeBinaryRecord (uint32_t stream_idx,
+                        uint32_t sequence_id,
+                        uint32_t log_options,
+                        const char *format,
+                        va_list args,
+                        std::vector<uint8_t> &record);
+
+    //------------------------------------------------------------------
+    /// Write the header that is prepended to each log line according
+    /// to the LLDB_LOG_OPTION_PREPEND_XXX bits in \a log_options.
+    //------------------------------------------------------------------
+    static void
+    DumpRecordHeader (Stream &s,
+                      uint32_t log_options,
+                      uint32_t sequence_id,
+                      uint64_t timestamp_usec,
+                      lldb::pid_t pid,
+                      lldb::tid_t tid,
+                      const char *thread_name);
+
+    //------------------------------------------------------------------
+    /// Decode a file full of binary log records to text. Any bytes in
+    /// the file that aren't part of a binary record (text log lines
+    /// from logs that share the same file) are copied as is.
+    ///
+    /// @return
+    ///     The number of records that were decoded.
+    //------------------------------------------------------------------
+    static uint32_t
+    DecodeBinaryLog (const FileSpec &file, Stream &strm, Error &error);
+
+    ~LogWriter ();
+
+protected:
+    LogWriter ();
+
+    RingBuffer *
+    GetRingBufferForCurrentThread ();
+
+    bool
+    StartWriterThread ();
+
+    lldb::StreamSP
+    GetStreamAtIndex (uint32_t stream_idx);
+
+    // Drain all ring buffers and write the records, returns the number
+    // of records written
+    size_t
+    WriteRecords ();
+
+    static lldb::thread_result_t
+    WriterThread (lldb::thread_arg_t arg);
+
+    static void
+    RingBufferThreadCleanup (void *ring_buffer);
+
+    Mutex m_mutex;                  // Protects all members below and the contents of the m_streams entries, which never change once set
+    Mutex m_write_mutex;            // Only one thread at a time can drain the ring buffers or write to the streams
+    Condition m_writer_condition;   // Signaled to wake the writer thread
+    Condition m_pass_condition;     // Broadcast when the writer thread completes a pass
+    StreamInfo * volatile m_streams[kMaxStreams];
+    uint32_t m_num_streams;
+    std::vector<RingBuffer *> m_ring_buffers;
+    lldb::thread_t m_writer_thread;
+    uint32_t m_pass_count;
+    bool m_flush_requested;
+    bool m_terminating;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (LogWriter);
+};
+
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_LogWriter_h_
@@ -12,6 +12,7 @@
 
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Core/Statistics.h"
 #include "lldb/Core/UUID.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Host/Mutex.h"
@@ -527,6 +528,23 @@ public:
                    bool append, 
                    SymbolContextList& sc_list);
 
+    //------------------------------------------------------------------
+    /// Check if FindFunctions() could find \a name in this module
+    /// without indexing the module's debug information.
+    ///
+    /// If the symbol file can't look up functions by name without
+    /// building its indexes first, the symbol table is consulted
+    /// instead. Functions that are only inlined have no symbols, so
+    /// this can miss those.
+    ///
+    /// @return
+    ///     \b false if the symbol table shows that this module has no
+    ///     function named \a name, \b true otherwise.
+    //------------------------------------------------------------------
+    bool
+    MightContainFunction (const ConstString &name,
+                          uint32_t name_type_mask);
+
     //------------------------------------------------------------------
     /// Find functions by name.
     ///
@@ -1101,6 +1119,38 @@ public:
     //------------------------------------------------------------------
     bool
     RemapSourceFile (const char *path, std::string &new_path) const;
+
+    //------------------------------------------------------------------
+    /// Get the always-on performance counters for this module.
+    ///
+    /// Object file and symbol file plug-ins update these counters as
+    /// they parse and index the module.
+    //------------------------------------------------------------------
+    ModuleStatistics &
+    GetStatistics ()
+    {
+        return m_stats;
+    }
+
+    //------------------------------------------------------------------
+    /// Dump the performance counters for this module as a JSON object.
+    //------------------------------------------------------------------
+    void
+    DumpStatistics (Stream &s);
+
+    //------------------------------------------------------------------
+    /// Get the cache of instructions that were disassembled from code
+    /// in this module.
+    //------------------------------------------------------------------
+    DisassemblyCache &
+    GetDisassemblyCache ();
+
+    //------------------------------------------------------------------
+    /// Drop the instructions that were disassembled from code in this
+    /// module, for instance when it gets unloaded.
+    //------------------------------------------------------------------
+    void
+    ClearDisassemblyCache ();
     
 protected:
     //------------------------------------------------------------------
@@ -1119,6 +1169,8 @@ protected:
     std::auto_ptr<SymbolVendor> m_symfile_ap;   ///< A pointer to the symbol vendor for this module.
     ClangASTContext             m_ast;          ///< The AST context for this module.
     PathMappingList             m_source_mappings; ///< Module specific source remappings for when you have debug info for a module that doesn't match where the sources currently are
+    ModuleStatistics            m_stats;        ///< Always-on performance counters for this module.
+    std::auto_ptr<DisassemblyCache> m_disassembly_cache_ap; ///< Instructions decoded from this module, created on demand.
 
     bool                        m_did_load_objfile:1,
                                 m_did_load_symbol_vendor:1,
@@ -0,0 +1,115 @@
+//===-- RegularExpressionSet.h ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_RegularExpressionSet_h_
+#define liblldb_RegularExpressionSet_h_
+#if defined(__cplusplus)
+
+// C Includes
+#include <stdint.h>
+
+// C++ Includes
+#include <map>
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Core/RegularExpression.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class RegularExpressionSet RegularExpressionSet.h "lldb/Core/RegularExpressionSet.h"
+/// @brief Finds the first of many regular expressions that matches a string.
+///
+/// Regular expressions are kept in the order they were appended, which
+/// is their priority. Most type name regular expressions start with an
+/// anchored literal prefix ("^std::vector<.+>$"), those are stored in a
+/// prefix trie so that a lookup only runs the regular expressions whose
+/// prefix matches the start of the string. All other regular expressions
+/// are also compiled into a single alternation which is used to skip
+/// them all at once when none of them can match.
+//----------------------------------------------------------------------
+class RegularExpressionSet
+{
+public:
+    RegularExpressionSet ();
+
+    ~RegularExpressionSet ();
+
+    //------------------------------------------------------------------
+    /// Add \a regex_sp with a lower priority than all regular
+    /// expressions that were added before it.
+    ///
+    /// @return
+    ///     The index of the regular expression in this set.
+    //------------------------------------------------------------------
+    uint32_t
+    Append (const lldb::RegularExpressionSP &regex_sp);
+
+    void
+    Clear ();
+
+    size_t
+    GetSize () const
+    {
+        return m_regexes.size();
+    }
+
+    //------------------------------------------------------------------
+    /// Find the first regular expression in priority order that
+    /// matches \a s.
+    ///
+    /// @return
+    ///     The index of the matching regular expression, or UINT32_MAX
+    ///     if none of them match.
+    //------------------------------------------------------------------
+    uint32_t
+    FindFirstMatch (const char *s);
+
+    //------------------------------------------------------------------
+    /// Get the literal text a string must start with for \a regex to
+    /// match it.
+    ///
+    /// @return
+    ///     True if \a regex is anchored and starts with literal text,
+    ///     false if a string may match it regardless of its prefix.
+    //------------------------------------------------------------------
+    static bool
+    GetLiteralPrefix (const RegularExpression &regex, std::string &prefix);
+
+protected:
+    struct TrieNode
+    {
+        std::map<char, uint32_t> children;  // Indexes into m_trie
+        std::vector<uint32_t> regex_indexes;// Regular expressions whose literal prefix ends at this node
+    };
+
+    void
+    CompileUnanchored ();
+
+    std::vector<lldb::RegularExpressionSP> m_regexes;
+    std::vector<TrieNode> m_trie;               // m_trie[0] is the root
+    std::vector<uint32_t> m_unanchored;         // Regular expressions covered by m_unanchored_regex
+    std::vector<uint32_t> m_always;             // Regular expressions that always need to be run
+    std::vector<uint32_t> m_candidates;         // Scratch space for FindFirstMatch()
+    RegularExpression m_unanchored_regex;
+    bool m_unanchored_regex_valid;
+    bool m_unanchored_regex_stale;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (RegularExpressionSet);
+};
+
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_RegularExpressionSet_h_
@@ -0,0 +1,221 @@
+//===-- Statistics.h --------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_Statistics_h_
+#define liblldb_Statistics_h_
+#if defined(__cplusplus)
+
+// C Includes
+#include <stdint.h>
+
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/lldb-private.h"
+#include "lldb/Host/TimeValue.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class Statistics Statistics.h "lldb/Core/Statistics.h"
+/// @brief Helpers for always-on performance counters.
+///
+/// Unlike Timer, which is only useful when "log timers" is enabled,
+/// the counters in this file are always collected. They are cheap
+/// enough to update on every call (an atomic add) and are reported
+/// through the "statistics dump" command and SBTarget::GetStatistics().
+//----------------------------------------------------------------------
+class Statistics
+{
+public:
+    static void
+    Increment (uint64_t &counter, uint64_t amount = 1)
+    {
+        __sync_add_and_fetch (&counter, amount);
+    }
+
+    static void
+    Decrement (uint64_t &counter, uint64_t amount = 1)
+    {
+        __sync_sub_and_fetch (&counter, amount);
+    }
+
+    static uint64_t
+    Get (const uint64_t &counter)
+    {
+        return __sync_add_and_fetch (const_cast<uint64_t *>(&counter), 0);
+    }
+
+    //------------------------------------------------------------------
+    /// Write \a cstr to \a s as a quoted JSON string.
+    //------------------------------------------------------------------
+    static void
+    PutJSONString (Stream &s, const char *cstr);
+
+    //------------------------------------------------------------------
+    /// Write a nanosecond counter to \a s as a JSON number of seconds.
+    //------------------------------------------------------------------
+    static void
+    PutJSONSeconds (Stream &s, uint64_t nsec);
+};
+
+//----------------------------------------------------------------------
+/// @class StatsTimer Statistics.h "lldb/Core/Statistics.h"
+/// @brief A scoped timer that adds its elapsed time to a counter.
+///
+/// A NULL counter makes the timer a no-op, which lets callers that may
+/// not have an owning module avoid special casing.
+//----------------------------------------------------------------------
+class StatsTimer
+{
+public:
+    StatsTimer (uint64_t *nsec_counter) :
+        m_counter (nsec_counter),
+        m_start ()
+    {
+        if (m_counter)
+            m_start = TimeValue::Now();
+    }
+
+    ~StatsTimer ()
+    {
+        if (m_counter)
+            Statistics::Increment (*m_counter, TimeValue::Now() - m_start);
+    }
+
+private:
+    uint64_t *m_counter;
+    TimeValue m_start;
+
+    DISALLOW_COPY_AND_ASSIGN (StatsTimer);
+};
+
+//----------------------------------------------------------------------
+// Counters kept by each Module. Symbol file and object file plug-ins
+// update these through Module::GetStatistics().
+//----------------------------------------------------------------------
+struct ModuleStatistics
+{
+    ModuleStatistics ()
+    {
+        Clear();
+    }
+
+    void
+    Clear ()
+    {
+        symtab_parse_nsec = 0;
+        symfile_index_nsec = 0;
+        num_symbols = 0;
+        num_dies_parsed = 0;
+        num_types_completed = 0;
+        num_methods_deferred = 0;
+        num_methods_completed = 0;
+        debug_info_byte_size = 0;
+        num_disassembly_cache_hits = 0;
+        num_disassembly_cache_misses = 0;
+    }
+
+    uint64_t symtab_parse_nsec;     // Time spent parsing the object file symbol table
+    uint64_t symfile_index_nsec;    // Time spent building the symbol file name indexes
+    uint64_t num_symbols;           // Number of symbols in the parsed symbol table
+    uint64_t num_dies_parsed;       // Number of debug information entries extracted
+    uint64_t num_types_completed;   // Number of forward declared types that were completed
+    uint64_t num_methods_deferred;  // Number of C++ methods left out when their class was completed
+    uint64_t num_methods_completed; // Number of deferred C++ methods that were added later on
+    uint64_t debug_info_byte_size;  // Bytes currently used by parsed debug information entries
+    uint64_t num_disassembly_cache_hits;    // Number of disassemblies copied from the module's disassembly cache
+    uint64_t num_disassembly_cache_misses;  // Number of disassemblies that had to be decoded
+};
+
+//----------------------------------------------------------------------
+// Counters kept by each Process. Process plug-ins fill in the packet
+// counters from Process::GetStatistics().
+//----------------------------------------------------------------------
+struct ProcessStatistics
+{
+    ProcessStatistics ()
+    {
+        Clear();
+    }
+
+    void
+    Clear ()
+    {
+        memory_read_count = 0;
+        memory_bytes_read = 0;
+        memory_write_count = 0;
+        memory_bytes_written = 0;
+        packets_sent = 0;
+        packets_received = 0;
+        packet_bytes_sent = 0;
+        packet_bytes_received = 0;
+        packet_bytes_saved = 0;
+    }
+
+    uint64_t memory_read_count;     // Number of reads from the inferior
+    uint64_t memory_bytes_read;     // Bytes read from the inferior
+    uint64_t memory_write_count;    // Number of writes to the inferior
+    uint64_t memory_bytes_written;  // Bytes written to the inferior
+    uint64_t packets_sent;          // Packets sent by remote process plug-ins
+    uint64_t packets_received;      // Packets received by remote process plug-ins
+    uint64_t packet_bytes_sent;
+    uint64_t packet_bytes_received;
+    uint64_t packet_bytes_saved;    // Bytes compressed packets didn't have to send
+};
+
+//----------------------------------------------------------------------
+// Counters kept by each Target.
+//----------------------------------------------------------------------
+struct TargetStatistics
+{
+    TargetStatistics ()
+    {
+        Clear();
+    }
+
+    void
+    Clear ()
+    {
+        expression_count = 0;
+        expression_failure_count = 0;
+        expression_nsec = 0;
+    }
+
+    uint64_t expression_count;          // Number of expressions evaluated
+    uint64_t expression_failure_count;  // Number of expressions that did not complete
+    uint64_t expression_nsec;           // Total time spent evaluating expressions
+};
+
+//----------------------------------------------------------------------
+// Counters kept for each Python summary function and synthetic children
+// provider class, see FormatManager::GetScriptedFormatterStatistics().
+//----------------------------------------------------------------------
+struct FormatterStatistics
+{
+    FormatterStatistics ()
+    {
+        Clear();
+    }
+
+    void
+    Clear ()
+    {
+        python_calls = 0;
+        python_nsec = 0;
+    }
+
+    uint64_t python_calls;          // Number of calls into the Python interpreter
+    uint64_t python_nsec;           // Total time spent in those calls
+};
+
+} // namespace lldb_private
+
+#endif  // #if defined(__cplusplus)
+#endif  // liblldb_Statistics_h_
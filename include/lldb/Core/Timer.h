@@ -22,17 +22,26 @@ namespace lldb_private {
 /// @class Timer Timer.h "lldb/Core/Timer.h"
 /// @brief A timer class that simplifies common timing metrics.
 ///
-/// A scoped timer class that allows a variety of pthread mutex
-/// objects to have a mutex locked when a Timer::Locker
-/// object is created, and unlocked when it goes out of scope or
-/// when the Timer::Locker::Reset(pthread_mutex_t *)
-/// is called. This provides an exception safe way to lock a mutex
-/// in a scope.
+/// A scoped timer class that accumulates the time spent in each
+/// category (usually the name of the function that created the timer).
+/// Timers only record anything when the display depth has been set
+/// with Timer::SetDisplayDepth() (see "log timers enable").
+///
+/// Category times are accumulated into per-thread counters so that
+/// a timer destruction never takes a lock. Categories are registered
+/// in a lock free table the first time they are seen, and the per-thread
+/// counters are only merged when the times are dumped or reset.
 //----------------------------------------------------------------------
 
 class Timer
 {
 public:
+    //--------------------------------------------------------------
+    /// Opaque per-thread timer state (timer stack, depth and
+    /// category times) that is defined in Timer.cpp.
+    //--------------------------------------------------------------
+    class ThreadData;
+
     static void
     Initialize ();
 
@@ -79,11 +88,11 @@ protected:
     /// Member variables
     //--------------------------------------------------------------
     const char *m_category;
+    ThreadData *m_thread_data; // Non-NULL if this timer incremented the depth of its thread
     TimeValue m_total_start;
     TimeValue m_timer_start;
     uint64_t m_total_ticks; // Total running time for this timer including when other timers below this are running
     uint64_t m_timer_ticks; // Ticks for this timer that do not include when other timers below this one are running
-    static uint32_t g_depth;
     static uint32_t g_display_depth;
     static FILE * g_file;
 private:
@@ -12,6 +12,7 @@
 
 // C Includes
 // C++ Includes
+#include <algorithm>
 #include <map>
 #include <vector>
 // Other libraries and framework includes
@@ -228,6 +229,8 @@ public:
         bool m_flat_output;
         uint32_t m_omit_summary_depth;
         bool m_ignore_cap;
+        uint32_t m_children_start;  // The first child of the root value to display
+        uint32_t m_children_count;  // How many children of the root value to display, UINT32_MAX for the target's default
         lldb::Format m_format;
         lldb::TypeSummaryImplSP m_summary_sp;
         std::string m_root_valobj_name;
@@ -244,6 +247,8 @@ public:
             m_flat_output(false),
             m_omit_summary_depth(0),
             m_ignore_cap(false), 
+            m_children_start(0),
+            m_children_count(UINT32_MAX),
             m_format (lldb::eFormatDefault),
             m_summary_sp(),
             m_root_valobj_name()
@@ -269,6 +274,8 @@ public:
             m_flat_output(rhs.m_flat_output),
             m_omit_summary_depth(rhs.m_omit_summary_depth),
             m_ignore_cap(rhs.m_ignore_cap),
+            m_children_start(rhs.m_children_start),
+            m_children_count(rhs.m_children_count),
             m_format(rhs.m_format),
             m_summary_sp(rhs.m_summary_sp),
             m_root_valobj_name(rhs.m_root_valobj_name)
@@ -361,6 +368,16 @@ public:
             return *this;
         }
 
+        // Only display a window of the children of the root value, so
+        // a large container can be paged through
+        DumpValueObjectOptions&
+        SetChildrenRange(uint32_t start = 0, uint32_t count = UINT32_MAX)
+        {
+            m_children_start = start;
+            m_children_count = count;
+            return *this;
+        }
+
         DumpValueObjectOptions&
         SetRawDisplay(bool raw = false)
         {
@@ -560,6 +577,37 @@ public:
     
     virtual ~ValueObject();
     
+    //------------------------------------------------------------------
+    // Children can be allocated out of the arena of the cluster of value
+    // objects they will belong to with "new (parent) ValueObjectXXX (parent, ...)",
+    // so a large tree of children is released in one go along with its
+    // root. Everything else uses the regular heap.
+    //------------------------------------------------------------------
+    static void *
+    operator new (size_t size)
+    {
+        return ::operator new (size);
+    }
+    
+    static void *
+    operator new (size_t size, ValueObject &parent)
+    {
+        return parent.GetManager()->Allocate (size);
+    }
+    
+    static void
+    operator delete (void *ptr)
+    {
+        ::operator delete (ptr);
+    }
+    
+    static void
+    operator delete (void *ptr, ValueObject &parent)
+    {
+        // Only called if a constructor throws, the memory stays in the
+        // arena until the cluster is destroyed
+    }
+    
     clang::ASTContext *
     GetClangAST ();
     
@@ -730,6 +778,19 @@ public:
     uint32_t
     GetNumChildren ();
 
+    //------------------------------------------------------------------
+    /// Get the number of children, but stop counting at \a max. Values
+    /// whose children come from a synthetic children provider may be
+    /// able to answer this without counting every child, which matters
+    /// for containers with millions of elements.
+    ///
+    /// @return
+    ///     The number of children, or \a max if there are at least
+    ///     \a max children.
+    //------------------------------------------------------------------
+    uint32_t
+    GetNumChildren (uint32_t max);
+
     const Value &
     GetValue() const;
 
@@ -774,6 +835,35 @@ public:
     bool
     GetValueDidChange ();
 
+    //------------------------------------------------------------------
+    /// Returns true if the bytes of this value were different from the
+    /// bytes it had before its last update. Unlike GetValueDidChange()
+    /// this also works for aggregates, which have no value string.
+    //------------------------------------------------------------------
+    bool
+    GetDataDidChange ();
+
+    //------------------------------------------------------------------
+    /// Update this value and the children that have already been
+    /// created, and append the children whose bytes or value changed
+    /// in the last update to \a changed_children. Children that were
+    /// never created are neither created nor reported.
+    ///
+    /// @return
+    ///     The number of children that were appended.
+    //------------------------------------------------------------------
+    size_t
+    GetChangedChildren (ValueObjectList &changed_children);
+
+    //------------------------------------------------------------------
+    /// Read the memory that the pointer children in [\a idx_start,
+    /// \a idx_end) point to into the process memory cache with a single
+    /// batch of reads, so that displaying the children doesn't need a
+    /// round trip to the inferior for each pointee.
+    //------------------------------------------------------------------
+    void
+    PrefetchChildPointees (uint32_t idx_start, uint32_t idx_end);
+
     bool
     UpdateValueIfNeeded (bool update_format = true);
     
@@ -799,6 +889,49 @@ public:
     lldb::addr_t
     GetPointerValue (AddressType *address_type = NULL);
     
+    //------------------------------------------------------------------
+    /// Get the data for a child that lives \a byte_offset bytes into
+    /// this value, such as an array element or a structure member, as a
+    /// slice of the data this value already read.
+    ///
+    /// @return
+    ///     True if \a data was filled in, false if this value's data
+    ///     doesn't cover the child and it should be read on its own.
+    //------------------------------------------------------------------
+    bool
+    GetDataForMemberChild (int32_t byte_offset,
+                           uint32_t byte_size,
+                           DataExtractor &data);
+    
+    //------------------------------------------------------------------
+    /// Read the memory for the synthetic array members [\a idx_start,
+    /// \a idx_end) of this pointer with a single read, so that the
+    /// members fetched next are slices of it. The data is kept only
+    /// until ClearPointeeData() or the next update, callers should clear
+    /// it as soon as they have fetched the members.
+    ///
+    /// @return
+    ///     True if at least some of the members' memory was read.
+    //------------------------------------------------------------------
+    bool
+    ReadPointeeData (uint32_t idx_start, uint32_t idx_end);
+    
+    void
+    ClearPointeeData ();
+    
+    //------------------------------------------------------------------
+    /// Get the data for a child of this pointer that lives at load
+    /// address \a addr as a slice of the memory ReadPointeeData() read.
+    ///
+    /// @return
+    ///     True if \a data was filled in, false if no read covers the
+    ///     child and it should read its memory on its own.
+    //------------------------------------------------------------------
+    bool
+    GetDataForPointeeChild (lldb::addr_t addr,
+                            uint32_t byte_size,
+                            DataExtractor &data);
+    
     lldb::ValueObjectSP
     GetSyntheticChild (const ConstString &key) const;
     
@@ -1041,12 +1174,16 @@ public:
 protected:
     typedef ClusterManager<ValueObject> ValueObjectManager;
     
+    // Children are kept in a flat vector indexed by child index. Entries
+    // that were asked for but couldn't be created are remembered too, so
+    // we don't keep trying to create them.
     class ChildrenManager
     {
     public:
         ChildrenManager() :
         m_mutex(Mutex::eMutexTypeRecursive),
         m_children(),
+        m_children_created(),
         m_children_count(0)
         {}
         
@@ -1054,29 +1191,35 @@ protected:
         HasChildAtIndex (uint32_t idx)
         {
             Mutex::Locker(m_mutex);
-            ChildrenIterator iter = m_children.find(idx);
-            ChildrenIterator end = m_children.end();
-            return (iter != end);
+            return idx < m_children_created.size() && m_children_created[idx];
         }
         
         ValueObject*
         GetChildAtIndex (uint32_t idx)
         {
             Mutex::Locker(m_mutex);
-            ChildrenIterator iter = m_children.find(idx);
-            ChildrenIterator end = m_children.end();
-            if (iter == end)
-                return NULL;
-            else
-                return iter->second;
+            if (idx < m_children.size())
+                return m_children[idx];
+            return NULL;
         }
         
         void
         SetChildAtIndex (uint32_t idx, ValueObject* valobj)
         {
-            ChildrenPair pair(idx,valobj); // we do not need to be mutex-protected to make a pair
             Mutex::Locker(m_mutex);
-            m_children.insert(pair);
+            if (idx >= m_children.size())
+            {
+                // Only grow as far as the children that were asked for,
+                // a huge (or bogus) children count shouldn't cost any
+                // memory until those children are created
+                m_children.resize (idx + 1, NULL);
+                m_children_created.resize (idx + 1, false);
+            }
+            if (!m_children_created[idx])
+            {
+                m_children[idx] = valobj;
+                m_children_created[idx] = true;
+            }
         }
         
         void
@@ -1097,14 +1240,13 @@ protected:
             m_children_count = 0;
             Mutex::Locker(m_mutex);
             m_children.clear();
+            m_children_created.clear();
         }
         
     private:
-        typedef std::map<uint32_t, ValueObject*> ChildrenMap;
-        typedef ChildrenMap::iterator ChildrenIterator;
-        typedef ChildrenMap::value_type ChildrenPair;
         Mutex m_mutex;
-        ChildrenMap m_children;
+        std::vector<ValueObject*> m_children;
+        std::vector<bool> m_children_created;
         uint32_t m_children_count;
     };
 
@@ -1152,9 +1294,12 @@ protected:
     lldb::SyntheticChildrenSP   m_synthetic_children_sp;
     ProcessModID                m_user_id_of_forced_summary;
     AddressType                 m_address_type_of_ptr_or_ref_children;
+    DataExtractor               m_pointee_data;         // Memory read by ReadPointeeData() for a range of synthetic array members
+    lldb::addr_t                m_pointee_data_addr;    // The load address of m_pointee_data
     
     bool                m_value_is_valid:1,
                         m_value_did_change:1,
+                        m_data_did_change:1,
                         m_children_count_valid:1,
                         m_old_value_valid:1,
                         m_is_deref_of_parent:1,
@@ -1213,6 +1358,15 @@ protected:
     virtual uint32_t
     CalculateNumChildren() = 0;
 
+    // Should only be called by ValueObject::GetNumChildren(uint32_t). May stop
+    // counting at max and return max, the result is only known to be exact
+    // if it isn't max.
+    virtual uint32_t
+    CalculateNumChildrenUpTo (uint32_t max)
+    {
+        return CalculateNumChildren();
+    }
+
     void
     SetNumChildren (uint32_t num_children);
 
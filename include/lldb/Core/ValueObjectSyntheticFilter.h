@@ -42,6 +42,9 @@ public:
     virtual uint32_t
     CalculateNumChildren();
 
+    virtual uint32_t
+    CalculateNumChildrenUpTo (uint32_t max);
+
     virtual lldb::ValueType
     GetValueType() const;
     
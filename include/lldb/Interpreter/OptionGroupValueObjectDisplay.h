@@ -58,7 +58,9 @@ public:
                ptr_depth != 0 ||
                use_synth == false ||
                be_raw == true ||
-               ignore_cap == true;
+               ignore_cap == true ||
+               child_start != 0 ||
+               child_count != UINT32_MAX;
     }
 
     bool show_types;
@@ -72,6 +74,8 @@ public:
     bool use_synth;
     bool be_raw;
     bool ignore_cap;
+    uint32_t child_start;
+    uint32_t child_count;
 };
 
 } // namespace lldb_private
@@ -10,6 +10,8 @@
 #ifndef liblldb_ScriptInterpreter_h_
 #define liblldb_ScriptInterpreter_h_
 
+#include <vector>
+
 #include "lldb/lldb-private.h"
 
 #include "lldb/Core/Broadcaster.h"
@@ -78,8 +80,10 @@ public:
                                                         const char *session_dictionary_name,
                                                         const lldb::ValueObjectSP& valobj_sp);
     
-    typedef uint32_t       (*SWIGPythonCalculateNumChildren)        (void *implementor);
+    typedef uint32_t       (*SWIGPythonCalculateNumChildren)        (void *implementor, uint32_t max);
     typedef void*          (*SWIGPythonGetChildAtIndex)             (void *implementor, uint32_t idx);
+    typedef int            (*SWIGPythonGetChildrenInRange)          (void *implementor, uint32_t start, uint32_t count,
+                                                                     std::vector<lldb::ValueObjectSP> &children);
     typedef int            (*SWIGPythonGetIndexOfChildWithName)     (void *implementor, const char* child_name);
     typedef void*          (*SWIGPythonCastPyObjectToSBValue)       (void* data);
     typedef bool           (*SWIGPythonUpdateSynthProviderInstance) (void* data);
@@ -211,8 +215,9 @@ public:
         return false;
     }
     
+    // Providers may stop counting at max, see SyntheticChildrenFrontEnd::CalculateNumChildrenUpTo()
     virtual uint32_t
-    CalculateNumChildren (const lldb::ScriptInterpreterObjectSP& implementor)
+    CalculateNumChildren (const lldb::ScriptInterpreterObjectSP& implementor, uint32_t max)
     {
         return 0;
     }
@@ -223,6 +228,18 @@ public:
         return lldb::ValueObjectSP();
     }
     
+    // Get up to count children starting at start with one call into the
+    // provider. Returns false if the provider can only produce one child
+    // at a time, in which case GetChildAtIndex() must be used.
+    virtual bool
+    GetChildrenInRange (const lldb::ScriptInterpreterObjectSP& implementor,
+                        uint32_t start,
+                        uint32_t count,
+                        std::vector<lldb::ValueObjectSP> &children)
+    {
+        return false;
+    }
+    
     virtual int
     GetIndexOfChildWithName (const lldb::ScriptInterpreterObjectSP& implementor, const char* child_name)
     {
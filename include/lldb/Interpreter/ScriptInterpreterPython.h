@@ -77,11 +77,17 @@ public:
                                      lldb::ValueObjectSP valobj);
     
     virtual uint32_t
-    CalculateNumChildren (const lldb::ScriptInterpreterObjectSP& implementor);
+    CalculateNumChildren (const lldb::ScriptInterpreterObjectSP& implementor, uint32_t max);
     
     virtual lldb::ValueObjectSP
     GetChildAtIndex (const lldb::ScriptInterpreterObjectSP& implementor, uint32_t idx);
     
+    virtual bool
+    GetChildrenInRange (const lldb::ScriptInterpreterObjectSP& implementor,
+                        uint32_t start,
+                        uint32_t count,
+                        std::vector<lldb::ValueObjectSP> &children);
+    
     virtual int
     GetIndexOfChildWithName (const lldb::ScriptInterpreterObjectSP& implementor, const char* child_name);
     
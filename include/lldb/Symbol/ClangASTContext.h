@@ -120,6 +120,14 @@ public:
     void
     RemoveExternalSource ();
 
+    //------------------------------------------------------------------
+    /// Get the number of bytes the clang::ASTContext allocated for
+    /// declarations, types and its side tables, or zero if no AST has
+    /// been created yet.
+    //------------------------------------------------------------------
+    size_t
+    GetAllocatedMemory () const;
+
     bool
     GetCompleteType (lldb::clang_type_t clang_type);
     
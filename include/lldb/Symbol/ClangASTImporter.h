@@ -11,12 +11,14 @@
 #define liblldb_ClangASTImporter_h_
 
 #include <map>
+#include <set>
 
 #include "lldb/lldb-types.h"
 
 #include "clang/AST/ASTImporter.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/FileSystemOptions.h"
+#include "lldb/Core/ConstString.h"
 #include "lldb/Symbol/ClangNamespaceDecl.h"
 
 namespace lldb_private {
@@ -25,7 +27,8 @@ class ClangASTImporter
 {
 public:
     ClangASTImporter () :
-        m_file_manager(clang::FileSystemOptions())
+        m_file_manager(clang::FileSystemOptions()),
+        m_num_reused_types(0)
     {
     }
     
@@ -83,6 +86,18 @@ public:
     uint64_t
     GetDeclMetadata (const clang::Decl *decl);
     
+    //------------------------------------------------------------------
+    /// Get the number of types CopyType() mapped to an identical type
+    /// that had already been imported from another AST, such as the
+    /// same class from another shared library. Each type is counted
+    /// once, no matter how often it is copied.
+    //------------------------------------------------------------------
+    uint64_t
+    GetNumReusedTypes () const
+    {
+        return m_num_reused_types;
+    }
+    
     //
     // Namespace maps
     //
@@ -171,6 +186,43 @@ private:
     
     typedef std::map<const clang::Decl *, DeclOrigin>   OriginMap;
     
+    //------------------------------------------------------------------
+    // Two complete struct, class, union or enum types are considered the
+    // same type if their names, sizes and members match, no matter which
+    // AST they come from.
+    //------------------------------------------------------------------
+    struct TypeIdentity
+    {
+        TypeIdentity () :
+            name(),
+            byte_size(0),
+            layout_hash(0)
+        {
+        }
+        
+        bool
+        operator< (const TypeIdentity &rhs) const
+        {
+            if (name != rhs.name)
+                return name.GetCString() < rhs.name.GetCString();
+            if (byte_size != rhs.byte_size)
+                return byte_size < rhs.byte_size;
+            return layout_hash < rhs.layout_hash;
+        }
+        
+        ConstString name;       // The fully qualified type name, including template arguments
+        uint64_t    byte_size;
+        uint64_t    layout_hash;// Hash of the bases, fields and enumerators
+    };
+    
+    typedef std::map<TypeIdentity, clang::TagDecl *>    TypeIdentityMap;
+    
+    static bool
+    GetTypeIdentity (clang::TagDecl *decl, TypeIdentity &identity);
+    
+    static clang::TagDecl *
+    GetUnderlyingTagDecl (clang::QualType type);
+    
     class Minion : public clang::ASTImporter
     {
     public:
@@ -206,7 +258,9 @@ private:
             m_minions (),
             m_origins (),
             m_namespace_maps (),
-            m_map_completer (NULL)
+            m_map_completer (NULL),
+            m_imported_types (),
+            m_reused_tag_decls ()
         {
         }
         
@@ -216,6 +270,8 @@ private:
         
         NamespaceMetaMap        m_namespace_maps;
         MapCompleter           *m_map_completer;
+        TypeIdentityMap         m_imported_types;   // Tag types imported by CopyType(), from any source
+        std::set<const clang::TagDecl *> m_reused_tag_decls;   // Source tag types already mapped onto one of m_imported_types
     };
     
     typedef STD_SHARED_PTR(ASTContextMetadata) ASTContextMetadataSP;    
@@ -275,6 +331,7 @@ private:
     GetDeclOrigin (const clang::Decl *decl);
         
     clang::FileManager      m_file_manager;
+    uint64_t                m_num_reused_types;
 };
     
 }
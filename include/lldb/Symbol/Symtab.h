@@ -11,6 +11,7 @@
 #ifndef liblldb_Symtab_h_
 #define liblldb_Symtab_h_
 
+#include <string>
 #include <vector>
 
 #include "lldb/lldb-private.h"
@@ -70,6 +71,7 @@ public:
             size_t      FindAllSymbolsWithNameAndType (const ConstString &name, lldb::SymbolType symbol_type, Debug symbol_debug_type, Visibility symbol_visibility, std::vector<uint32_t>& symbol_indexes);
             size_t      FindAllSymbolsMatchingRexExAndType (const RegularExpression &regex, lldb::SymbolType symbol_type, Debug symbol_debug_type, Visibility symbol_visibility, std::vector<uint32_t>& symbol_indexes);
             Symbol *    FindFirstSymbolWithNameAndType (const ConstString &name, lldb::SymbolType symbol_type, Debug symbol_debug_type, Visibility symbol_visibility);
+            size_t      FindAllCodeSymbolsWithBaseName (const ConstString &base_name, std::vector<uint32_t>& symbol_indexes);
             Symbol *    FindSymbolWithFileAddress (lldb::addr_t file_addr);
 //            Symbol *    FindSymbolContainingAddress (const Address& value, const uint32_t* indexes, uint32_t num_indexes);
 //            Symbol *    FindSymbolContainingAddress (const Address& value);
@@ -97,21 +99,33 @@ public:
                                                 bool add_mangled,
                                                 NameToIndexMap &name_to_index_map) const;
 
+    //------------------------------------------------------------------
+    /// Get the function name without namespaces, classes and parameters
+    /// from a demangled C++ name, "bar" for "ns::Foo::bar(int) const".
+    ///
+    /// @return
+    ///     \b true if \a base_name was filled in.
+    //------------------------------------------------------------------
+    static  bool        GetFunctionBaseName (const char *name, std::string &base_name);
+
 protected:
     typedef std::vector<Symbol>         collection;
     typedef collection::iterator        iterator;
     typedef collection::const_iterator  const_iterator;
 
             void        InitNameIndexes ();
+            void        InitBaseNameIndexes ();
             void        InitAddressIndexes ();
 
     ObjectFile *        m_objfile;
     collection          m_symbols;
     std::vector<uint32_t> m_addr_indexes;
     UniqueCStringMap<uint32_t> m_name_to_index;
+    UniqueCStringMap<uint32_t> m_basename_to_index; // Base names of the demangled names of code symbols
     mutable Mutex       m_mutex; // Provide thread safety for this symbol table
     bool                m_addr_indexes_computed:1,
-                        m_name_indexes_computed:1;
+                        m_name_indexes_computed:1,
+                        m_basename_indexes_computed:1;
 private:
 
     bool
@@ -48,6 +48,20 @@ namespace lldb_private {
               void *dst, 
               size_t dst_len,
               Error &error);
+
+        // Read [addr, addr + size) from the process with a single read and
+        // add it as cache lines, returns the number of bytes that were read
+        size_t
+        Prefetch (lldb::addr_t addr, 
+                  size_t size,
+                  Error &error);
+
+        // Add the cache lines that hold all of "ranges" with a single call
+        // to Process::ReadMemoryRangesFromInferior(), returns the number of
+        // bytes that were read
+        size_t
+        PrefetchRanges (const std::vector<Range<lldb::addr_t, lldb::addr_t> > &ranges,
+                        Error &error);
         
         uint32_t
         GetMemoryCacheLineSize() const
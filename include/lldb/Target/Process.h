@@ -28,6 +28,7 @@
 #include "lldb/Core/Error.h"
 #include "lldb/Core/Event.h"
 #include "lldb/Core/RangeMap.h"
+#include "lldb/Core/Statistics.h"
 #include "lldb/Core/StringList.h"
 #include "lldb/Core/ThreadSafeValue.h"
 #include "lldb/Core/PluginInterface.h"
@@ -1355,6 +1356,7 @@ public:
     };
     
     typedef Range<lldb::addr_t, lldb::addr_t> LoadRange;
+    typedef std::vector<LoadRange> LoadRangeList;
     // We use a read/write lock to allow on or more clients to
     // access the process state while the process is stopped (reader).
     // We lock the write lock to control access to the process
@@ -2457,6 +2459,24 @@ public:
     {
         return m_mod_id.GetLastUserExpressionResumeID();
     }
+
+    //------------------------------------------------------------------
+    /// Get the always-on performance counters for this process.
+    ///
+    /// Process plug-ins that talk to a remote stub should override this
+    /// to fill in the packet counters after calling the base class.
+    ///
+    /// @param[out] stats
+    ///     The statistics object to fill in.
+    //------------------------------------------------------------------
+    virtual void
+    GetStatistics (ProcessStatistics &stats);
+
+    //------------------------------------------------------------------
+    /// Dump the performance counters for this process as a JSON object.
+    //------------------------------------------------------------------
+    void
+    DumpStatistics (Stream &s);
     
     //------------------------------------------------------------------
     /// Set accessor for the process exit status (return code).
@@ -2550,6 +2570,73 @@ public:
                 size_t size,
                 Error &error);
 
+    //------------------------------------------------------------------
+    /// Read a range of memory into the memory cache with a single read
+    /// from the inferior, so that later ReadMemory() calls within the
+    /// range don't each need their own. Does nothing when the memory
+    /// cache is disabled.
+    ///
+    /// @return
+    ///     The number of bytes that were read from the inferior.
+    //------------------------------------------------------------------
+    size_t
+    PrefetchMemory (lldb::addr_t vm_addr, size_t size);
+
+    //------------------------------------------------------------------
+    /// Actually do the reading of several independent ranges of memory
+    /// from a process.
+    ///
+    /// The default implementation reads one range at a time with
+    /// DoReadMemory(). Subclasses that can read many ranges with a
+    /// single request to the inferior should override this.
+    ///
+    /// @param[in] ranges
+    ///     The ranges of memory to read.
+    ///
+    /// @param[out] buf
+    ///     A byte buffer that receives the bytes of each range, one
+    ///     after the other. It must be as long as all ranges together.
+    ///
+    /// @param[out] bytes_read
+    ///     Has one entry per range which receives the number of bytes
+    ///     that were read for that range.
+    ///
+    /// @return
+    ///     The total number of bytes that were read.
+    //------------------------------------------------------------------
+    virtual size_t
+    DoReadMemoryRanges (const LoadRangeList &ranges,
+                        uint8_t *buf,
+                        std::vector<size_t> &bytes_read,
+                        Error &error);
+
+    //------------------------------------------------------------------
+    /// Read several independent ranges of memory from a process.
+    ///
+    /// Reading many small ranges, like the targets of a list of
+    /// pointers, with one call to this function needs far fewer round
+    /// trips to the inferior than a ReadMemory() call per range. Ranges
+    /// may be read partially or not at all.
+    ///
+    /// @see Process::DoReadMemoryRanges()
+    //------------------------------------------------------------------
+    size_t
+    ReadMemoryRanges (const LoadRangeList &ranges,
+                      void *buf,
+                      std::vector<size_t> &bytes_read,
+                      Error &error);
+
+    //------------------------------------------------------------------
+    /// Read the cache lines that hold all of \a ranges into the memory
+    /// cache with as few reads from the inferior as possible. Does
+    /// nothing when the memory cache is disabled.
+    ///
+    /// @return
+    ///     The number of bytes that were read from the inferior.
+    //------------------------------------------------------------------
+    size_t
+    PrefetchMemoryRanges (const LoadRangeList &ranges);
+
     //------------------------------------------------------------------
     /// Read a NULL terminated C string from memory
     ///
@@ -2575,6 +2662,12 @@ public:
                             void *buf, 
                             size_t size,
                             Error &error);
+
+    size_t
+    ReadMemoryRangesFromInferior (const LoadRangeList &ranges,
+                                  void *buf,
+                                  std::vector<size_t> &bytes_read,
+                                  Error &error);
     
     //------------------------------------------------------------------
     /// Reads an unsigned integer of the specified byte size from 
@@ -3025,6 +3118,93 @@ public:
                                    lldb::user_id_t owner_loc_id,
                                    lldb::BreakpointSiteSP &bp_site_sp);
 
+    //------------------------------------------------------------------
+    /// Enable many breakpoint sites with one call into the process
+    /// plug-in.
+    ///
+    /// The default implementation calls EnableBreakpoint() for each
+    /// site. Process plug-ins that can insert many breakpoints at once
+    /// (with one packet, or by reading and writing each page of memory
+    /// only once, see EnableSoftwareBreakpoints()) should override it.
+    ///
+    /// @param[in] bp_sites
+    ///     The breakpoint sites to enable.
+    ///
+    /// @param[out] errors
+    ///     Resized to the number of sites in \a bp_sites, and filled
+    ///     in with the result of enabling each of them.
+    ///
+    /// @return
+    ///     The number of breakpoint sites that were enabled.
+    //------------------------------------------------------------------
+    virtual size_t
+    EnableBreakpointSites (const BreakpointSiteList::collection &bp_sites,
+                           std::vector<Error> &errors);
+
+    //------------------------------------------------------------------
+    /// Disable many breakpoint sites with one call into the process
+    /// plug-in.
+    ///
+    /// @see Process::EnableBreakpointSites()
+    //------------------------------------------------------------------
+    virtual size_t
+    DisableBreakpointSites (const BreakpointSiteList::collection &bp_sites,
+                            std::vector<Error> &errors);
+
+    // These are the batched versions of EnableSoftwareBreakpoint() and
+    // DisableSoftwareBreakpoint(). The sites are grouped by memory page,
+    // and each page is read, written and verified with one call each.
+    // Process plug-ins can use them from EnableBreakpointSites() and
+    // DisableBreakpointSites().
+    size_t
+    EnableSoftwareBreakpoints (const BreakpointSiteList::collection &bp_sites,
+                               std::vector<Error> &errors);
+
+    size_t
+    DisableSoftwareBreakpoints (const BreakpointSiteList::collection &bp_sites,
+                                std::vector<Error> &errors);
+
+    //------------------------------------------------------------------
+    /// Defer enabling and disabling breakpoint sites until the matching
+    /// call to EndBreakpointSiteBatch().
+    ///
+    /// While a batch is open, CreateBreakpointSite() adds new sites to
+    /// the breakpoint site list without enabling them, and
+    /// RemoveOwnerFromBreakpointSite() doesn't disable sites that lose
+    /// their last owner. Ending the outermost batch enables and
+    /// disables all of these sites with one call each to
+    /// EnableBreakpointSites() and DisableBreakpointSites(). Locations
+    /// whose site couldn't be enabled lose their site, just as if
+    /// CreateBreakpointSite() had failed. Batches can be nested.
+    //------------------------------------------------------------------
+    void
+    BeginBreakpointSiteBatch ();
+
+    void
+    EndBreakpointSiteBatch ();
+
+    class
+    BreakpointSiteBatch
+    {
+    public:
+        // A NULL process makes this a no-op, so callers that may not
+        // have a process don't need to special case it.
+        BreakpointSiteBatch (Process *process) :
+            m_process (process)
+        {
+            if (m_process)
+                m_process->BeginBreakpointSiteBatch();
+        }
+        ~BreakpointSiteBatch ()
+        {
+            if (m_process)
+                m_process->EndBreakpointSiteBatch();
+        }
+
+    private:
+        Process *m_process;
+    };
+
     //----------------------------------------------------------------------
     // Process Watchpoints (optional)
     //----------------------------------------------------------------------
@@ -3389,6 +3569,9 @@ protected:
     std::vector<lldb::addr_t>   m_image_tokens;
     Listener                    &m_listener;
     BreakpointSiteList          m_breakpoint_site_list; ///< This is the list of breakpoint locations we intend to insert in the target.
+    uint32_t                    m_breakpoint_site_batch_depth;      ///< The number of open breakpoint site batches, see BeginBreakpointSiteBatch()
+    BreakpointSiteList::collection m_batched_sites_to_enable;       ///< Sites created while a batch was open
+    BreakpointSiteList::collection m_batched_sites_to_remove;       ///< Sites that lost their last owner while a batch was open
     std::auto_ptr<DynamicLoader> m_dyld_ap;
     std::auto_ptr<DynamicCheckerFunctions> m_dynamic_checkers_ap; ///< The functions used by the expression parser to validate data that expressions use.
     std::auto_ptr<OperatingSystem> m_os_ap;
@@ -3400,6 +3583,7 @@ protected:
     std::string                 m_stdout_data;
     std::string                 m_stderr_data;
     MemoryCache                 m_memory_cache;
+    ProcessStatistics           m_stats;                ///< Always-on memory read and write counters.
     AllocatedMemoryCache        m_allocated_memory_cache;
     bool                        m_should_detach;   /// Should we detach if the process object goes away with an explicit call to Kill or Detach?
     LanguageRuntimeCollection 	m_language_runtimes;
@@ -146,6 +146,13 @@ public:
     lldb::ValueObjectSP
     TrackGlobalVariable (const lldb::VariableSP &variable_sp, lldb::DynamicValueType use_dynamic);
     
+    // Read the stack memory between the stack pointer and the CFA into the
+    // process memory cache with a single read, so that updating all the
+    // local variables of this frame after a stop doesn't read them one
+    // cache line at a time. Only does any work once per stop.
+    void
+    PrefetchFrameMemory ();
+    
     //------------------------------------------------------------------
     // lldb::ExecutionContextScope pure virtual functions
     //------------------------------------------------------------------
@@ -202,6 +209,7 @@ private:
     Error m_frame_base_error;
     lldb::VariableListSP m_variable_list_sp;
     ValueObjectList m_variable_list_value_objects;  // Value objects for each variable in m_variable_list_sp
+    uint32_t m_prefetch_stop_id;                    // The stop ID PrefetchFrameMemory() last ran at
     StreamString m_disassembly;
     DISALLOW_COPY_AND_ASSIGN (StackFrame);
 };
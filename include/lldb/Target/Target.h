@@ -22,6 +22,7 @@
 #include "lldb/Core/Broadcaster.h"
 #include "lldb/Core/Event.h"
 #include "lldb/Core/ModuleList.h"
+#include "lldb/Core/Statistics.h"
 #include "lldb/Core/UserSettingsController.h"
 #include "lldb/Core/SourceManager.h"
 #include "lldb/Expression/ClangPersistentVariables.h"
@@ -128,6 +129,12 @@ public:
     {
         return m_breakpoints_use_platform_avoid;
     }
+
+    bool
+    GetBreakpointsPrefilterWithSymbols ()
+    {
+        return m_breakpoints_prefilter_with_symbols;
+    }
         
     const Args &
     GetRunArguments () const
@@ -254,6 +261,7 @@ protected:
     uint32_t m_max_children_display;
     uint32_t m_max_strlen_length;
     OptionValueBoolean m_breakpoints_use_platform_avoid;
+    OptionValueBoolean m_breakpoints_prefilter_with_symbols;
     typedef std::map<std::string, std::string> dictionary;
     Args m_run_args;
     dictionary m_env_vars;
@@ -906,6 +914,25 @@ public:
         return m_persistent_variables;
     }
 
+    //------------------------------------------------------------------
+    /// Get the always-on performance counters for this target.
+    //------------------------------------------------------------------
+    TargetStatistics &
+    GetStatistics ()
+    {
+        return m_stats;
+    }
+
+    //------------------------------------------------------------------
+    /// Dump the performance counters for this target, its process and
+    /// all of its modules as a JSON object.
+    ///
+    /// @param[in] s
+    ///     The stream to which to dump the JSON text.
+    //------------------------------------------------------------------
+    void
+    DumpStatistics (Stream &s);
+
     //------------------------------------------------------------------
     // Target Stop Hooks
     //------------------------------------------------------------------
@@ -1178,6 +1205,7 @@ protected:
     lldb::user_id_t         m_stop_hook_next_id;
     bool                    m_suppress_stop_hooks;
     bool                    m_suppress_synthetic_value;
+    TargetStatistics        m_stats;
     
     static void
     ImageSearchPathsChanged (const PathMappingList &path_list,
@@ -10,6 +10,10 @@
 #ifndef utility_SharedCluster_h_
 #define utility_SharedCluster_h_
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "lldb/Utility/SharingPtr.h"
 #include "lldb/Host/Mutex.h"
 
@@ -45,6 +49,10 @@ class ClusterManager
 public:
     ClusterManager () : 
         m_objects(),
+        m_object_in_arena(),
+        m_arena_blocks(),
+        m_arena_ptr(NULL),
+        m_arena_end(NULL),
         m_external_ref(0),
         m_mutex(Mutex::eMutexTypeNormal) {}
     
@@ -53,8 +61,15 @@ public:
         size_t n_items = m_objects.size();
         for (size_t i = 0; i < n_items; i++)
         {
-            delete m_objects[i];
+            // Objects that live in the arena are only destroyed here, their
+            // memory is released along with the arena blocks below
+            if (m_object_in_arena[i])
+                m_objects[i]->~T();
+            else
+                delete m_objects[i];
         }
+        for (size_t i = 0; i < m_arena_blocks.size(); i++)
+            ::operator delete (m_arena_blocks[i].first);
         // Decrement refcount should have been called on this ClusterManager,
         // and it should have locked the mutex, now we will unlock it before
         // we destroy it...
@@ -64,8 +79,32 @@ public:
     void ManageObject (T *new_object)
     {
         Mutex::Locker locker (m_mutex);
-        if (!ContainsObject(new_object))
-            m_objects.push_back (new_object);
+        // Objects only get managed once, from their constructor, so there
+        // is no need to search m_objects for them
+        m_objects.push_back (new_object);
+        m_object_in_arena.push_back (IsInArena (new_object));
+    }
+    
+    //------------------------------------------------------------------
+    // Allocate memory for an object that will be managed by this cluster.
+    // The memory comes out of large blocks that are released all at once
+    // when the cluster goes away, instead of one object at a time.
+    //------------------------------------------------------------------
+    void *Allocate (size_t size)
+    {
+        Mutex::Locker locker (m_mutex);
+        size = (size + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+        if (size > (size_t)(m_arena_end - m_arena_ptr))
+        {
+            const size_t block_size = std::max<size_t> (size, kArenaBlockSize);
+            char *block = (char *)::operator new (block_size);
+            m_arena_blocks.push_back (std::make_pair (block, block_size));
+            m_arena_ptr = block;
+            m_arena_end = block + block_size;
+        }
+        void *result = m_arena_ptr;
+        m_arena_ptr += size;
+        return result;
     }
     
     typename lldb_private::SharingPtr<T> GetSharedPointer(T *desired_object)
@@ -79,6 +118,11 @@ public:
     }
     
 private:
+    enum
+    {
+        kArenaBlockSize = 64 * 1024,
+        kArenaAlignment = 16
+    };
     
     bool ContainsObject (const T *desired_object)
     {
@@ -87,6 +131,20 @@ private:
         return pos != end;
     }
     
+    bool IsInArena (const T *object)
+    {
+        // Objects are managed right after they are allocated, so start
+        // looking in the newest block
+        const char *ptr = (const char *)object;
+        for (size_t i = m_arena_blocks.size(); i > 0; --i)
+        {
+            const char *block = m_arena_blocks[i - 1].first;
+            if (ptr >= block && ptr < block + m_arena_blocks[i - 1].second)
+                return true;
+        }
+        return false;
+    }
+    
     void DecrementRefCount () 
     {
         m_mutex.Lock();
@@ -100,6 +158,10 @@ private:
     friend class imp::shared_ptr_refcount<ClusterManager>;
     
     std::vector<T *> m_objects;
+    std::vector<bool> m_object_in_arena;
+    std::vector<std::pair<char *, size_t> > m_arena_blocks;
+    char *m_arena_ptr;
+    char *m_arena_end;
     int m_external_ref;
     Mutex m_mutex;
 };
@@ -93,6 +93,7 @@ class   DataExtractor;
 class   Debugger;
 class   Declaration;
 class   Disassembler;
+class   DisassemblyCache;
 class   DynamicLoader;
 class   EmulateInstruction;
 class   Error;
@@ -304,6 +305,7 @@ namespace lldb {
     typedef STD_SHARED_PTR(lldb_private::StopInfo) StopInfoSP;
     typedef STD_SHARED_PTR(lldb_private::StoppointLocation) StoppointLocationSP;
     typedef STD_SHARED_PTR(lldb_private::Stream) StreamSP;
+    typedef STD_WEAK_PTR(lldb_private::Stream) StreamWP;
     typedef STD_SHARED_PTR(lldb_private::StringSummaryFormat) StringTypeSummaryImplSP;
     typedef STD_SHARED_PTR(lldb_private::TypeSummaryImpl) TypeSummaryImplSP;
     typedef STD_SHARED_PTR(lldb_private::TypeNameSpecifierImpl) TypeNameSpecifierImplSP;
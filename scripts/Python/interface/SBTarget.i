@@ -683,6 +683,15 @@ public:
     
     bool
     GetDescription (lldb::SBStream &description, lldb::DescriptionLevel description_level);
+
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Write performance statistics for this target, its process and
+    /// its modules to \a stream as a JSON object.
+    //------------------------------------------------------------------
+    ") GetStatistics;
+    bool
+    GetStatistics (lldb::SBStream &stream);
     
     %pythoncode %{
         class modules_access(object):
@@ -115,6 +115,15 @@ public:
     bool
     GetValueDidChange ();
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Get the children that were already fetched and whose bytes or
+    /// value changed when they were last updated, as an SBValueList.
+    //------------------------------------------------------------------
+    ") GetChangedChildren;
+    lldb::SBValueList
+    GetChangedChildren ();
+
     const char *
     GetSummary ();
     
@@ -231,6 +240,18 @@ public:
 	                     lldb::SBData data,
 	                     lldb::SBType type);
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Create a value named '[idx]' for each item of type in data, which
+    /// lets synthetic children providers turn the memory for many children
+    /// (e.g. from GetPointeeData()) into values in a single call.
+    //------------------------------------------------------------------
+    ") CreateValuesFromData;
+    lldb::SBValueList
+    CreateValuesFromData (lldb::SBData data,
+                          lldb::SBType type,
+                          uint32_t start_idx = 0);
+
     lldb::SBType
     GetType();
     
@@ -284,6 +305,27 @@ public:
     uint32_t
     GetNumChildren ();
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Get the number of children, but stop counting at max. Returns max
+    /// if there are at least max children. Synthetic children providers
+    /// whose num_children() method takes a max argument can stop counting
+    /// there, which keeps this fast for huge containers.
+    //------------------------------------------------------------------
+    ") GetNumChildren;
+    uint32_t
+    GetNumChildren (uint32_t max);
+
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Get up to count children starting at index start_idx as an
+    /// SBValueList. The list is shorter than count if the end of the
+    /// children was reached.
+    //------------------------------------------------------------------
+    ") GetChildrenInRange;
+    lldb::SBValueList
+    GetChildrenInRange (uint32_t start_idx, uint32_t count);
+
     void *
     GetOpaqueType();
 
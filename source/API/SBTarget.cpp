@@ -1944,6 +1944,18 @@ SBTarget::GetDescription (SBStream &description, lldb::DescriptionLevel descript
     return true;
 }
 
+bool
+SBTarget::GetStatistics (SBStream &stream)
+{
+    TargetSP target_sp(GetSP());
+    if (target_sp)
+    {
+        target_sp->DumpStatistics (stream.ref());
+        return true;
+    }
+    return false;
+}
+
 lldb::SBSymbolContextList
 SBTarget::FindFunctions (const char *name, uint32_t name_type_mask)
 {
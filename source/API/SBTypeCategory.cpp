@@ -228,7 +228,7 @@ SBTypeCategory::GetSyntheticForType (SBTypeNameSpecifier spec)
     else
         m_opaque_sp->GetSyntheticNavigator()->GetExact(ConstString(spec.GetName()), children_sp);
     
-    if (!children_sp)
+    if (!children_sp || !children_sp->IsScripted())
         return lldb::SBTypeSynthetic();
     
     TypeSyntheticImplSP synth_sp = STD_STATIC_POINTER_CAST(TypeSyntheticImpl,children_sp);
@@ -280,7 +280,7 @@ SBTypeCategory::GetSyntheticAtIndex (uint32_t index)
         return SBTypeSynthetic();
     lldb::SyntheticChildrenSP children_sp = m_opaque_sp->GetSyntheticAtIndex((index));
     
-    if (!children_sp.get())
+    if (!children_sp.get() || !children_sp->IsScripted())
         return lldb::SBTypeSynthetic();
     
     TypeSyntheticImplSP synth_sp = STD_STATIC_POINTER_CAST(TypeSyntheticImpl,children_sp);
@@ -14,6 +14,7 @@
 #include "lldb/API/SBTypeFormat.h"
 #include "lldb/API/SBTypeSummary.h"
 #include "lldb/API/SBTypeSynthetic.h"
+#include "lldb/API/SBValueList.h"
 
 #include "lldb/Breakpoint/Watchpoint.h"
 #include "lldb/Core/DataExtractor.h"
@@ -23,6 +24,7 @@
 #include "lldb/Core/Scalar.h"
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Core/StreamString.h"
 #include "lldb/Core/Value.h"
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Core/ValueObjectConstResult.h"
@@ -358,6 +360,41 @@ SBValue::GetValueDidChange ()
     return result;
 }
 
+lldb::SBValueList
+SBValue::GetChangedChildren ()
+{
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+    lldb::SBValueList sb_values;
+    lldb::ValueObjectSP value_sp(GetSP());
+    if (value_sp)
+    {
+        ProcessSP process_sp(value_sp->GetProcessSP());
+        Process::StopLocker stop_locker;
+        if (process_sp && !stop_locker.TryLock(&process_sp->GetRunLock()))
+        {
+            if (log)
+                log->Printf ("SBValue(%p)::GetChangedChildren() => error: process is running", value_sp.get());
+        }
+        else
+        {
+            TargetSP target_sp(value_sp->GetTargetSP());
+            if (target_sp)
+            {
+                Mutex::Locker api_locker (target_sp->GetAPIMutex());
+                ValueObjectList changed_children;
+                value_sp->GetChangedChildren (changed_children);
+                const size_t num_changed = changed_children.GetSize();
+                for (size_t i = 0; i < num_changed; ++i)
+                    sb_values.Append (SBValue (changed_children.GetValueObjectAtIndex (i)));
+            }
+        }
+    }
+    if (log)
+        log->Printf ("SBValue(%p)::GetChangedChildren() => %u children", value_sp.get(), sb_values.GetSize());
+
+    return sb_values;
+}
+
 #ifndef LLDB_DISABLE_PYTHON
 const char *
 SBValue::GetSummary ()
@@ -562,7 +599,7 @@ SBValue::GetTypeFilter ()
                 {
                     lldb::SyntheticChildrenSP synthetic_sp = value_sp->GetSyntheticChildren();
                     
-                    if (synthetic_sp && !synthetic_sp->IsScripted())
+                    if (synthetic_sp && !synthetic_sp->IsScripted() && !synthetic_sp->IsNative())
                     {
                         TypeFilterImplSP filter_sp = STD_STATIC_POINTER_CAST(TypeFilterImpl,synthetic_sp);
                         filter.SetSP(filter_sp);
@@ -800,6 +837,39 @@ SBValue::CreateValueFromData (const char* name, SBData data, SBType type)
     return sb_value;
 }
 
+lldb::SBValueList
+SBValue::CreateValuesFromData (SBData data, SBType type, uint32_t start_idx)
+{
+    lldb::SBValueList sb_values;
+    lldb::ValueObjectSP value_sp(GetSP());
+    const size_t item_byte_size = type.IsValid() ? type.GetByteSize() : 0;
+    if (value_sp && data.IsValid() && item_byte_size > 0)
+    {
+        ExecutionContext exe_ctx (value_sp->GetExecutionContextRef());
+        const DataExtractor &items_data = *data.m_opaque_sp;
+        const uint32_t num_items = items_data.GetByteSize() / item_byte_size;
+        for (uint32_t i = 0; i < num_items; ++i)
+        {
+            // Each item shares the buffer of data rather than getting a copy
+            DataExtractor item_data (items_data, i * item_byte_size, item_byte_size);
+            StreamString item_name;
+            item_name.Printf ("[%u]", start_idx + i);
+            ValueObjectSP item_sp (ValueObjectConstResult::Create (exe_ctx.GetBestExecutionContextScope(),
+                                                                   type.m_opaque_sp->GetASTContext(),
+                                                                   type.m_opaque_sp->GetOpaqueQualType(),
+                                                                   ConstString(item_name.GetData()),
+                                                                   item_data,
+                                                                   LLDB_INVALID_ADDRESS));
+            item_sp->SetAddressTypeOfChildren(eAddressTypeLoad);
+            sb_values.Append (SBValue (item_sp));
+        }
+    }
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+    if (log)
+        log->Printf ("SBValue(%p)::CreateValuesFromData (start_idx = %u) => %u values", value_sp.get(), start_idx, sb_values.GetSize());
+    return sb_values;
+}
+
 SBValue
 SBValue::GetChildAtIndex (uint32_t idx)
 {
@@ -1213,6 +1283,12 @@ SBValue::GetValueAsUnsigned(uint64_t fail_value)
 
 uint32_t
 SBValue::GetNumChildren ()
+{
+    return GetNumChildren (UINT32_MAX);
+}
+
+uint32_t
+SBValue::GetNumChildren (uint32_t max)
 {
     uint32_t num_children = 0;
 
@@ -1234,17 +1310,38 @@ SBValue::GetNumChildren ()
             {
                 Mutex::Locker api_locker (target_sp->GetAPIMutex());
 
-                num_children = value_sp->GetNumChildren();
+                num_children = value_sp->GetNumChildren(max);
             }
         }
     }
 
     if (log)
-        log->Printf ("SBValue(%p)::GetNumChildren () => %u", value_sp.get(), num_children);
+        log->Printf ("SBValue(%p)::GetNumChildren (%u) => %u", value_sp.get(), max, num_children);
 
     return num_children;
 }
 
+SBValueList
+SBValue::GetChildrenInRange (uint32_t start_idx, uint32_t count)
+{
+    SBValueList children;
+    LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_API));
+    lldb::ValueObjectSP value_sp(GetSP());
+    if (value_sp)
+    {
+        for (uint32_t i = 0; i < count && start_idx + i >= start_idx; ++i)
+        {
+            SBValue child (GetChildAtIndex (start_idx + i));
+            if (!child.IsValid())
+                break;
+            children.Append (child);
+        }
+    }
+    if (log)
+        log->Printf ("SBValue(%p)::GetChildrenInRange (%u, %u) => %u children", value_sp.get(), start_idx, count, children.GetSize());
+    return children;
+}
+
 
 SBValue
 SBValue::Dereference ()
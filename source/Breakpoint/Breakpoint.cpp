@@ -25,6 +25,7 @@
 #include "lldb/Core/Stream.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/ThreadSpec.h"
 #include "lldb/lldb-private-log.h"
@@ -127,10 +128,14 @@ Breakpoint::SetEnabled (bool enable)
         return;
 
     m_options.SetEnabled(enable);
-    if (enable)
-        m_locations.ResolveAllBreakpointSites();
-    else
-        m_locations.ClearAllBreakpointSites();
+    {
+        ProcessSP process_sp (m_target.GetProcessSP());
+        Process::BreakpointSiteBatch site_batch (process_sp.get());
+        if (enable)
+            m_locations.ResolveAllBreakpointSites();
+        else
+            m_locations.ClearAllBreakpointSites();
+    }
         
     SendBreakpointChangedEvent (enable ? eBreakpointEventTypeEnabled : eBreakpointEventTypeDisabled);
 
@@ -318,19 +323,31 @@ void
 Breakpoint::ResolveBreakpoint ()
 {
     if (m_resolver_sp)
+    {
+        // Each new location creates its breakpoint site as soon as it is
+        // added, batch them so they are all enabled at once
+        ProcessSP process_sp (m_target.GetProcessSP());
+        Process::BreakpointSiteBatch site_batch (process_sp.get());
         m_resolver_sp->ResolveBreakpoint(*m_filter_sp);
+    }
 }
 
 void
 Breakpoint::ResolveBreakpointInModules (ModuleList &module_list)
 {
     if (m_resolver_sp)
+    {
+        ProcessSP process_sp (m_target.GetProcessSP());
+        Process::BreakpointSiteBatch site_batch (process_sp.get());
         m_resolver_sp->ResolveBreakpointInModules(*m_filter_sp, module_list);
+    }
 }
 
 void
 Breakpoint::ClearAllBreakpointSites ()
 {
+    ProcessSP process_sp (m_target.GetProcessSP());
+    Process::BreakpointSiteBatch site_batch (process_sp.get());
     m_locations.ClearAllBreakpointSites();
 }
 
@@ -339,7 +356,7 @@ Breakpoint::ClearAllBreakpointSites ()
 //----------------------------------------------------------------------
 
 void
-Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_locations)
+Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_locations, ModuleList *modules_to_search)
 {
     Mutex::Locker modules_mutex(module_list.GetMutex());
     if (load)
@@ -387,7 +404,10 @@ Breakpoint::ModulesChanged (ModuleList &module_list, bool load, bool delete_loca
             }
 
             if (!seen)
-                new_modules.AppendIfNeeded (module_sp);
+            {
+                if (modules_to_search == NULL || modules_to_search->FindModule (module_sp.get()))
+                    new_modules.AppendIfNeeded (module_sp);
+            }
 
         }
         
@@ -13,6 +13,11 @@
 // C++ Includes
 // Other libraries and framework includes
 // Project includes
+#include "lldb/Breakpoint/BreakpointResolver.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Symbol/CompileUnit.h"
+#include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Target/Target.h"
 
 using namespace lldb;
@@ -22,7 +27,11 @@ BreakpointList::BreakpointList (bool is_internal) :
     m_mutex (Mutex::eMutexTypeRecursive),
     m_breakpoints(),
     m_next_break_id (0),
-    m_is_internal (is_internal)
+    m_is_internal (is_internal),
+    m_function_name_index (),
+    m_file_basename_index (),
+    m_indexed_breakpoints (),
+    m_module_key_index_valid (false)
 {
 }
 
@@ -39,6 +48,7 @@ BreakpointList::Add (BreakpointSP &bp_sp, bool notify)
     bp_sp->SetID (m_is_internal ? --m_next_break_id : ++m_next_break_id);
     
     m_breakpoints.push_back(bp_sp);
+    m_module_key_index_valid = false;
     if (notify)
     {
         if (bp_sp->GetTarget().EventTypeHasListeners(Target::eBroadcastBitBreakpointChanged))
@@ -57,6 +67,7 @@ BreakpointList::Remove (break_id_t break_id, bool notify)
     {
         BreakpointSP bp_sp (*pos);
         m_breakpoints.erase(pos);
+        m_module_key_index_valid = false;
         if (notify)
         {
             if (bp_sp->GetTarget().EventTypeHasListeners(Target::eBroadcastBitBreakpointChanged))
@@ -93,6 +104,7 @@ BreakpointList::RemoveAll (bool notify)
                                                     new Breakpoint::BreakpointEventData (eBreakpointEventTypeRemoved, *pos));
     }
     m_breakpoints.erase (m_breakpoints.begin(), m_breakpoints.end());
+    m_module_key_index_valid = false;
 }
 
 class BreakpointIDMatches
@@ -198,15 +210,136 @@ BreakpointList::GetBreakpointAtIndex (uint32_t i) const
     return stop_sp;
 }
 
+void
+BreakpointList::UpdateModuleKeyIndex ()
+{
+    if (m_module_key_index_valid)
+        return;
+
+    m_function_name_index.clear();
+    m_file_basename_index.clear();
+    m_indexed_breakpoints.clear();
+
+    std::vector<ConstString> func_names;
+    std::vector<ConstString> file_basenames;
+    bp_collection::iterator pos, end = m_breakpoints.end();
+    for (pos = m_breakpoints.begin(); pos != end; ++pos)
+    {
+        Breakpoint *bp = pos->get();
+        BreakpointResolverSP resolver_sp (bp->GetResolver());
+        func_names.clear();
+        file_basenames.clear();
+        uint32_t name_type_mask = 0;
+        if (!resolver_sp || !resolver_sp->GetModuleKeys (func_names, name_type_mask, file_basenames))
+            continue;
+
+        m_indexed_breakpoints.insert (bp);
+        for (size_t i = 0; i < func_names.size(); ++i)
+        {
+            FunctionNameEntry &entry = m_function_name_index[func_names[i]];
+            entry.name_type_mask |= name_type_mask;
+            entry.breakpoints.push_back (bp);
+        }
+        for (size_t i = 0; i < file_basenames.size(); ++i)
+            m_file_basename_index[file_basenames[i]].push_back (bp);
+    }
+    m_module_key_index_valid = true;
+}
+
+void
+BreakpointList::FindBreakpointsForModule (const ModuleSP &module_sp, std::set<Breakpoint *> &breakpoints)
+{
+    // Look up each function name once no matter how many breakpoints use it
+    const bool include_symbols = true;
+    const bool include_inlines = true;
+    const bool append = false;
+    SymbolContextList sc_list;
+    function_name_index::const_iterator name_pos, name_end = m_function_name_index.end();
+    for (name_pos = m_function_name_index.begin(); name_pos != name_end; ++name_pos)
+    {
+        if (name_pos->second.breakpoints.front()->GetTarget().GetBreakpointsPrefilterWithSymbols() &&
+            !module_sp->MightContainFunction (name_pos->first, name_pos->second.name_type_mask))
+            continue;
+        if (module_sp->FindFunctions (name_pos->first,
+                                      NULL,
+                                      name_pos->second.name_type_mask,
+                                      include_symbols,
+                                      include_inlines,
+                                      append,
+                                      sc_list) > 0)
+            breakpoints.insert (name_pos->second.breakpoints.begin(), name_pos->second.breakpoints.end());
+    }
+
+    // Walk the compile units and their support files once for all file
+    // and line breakpoints
+    if (m_file_basename_index.empty())
+        return;
+    const uint32_t num_comp_units = module_sp->GetNumCompileUnits();
+    for (uint32_t i = 0; i < num_comp_units; ++i)
+    {
+        CompUnitSP cu_sp (module_sp->GetCompileUnitAtIndex (i));
+        if (!cu_sp)
+            continue;
+        file_basename_index::const_iterator file_pos = m_file_basename_index.find (cu_sp->GetFilename());
+        if (file_pos != m_file_basename_index.end())
+            breakpoints.insert (file_pos->second.begin(), file_pos->second.end());
+
+        const FileSpecList &support_files = cu_sp->GetSupportFiles();
+        const uint32_t num_support_files = support_files.GetSize();
+        for (uint32_t j = 0; j < num_support_files; ++j)
+        {
+            file_pos = m_file_basename_index.find (support_files.GetFileSpecAtIndex(j).GetFilename());
+            if (file_pos != m_file_basename_index.end())
+                breakpoints.insert (file_pos->second.begin(), file_pos->second.end());
+        }
+    }
+}
+
 void
 BreakpointList::UpdateBreakpoints (ModuleList& module_list, bool added)
 {
     Mutex::Locker locker(m_mutex);
     bp_collection::iterator end = m_breakpoints.end();
     bp_collection::iterator pos;
+
+    if (added)
+        UpdateModuleKeyIndex ();
+    if (!added || m_indexed_breakpoints.empty())
+    {
+        for (pos = m_breakpoints.begin(); pos != end; ++pos)
+            (*pos)->ModulesChanged (module_list, added);
+        return;
+    }
+
+    // Search each new module once for the keys of all indexed breakpoints,
+    // those only need to look for new locations in the modules they
+    // matched instead of running their resolver on every module
+    const size_t num_modules = module_list.GetSize();
+    std::vector<std::set<Breakpoint *> > module_breakpoints (num_modules);
+    for (size_t i = 0; i < num_modules; ++i)
+    {
+        ModuleSP module_sp (module_list.GetModuleAtIndex (i));
+        if (module_sp)
+            FindBreakpointsForModule (module_sp, module_breakpoints[i]);
+    }
+
     for (pos = m_breakpoints.begin(); pos != end; ++pos)
-        (*pos)->ModulesChanged (module_list, added);
+    {
+        Breakpoint *bp = pos->get();
+        if (m_indexed_breakpoints.find (bp) == m_indexed_breakpoints.end())
+        {
+            bp->ModulesChanged (module_list, added);
+            continue;
+        }
 
+        ModuleList modules_to_search;
+        for (size_t i = 0; i < num_modules; ++i)
+        {
+            if (module_breakpoints[i].find (bp) != module_breakpoints[i].end())
+                modules_to_search.Append (module_list.GetModuleAtIndex (i));
+        }
+        bp->ModulesChanged (module_list, added, false, &modules_to_search);
+    }
 }
 
 void
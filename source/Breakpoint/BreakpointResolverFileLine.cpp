@@ -214,6 +214,17 @@ BreakpointResolverFileLine::GetDepth()
     return Searcher::eDepthModule;
 }
 
+bool
+BreakpointResolverFileLine::GetModuleKeys (std::vector<ConstString> &func_names,
+                                           uint32_t &func_name_type_mask,
+                                           std::vector<ConstString> &file_basenames)
+{
+    if (!m_file_spec.GetFilename())
+        return false;
+    file_basenames.push_back (m_file_spec.GetFilename());
+    return true;
+}
+
 void
 BreakpointResolverFileLine::GetDescription (Stream *s)
 {
@@ -157,6 +157,9 @@ BreakpointResolverName::SearchCallback
     const bool include_inlines = true;
     const bool append = true;
     bool filter_by_cu = (filter.GetFilterRequiredItems() & eSymbolContextCompUnit) != 0;
+    // Don't make modules whose symbol table doesn't have the name index
+    // all of their debug information
+    const bool prefilter_with_symbols = m_breakpoint->GetTarget().GetBreakpointsPrefilterWithSymbols();
 
     switch (m_match_type)
     {
@@ -166,6 +169,8 @@ BreakpointResolverName::SearchCallback
                 size_t num_names = m_func_names.size();
                 for (int i = 0; i < num_names; i++)
                 {
+                    if (prefilter_with_symbols && !context.module_sp->MightContainFunction (m_func_names[i], m_func_name_type_mask))
+                        continue;
                     uint32_t num_functions = context.module_sp->FindFunctions (m_func_names[i], 
                                                                                NULL,
                                                                                m_func_name_type_mask, 
@@ -331,6 +336,19 @@ BreakpointResolverName::GetDepth()
     return Searcher::eDepthModule;
 }
 
+bool
+BreakpointResolverName::GetModuleKeys (std::vector<ConstString> &func_names,
+                                       uint32_t &func_name_type_mask,
+                                       std::vector<ConstString> &file_basenames)
+{
+    // Regular expressions can match anything
+    if (m_match_type != Breakpoint::Exact || m_class_name || m_func_names.empty())
+        return false;
+    func_names.insert (func_names.end(), m_func_names.begin(), m_func_names.end());
+    func_name_type_mask = m_func_name_type_mask;
+    return true;
+}
+
 void
 BreakpointResolverName::GetDescription (Stream *s)
 {
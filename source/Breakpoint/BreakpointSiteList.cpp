@@ -20,7 +20,11 @@ using namespace lldb;
 using namespace lldb_private;
 
 BreakpointSiteList::BreakpointSiteList() :
-    m_bp_site_list()
+    m_sites(),
+    m_addr_table(),
+    m_id_table(),
+    m_sorted_sites(),
+    m_num_sorted(0)
 {
 }
 
@@ -28,24 +32,185 @@ BreakpointSiteList::~BreakpointSiteList()
 {
 }
 
+// Sites added one at a time are appended to the unsorted tail of
+// m_sorted_sites, which every range query has to scan, so it is merged
+// into the sorted part once it has this many entries.
+static const size_t g_max_unsorted_sites = 64;
+
+static inline size_t
+GetHomeSlot (uint64_t key, size_t mask)
+{
+    // Breakpoint addresses are often aligned and close together, so mix
+    // all the bits of the key before masking off the table index.
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return key & mask;
+}
+
+uint32_t
+BreakpointSiteList::HashFind (const hash_table &table, uint64_t key)
+{
+    if (table.empty())
+        return UINT32_MAX;
+    const size_t mask = table.size() - 1;
+    for (size_t i = GetHomeSlot (key, mask); table[i].site_idx != UINT32_MAX; i = (i + 1) & mask)
+    {
+        if (table[i].key == key)
+            return table[i].site_idx;
+    }
+    return UINT32_MAX;
+}
+
+void
+BreakpointSiteList::HashInsert (hash_table &table, uint64_t key, uint32_t site_idx)
+{
+    const size_t mask = table.size() - 1;
+    size_t i = GetHomeSlot (key, mask);
+    while (table[i].site_idx != UINT32_MAX)
+        i = (i + 1) & mask;
+    table[i].key = key;
+    table[i].site_idx = site_idx;
+}
+
+void
+BreakpointSiteList::HashRemove (hash_table &table, uint64_t key)
+{
+    if (table.empty())
+        return;
+    const size_t mask = table.size() - 1;
+    size_t i = GetHomeSlot (key, mask);
+    while (table[i].site_idx != UINT32_MAX && table[i].key != key)
+        i = (i + 1) & mask;
+    if (table[i].site_idx == UINT32_MAX)
+        return;
+
+    // Shift back any entries in the same probe run that can now be found
+    // from an earlier slot so lookups never stop at the hole we leave.
+    size_t j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (table[j].site_idx == UINT32_MAX)
+            break;
+        const size_t home = GetHomeSlot (table[j].key, mask);
+        const bool home_in_gap = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (home_in_gap)
+            continue;
+        table[i] = table[j];
+        i = j;
+    }
+    table[i].site_idx = UINT32_MAX;
+}
+
+void
+BreakpointSiteList::HashUpdate (hash_table &table, uint64_t key, uint32_t site_idx)
+{
+    const size_t mask = table.size() - 1;
+    for (size_t i = GetHomeSlot (key, mask); table[i].site_idx != UINT32_MAX; i = (i + 1) & mask)
+    {
+        if (table[i].key == key)
+        {
+            table[i].site_idx = site_idx;
+            return;
+        }
+    }
+}
+
+void
+BreakpointSiteList::ReserveHashTables (size_t num_sites)
+{
+    // Keep both tables at most half full
+    if (num_sites * 2 <= m_addr_table.size())
+        return;
+
+    size_t capacity = 16;
+    while (capacity < num_sites * 2)
+        capacity *= 2;
+
+    HashSlot empty_slot;
+    empty_slot.key = 0;
+    empty_slot.site_idx = UINT32_MAX;
+    m_addr_table.assign (capacity, empty_slot);
+    m_id_table.assign (capacity, empty_slot);
+    const uint32_t num_current_sites = m_sites.size();
+    for (uint32_t site_idx = 0; site_idx < num_current_sites; ++site_idx)
+    {
+        HashInsert (m_addr_table, m_sites[site_idx]->GetLoadAddress(), site_idx);
+        HashInsert (m_id_table, m_sites[site_idx]->GetID(), site_idx);
+    }
+}
+
+uint32_t
+BreakpointSiteList::FindIndexByAddress (lldb::addr_t addr) const
+{
+    return HashFind (m_addr_table, addr);
+}
+
+uint32_t
+BreakpointSiteList::FindIndexByID (lldb::break_id_t break_id) const
+{
+    return HashFind (m_id_table, break_id);
+}
+
+bool
+BreakpointSiteList::AddSite (const BreakpointSiteSP &bp_site_sp)
+{
+    const lldb::addr_t bp_site_load_addr = bp_site_sp->GetLoadAddress();
+    if (FindIndexByAddress (bp_site_load_addr) != UINT32_MAX)
+        return false;
+
+    const uint32_t site_idx = m_sites.size();
+    m_sites.push_back (bp_site_sp);
+    HashInsert (m_addr_table, bp_site_load_addr, site_idx);
+    HashInsert (m_id_table, bp_site_sp->GetID(), site_idx);
+
+    SortedSite sorted_site;
+    sorted_site.addr = bp_site_load_addr;
+    sorted_site.site = bp_site_sp.get();
+    m_sorted_sites.push_back (sorted_site);
+    return true;
+}
+
+void
+BreakpointSiteList::MergeUnsortedSites ()
+{
+    if (m_num_sorted == m_sorted_sites.size())
+        return;
+    sorted_collection::iterator middle = m_sorted_sites.begin() + m_num_sorted;
+    std::sort (middle, m_sorted_sites.end());
+    std::inplace_merge (m_sorted_sites.begin(), middle, m_sorted_sites.end());
+    m_num_sorted = m_sorted_sites.size();
+}
+
 // Add breakpoint site to the list.  However, if the element already exists in the
 // list, then we don't add it, and return LLDB_INVALID_BREAK_ID.
 
 lldb::break_id_t
 BreakpointSiteList::Add(const BreakpointSiteSP &bp)
 {
-    lldb::addr_t bp_site_load_addr = bp->GetLoadAddress();
-    collection::iterator iter = m_bp_site_list.find (bp_site_load_addr);
+    ReserveHashTables (m_sites.size() + 1);
+    if (!AddSite (bp))
+        return LLDB_INVALID_BREAK_ID;
 
-    if (iter == m_bp_site_list.end())
-    {
-        m_bp_site_list.insert (iter, collection::value_type (bp_site_load_addr, bp));
-        return bp->GetID();
-    }
-    else
+    if (m_sorted_sites.size() - m_num_sorted > g_max_unsorted_sites)
+        MergeUnsortedSites ();
+    return bp->GetID();
+}
+
+size_t
+BreakpointSiteList::AddSites (const collection &bp_sites)
+{
+    ReserveHashTables (m_sites.size() + bp_sites.size());
+    size_t num_added = 0;
+    collection::const_iterator pos, end = bp_sites.end();
+    for (pos = bp_sites.begin(); pos != end; ++pos)
     {
-        return LLDB_INVALID_BREAK_ID;
+        if (*pos && AddSite (*pos))
+            ++num_added;
     }
+    MergeUnsortedSites ();
+    return num_added;
 }
 
 bool
@@ -76,13 +241,54 @@ BreakpointSiteList::FindIDByAddress (lldb::addr_t addr)
     return LLDB_INVALID_BREAK_ID;
 }
 
+void
+BreakpointSiteList::RemoveSiteAtIndex (uint32_t site_idx)
+{
+    BreakpointSite *site = m_sites[site_idx].get();
+    const lldb::addr_t addr = site->GetLoadAddress();
+    HashRemove (m_addr_table, addr);
+    HashRemove (m_id_table, site->GetID());
+
+    SortedSite key;
+    key.addr = addr;
+    key.site = NULL;
+    sorted_collection::iterator sorted_end = m_sorted_sites.begin() + m_num_sorted;
+    sorted_collection::iterator pos = std::lower_bound (m_sorted_sites.begin(), sorted_end, key);
+    if (pos != sorted_end && pos->site == site)
+    {
+        m_sorted_sites.erase (pos);
+        --m_num_sorted;
+    }
+    else
+    {
+        for (pos = sorted_end; pos != m_sorted_sites.end(); ++pos)
+        {
+            if (pos->site == site)
+            {
+                m_sorted_sites.erase (pos);
+                break;
+            }
+        }
+    }
+
+    // Move the last site into the hole so m_sites stays dense
+    const uint32_t last_idx = m_sites.size() - 1;
+    if (site_idx != last_idx)
+    {
+        m_sites[site_idx] = m_sites[last_idx];
+        HashUpdate (m_addr_table, m_sites[site_idx]->GetLoadAddress(), site_idx);
+        HashUpdate (m_id_table, m_sites[site_idx]->GetID(), site_idx);
+    }
+    m_sites.pop_back();
+}
+
 bool
 BreakpointSiteList::Remove (lldb::break_id_t break_id)
 {
-    collection::iterator pos = GetIDIterator(break_id);    // Predicate
-    if (pos != m_bp_site_list.end())
+    const uint32_t site_idx = FindIndexByID (break_id);
+    if (site_idx != UINT32_MAX)
     {
-        m_bp_site_list.erase(pos);
+        RemoveSiteAtIndex (site_idx);
         return true;
     }
     return false;
@@ -91,53 +297,69 @@ BreakpointSiteList::Remove (lldb::break_id_t break_id)
 bool
 BreakpointSiteList::RemoveByAddress (lldb::addr_t address)
 {
-    collection::iterator pos =  m_bp_site_list.find(address);
-    if (pos != m_bp_site_list.end())
+    const uint32_t site_idx = FindIndexByAddress (address);
+    if (site_idx != UINT32_MAX)
     {
-        m_bp_site_list.erase(pos);
+        RemoveSiteAtIndex (site_idx);
         return true;
     }
     return false;
 }
 
-class BreakpointSiteIDMatches
+size_t
+BreakpointSiteList::RemoveByAddresses (const std::vector<lldb::addr_t> &addrs)
 {
-public:
-    BreakpointSiteIDMatches (lldb::break_id_t break_id) :
-        m_break_id(break_id)
+    // Only remove the sites from m_sites and the hash tables here, erasing
+    // them one by one from the sorted array would make this quadratic.
+    size_t num_removed = 0;
+    std::vector<lldb::addr_t>::const_iterator addr_pos, addr_end = addrs.end();
+    for (addr_pos = addrs.begin(); addr_pos != addr_end; ++addr_pos)
     {
+        const uint32_t site_idx = FindIndexByAddress (*addr_pos);
+        if (site_idx == UINT32_MAX)
+            continue;
+        HashRemove (m_addr_table, *addr_pos);
+        HashRemove (m_id_table, m_sites[site_idx]->GetID());
+        const uint32_t last_idx = m_sites.size() - 1;
+        if (site_idx != last_idx)
+        {
+            m_sites[site_idx] = m_sites[last_idx];
+            HashUpdate (m_addr_table, m_sites[site_idx]->GetLoadAddress(), site_idx);
+            HashUpdate (m_id_table, m_sites[site_idx]->GetID(), site_idx);
+        }
+        m_sites.pop_back();
+        ++num_removed;
     }
 
-    bool operator() (std::pair <lldb::addr_t, BreakpointSiteSP> val_pair) const
+    if (num_removed > 0)
     {
-        return m_break_id == val_pair.second.get()->GetID();
+        // Now compact the sorted array, keeping the sites that are still
+        // in the address table.
+        size_t num_kept = 0;
+        size_t num_sorted_kept = 0;
+        const size_t num_sorted_sites = m_sorted_sites.size();
+        for (size_t i = 0; i < num_sorted_sites; ++i)
+        {
+            const uint32_t site_idx = FindIndexByAddress (m_sorted_sites[i].addr);
+            if (site_idx == UINT32_MAX || m_sites[site_idx].get() != m_sorted_sites[i].site)
+                continue;
+            if (i < m_num_sorted)
+                ++num_sorted_kept;
+            m_sorted_sites[num_kept++] = m_sorted_sites[i];
+        }
+        m_sorted_sites.resize (num_kept);
+        m_num_sorted = num_sorted_kept;
     }
-
-private:
-   const lldb::break_id_t m_break_id;
-};
-
-BreakpointSiteList::collection::iterator
-BreakpointSiteList::GetIDIterator (lldb::break_id_t break_id)
-{
-    return std::find_if(m_bp_site_list.begin(), m_bp_site_list.end(),   // Search full range
-                        BreakpointSiteIDMatches(break_id));             // Predicate
-}
-
-BreakpointSiteList::collection::const_iterator
-BreakpointSiteList::GetIDConstIterator (lldb::break_id_t break_id) const
-{
-    return std::find_if(m_bp_site_list.begin(), m_bp_site_list.end(),   // Search full range
-                        BreakpointSiteIDMatches(break_id));             // Predicate
+    return num_removed;
 }
 
 BreakpointSiteSP
 BreakpointSiteList::FindByID (lldb::break_id_t break_id)
 {
     BreakpointSiteSP stop_sp;
-    collection::iterator pos = GetIDIterator(break_id);
-    if (pos != m_bp_site_list.end())
-        stop_sp = pos->second;
+    const uint32_t site_idx = FindIndexByID (break_id);
+    if (site_idx != UINT32_MAX)
+        stop_sp = m_sites[site_idx];
 
     return stop_sp;
 }
@@ -146,9 +368,9 @@ const BreakpointSiteSP
 BreakpointSiteList::FindByID (lldb::break_id_t break_id) const
 {
     BreakpointSiteSP stop_sp;
-    collection::const_iterator pos = GetIDConstIterator(break_id);
-    if (pos != m_bp_site_list.end())
-        stop_sp = pos->second;
+    const uint32_t site_idx = FindIndexByID (break_id);
+    if (site_idx != UINT32_MAX)
+        stop_sp = m_sites[site_idx];
 
     return stop_sp;
 }
@@ -157,19 +379,18 @@ BreakpointSiteSP
 BreakpointSiteList::FindByAddress (lldb::addr_t addr)
 {
     BreakpointSiteSP found_sp;
-
-    collection::iterator iter =  m_bp_site_list.find(addr);
-    if (iter != m_bp_site_list.end())
-        found_sp = iter->second;
+    const uint32_t site_idx = FindIndexByAddress (addr);
+    if (site_idx != UINT32_MAX)
+        found_sp = m_sites[site_idx];
     return found_sp;
 }
 
 bool
 BreakpointSiteList::BreakpointSiteContainsBreakpoint (lldb::break_id_t bp_site_id, lldb::break_id_t bp_id)
 {
-    collection::const_iterator pos = GetIDConstIterator(bp_site_id);
-    if (pos != m_bp_site_list.end())
-        pos->second->IsBreakpointAtThisSite (bp_id);
+    const uint32_t site_idx = FindIndexByID (bp_site_id);
+    if (site_idx != UINT32_MAX)
+        return m_sites[site_idx]->IsBreakpointAtThisSite (bp_id);
 
     return false;
 }
@@ -179,12 +400,12 @@ BreakpointSiteList::Dump (Stream *s) const
 {
     s->Printf("%p: ", this);
     //s->Indent();
-    s->Printf("BreakpointSiteList with %u BreakpointSites:\n", (uint32_t)m_bp_site_list.size());
+    s->Printf("BreakpointSiteList with %u BreakpointSites:\n", (uint32_t)m_sites.size());
     s->IndentMore();
     collection::const_iterator pos;
-    collection::const_iterator end = m_bp_site_list.end();
-    for (pos = m_bp_site_list.begin(); pos != end; ++pos)
-        pos->second.get()->Dump(s);
+    collection::const_iterator end = m_sites.end();
+    for (pos = m_sites.begin(); pos != end; ++pos)
+        (*pos)->Dump(s);
     s->IndentLess();
 }
 
@@ -193,14 +414,8 @@ BreakpointSiteSP
 BreakpointSiteList::GetByIndex (uint32_t i)
 {
     BreakpointSiteSP stop_sp;
-    collection::iterator end = m_bp_site_list.end();
-    collection::iterator pos;
-    uint32_t curr_i = 0;
-    for (pos = m_bp_site_list.begin(), curr_i = 0; pos != end; ++pos, ++curr_i)
-    {
-        if (curr_i == i)
-            stop_sp = pos->second;
-    }
+    if (i < m_sites.size())
+        stop_sp = m_sites[i];
     return stop_sp;
 }
 
@@ -208,48 +423,72 @@ const BreakpointSiteSP
 BreakpointSiteList::GetByIndex (uint32_t i) const
 {
     BreakpointSiteSP stop_sp;
-    collection::const_iterator end = m_bp_site_list.end();
-    collection::const_iterator pos;
-    uint32_t curr_i = 0;
-    for (pos = m_bp_site_list.begin(), curr_i = 0; pos != end; ++pos, ++curr_i)
-    {
-        if (curr_i == i)
-            stop_sp = pos->second;
-    }
+    if (i < m_sites.size())
+        stop_sp = m_sites[i];
     return stop_sp;
 }
 
-bool
-BreakpointSiteList::FindInRange (lldb::addr_t lower_bound, lldb::addr_t upper_bound, BreakpointSiteList &bp_site_list) const
+class BreakpointSiteAddressLess
 {
-        
-    if (lower_bound > upper_bound)
-        return false;
-    
-    collection::const_iterator lower, upper, pos;
-    lower = m_bp_site_list.lower_bound(lower_bound);
-    if (lower == m_bp_site_list.end()
-            || (*lower).first >= upper_bound)
-        return false;
-    
+public:
+    bool operator() (const BreakpointSiteSP &lhs, const BreakpointSiteSP &rhs) const
+    {
+        return lhs->GetLoadAddress() < rhs->GetLoadAddress();
+    }
+};
+
+size_t
+BreakpointSiteList::FindInRange (lldb::addr_t lower_bound, lldb::addr_t upper_bound, collection &bp_sites) const
+{
+    if (lower_bound >= upper_bound)
+        return 0;
+
+    const size_t old_size = bp_sites.size();
+    SortedSite key;
+    key.addr = lower_bound;
+    key.site = NULL;
+    sorted_collection::const_iterator sorted_begin = m_sorted_sites.begin();
+    sorted_collection::const_iterator sorted_end = sorted_begin + m_num_sorted;
+    sorted_collection::const_iterator pos = std::lower_bound (sorted_begin, sorted_end, key);
+
     // This is one tricky bit.  The breakpoint might overlap the bottom end of the range.  So we grab the
     // breakpoint prior to the lower bound, and check that that + its byte size isn't in our range.
-    if (lower != m_bp_site_list.begin())
+    if (pos != sorted_begin)
     {
-        collection::const_iterator prev_pos = lower;
-        prev_pos--;
-        const BreakpointSiteSP &prev_bp = (*prev_pos).second;
-        if (prev_bp->GetLoadAddress() + prev_bp->GetByteSize() > lower_bound)
-            bp_site_list.Add (prev_bp);
-        
+        sorted_collection::const_iterator prev_pos = pos - 1;
+        if (prev_pos->addr + prev_pos->site->GetByteSize() > lower_bound)
+            bp_sites.push_back (m_sites[FindIndexByAddress (prev_pos->addr)]);
     }
-    
-    upper = m_bp_site_list.upper_bound(upper_bound);
-        
-    for (pos = lower; pos != upper; pos++)
+
+    for (; pos != sorted_end && pos->addr < upper_bound; ++pos)
+        bp_sites.push_back (m_sites[FindIndexByAddress (pos->addr)]);
+
+    // Sites that were added recently aren't sorted yet
+    bool added_unsorted = false;
+    sorted_collection::const_iterator end = m_sorted_sites.end();
+    for (pos = sorted_end; pos != end; ++pos)
     {
-        bp_site_list.Add ((*pos).second);
+        const bool overlaps = pos->addr >= lower_bound ? pos->addr < upper_bound
+                                                       : pos->addr + pos->site->GetByteSize() > lower_bound;
+        if (overlaps)
+        {
+            bp_sites.push_back (m_sites[FindIndexByAddress (pos->addr)]);
+            added_unsorted = true;
+        }
     }
+    if (added_unsorted)
+        std::sort (bp_sites.begin() + old_size, bp_sites.end(), BreakpointSiteAddressLess());
+
+    return bp_sites.size() - old_size;
+}
+
+bool
+BreakpointSiteList::FindInRange (lldb::addr_t lower_bound, lldb::addr_t upper_bound, BreakpointSiteList &bp_site_list) const
+{
+    collection bp_sites;
+    if (FindInRange (lower_bound, upper_bound, bp_sites) == 0)
+        return false;
+    bp_site_list.AddSites (bp_sites);
     return true;
 }
 
@@ -257,19 +496,13 @@ BreakpointSiteList::FindInRange (lldb::addr_t lower_bound, lldb::addr_t upper_bo
 void
 BreakpointSiteList::SetEnabledForAll (const bool enabled, const lldb::break_id_t except_id)
 {
-    collection::iterator end = m_bp_site_list.end();
+    collection::iterator end = m_sites.end();
     collection::iterator pos;
-    for (pos = m_bp_site_list.begin(); pos != end; ++pos)
+    for (pos = m_sites.begin(); pos != end; ++pos)
     {
-        if (except_id != LLDB_INVALID_BREAK_ID && except_id != pos->second->GetID())
-            pos->second->SetEnabled (enabled);
+        if (except_id != LLDB_INVALID_BREAK_ID && except_id != (*pos)->GetID())
+            (*pos)->SetEnabled (enabled);
         else
-            pos->second->SetEnabled (!enabled);
+            (*pos)->SetEnabled (!enabled);
     }
 }
-
-const BreakpointSiteList::collection *
-BreakpointSiteList::GetMap ()
-{
-    return &m_bp_site_list;
-}
@@ -416,6 +416,7 @@ protected:
             .SetFlatOutput(m_varobj_options.flat_output)
             .SetOmitSummaryDepth(m_varobj_options.no_summary_depth)
             .SetIgnoreCap(m_varobj_options.ignore_cap)
+            .SetChildrenRange(m_varobj_options.child_start, m_varobj_options.child_count)
             .SetSummary(summary_format_sp);
 
         if (m_varobj_options.be_raw)
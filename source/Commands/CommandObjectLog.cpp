@@ -19,6 +19,7 @@
 #include "lldb/Core/Debugger.h"
 #include "lldb/Host/FileSpec.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/LogWriter.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Interpreter/Options.h"
 #include "lldb/Core/RegularExpression.h"
@@ -144,6 +145,8 @@ public:
             case 'T':  log_options |= LLDB_LOG_OPTION_PREPEND_TIMESTAMP;      break;
             case 'p':  log_options |= LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD;break;
             case 'n':  log_options |= LLDB_LOG_OPTION_PREPEND_THREAD_NAME;    break;
+            case 'a':  log_options |= LLDB_LOG_OPTION_ASYNC;                  break;
+            case 'b':  log_options |= LLDB_LOG_OPTION_BINARY;                 break;
             default:
                 error.SetErrorStringWithFormat ("unrecognized option '%c'", short_option);
                 break;
@@ -194,7 +197,11 @@ protected:
                                                                   m_options.log_options, 
                                                                   result.GetErrorStream());
             if (success)
+            {
                 result.SetStatus (eReturnStatusSuccessFinishNoResult);
+                if ((m_options.log_options & LLDB_LOG_OPTION_ASYNC) && !LogWriter::GetSharedInstance().HasFreeStream())
+                    result.AppendWarningWithFormat ("Too many async logs are enabled, log records will be written synchronously.\n");
+            }
             else
                 result.SetStatus (eReturnStatusFailed);
         }    
@@ -215,6 +222,8 @@ CommandObjectLogEnable::CommandOptions::g_option_table[] =
 { LLDB_OPT_SET_1, false, "timestamp",  'T', no_argument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with a timestamp." },
 { LLDB_OPT_SET_1, false, "pid-tid",    'p', no_argument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with the process and thread ID that generates the log line." },
 { LLDB_OPT_SET_1, false, "thread-name",'n', no_argument,       NULL, 0, eArgTypeNone,       "Prepend all log lines with the thread name for the thread that generates the log line." },
+{ LLDB_OPT_SET_1, false, "async",      'a', no_argument,       NULL, 0, eArgTypeNone,       "Write log lines on a background thread so logging doesn't block the thread that generates the log line." },
+{ LLDB_OPT_SET_1, false, "binary",     'b', no_argument,       NULL, 0, eArgTypeNone,       "Write compact binary log records that can be converted to text with the 'log decode' command." },
 { 0, false, NULL,                       0,  0,                 NULL, 0, eArgTypeNone,       NULL }
 };
 
@@ -467,6 +476,73 @@ protected:
     }
 };
 
+class CommandObjectLogDecode : public CommandObjectParsed
+{
+public:
+    //------------------------------------------------------------------
+    // Constructors and Destructors
+    //------------------------------------------------------------------
+    CommandObjectLogDecode(CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "log decode",
+                             "Convert a log file that was written with 'log enable --binary' to text.",
+                             NULL)
+    {
+        CommandArgumentEntry arg;
+        CommandArgumentData file_arg;
+
+        // Define the first (and only) variant of this arg.
+        file_arg.arg_type = eArgTypeFilename;
+        file_arg.arg_repetition = eArgRepeatPlain;
+
+        // There is only one variant this argument could be; put it into the argument entry.
+        arg.push_back (file_arg);
+
+        // Push the data for the first argument into the m_arguments vector.
+        m_arguments.push_back (arg);
+    }
+
+    virtual
+    ~CommandObjectLogDecode()
+    {
+    }
+
+protected:
+    virtual bool
+    DoExecute (Args& args,
+             CommandReturnObject &result)
+    {
+        if (args.GetArgumentCount() != 1)
+        {
+            result.AppendErrorWithFormat("%s takes a log file path.\n", m_cmd_name.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        FileSpec log_file (args.GetArgumentAtIndex(0), true);
+        if (!log_file.Exists())
+        {
+            result.AppendErrorWithFormat("log file '%s' does not exist.\n", args.GetArgumentAtIndex(0));
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        // Make sure any async logs to this file have been written out
+        LogWriter::GetSharedInstance().Flush();
+
+        Error error;
+        LogWriter::DecodeBinaryLog (log_file, result.GetOutputStream(), error);
+        if (error.Fail())
+        {
+            result.AppendError (error.AsCString());
+            result.SetStatus (eReturnStatusFailed);
+        }
+        else
+            result.SetStatus (eReturnStatusSuccessFinishResult);
+        return result.Succeeded();
+    }
+};
+
 //----------------------------------------------------------------------
 // CommandObjectLog constructor
 //----------------------------------------------------------------------
@@ -480,6 +556,7 @@ CommandObjectLog::CommandObjectLog(CommandInterpreter &interpreter) :
     LoadSubCommand ("disable", CommandObjectSP (new CommandObjectLogDisable (interpreter)));
     LoadSubCommand ("list",    CommandObjectSP (new CommandObjectLogList (interpreter)));
     LoadSubCommand ("timers",  CommandObjectSP (new CommandObjectLogTimer (interpreter)));
+    LoadSubCommand ("decode",  CommandObjectSP (new CommandObjectLogDecode (interpreter)));
 }
 
 //----------------------------------------------------------------------
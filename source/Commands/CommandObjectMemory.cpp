@@ -757,6 +757,7 @@ protected:
                     .SetUseSyntheticValue(m_varobj_options.be_raw ? false : m_varobj_options.use_synth)
                     .SetOmitSummaryDepth(m_varobj_options.be_raw ? UINT32_MAX : m_varobj_options.no_summary_depth)
                     .SetIgnoreCap(m_varobj_options.be_raw ? true : m_varobj_options.ignore_cap)
+                    .SetChildrenRange(m_varobj_options.child_start, m_varobj_options.child_count)
                     .SetFormat(format)
                     .SetSummary();
                     ValueObject::DumpValueObject (*output_stream,
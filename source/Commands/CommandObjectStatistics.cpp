@@ -0,0 +1,85 @@
+//===-- CommandObjectStatistics.cpp -----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CommandObjectStatistics.h"
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Debugger.h"
+#include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Interpreter/CommandReturnObject.h"
+#include "lldb/Target/Target.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+//-------------------------------------------------------------------------
+// CommandObjectStatisticsDump
+//-------------------------------------------------------------------------
+
+class CommandObjectStatisticsDump : public CommandObjectParsed
+{
+public:
+    CommandObjectStatisticsDump (CommandInterpreter &interpreter) :
+        CommandObjectParsed (interpreter,
+                             "statistics dump",
+                             "Dump performance statistics for the current target, its process and its modules as JSON.",
+                             "statistics dump")
+    {
+    }
+
+    virtual
+    ~CommandObjectStatisticsDump ()
+    {
+    }
+
+protected:
+    virtual bool
+    DoExecute (Args& args,
+               CommandReturnObject &result)
+    {
+        if (args.GetArgumentCount() != 0)
+        {
+            result.AppendErrorWithFormat ("Usage: %s\n", m_cmd_syntax.c_str());
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        Target *target = m_interpreter.GetDebugger().GetSelectedTarget().get();
+        if (target == NULL)
+        {
+            result.AppendError ("invalid target, create a debug target using the 'target create' command");
+            result.SetStatus (eReturnStatusFailed);
+            return false;
+        }
+
+        target->DumpStatistics (result.GetOutputStream());
+        result.SetStatus (eReturnStatusSuccessFinishResult);
+        return true;
+    }
+};
+
+//-------------------------------------------------------------------------
+// CommandObjectStatistics
+//-------------------------------------------------------------------------
+
+CommandObjectStatistics::CommandObjectStatistics (CommandInterpreter &interpreter) :
+    CommandObjectMultiword (interpreter,
+                            "statistics",
+                            "A set of commands for inspecting LLDB performance statistics.",
+                            "statistics <subcommand> [<subcommand-options>]")
+{
+    LoadSubCommand ("dump", CommandObjectSP (new CommandObjectStatisticsDump (interpreter)));
+}
+
+CommandObjectStatistics::~CommandObjectStatistics ()
+{
+}
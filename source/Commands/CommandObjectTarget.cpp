@@ -620,7 +620,8 @@ public:
                .SetUseSyntheticValue(m_varobj_options.use_synth)
                .SetFlatOutput(m_varobj_options.flat_output)
                .SetOmitSummaryDepth(m_varobj_options.no_summary_depth)
-               .SetIgnoreCap(m_varobj_options.ignore_cap);
+               .SetIgnoreCap(m_varobj_options.ignore_cap)
+               .SetChildrenRange(m_varobj_options.child_start, m_varobj_options.child_count);
                 
         switch (var_sp->GetScope())
         {
@@ -0,0 +1,919 @@
+//===-- CXXFormatterFunctions.cpp -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/CXXFormatterFunctions.h"
+
+// C Includes
+#include <stdio.h>
+#include <stdlib.h>
+
+// C++ Includes
+#include <map>
+#include <set>
+#include <vector>
+
+// Other libraries and framework includes
+#include "clang/AST/Type.h"
+
+// Project includes
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Core/ValueObjectMemory.h"
+#include "lldb/Symbol/ClangASTContext.h"
+#include "lldb/Symbol/ClangASTType.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::formatters;
+
+//----------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------
+
+// The children of all the front ends in this file are named "[0]", "[1]"...
+static ConstString
+GetChildName (uint32_t idx)
+{
+    char name[32];
+    ::snprintf (name, sizeof(name), "[%u]", idx);
+    return ConstString (name);
+}
+
+static uint32_t
+ExtractIndexFromName (const ConstString &name)
+{
+    const char *name_cstr = name.GetCString();
+    if (name_cstr == NULL || name_cstr[0] != '[')
+        return UINT32_MAX;
+    char *end = NULL;
+    const unsigned long idx = ::strtoul (name_cstr + 1, &end, 10);
+    if (end == name_cstr + 1 || end[0] != ']' || end[1] != '\0' || idx >= UINT32_MAX)
+        return UINT32_MAX;
+    return idx;
+}
+
+// Follow a NULL terminated list of member names starting at valobj
+static ValueObjectSP
+GetChildAtNamePath (ValueObject &valobj, const char **path)
+{
+    ValueObjectSP child_sp;
+    ValueObject *parent = &valobj;
+    for (; *path; ++path)
+    {
+        child_sp = parent->GetChildMemberWithName (ConstString(*path), true);
+        if (!child_sp)
+            break;
+        parent = child_sp.get();
+    }
+    return child_sp;
+}
+
+static uint64_t
+GetUnsignedAtNamePath (ValueObject &valobj, const char **path, bool &success)
+{
+    ValueObjectSP child_sp (GetChildAtNamePath (valobj, path));
+    success = false;
+    if (!child_sp)
+        return 0;
+    return child_sp->GetValueAsUnsigned (0, &success);
+}
+
+// Get the type of template argument arg_idx of the (possibly typedef'ed
+// or referenced) class type of valobj
+static ClangASTType
+GetTemplateArgumentType (ValueObject &valobj, size_t arg_idx)
+{
+    clang::ASTContext *ast = valobj.GetClangAST();
+    clang_type_t clang_type = valobj.GetClangType();
+    if (ast == NULL || clang_type == NULL)
+        return ClangASTType();
+    clang::QualType qual_type (clang::QualType::getFromOpaquePtr(clang_type).getNonReferenceType().getCanonicalType());
+    TemplateArgumentKind kind = eTemplateArgumentKindNull;
+    clang_type_t arg_type = ClangASTContext::GetTemplateArgument (ast, qual_type.getAsOpaquePtr(), arg_idx, kind);
+    if (arg_type == NULL || kind != eTemplateArgumentKindType)
+        return ClangASTType();
+    return ClangASTType (ast, arg_type);
+}
+
+static uint64_t
+RoundUp (uint64_t value, uint64_t alignment)
+{
+    if (alignment <= 1)
+        return value;
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+namespace {
+
+//----------------------------------------------------------------------
+// Common base class of the container front ends. Subclasses fill in
+// the element type and figure out the address of each element, this
+// class takes care of creating and caching the child value objects.
+//----------------------------------------------------------------------
+class ContainerFrontEnd : public SyntheticChildrenFrontEnd
+{
+public:
+    ContainerFrontEnd (ValueObject &backend) :
+        SyntheticChildrenFrontEnd (backend),
+        m_process_wp (),
+        m_addr_size (0),
+        m_byte_order (eByteOrderInvalid),
+        m_element_type (),
+        m_element_size (0),
+        m_children ()
+    {
+    }
+
+    virtual
+    ~ContainerFrontEnd ()
+    {
+    }
+
+    virtual uint32_t
+    CalculateNumChildren ()
+    {
+        return CalculateNumChildrenUpTo (UINT32_MAX);
+    }
+
+    virtual lldb::ValueObjectSP
+    GetChildAtIndex (uint32_t idx, bool can_create)
+    {
+        std::map<uint32_t, ValueObjectSP>::const_iterator pos = m_children.find (idx);
+        if (pos != m_children.end())
+            return pos->second;
+        if (!can_create || m_element_size == 0)
+            return ValueObjectSP();
+        ValueObjectSP child_sp (CreateChildAtIndex (idx));
+        if (child_sp)
+            m_children[idx] = child_sp;
+        return child_sp;
+    }
+
+    virtual uint32_t
+    GetIndexOfChildWithName (const ConstString &name)
+    {
+        const uint32_t idx = ExtractIndexFromName (name);
+        if (idx == UINT32_MAX || idx >= CalculateNumChildrenUpTo (idx + 1))
+            return UINT32_MAX;
+        return idx;
+    }
+
+    virtual bool
+    Update ()
+    {
+        m_children.clear();
+        m_element_type = ClangASTType();
+        m_element_size = 0;
+        ProcessSP process_sp (m_backend.GetProcessSP());
+        m_process_wp = process_sp;
+        if (process_sp)
+        {
+            m_addr_size = process_sp->GetAddressByteSize();
+            m_byte_order = process_sp->GetByteOrder();
+        }
+        UpdateContainer ();
+        // The children are cached here, so always let ValueObjectSynthetic
+        // throw away its own cache
+        return false;
+    }
+
+protected:
+    // Read the container bookkeeping from m_backend, called by Update()
+    // with m_process_wp set (if the value lives in a process at all)
+    virtual void
+    UpdateContainer () = 0;
+
+    virtual lldb::ValueObjectSP
+    CreateChildAtIndex (uint32_t idx) = 0;
+
+    lldb::ValueObjectSP
+    CreateChildAtAddress (uint32_t idx, lldb::addr_t addr)
+    {
+        ExecutionContext exe_ctx (m_backend.GetExecutionContextRef());
+        return ValueObjectMemory::Create (exe_ctx.GetBestExecutionContextScope(),
+                                          GetChildName(idx).GetCString(),
+                                          Address (addr),
+                                          m_element_type);
+    }
+
+    bool
+    SetElementType (const ClangASTType &type)
+    {
+        m_element_type = type;
+        if (type.GetASTContext() && type.GetOpaqueQualType())
+            m_element_size = type.GetTypeByteSize();
+        else
+            m_element_size = 0;
+        return m_element_size > 0;
+    }
+
+    uint64_t
+    GetElementAlignment ()
+    {
+        const uint64_t alignment = ClangASTType::GetTypeBitAlign (m_element_type.GetASTContext(),
+                                                                  m_element_type.GetOpaqueQualType()) / 8;
+        return alignment > 0 ? alignment : 1;
+    }
+
+    // Read count consecutive pointers at addr with a single memory read
+    bool
+    ReadPointers (lldb::addr_t addr, size_t count, lldb::addr_t *pointers)
+    {
+        ProcessSP process_sp (m_process_wp.lock());
+        if (!process_sp || m_addr_size == 0 || count == 0)
+            return false;
+        const size_t byte_size = count * m_addr_size;
+        uint8_t stack_buf[64];
+        std::vector<uint8_t> heap_buf;
+        uint8_t *buf = stack_buf;
+        if (byte_size > sizeof(stack_buf))
+        {
+            heap_buf.resize (byte_size);
+            buf = &heap_buf[0];
+        }
+        Error error;
+        if (process_sp->ReadMemory (addr, buf, byte_size, error) != byte_size)
+            return false;
+        DataExtractor data (buf, byte_size, m_byte_order, m_addr_size);
+        uint32_t offset = 0;
+        for (size_t i = 0; i < count; ++i)
+            pointers[i] = data.GetPointer (&offset);
+        return true;
+    }
+
+    // Get the offset and type of the "__value_" member of the node that
+    // node_ptr_sp points to, libc++ containers only have complete node
+    // types behind their node pointers
+    bool
+    SetElementTypeFromNodePointer (const lldb::ValueObjectSP &node_ptr_sp, uint64_t &value_offset)
+    {
+        if (!node_ptr_sp)
+            return false;
+        Error error;
+        ValueObjectSP node_sp (node_ptr_sp->Dereference (error));
+        if (!node_sp || error.Fail())
+            return false;
+        ValueObjectSP value_sp (node_sp->GetChildMemberWithName (ConstString("__value_"), true));
+        if (!value_sp)
+            return false;
+        value_offset = value_sp->GetByteOffset();
+        return SetElementType (ClangASTType (value_sp->GetClangAST(), value_sp->GetClangType()));
+    }
+
+    lldb::ProcessWP m_process_wp;    // Weak so a value object that outlives its process doesn't keep it around
+    uint32_t m_addr_size;
+    lldb::ByteOrder m_byte_order;
+    ClangASTType m_element_type;
+    uint64_t m_element_size;
+    std::map<uint32_t, lldb::ValueObjectSP> m_children;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN (ContainerFrontEnd);
+};
+
+//----------------------------------------------------------------------
+// std::vector, the elements are children of the start pointer so that
+// they share its read-ahead of the pointee memory
+//----------------------------------------------------------------------
+class VectorFrontEnd : public ContainerFrontEnd
+{
+public:
+    VectorFrontEnd (ValueObject &backend, bool is_libcxx) :
+        ContainerFrontEnd (backend),
+        m_is_libcxx (is_libcxx),
+        m_start_sp (),
+        m_start (0),
+        m_count (0)
+    {
+    }
+
+    virtual uint32_t
+    CalculateNumChildrenUpTo (uint32_t max)
+    {
+        return m_count < max ? m_count : max;
+    }
+
+protected:
+    virtual void
+    UpdateContainer ()
+    {
+        m_start_sp.reset();
+        m_start = 0;
+        m_count = 0;
+
+        ValueObjectSP start_sp, finish_sp;
+        if (m_is_libcxx)
+        {
+            start_sp = m_backend.GetChildMemberWithName (ConstString("__begin_"), true);
+            finish_sp = m_backend.GetChildMemberWithName (ConstString("__end_"), true);
+        }
+        else
+        {
+            static const char *g_start_path[] = { "_M_impl", "_M_start", NULL };
+            static const char *g_finish_path[] = { "_M_impl", "_M_finish", NULL };
+            start_sp = GetChildAtNamePath (m_backend, g_start_path);
+            finish_sp = GetChildAtNamePath (m_backend, g_finish_path);
+        }
+        // std::vector<bool> uses bit iterators instead of pointers and has
+        // no children here
+        if (!start_sp || !finish_sp || !start_sp->IsPointerType())
+            return;
+        if (!SetElementType (ClangASTType (start_sp->GetClangAST(), ClangASTType::GetPointeeType (start_sp->GetClangType()))))
+            return;
+
+        const addr_t start = start_sp->GetValueAsUnsigned (0);
+        const addr_t finish = finish_sp->GetValueAsUnsigned (0);
+        if (start == 0 || finish < start || (finish - start) % m_element_size != 0)
+            return;
+        const uint64_t count = (finish - start) / m_element_size;
+        m_start_sp = start_sp;
+        m_start = start;
+        m_count = count < UINT32_MAX ? count : UINT32_MAX;
+    }
+
+    virtual lldb::ValueObjectSP
+    CreateChildAtIndex (uint32_t idx)
+    {
+        if (idx >= m_count)
+            return ValueObjectSP();
+        const uint64_t offset = idx * m_element_size;
+        if (offset > UINT32_MAX)
+            return CreateChildAtAddress (idx, m_start + offset);
+        ValueObjectSP child_sp (m_start_sp->GetSyntheticChildAtOffset (offset, m_element_type, true));
+        if (child_sp)
+            child_sp->SetName (GetChildName (idx));
+        return child_sp;
+    }
+
+    bool m_is_libcxx;
+    lldb::ValueObjectSP m_start_sp;
+    lldb::addr_t m_start;
+    uint32_t m_count;
+};
+
+//----------------------------------------------------------------------
+// Linked lists: std::list from both libraries (circular, with a
+// sentinel node) and the singly linked node list of the libc++
+// unordered containers (NULL terminated). The list is walked lazily,
+// only as far as the children that were asked for. The libc++
+// containers keep their size, so they are only walked to get at the
+// children themselves.
+//----------------------------------------------------------------------
+class LinkedListFrontEnd : public ContainerFrontEnd
+{
+public:
+    enum Kind
+    {
+        eLibstdcppList,
+        eLibcxxList,
+        eLibcxxUnordered
+    };
+
+    LinkedListFrontEnd (ValueObject &backend, Kind kind) :
+        ContainerFrontEnd (backend),
+        m_kind (kind),
+        m_end (0),
+        m_next_offset (0),
+        m_value_offset (0),
+        m_next_node (0),
+        m_nodes (),
+        m_visited (),
+        m_count (UINT32_MAX),
+        m_done (true)
+    {
+    }
+
+    virtual uint32_t
+    CalculateNumChildrenUpTo (uint32_t max)
+    {
+        // Use the size the container keeps unless walking the list has
+        // already shown that it is broken
+        if (m_count != UINT32_MAX && !m_done)
+            return m_count < max ? m_count : max;
+        FetchNodes (max);
+        uint32_t count = m_nodes.size();
+        if (m_count < count)
+            count = m_count;
+        return count < max ? count : max;
+    }
+
+protected:
+    virtual void
+    UpdateContainer ()
+    {
+        m_nodes.clear();
+        m_visited.clear();
+        m_count = UINT32_MAX;
+        m_done = true;
+
+        ValueObjectSP first_ptr_sp;
+        bool has_count = false;
+        uint64_t count = 0;
+        switch (m_kind)
+        {
+        case eLibstdcppList:
+            {
+                // _List_node<T> is a _List_node_base {next, prev} followed by T
+                static const char *g_node_path[] = { "_M_impl", "_M_node", NULL };
+                ValueObjectSP sentinel_sp (GetChildAtNamePath (m_backend, g_node_path));
+                if (!sentinel_sp || !SetElementType (GetTemplateArgumentType (m_backend, 0)))
+                    return;
+                ValueObjectSP next_sp (sentinel_sp->GetChildMemberWithName (ConstString("_M_next"), true));
+                if (!next_sp)
+                    return;
+                m_end = sentinel_sp->GetAddressOf();
+                m_next_offset = 0;
+                m_value_offset = RoundUp (2 * m_addr_size, GetElementAlignment());
+                m_next_node = next_sp->GetValueAsUnsigned (0);
+                if (m_end == LLDB_INVALID_ADDRESS)
+                    return;
+            }
+            break;
+
+        case eLibcxxList:
+            {
+                // __list_node_base is {prev, next}
+                ValueObjectSP sentinel_sp (m_backend.GetChildMemberWithName (ConstString("__end_"), true));
+                if (!sentinel_sp)
+                    return;
+                first_ptr_sp = sentinel_sp->GetChildMemberWithName (ConstString("__next_"), true);
+                if (!first_ptr_sp)
+                    return;
+                m_end = sentinel_sp->GetAddressOf();
+                m_next_offset = m_addr_size;
+                m_next_node = first_ptr_sp->GetValueAsUnsigned (0);
+                if (m_end == LLDB_INVALID_ADDRESS)
+                    return;
+                static const char *g_size_path[] = { "__size_alloc_", "__first_", NULL };
+                count = GetUnsignedAtNamePath (m_backend, g_size_path, has_count);
+            }
+            break;
+
+        case eLibcxxUnordered:
+            {
+                static const char *g_first_path[] = { "__table_", "__p1_", "__first_", "__next_", NULL };
+                first_ptr_sp = GetChildAtNamePath (m_backend, g_first_path);
+                if (!first_ptr_sp)
+                    return;
+                m_end = 0;
+                m_next_offset = 0;
+                m_next_node = first_ptr_sp->GetValueAsUnsigned (0);
+                static const char *g_size_path[] = { "__table_", "__p2_", "__first_", NULL };
+                count = GetUnsignedAtNamePath (m_backend, g_size_path, has_count);
+            }
+            break;
+        }
+
+        if (m_next_node == m_end || (has_count && count == 0))
+            return;
+        if (first_ptr_sp && !SetElementTypeFromNodePointer (first_ptr_sp, m_value_offset))
+            return;
+        if (has_count)
+            m_count = count < UINT32_MAX ? count : UINT32_MAX - 1;
+        m_done = false;
+    }
+
+    virtual lldb::ValueObjectSP
+    CreateChildAtIndex (uint32_t idx)
+    {
+        FetchNodes (idx + 1);
+        if (idx >= m_nodes.size())
+            return ValueObjectSP();
+        return CreateChildAtAddress (idx, m_nodes[idx] + m_value_offset);
+    }
+
+    void
+    FetchNodes (uint32_t max)
+    {
+        while (!m_done && m_nodes.size() < max)
+        {
+            const addr_t node = m_next_node;
+            // Seeing a node twice means the list has a loop that doesn't
+            // go through the sentinel, stop at the last new node
+            if (node == m_end || node == 0 || node == LLDB_INVALID_ADDRESS || !m_visited.insert(node).second)
+            {
+                m_done = true;
+                break;
+            }
+            addr_t next = 0;
+            if (!ReadPointers (node + m_next_offset, 1, &next))
+            {
+                m_done = true;
+                break;
+            }
+            m_nodes.push_back (node);
+            m_next_node = next;
+        }
+    }
+
+    Kind m_kind;
+    lldb::addr_t m_end;             // Address of the sentinel node, or zero for NULL terminated lists
+    uint64_t m_next_offset;         // Offset of the next pointer in each node
+    uint64_t m_value_offset;        // Offset of the element in each node
+    lldb::addr_t m_next_node;       // The next node to visit
+    std::vector<lldb::addr_t> m_nodes;
+    std::set<lldb::addr_t> m_visited;
+    uint32_t m_count;               // The size the container keeps, UINT32_MAX if it doesn't
+    bool m_done;
+};
+
+//----------------------------------------------------------------------
+// Red-black trees (std::map, std::multimap, std::set, std::multiset),
+// walked in order. All links of a node are read with a single memory
+// read and cached, since finding the successor of a node revisits its
+// parents.
+//----------------------------------------------------------------------
+class TreeFrontEnd : public ContainerFrontEnd
+{
+public:
+    TreeFrontEnd (ValueObject &backend, bool is_libcxx) :
+        ContainerFrontEnd (backend),
+        m_is_libcxx (is_libcxx),
+        m_end (0),
+        m_first (0),
+        m_count (0),
+        m_value_offset (0),
+        m_nodes (),
+        m_visited (),
+        m_links (),
+        m_done (true)
+    {
+    }
+
+    virtual uint32_t
+    CalculateNumChildrenUpTo (uint32_t max)
+    {
+        // Use the size the container keeps unless walking the tree has
+        // already shown that it is broken
+        uint32_t count = m_count;
+        if (m_done && m_nodes.size() < count)
+            count = m_nodes.size();
+        return count < max ? count : max;
+    }
+
+protected:
+    enum
+    {
+        kMaxTreeHeight = 128    // Red-black trees that fit in a 64 bit address space aren't deeper than this
+    };
+
+    struct NodeLinks
+    {
+        lldb::addr_t left;
+        lldb::addr_t right;
+        lldb::addr_t parent;
+    };
+
+    virtual void
+    UpdateContainer ()
+    {
+        m_nodes.clear();
+        m_visited.clear();
+        m_links.clear();
+        m_count = 0;
+        m_done = true;
+
+        bool success = false;
+        uint64_t count = 0;
+        if (m_is_libcxx)
+        {
+            ValueObjectSP tree_sp (m_backend.GetChildMemberWithName (ConstString("__tree_"), true));
+            if (!tree_sp)
+                return;
+            // The end node is the first member of __pair1_ and its left
+            // child is the root
+            ValueObjectSP begin_sp (tree_sp->GetChildMemberWithName (ConstString("__begin_node_"), true));
+            ValueObjectSP end_sp (tree_sp->GetChildMemberWithName (ConstString("__pair1_"), true));
+            static const char *g_size_path[] = { "__pair3_", "__first_", NULL };
+            count = GetUnsignedAtNamePath (*tree_sp, g_size_path, success);
+            if (!begin_sp || !end_sp || !success || count == 0)
+                return;
+            m_end = end_sp->GetAddressOf();
+            m_first = begin_sp->GetValueAsUnsigned (0);
+            if (m_end == LLDB_INVALID_ADDRESS || !SetElementTypeFromNodePointer (begin_sp, m_value_offset))
+                return;
+        }
+        else
+        {
+            // _Rb_tree_node<T> is a _Rb_tree_node_base {color, parent, left,
+            // right} followed by T, the header's left child is the leftmost
+            // node
+            ValueObjectSP tree_sp (m_backend.GetChildMemberWithName (ConstString("_M_t"), true));
+            if (!tree_sp)
+                return;
+            static const char *g_header_path[] = { "_M_impl", "_M_header", NULL };
+            static const char *g_size_path[] = { "_M_impl", "_M_node_count", NULL };
+            ValueObjectSP header_sp (GetChildAtNamePath (*tree_sp, g_header_path));
+            count = GetUnsignedAtNamePath (*tree_sp, g_size_path, success);
+            if (!header_sp || !success || count == 0)
+                return;
+            // _Rb_tree<Key, Value, KeyOfValue, Compare, Alloc>
+            if (!SetElementType (GetTemplateArgumentType (*tree_sp, 1)))
+                return;
+            m_end = header_sp->GetAddressOf();
+            m_value_offset = RoundUp (4 * m_addr_size, GetElementAlignment());
+            NodeLinks header_links;
+            if (m_end == LLDB_INVALID_ADDRESS || !GetNodeLinks (m_end, header_links))
+                return;
+            m_first = header_links.left;
+        }
+        m_count = count < UINT32_MAX ? count : UINT32_MAX;
+        m_done = false;
+    }
+
+    virtual lldb::ValueObjectSP
+    CreateChildAtIndex (uint32_t idx)
+    {
+        FetchNodes (idx + 1);
+        if (idx >= m_nodes.size())
+            return ValueObjectSP();
+        return CreateChildAtAddress (idx, m_nodes[idx] + m_value_offset);
+    }
+
+    bool
+    GetNodeLinks (lldb::addr_t node, NodeLinks &links)
+    {
+        std::map<lldb::addr_t, NodeLinks>::const_iterator pos = m_links.find (node);
+        if (pos != m_links.end())
+        {
+            links = pos->second;
+            return true;
+        }
+        addr_t pointers[4];
+        if (m_is_libcxx)
+        {
+            if (!ReadPointers (node, 3, pointers))
+                return false;
+            links.left = pointers[0];
+            links.right = pointers[1];
+            links.parent = pointers[2];
+        }
+        else
+        {
+            // The color is an enum, padded to the size of a pointer
+            if (!ReadPointers (node, 4, pointers))
+                return false;
+            links.parent = pointers[1];
+            links.left = pointers[2];
+            links.right = pointers[3];
+        }
+        m_links[node] = links;
+        return true;
+    }
+
+    // Get the in order successor of node, or LLDB_INVALID_ADDRESS if the
+    // tree doesn't look like a tree
+    lldb::addr_t
+    GetSuccessor (lldb::addr_t node)
+    {
+        NodeLinks links;
+        if (!GetNodeLinks (node, links))
+            return LLDB_INVALID_ADDRESS;
+        uint32_t steps = 0;
+        if (links.right != 0)
+        {
+            // The leftmost node of the right subtree
+            node = links.right;
+            while (GetNodeLinks (node, links))
+            {
+                if (links.left == 0)
+                    return node;
+                if (++steps > kMaxTreeHeight)
+                    break;
+                node = links.left;
+            }
+            return LLDB_INVALID_ADDRESS;
+        }
+        // The first ancestor whose left subtree node is in
+        while (links.parent != 0 && ++steps <= kMaxTreeHeight)
+        {
+            const addr_t parent = links.parent;
+            NodeLinks parent_links;
+            if (!GetNodeLinks (parent, parent_links))
+                break;
+            if (parent_links.left == node)
+                return parent;
+            node = parent;
+            links = parent_links;
+        }
+        return LLDB_INVALID_ADDRESS;
+    }
+
+    void
+    FetchNodes (uint32_t max)
+    {
+        if (max > m_count)
+            max = m_count;
+        while (!m_done && m_nodes.size() < max)
+        {
+            const addr_t node = m_nodes.empty() ? m_first : GetSuccessor (m_nodes.back());
+            if (node == m_end || node == 0 || node == LLDB_INVALID_ADDRESS || !m_visited.insert(node).second)
+            {
+                m_done = true;
+                break;
+            }
+            m_nodes.push_back (node);
+        }
+    }
+
+    bool m_is_libcxx;
+    lldb::addr_t m_end;             // Address of the header (libstdc++) or end node (libc++)
+    lldb::addr_t m_first;           // The leftmost node
+    uint32_t m_count;               // The size kept by the container
+    uint64_t m_value_offset;        // Offset of the element in each node
+    std::vector<lldb::addr_t> m_nodes;
+    std::set<lldb::addr_t> m_visited;
+    std::map<lldb::addr_t, NodeLinks> m_links;
+    bool m_done;
+};
+
+//----------------------------------------------------------------------
+// std::deque, the part of the block map that is in use is read with a
+// single memory read
+//----------------------------------------------------------------------
+class DequeFrontEnd : public ContainerFrontEnd
+{
+public:
+    DequeFrontEnd (ValueObject &backend, bool is_libcxx) :
+        ContainerFrontEnd (backend),
+        m_is_libcxx (is_libcxx),
+        m_count (0),
+        m_first_offset (0),
+        m_block_size (0),
+        m_blocks ()
+    {
+    }
+
+    virtual uint32_t
+    CalculateNumChildrenUpTo (uint32_t max)
+    {
+        return m_count < max ? m_count : max;
+    }
+
+protected:
+    enum
+    {
+        kMaxBlocks = 65536      // Don't read more of the block map than this
+    };
+
+    virtual void
+    UpdateContainer ()
+    {
+        m_count = 0;
+        m_blocks.clear();
+        if (!SetElementType (GetTemplateArgumentType (m_backend, 0)))
+            return;
+
+        bool success = false;
+        addr_t map_addr = 0;
+        uint64_t count = 0;
+        if (m_is_libcxx)
+        {
+            static const char *g_map_path[] = { "__map_", "__begin_", NULL };
+            static const char *g_start_path[] = { "__start_", NULL };
+            static const char *g_size_path[] = { "__size_", "__first_", NULL };
+            m_block_size = m_element_size < 256 ? 4096 / m_element_size : 16;
+            const addr_t map_begin = GetUnsignedAtNamePath (m_backend, g_map_path, success);
+            if (!success)
+                return;
+            const uint64_t start = GetUnsignedAtNamePath (m_backend, g_start_path, success);
+            if (!success)
+                return;
+            count = GetUnsignedAtNamePath (m_backend, g_size_path, success);
+            if (!success)
+                return;
+            map_addr = map_begin + (start / m_block_size) * m_addr_size;
+            m_first_offset = start % m_block_size;
+        }
+        else
+        {
+            // Each iterator is {cur, first, last, node}
+            static const char *g_start_cur[] = { "_M_impl", "_M_start", "_M_cur", NULL };
+            static const char *g_start_first[] = { "_M_impl", "_M_start", "_M_first", NULL };
+            static const char *g_start_node[] = { "_M_impl", "_M_start", "_M_node", NULL };
+            static const char *g_finish_cur[] = { "_M_impl", "_M_finish", "_M_cur", NULL };
+            static const char *g_finish_first[] = { "_M_impl", "_M_finish", "_M_first", NULL };
+            static const char *g_finish_node[] = { "_M_impl", "_M_finish", "_M_node", NULL };
+            const char **paths[] = { g_start_cur, g_start_first, g_start_node, g_finish_cur, g_finish_first, g_finish_node };
+            uint64_t values[6];
+            for (size_t i = 0; i < 6; ++i)
+            {
+                values[i] = GetUnsignedAtNamePath (m_backend, paths[i], success);
+                if (!success)
+                    return;
+            }
+            const addr_t start_cur = values[0], start_first = values[1], start_node = values[2];
+            const addr_t finish_cur = values[3], finish_first = values[4], finish_node = values[5];
+            m_block_size = m_element_size < 512 ? 512 / m_element_size : 1;
+            if (m_addr_size == 0 || finish_node < start_node || (finish_node - start_node) % m_addr_size != 0 ||
+                start_cur < start_first || finish_cur < finish_first)
+                return;
+            const uint64_t num_full_blocks = (finish_node - start_node) / m_addr_size;
+            const uint64_t end_offset = num_full_blocks * m_block_size + (finish_cur - finish_first) / m_element_size;
+            map_addr = start_node;
+            m_first_offset = (start_cur - start_first) / m_element_size;
+            if (end_offset < m_first_offset)
+                return;
+            count = end_offset - m_first_offset;
+        }
+        if (count == 0 || m_addr_size == 0)
+            return;
+
+        uint64_t num_blocks = (m_first_offset + count + m_block_size - 1) / m_block_size;
+        if (num_blocks > kMaxBlocks)
+        {
+            num_blocks = kMaxBlocks;
+            count = num_blocks * m_block_size - m_first_offset;
+        }
+        m_blocks.resize (num_blocks);
+        if (!ReadPointers (map_addr, num_blocks, &m_blocks[0]))
+        {
+            m_blocks.clear();
+            return;
+        }
+        m_count = count < UINT32_MAX ? count : UINT32_MAX;
+    }
+
+    virtual lldb::ValueObjectSP
+    CreateChildAtIndex (uint32_t idx)
+    {
+        if (idx >= m_count)
+            return ValueObjectSP();
+        const uint64_t offset = m_first_offset + idx;
+        const addr_t block = m_blocks[offset / m_block_size];
+        if (block == 0)
+            return ValueObjectSP();
+        return CreateChildAtAddress (idx, block + (offset % m_block_size) * m_element_size);
+    }
+
+    bool m_is_libcxx;
+    uint32_t m_count;
+    uint64_t m_first_offset;        // Index of the first element in the first block
+    uint64_t m_block_size;          // Number of elements per block
+    std::vector<lldb::addr_t> m_blocks;
+};
+
+} // anonymous namespace
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibstdcppVectorSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new VectorFrontEnd (backend, false);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibstdcppListSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new LinkedListFrontEnd (backend, LinkedListFrontEnd::eLibstdcppList);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibstdcppMapSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new TreeFrontEnd (backend, false);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibstdcppDequeSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new DequeFrontEnd (backend, false);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibcxxVectorSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new VectorFrontEnd (backend, true);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibcxxListSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new LinkedListFrontEnd (backend, LinkedListFrontEnd::eLibcxxList);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibcxxMapSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new TreeFrontEnd (backend, true);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibcxxDequeSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new DequeFrontEnd (backend, true);
+}
+
+SyntheticChildrenFrontEnd *
+lldb_private::formatters::LibcxxUnorderedSyntheticFrontEndCreator (ValueObject &backend)
+{
+    return new LinkedListFrontEnd (backend, LinkedListFrontEnd::eLibcxxUnordered);
+}
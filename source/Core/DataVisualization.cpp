@@ -15,6 +15,7 @@
 // Project includes
 
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Statistics.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -38,12 +39,34 @@ DataVisualization::GetCurrentRevision ()
     return GetFormatManager().GetCurrentRevision();
 }
 
+uint64_t
+DataVisualization::GetFormatCacheHits ()
+{
+    return Statistics::Get(GetFormatManager().GetFormatCacheHits());
+}
+
+uint64_t
+DataVisualization::GetFormatCacheMisses ()
+{
+    return Statistics::Get(GetFormatManager().GetFormatCacheMisses());
+}
+
+FormatterStatistics *
+DataVisualization::GetScriptedFormatterStatistics (const ConstString &name)
+{
+    return GetFormatManager().GetScriptedFormatterStatistics(name);
+}
+
+void
+DataVisualization::DumpScriptedFormatterStatistics (Stream &s)
+{
+    GetFormatManager().DumpScriptedFormatterStatistics(s);
+}
+
 lldb::TypeFormatImplSP
 DataVisualization::ValueFormats::GetFormat (ValueObject& valobj, lldb::DynamicValueType use_dynamic)
 {
-    lldb::TypeFormatImplSP entry;
-    GetFormatManager().GetValueNavigator().Get(valobj, entry, use_dynamic);
-    return entry;
+    return GetFormatManager().GetFormat(valobj, use_dynamic);
 }
 
 lldb::TypeFormatImplSP
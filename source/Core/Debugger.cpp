@@ -9,6 +9,7 @@
 
 #include "lldb/Core/Debugger.h"
 
+#include <algorithm>
 #include <map>
 
 #include "clang/AST/DeclCXX.h"
@@ -1444,6 +1445,10 @@ Debugger::FormatPrompt
                                     
                                     uint32_t max_num_children = target->GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
                                     
+                                    // Read the pointees of all the items that get displayed at once
+                                    if (is_pointer && index_lower >= 0)
+                                        target->ReadPointeeData (index_lower, index_lower + std::min<int64_t> (index_higher - index_lower + 1, max_num_children));
+                                    
                                     for (;index_lower<=index_higher;index_lower++)
                                     {
                                         ValueObject* item = ExpandIndexedExpression (target,
@@ -1476,6 +1481,7 @@ Debugger::FormatPrompt
                                         if (index_lower < index_higher)
                                             s.PutChar(',');
                                     }
+                                    target->ClearPointeeData();
                                     s.PutChar(']');
                                 }
                             }
@@ -2381,14 +2387,15 @@ Debugger::EnableLog (const char *channel, const char **categories, const char *l
     }
     else
     {
+        // Log files are closed once no log is using them anymore
         LogStreamMap::iterator pos = m_log_streams.find(log_file);
-        if (pos == m_log_streams.end())
+        if (pos != m_log_streams.end())
+            log_stream_sp = pos->second.lock();
+        if (!log_stream_sp)
         {
             log_stream_sp.reset (new StreamFile (log_file));
             m_log_streams[log_file] = log_stream_sp;
         }
-        else
-            log_stream_sp = pos->second;
     }
     assert (log_stream_sp.get());
     
@@ -10,6 +10,8 @@
 #include "lldb/Core/Disassembler.h"
 
 // C Includes
+#include <string.h>
+
 // C++ Includes
 // Other libraries and framework includes
 // Project includes
@@ -22,6 +24,7 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/RegularExpression.h"
+#include "lldb/Core/Statistics.h"
 #include "lldb/Core/Timer.h"
 #include "lldb/Interpreter/NamedOptionValue.h"
 #include "lldb/Symbol/ClangNamespaceDecl.h"
@@ -102,6 +105,99 @@ ResolveAddress (const ExecutionContext &exe_ctx,
     resolved_addr = addr;
 }
 
+//----------------------------------------------------------------------
+// Read the bytes at "start" and decode up to "num_instructions" of
+// them, copying the instructions in the disassembly cache of the module
+// that contains "start" instead when they were decoded from the same
+// bytes.
+//----------------------------------------------------------------------
+static DisassemblerSP
+DisassembleCached (const ArchSpec &arch,
+                   const char *plugin_name,
+                   const ExecutionContext &exe_ctx,
+                   const Address &start,
+                   addr_t byte_size,
+                   uint32_t num_instructions,
+                   Stream *error_strm_ptr)
+{
+    DisassemblerSP disasm_sp;
+    Target *target = exe_ctx.GetTargetPtr();
+    if (target == NULL)
+    {
+        if (error_strm_ptr)
+            error_strm_ptr->PutCString("error: invalid execution context\n");
+        return disasm_sp;
+    }
+    if (byte_size == 0 || num_instructions == 0 || !start.IsValid())
+        return disasm_sp;
+
+    DataBufferHeap *heap_buffer = new DataBufferHeap (byte_size, '\0');
+    DataBufferSP data_sp (heap_buffer);
+
+    // Prefer the file cache so that breakpoint opcodes never end up in
+    // the bytes we decode (or compare against the cache)
+    Error error;
+    const bool prefer_file_cache = true;
+    const size_t bytes_read = target->ReadMemory (start,
+                                                  prefer_file_cache,
+                                                  heap_buffer->GetBytes(),
+                                                  heap_buffer->GetByteSize(),
+                                                  error);
+    if (bytes_read == 0)
+    {
+        if (error_strm_ptr)
+        {
+            const char *error_cstr = error.AsCString();
+            if (error_cstr)
+                error_strm_ptr->Printf("error: %s\n", error_cstr);
+        }
+        return disasm_sp;
+    }
+    if (bytes_read != heap_buffer->GetByteSize())
+        heap_buffer->SetByteSize (bytes_read);
+    DataExtractor data (data_sp,
+                        arch.GetByteOrder(),
+                        arch.GetAddressByteSize());
+
+    // Every caller gets a disassembler and instructions of its own, the
+    // strings of an instruction depend on the execution context they
+    // are calculated in
+    disasm_sp.reset (Disassembler::FindPlugin (arch, plugin_name));
+    if (!disasm_sp)
+        return disasm_sp;
+
+    // Only addresses in a module can be cached, since they need to be
+    // described by a file address
+    ModuleSP module_sp (start.GetModule());
+    DisassemblyCache *cache = module_sp ? &module_sp->GetDisassemblyCache() : NULL;
+    const addr_t file_addr = start.GetFileAddress();
+    if (cache)
+    {
+        if (cache->CopyInstructions (arch, plugin_name, file_addr, num_instructions, data, *disasm_sp))
+        {
+            Statistics::Increment (module_sp->GetStatistics().num_disassembly_cache_hits);
+            return disasm_sp;
+        }
+        Statistics::Increment (module_sp->GetStatistics().num_disassembly_cache_misses);
+    }
+
+    if (disasm_sp->DecodeInstructions (start, data, 0, num_instructions, false) == 0)
+    {
+        disasm_sp.reset();
+        return disasm_sp;
+    }
+
+    // Cache copies made before any strings were calculated, the
+    // caller's instructions stay its own
+    if (cache)
+    {
+        DisassemblerSP cached_disasm_sp (Disassembler::FindPlugin (arch, plugin_name));
+        if (cached_disasm_sp && cached_disasm_sp->CopyInstructions (*disasm_sp) > 0)
+            cache->Insert (arch, plugin_name, file_addr, num_instructions, data, cached_disasm_sp);
+    }
+    return disasm_sp;
+}
+
 size_t
 Disassembler::Disassemble
 (
@@ -218,19 +314,13 @@ Disassembler::DisassembleRange
     const AddressRange &range
 )
 {
-    lldb::DisassemblerSP disasm_sp;
-    if (range.GetByteSize() > 0 && range.GetBaseAddress().IsValid())
-    {
-        disasm_sp.reset (Disassembler::FindPlugin(arch, plugin_name));
-
-        if (disasm_sp)
-        {
-            size_t bytes_disassembled = disasm_sp->ParseInstructions (&exe_ctx, range, NULL);
-            if (bytes_disassembled == 0)
-                disasm_sp.reset();
-        }
-    }
-    return disasm_sp;
+    return DisassembleCached (arch,
+                              plugin_name,
+                              exe_ctx,
+                              range.GetBaseAddress(),
+                              range.GetByteSize(),
+                              UINT32_MAX,
+                              NULL);
 }
 
 lldb::DisassemblerSP 
@@ -282,19 +372,19 @@ Disassembler::Disassemble
 {
     if (disasm_range.GetByteSize())
     {
-        std::auto_ptr<Disassembler> disasm_ap (Disassembler::FindPlugin(arch, plugin_name));
-
-        if (disasm_ap.get())
+        Address addr;
+        ResolveAddress (exe_ctx, disasm_range.GetBaseAddress(), addr);
+
+        DisassemblerSP disasm_sp (DisassembleCached (arch,
+                                                     plugin_name,
+                                                     exe_ctx,
+                                                     addr,
+                                                     disasm_range.GetByteSize(),
+                                                     UINT32_MAX,
+                                                     &strm));
+        if (disasm_sp)
         {
-            AddressRange range;
-            ResolveAddress (exe_ctx, disasm_range.GetBaseAddress(), range.GetBaseAddress());
-            range.SetByteSize (disasm_range.GetByteSize());
-            
-            size_t bytes_disassembled = disasm_ap->ParseInstructions (&exe_ctx, range, &strm);
-            if (bytes_disassembled == 0)
-                return false;
-
-            return PrintInstructions (disasm_ap.get(),
+            return PrintInstructions (disasm_sp.get(),
                                       debugger,
                                       arch,
                                       exe_ctx,
@@ -323,16 +413,20 @@ Disassembler::Disassemble
 {
     if (num_instructions > 0)
     {
-        std::auto_ptr<Disassembler> disasm_ap (Disassembler::FindPlugin(arch, plugin_name));
-        if (disasm_ap.get())
+        Address addr;
+        ResolveAddress (exe_ctx, start_address, addr);
+
+        // Read enough bytes for the largest opcodes of this architecture
+        DisassemblerSP disasm_sp (DisassembleCached (arch,
+                                                     plugin_name,
+                                                     exe_ctx,
+                                                     addr,
+                                                     num_instructions * arch.GetMaximumOpcodeByteSize(),
+                                                     num_instructions,
+                                                     NULL));
+        if (disasm_sp)
         {
-            Address addr;
-            ResolveAddress (exe_ctx, start_address, addr);
-
-            size_t bytes_disassembled = disasm_ap->ParseInstructions (&exe_ctx, addr, num_instructions);
-            if (bytes_disassembled == 0)
-                return false;
-            return PrintInstructions (disasm_ap.get(),
+            return PrintInstructions (disasm_sp.get(),
                                       debugger,
                                       arch,
                                       exe_ctx,
@@ -1122,6 +1216,14 @@ Disassembler::~Disassembler()
 {
 }
 
+size_t
+Disassembler::CopyInstructions (Disassembler &source)
+{
+    // Plug-ins that can't copy their instructions decode them again
+    m_instruction_list.Clear();
+    return 0;
+}
+
 InstructionList &
 Disassembler::GetInstructionList ()
 {
@@ -1206,3 +1308,135 @@ PseudoInstruction::SetDescription (const char *description)
     if (description && strlen (description) > 0)
         m_description = description;
 }
+
+//----------------------------------------------------------------------
+// DisassemblyCache
+//----------------------------------------------------------------------
+
+// The most memory the instructions cached for one module may use
+static const size_t g_max_disassembly_cache_byte_size = 4 * 1024 * 1024;
+
+// Instructions are opaque plug-in objects, so their memory use (the
+// object and any plug-in state) is estimated
+static const size_t g_estimated_instruction_byte_size = 256;
+
+DisassemblyCache::DisassemblyCache () :
+    m_mutex (Mutex::eMutexTypeNormal),
+    m_entries (),
+    m_entry_map (),
+    m_byte_size (0)
+{
+}
+
+DisassemblyCache::~DisassemblyCache ()
+{
+}
+
+bool
+DisassemblyCache::CopyInstructions (const ArchSpec &arch,
+                                    const char *plugin_name,
+                                    addr_t file_addr,
+                                    uint32_t num_instructions,
+                                    const DataExtractor &data,
+                                    Disassembler &disasm)
+{
+    if (file_addr == LLDB_INVALID_ADDRESS)
+        return false;
+
+    Key key;
+    key.file_addr = file_addr;
+    key.byte_size = data.GetByteSize();
+    key.num_instructions = num_instructions;
+
+    Mutex::Locker locker (m_mutex);
+    EntryMap::iterator pos = m_entry_map.find (key);
+    if (pos == m_entry_map.end())
+        return false;
+
+    const Entry &entry = *pos->second;
+    if (entry.arch != arch ||
+        entry.plugin_name != ConstString (plugin_name) ||
+        ::memcmp (&entry.bytes[0], data.GetDataStart(), entry.bytes.size()) != 0)
+    {
+        // The code or the way it would be decoded changed since these
+        // instructions were cached, the caller will insert new ones
+        RemoveEntry (pos);
+        return false;
+    }
+
+    // Copy while holding the lock, so only one thread at a time ever
+    // looks at the cached instructions
+    if (disasm.CopyInstructions (*entry.disasm_sp) == 0)
+        return false;
+
+    // Move the entry to the front of the least recently used list
+    m_entries.splice (m_entries.begin(), m_entries, pos->second);
+    return true;
+}
+
+void
+DisassemblyCache::Insert (const ArchSpec &arch,
+                          const char *plugin_name,
+                          addr_t file_addr,
+                          uint32_t num_instructions,
+                          const DataExtractor &data,
+                          const DisassemblerSP &disasm_sp)
+{
+    const size_t byte_size = data.GetByteSize();
+    if (!disasm_sp || file_addr == LLDB_INVALID_ADDRESS || byte_size == 0)
+        return;
+
+    const size_t accounted_size = sizeof(Entry) + byte_size +
+        disasm_sp->GetInstructionList().GetSize() * g_estimated_instruction_byte_size;
+    // Don't flush the whole cache for something that won't fit anyway
+    if (accounted_size > g_max_disassembly_cache_byte_size / 4)
+        return;
+
+    Key key;
+    key.file_addr = file_addr;
+    key.byte_size = byte_size;
+    key.num_instructions = num_instructions;
+
+    Mutex::Locker locker (m_mutex);
+    EntryMap::iterator pos = m_entry_map.find (key);
+    if (pos != m_entry_map.end())
+        RemoveEntry (pos);
+
+    while (!m_entries.empty() && m_byte_size + accounted_size > g_max_disassembly_cache_byte_size)
+        RemoveEntry (m_entry_map.find (m_entries.back().key));
+
+    m_entries.push_front (Entry());
+    Entry &entry = m_entries.front();
+    entry.key = key;
+    entry.arch = arch;
+    entry.plugin_name.SetCString (plugin_name);
+    entry.bytes.assign (data.GetDataStart(), data.GetDataStart() + byte_size);
+    entry.disasm_sp = disasm_sp;
+    entry.accounted_size = accounted_size;
+    m_entry_map[key] = m_entries.begin();
+    m_byte_size += accounted_size;
+}
+
+void
+DisassemblyCache::RemoveEntry (EntryMap::iterator pos)
+{
+    m_byte_size -= pos->second->accounted_size;
+    m_entries.erase (pos->second);
+    m_entry_map.erase (pos);
+}
+
+void
+DisassemblyCache::Clear ()
+{
+    Mutex::Locker locker (m_mutex);
+    m_entries.clear();
+    m_entry_map.clear();
+    m_byte_size = 0;
+}
+
+size_t
+DisassemblyCache::GetByteSize () const
+{
+    Mutex::Locker locker (m_mutex);
+    return m_byte_size;
+}
@@ -17,6 +17,7 @@
 #include "lldb/lldb-public.h"
 #include "lldb/lldb-enumerations.h"
 
+#include "lldb/Core/DataVisualization.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/FormatClasses.h"
 #include "lldb/Core/StreamString.h"
@@ -166,7 +167,8 @@ ScriptSummaryFormat::ScriptSummaryFormat(const TypeSummaryImpl::Flags& flags,
     TypeSummaryImpl(flags),
     m_function_name(),
     m_python_script(),
-    m_script_function_sp()
+    m_script_function_sp(),
+    m_stats(NULL)
 {
    if (function_name)
      m_function_name.assign(function_name);
@@ -195,6 +197,11 @@ ScriptSummaryFormat::FormatObject(ValueObject *valobj,
         retval.assign("error: no ScriptInterpreter");
         return false;
     }
+    
+    if (m_stats == NULL)
+        m_stats = DataVisualization::GetScriptedFormatterStatistics(ConstString(m_function_name.c_str()));
+    Statistics::Increment(m_stats->python_calls);
+    StatsTimer python_timer(&m_stats->python_nsec);
         
     return script_interpreter->GetScriptedSummary(m_function_name.c_str(),
                                                   valobj->GetSP(),
@@ -266,13 +273,29 @@ SyntheticArrayView::GetDescription()
     return sstr.GetString();
 }
 
+std::string
+CXXSyntheticChildren::GetDescription()
+{
+    StreamString sstr;
+    sstr.Printf("%s%s%s %s",
+                Cascades() ? "" : " (not cascading)",
+                SkipsPointers() ? " (skip pointers)" : "",
+                SkipsReferences() ? " (skip references)" : "",
+                m_description.c_str());
+    return sstr.GetString();
+}
+
 #ifndef LLDB_DISABLE_PYTHON
 
 TypeSyntheticImpl::FrontEnd::FrontEnd(std::string pclass, ValueObject &backend) :
     SyntheticChildrenFrontEnd(backend),
     m_python_class(pclass),
     m_wrapper_sp(),
-    m_interpreter(NULL)
+    m_interpreter(NULL),
+    m_stats(DataVisualization::GetScriptedFormatterStatistics(ConstString(pclass.c_str()))),
+    m_child_batch(),
+    m_child_batch_start(0),
+    m_can_batch(true)
 {
     if (backend == NULL)
         return;
@@ -285,22 +308,76 @@ TypeSyntheticImpl::FrontEnd::FrontEnd(std::string pclass, ValueObject &backend)
     m_interpreter = target_sp->GetDebugger().GetCommandInterpreter().GetScriptInterpreter();
     
     if (m_interpreter != NULL)
+    {
+        Statistics::Increment(m_stats->python_calls);
+        StatsTimer python_timer(&m_stats->python_nsec);
         m_wrapper_sp = m_interpreter->CreateSyntheticScriptedProvider(m_python_class, backend.GetSP());
+    }
 }
 
 TypeSyntheticImpl::FrontEnd::~FrontEnd()
 {
 }
 
+uint32_t
+TypeSyntheticImpl::FrontEnd::CalculateNumChildrenUpTo (uint32_t max)
+{
+    if (!m_wrapper_sp || m_interpreter == NULL)
+        return 0;
+    Statistics::Increment(m_stats->python_calls);
+    StatsTimer python_timer(&m_stats->python_nsec);
+    return m_interpreter->CalculateNumChildren(m_wrapper_sp, max);
+}
+
 lldb::ValueObjectSP
 TypeSyntheticImpl::FrontEnd::GetChildAtIndex (uint32_t idx, bool can_create)
 {
     if (!m_wrapper_sp || !m_interpreter)
         return lldb::ValueObjectSP();
     
+    if (idx >= m_child_batch_start && idx - m_child_batch_start < m_child_batch.size())
+        return m_child_batch[idx - m_child_batch_start];
+    
+    Statistics::Increment(m_stats->python_calls);
+    StatsTimer python_timer(&m_stats->python_nsec);
+    
+    if (m_can_batch)
+    {
+        // Children are usually asked for in order, so get this one and the
+        // ones after it in a single call into the provider
+        m_child_batch.clear();
+        m_child_batch_start = idx;
+        if (m_interpreter->GetChildrenInRange(m_wrapper_sp, idx, kChildBatchSize, m_child_batch))
+            return m_child_batch.empty() ? lldb::ValueObjectSP() : m_child_batch[0];
+        m_child_batch.clear();
+        m_can_batch = false;
+    }
+    
     return m_interpreter->GetChildAtIndex(m_wrapper_sp, idx);
 }
 
+bool
+TypeSyntheticImpl::FrontEnd::Update()
+{
+    if (!m_wrapper_sp || m_interpreter == NULL)
+        return false;
+    
+    m_child_batch.clear();
+    Statistics::Increment(m_stats->python_calls);
+    StatsTimer python_timer(&m_stats->python_nsec);
+    return m_interpreter->UpdateSynthProviderInstance(m_wrapper_sp);
+}
+
+uint32_t
+TypeSyntheticImpl::FrontEnd::GetIndexOfChildWithName (const ConstString &name)
+{
+    if (!m_wrapper_sp || m_interpreter == NULL)
+        return UINT32_MAX;
+    Statistics::Increment(m_stats->python_calls);
+    StatsTimer python_timer(&m_stats->python_nsec);
+    return m_interpreter->GetIndexOfChildWithName(m_wrapper_sp, name.GetCString());
+}
+
 std::string
 TypeSyntheticImpl::GetDescription()
 {
@@ -14,7 +14,9 @@
 // Other libraries and framework includes
 // Project includes
 
+#include "lldb/Core/CXXFormatterFunctions.h"
 #include "lldb/Core/Debugger.h"
+#include "lldb/Core/Statistics.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -445,6 +447,204 @@ CategoryMap::GetSummaryFormat (ValueObject& valobj,
     return lldb::TypeSummaryImplSP();
 }
 
+bool
+FormatManager::GetFormatCacheKey (ValueObject& valobj,
+                                  lldb::DynamicValueType use_dynamic,
+                                  FormatCacheKey &key)
+{
+    key.clang_type = valobj.GetClangType();
+    key.bitfield_bit_size = valobj.GetBitfieldBitSize();
+    key.use_dynamic = use_dynamic;
+    if (key.clang_type == NULL)
+        return false;
+    if (use_dynamic == lldb::eNoDynamicValues)
+        return true;
+    // With dynamic values on, the navigators look up the runtime class of
+    // Objective-C objects (see FormatNavigator::Get_ObjC), which depends on
+    // the value and not just on its type. Pointers and references to those
+    // are followed the same way.
+    clang::QualType type = clang::QualType::getFromOpaquePtr(key.clang_type);
+    while (!type.isNull())
+    {
+        const clang::Type *type_ptr = type.getCanonicalType().getTypePtrOrNull();
+        if (type_ptr == NULL)
+            return true;
+        if (type_ptr->isObjCObjectPointerType() || type_ptr->isObjCObjectType())
+            return false;
+        if (type_ptr->isReferenceType())
+            type = type.getNonReferenceType();
+        else if (type_ptr->isPointerType())
+            type = type_ptr->getPointeeType();
+        else
+            return true;
+    }
+    return true;
+}
+
+FormatManager::FormatCacheEntry *
+FormatManager::FindFormatCacheEntry (const FormatCacheKey &key,
+                                     const ConstString &type_name,
+                                     uint32_t revision,
+                                     bool can_create)
+{
+    if (m_format_cache_revision != revision)
+    {
+        // The results would only have been stored if nothing changed
+        // since the lookup started
+        if (can_create)
+            return NULL;
+        m_format_cache.clear();
+        m_format_cache_revision = revision;
+    }
+    FormatCache::iterator pos = m_format_cache.find(key);
+    if (pos != m_format_cache.end())
+    {
+        // The clang type pointer may have been reused by a type from
+        // another module since the entry was made
+        if (pos->second.type_name == type_name)
+            return &pos->second;
+        m_format_cache.erase(pos);
+    }
+    if (!can_create)
+        return NULL;
+    FormatCacheEntry &entry = m_format_cache[key];
+    entry.type_name = type_name;
+    return &entry;
+}
+
+// The categories are searched without holding m_format_cache_mutex since
+// summary and synthetic lookups can end up calling into Python, and the
+// result is only stored if nothing changed in the meantime.
+lldb::TypeFormatImplSP
+FormatManager::GetFormat (ValueObject& valobj,
+                          lldb::DynamicValueType use_dynamic)
+{
+    FormatCacheKey key;
+    const bool cacheable = GetFormatCacheKey(valobj, use_dynamic, key);
+    const uint32_t revision = GetCurrentRevision();
+    ConstString type_name;
+    if (cacheable)
+    {
+        type_name = valobj.GetTypeName();
+        Mutex::Locker locker(m_format_cache_mutex);
+        FormatCacheEntry *entry = FindFormatCacheEntry(key, type_name, revision, false);
+        if (entry && entry->has_format)
+        {
+            Statistics::Increment(m_format_cache_hits);
+            return entry->format_sp;
+        }
+    }
+    Statistics::Increment(m_format_cache_misses);
+    lldb::TypeFormatImplSP format_sp;
+    m_value_nav.Get(valobj, format_sp, use_dynamic);
+    if (cacheable)
+    {
+        Mutex::Locker locker(m_format_cache_mutex);
+        FormatCacheEntry *entry = FindFormatCacheEntry(key, type_name, revision, true);
+        if (entry)
+        {
+            entry->format_sp = format_sp;
+            entry->has_format = true;
+        }
+    }
+    return format_sp;
+}
+
+lldb::TypeSummaryImplSP
+FormatManager::GetSummaryFormat (ValueObject& valobj,
+                                 lldb::DynamicValueType use_dynamic)
+{
+    FormatCacheKey key;
+    const bool cacheable = GetFormatCacheKey(valobj, use_dynamic, key);
+    const uint32_t revision = GetCurrentRevision();
+    ConstString type_name;
+    if (cacheable)
+    {
+        type_name = valobj.GetTypeName();
+        Mutex::Locker locker(m_format_cache_mutex);
+        FormatCacheEntry *entry = FindFormatCacheEntry(key, type_name, revision, false);
+        if (entry && entry->has_summary)
+        {
+            Statistics::Increment(m_format_cache_hits);
+            return entry->summary_sp;
+        }
+    }
+    Statistics::Increment(m_format_cache_misses);
+    lldb::TypeSummaryImplSP summary_sp (m_categories_map.GetSummaryFormat(valobj, use_dynamic));
+    if (cacheable)
+    {
+        Mutex::Locker locker(m_format_cache_mutex);
+        FormatCacheEntry *entry = FindFormatCacheEntry(key, type_name, revision, true);
+        if (entry)
+        {
+            entry->summary_sp = summary_sp;
+            entry->has_summary = true;
+        }
+    }
+    return summary_sp;
+}
+
+#ifndef LLDB_DISABLE_PYTHON
+lldb::SyntheticChildrenSP
+FormatManager::GetSyntheticChildren (ValueObject& valobj,
+                                     lldb::DynamicValueType use_dynamic)
+{
+    FormatCacheKey key;
+    const bool cacheable = GetFormatCacheKey(valobj, use_dynamic, key);
+    const uint32_t revision = GetCurrentRevision();
+    ConstString type_name;
+    if (cacheable)
+    {
+        type_name = valobj.GetTypeName();
+        Mutex::Locker locker(m_format_cache_mutex);
+        FormatCacheEntry *entry = FindFormatCacheEntry(key, type_name, revision, false);
+        if (entry && entry->has_synthetic)
+        {
+            Statistics::Increment(m_format_cache_hits);
+            return entry->synthetic_sp;
+        }
+    }
+    Statistics::Increment(m_format_cache_misses);
+    lldb::SyntheticChildrenSP synthetic_sp (m_categories_map.GetSyntheticChildren(valobj, use_dynamic));
+    if (cacheable)
+    {
+        Mutex::Locker locker(m_format_cache_mutex);
+        FormatCacheEntry *entry = FindFormatCacheEntry(key, type_name, revision, true);
+        if (entry)
+        {
+            entry->synthetic_sp = synthetic_sp;
+            entry->has_synthetic = true;
+        }
+    }
+    return synthetic_sp;
+}
+#endif
+
+FormatterStatistics *
+FormatManager::GetScriptedFormatterStatistics (const ConstString &name)
+{
+    Mutex::Locker locker(m_formatter_stats_mutex);
+    // std::map never moves its values, so the pointer stays valid
+    return &m_formatter_stats[name];
+}
+
+void
+FormatManager::DumpScriptedFormatterStatistics (Stream &s)
+{
+    Mutex::Locker locker(m_formatter_stats_mutex);
+    s.PutCString ("[");
+    std::map<ConstString, FormatterStatistics>::const_iterator pos, end = m_formatter_stats.end();
+    for (pos = m_formatter_stats.begin(); pos != end; ++pos)
+    {
+        s.PutCString (pos == m_formatter_stats.begin() ? "\n    { \"name\": " : ",\n    { \"name\": ");
+        Statistics::PutJSONString (s, pos->first.GetCString());
+        s.Printf (", \"python_calls\": %llu, \"python_seconds\": ", Statistics::Get (pos->second.python_calls));
+        Statistics::PutJSONSeconds (s, Statistics::Get (pos->second.python_nsec));
+        s.PutCString (" }");
+    }
+    s.PutCString (m_formatter_stats.empty() ? "]" : "\n  ]");
+}
+
 lldb::TypeSummaryImplSP
 FormatManager::GetSummaryForType (lldb::TypeNameSpecifierImplSP type_sp)
 {
@@ -514,7 +714,11 @@ FormatManager::GetSyntheticForType (lldb::TypeNameSpecifierImplSP type_sp)
         category_sp = GetCategoryAtIndex(category_id);
         if (category_sp->IsEnabled() == false)
             continue;
-        lldb::TypeSyntheticImplSP synth_current_sp((TypeSyntheticImpl*)category_sp->GetSyntheticForType(type_sp).get());
+        // built-in synthetic children share the navigator but have no Python class
+        lldb::SyntheticChildrenSP children_sp(category_sp->GetSyntheticForType(type_sp));
+        if (!children_sp || !children_sp->IsScripted())
+            continue;
+        lldb::TypeSyntheticImplSP synth_current_sp(STD_STATIC_POINTER_CAST(TypeSyntheticImpl,children_sp));
         if (synth_current_sp && (synth_chosen_sp.get() == NULL || (prio_category > category_sp->GetEnabledPosition())))
         {
             prio_category = category_sp->GetEnabledPosition();
@@ -674,10 +878,19 @@ FormatManager::FormatManager() :
     m_named_summaries_map(this),
     m_last_revision(0),
     m_categories_map(this),
+    m_format_cache_mutex(),
+    m_format_cache(),
+    m_format_cache_revision(0),
+    m_format_cache_hits(0),
+    m_format_cache_misses(0),
+    m_formatter_stats_mutex(),
+    m_formatter_stats(),
     m_default_category_name(ConstString("default")),
     m_system_category_name(ConstString("system")), 
     m_gnu_cpp_category_name(ConstString("gnu-libstdc++")),
     m_libcxx_category_name(ConstString("libcxx")),
+    m_gnu_cpp_python_category_name(ConstString("gnu-libstdc++-python")),
+    m_libcxx_python_category_name(ConstString("libcxx-python")),
     m_objc_category_name(ConstString("objc")),
     m_corefoundation_category_name(ConstString("CoreFoundation")),
     m_coregraphics_category_name(ConstString("CoreGraphics")),
@@ -737,25 +950,49 @@ FormatManager::LoadSTLFormatters()
     stl_synth_flags.SetCascades(true).SetSkipPointers(false).SetSkipReferences(false);
     
     gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::vector<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdVectorSynthProvider")));
-    gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::map<.+> >(( )?&)?$")),
-                                                       SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdMapSynthProvider")));
+                                                       SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                    "libstdc++ std::vector synthetic children",
+                                                                                                    formatters::LibstdcppVectorSyntheticFrontEndCreator)));
+    gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::(multi)?(map|set)<.+> >(( )?&)?$")),
+                                                       SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                    "libstdc++ std::map synthetic children",
+                                                                                                    formatters::LibstdcppMapSyntheticFrontEndCreator)));
     gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::list<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.gnu_libstdcpp.StdListSynthProvider")));
+                                                       SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                    "libstdc++ std::list synthetic children",
+                                                                                                    formatters::LibstdcppListSyntheticFrontEndCreator)));
+    gnu_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::deque<.+>(( )?&)?$")),
+                                                       SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                    "libstdc++ std::deque synthetic children",
+                                                                                                    formatters::LibstdcppDequeSyntheticFrontEndCreator)));
+    
+    // The Python implementations of the above, "type category enable gnu-libstdc++-python"
+    // gives them priority over the built-in ones
+    TypeCategoryImpl::SharedPointer gnu_python_category_sp = GetCategory(m_gnu_cpp_python_category_name);
+    
+    gnu_python_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::vector<.+>(( )?&)?$")),
+                                                              SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
+                                                                                                        "lldb.formatters.cpp.gnu_libstdcpp.StdVectorSynthProvider")));
+    gnu_python_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::map<.+> >(( )?&)?$")),
+                                                              SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
+                                                                                                        "lldb.formatters.cpp.gnu_libstdcpp.StdMapSynthProvider")));
+    gnu_python_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::list<.+>(( )?&)?$")),
+                                                              SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
+                                                                                                        "lldb.formatters.cpp.gnu_libstdcpp.StdListSynthProvider")));
     
     stl_summary_flags.SetDontShowChildren(false);
     gnu_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::vector<.+>(( )?&)?$")),
                                                      TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
                                                                                                "size=${svar%#}")));
-    gnu_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::map<.+> >(( )?&)?$")),
+    gnu_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::(multi)?(map|set)<.+> >(( )?&)?$")),
                                                      TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
                                                                                                "size=${svar%#}")));
     gnu_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::list<.+>(( )?&)?$")),
                                                      TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
                                                                                                "size=${svar%#}")));
+    gnu_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::deque<.+>(( )?&)?$")),
+                                                     TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags,
+                                                                                               "size=${svar%#}")));
 #endif
 }
 
@@ -786,21 +1023,50 @@ FormatManager::LoadLibcxxFormatters()
     stl_synth_flags.SetCascades(true).SetSkipPointers(false).SetSkipReferences(false);
     
     libcxx_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::vector<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.libcxx.stdvector_SynthProvider")));
+                                                          SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                       "libc++ std::vector synthetic children",
+                                                                                                       formatters::LibcxxVectorSyntheticFrontEndCreator)));
     libcxx_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::list<.+>(( )?&)?$")),
-                                                       SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.libcxx.stdlist_SynthProvider")));
-    libcxx_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::map<.+> >(( )?&)?$")),
-                                                       SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
-                                                                                                 "lldb.formatters.cpp.libcxx.stdmap_SynthProvider")));
+                                                          SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                       "libc++ std::list synthetic children",
+                                                                                                       formatters::LibcxxListSyntheticFrontEndCreator)));
+    libcxx_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::(multi)?(map|set)<.+> >(( )?&)?$")),
+                                                          SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                       "libc++ std::map synthetic children",
+                                                                                                       formatters::LibcxxMapSyntheticFrontEndCreator)));
+    libcxx_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::deque<.+>(( )?&)?$")),
+                                                          SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                       "libc++ std::deque synthetic children",
+                                                                                                       formatters::LibcxxDequeSyntheticFrontEndCreator)));
+    libcxx_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::unordered_(multi)?(map|set)<.+> >(( )?&)?$")),
+                                                          SyntheticChildrenSP(new CXXSyntheticChildren(stl_synth_flags,
+                                                                                                       "libc++ std::unordered containers synthetic children",
+                                                                                                       formatters::LibcxxUnorderedSyntheticFrontEndCreator)));
+    
+    // The Python implementations of the above, "type category enable libcxx-python"
+    // gives them priority over the built-in ones
+    TypeCategoryImpl::SharedPointer libcxx_python_category_sp = GetCategory(m_libcxx_python_category_name);
+    
+    libcxx_python_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::vector<.+>(( )?&)?$")),
+                                                                 SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
+                                                                                                           "lldb.formatters.cpp.libcxx.stdvector_SynthProvider")));
+    libcxx_python_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::list<.+>(( )?&)?$")),
+                                                                 SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
+                                                                                                           "lldb.formatters.cpp.libcxx.stdlist_SynthProvider")));
+    libcxx_python_category_sp->GetRegexSyntheticNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::map<.+> >(( )?&)?$")),
+                                                                 SyntheticChildrenSP(new TypeSyntheticImpl(stl_synth_flags,
+                                                                                                           "lldb.formatters.cpp.libcxx.stdmap_SynthProvider")));
     
     stl_summary_flags.SetDontShowChildren(false);
     libcxx_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::vector<.+>(( )?&)?")),
                                                         TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags, "size=${svar%#}")));
     libcxx_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::list<.+>(( )?&)?$")),
                                                         TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags, "size=${svar%#}")));
-    libcxx_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::map<.+> >(( )?&)?$")),
+    libcxx_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::(multi)?(map|set)<.+> >(( )?&)?$")),
+                                                        TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags, "size=${svar%#}")));
+    libcxx_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::deque<.+>(( )?&)?$")),
+                                                        TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags, "size=${svar%#}")));
+    libcxx_category_sp->GetRegexSummaryNavigator()->Add(RegularExpressionSP(new RegularExpression("^std::__1::unordered_(multi)?(map|set)<.+> >(( )?&)?$")),
                                                         TypeSummaryImplSP(new StringSummaryFormat(stl_summary_flags, "size=${svar%#}")));
 #endif
 }
@@ -29,6 +29,9 @@ Listener::Listener(const char *name) :
     m_broadcasters(),
     m_broadcasters_mutex (Mutex::eMutexTypeRecursive),
     m_events (),
+    m_events_index (),
+    m_next_event_sequence (0),
+    m_pending_events (NULL),
     m_events_mutex (Mutex::eMutexTypeRecursive),
     m_cond_wait()
 {
@@ -63,7 +66,9 @@ Listener::Clear()
     m_cond_wait.SetValue (false, eBroadcastNever);
     m_broadcasters.clear();
     Mutex::Locker event_locker(m_events_mutex);
+    MovePendingEvents ();
     m_events.clear();
+    m_events_index.clear();
 }
 
 uint32_t
@@ -154,18 +159,23 @@ Listener::BroadcasterWillDestruct (Broadcaster *broadcaster)
     // Scope for "event_locker"
     {
         Mutex::Locker event_locker(m_events_mutex);
+        MovePendingEvents ();
         // Remove all events for this broadcaster object.
-        event_collection::iterator pos = m_events.begin();
-        while (pos != m_events.end())
+        event_broadcaster_index::iterator index_pos = m_events_index.find (broadcaster);
+        if (index_pos != m_events_index.end())
         {
-            if ((*pos)->GetBroadcaster() == broadcaster)
-                pos = m_events.erase(pos);
-            else
-                ++pos;
+            event_type_index::iterator type_pos, type_end = index_pos->second.end();
+            for (type_pos = index_pos->second.begin(); type_pos != type_end; ++type_pos)
+            {
+                event_position_list::iterator pos, end = type_pos->second.end();
+                for (pos = type_pos->second.begin(); pos != end; ++pos)
+                    m_events.erase (*pos);
+            }
+            m_events_index.erase (index_pos);
         }
 
         if (m_events.empty())
-            m_cond_wait.SetValue (false, eBroadcastNever);
+            ResetEventCondition ();
 
     }
 }
@@ -187,14 +197,91 @@ Listener::AddEvent (EventSP &event_sp)
     if (log)
         log->Printf ("%p Listener('%s')::AddEvent (event_sp = {%p})", this, m_name.c_str(), event_sp.get());
 
-    // Scope for "locker"
+    // Broadcasters call this from many threads while the thread that
+    // owns this listener may be holding m_events_mutex to look through
+    // the queue, so the event is only pushed onto m_pending_events here.
+    // It is moved into the queue the next time the queue is looked at.
+    PendingEvent *pending = new PendingEvent;
+    pending->event_sp = event_sp;
+    PendingEvent *head;
+    do
     {
-        Mutex::Locker locker(m_events_mutex);
-        m_events.push_back (event_sp);
-    }
+        head = m_pending_events;
+        pending->next = head;
+    } while (!__sync_bool_compare_and_swap (&m_pending_events, head, pending));
+
     m_cond_wait.SetValue (true, eBroadcastAlways);
 }
 
+// Must be called with m_events_mutex locked
+void
+Listener::MovePendingEvents ()
+{
+    PendingEvent *pending = __sync_lock_test_and_set (&m_pending_events, (PendingEvent *)NULL);
+    if (pending == NULL)
+        return;
+
+    // The pending events are in reverse order
+    PendingEvent *ordered = NULL;
+    while (pending)
+    {
+        PendingEvent *next = pending->next;
+        pending->next = ordered;
+        ordered = pending;
+        pending = next;
+    }
+
+    while (ordered)
+    {
+        event_collection::iterator pos = m_events.insert (m_events.end(), QueuedEvent (m_next_event_sequence++, ordered->event_sp));
+        m_events_index[pos->broadcaster][pos->event_type].push_back (pos);
+        PendingEvent *next = ordered->next;
+        delete ordered;
+        ordered = next;
+    }
+}
+
+// Must be called with m_events_mutex locked
+void
+Listener::RemoveQueuedEvent (event_collection::iterator pos)
+{
+    event_broadcaster_index::iterator index_pos = m_events_index.find (pos->broadcaster);
+    if (index_pos != m_events_index.end())
+    {
+        event_type_index::iterator type_pos = index_pos->second.find (pos->event_type);
+        if (type_pos != index_pos->second.end())
+        {
+            // Events are almost always removed from the front of their list
+            event_position_list::iterator list_pos, list_end = type_pos->second.end();
+            for (list_pos = type_pos->second.begin(); list_pos != list_end; ++list_pos)
+            {
+                if (*list_pos == pos)
+                {
+                    type_pos->second.erase (list_pos);
+                    break;
+                }
+            }
+            if (type_pos->second.empty())
+            {
+                index_pos->second.erase (type_pos);
+                if (index_pos->second.empty())
+                    m_events_index.erase (index_pos);
+            }
+        }
+    }
+    m_events.erase (pos);
+}
+
+void
+Listener::ResetEventCondition ()
+{
+    m_cond_wait.SetValue (false, eBroadcastNever);
+    // AddEvent() doesn't take m_events_mutex, so an event that it added
+    // after the queue was last looked at must still wake up the waiter
+    if (m_pending_events != NULL)
+        m_cond_wait.SetValue (true, eBroadcastAlways);
+}
+
 class EventBroadcasterMatches
 {
 public:
@@ -274,6 +361,8 @@ Listener::FindNextEventInternal
 
     Mutex::Locker lock(m_events_mutex);
 
+    MovePendingEvents ();
+
     if (m_events.empty())
         return false;
 
@@ -284,20 +373,43 @@ Listener::FindNextEventInternal
     {
         pos = m_events.begin();
     }
+    else if (broadcaster && broadcaster_names == NULL)
+    {
+        // The oldest matching event is at the front of one of the lists of
+        // this broadcaster's event types
+        event_broadcaster_index::iterator index_pos = m_events_index.find (broadcaster);
+        if (index_pos != m_events_index.end())
+        {
+            event_type_index::iterator type_pos, type_end = index_pos->second.end();
+            for (type_pos = index_pos->second.begin(); type_pos != type_end; ++type_pos)
+            {
+                if (event_type_mask != 0 && (type_pos->first & event_type_mask) == 0)
+                    continue;
+                event_collection::iterator front = type_pos->second.front();
+                if (pos == m_events.end() || front->sequence < pos->sequence)
+                    pos = front;
+            }
+        }
+    }
     else
     {
-        pos = std::find_if (m_events.begin(), m_events.end(), EventMatcher (broadcaster, broadcaster_names, num_broadcaster_names, event_type_mask));
+        EventMatcher matcher (broadcaster, broadcaster_names, num_broadcaster_names, event_type_mask);
+        for (pos = m_events.begin(); pos != m_events.end(); ++pos)
+        {
+            if (matcher (pos->event_sp))
+                break;
+        }
     }
 
     if (pos != m_events.end())
     {
-        event_sp = *pos;
+        event_sp = pos->event_sp;
         if (remove)
         {
-            m_events.erase(pos);
+            RemoveQueuedEvent (pos);
 
             if (m_events.empty())
-                m_cond_wait.SetValue (false, eBroadcastNever);
+                ResetEventCondition ();
         }
         
         // Unlock the event queue here.  We've removed this event and are about to return
@@ -400,7 +512,7 @@ Listener::WaitForEventsInternal
 
         // Reset condition value to false, so we can wait for new events to be
         // added that might meet our current filter
-        m_cond_wait.SetValue (false, eBroadcastNever);
+        ResetEventCondition ();
 
         if (m_cond_wait.WaitForValueEqualTo (true, timeout, &timed_out))
             continue;
@@ -17,11 +17,13 @@
 // C++ Includes
 #include <map>
 #include <string>
+#include <vector>
 
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Log.h"
+#include "lldb/Core/LogWriter.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/StreamFile.h"
 #include "lldb/Core/StreamString.h"
@@ -35,19 +37,25 @@ using namespace lldb_private;
 Log::Log () :
     m_stream_sp(),
     m_options(0),
-    m_mask_bits(0)
+    m_mask_bits(0),
+    m_writer_stream_idx(UINT32_MAX)
 {
 }
 
 Log::Log (StreamSP &stream_sp) :
     m_stream_sp(stream_sp),
     m_options(0),
-    m_mask_bits(0)
+    m_mask_bits(0),
+    m_writer_stream_idx(UINT32_MAX)
 {
 }
 
 Log::~Log ()
 {
+    // Make sure any records we enqueued make it out before the log
+    // channel or stream goes away, and let the writer drop the stream.
+    if (m_writer_stream_idx != UINT32_MAX)
+        LogWriter::GetSharedInstance().UnregisterStream (m_writer_stream_idx);
 }
 
 Flags &
@@ -85,39 +93,97 @@ Log::PrintfWithFlagsVarArg (uint32_t flags, const char *format, va_list args)
 {
     if (m_stream_sp)
     {
-        static uint32_t g_sequence_id = 0;
+        if (m_options.AnySet (LLDB_LOG_OPTION_ASYNC | LLDB_LOG_OPTION_BINARY))
+        {
+            WriteRecordVarArg (format, args);
+            return;
+        }
+
         StreamString header;
 		// Enabling the thread safe logging actually deadlocks right now.
 		// Need to fix this at some point.
 //        static Mutex g_LogThreadedMutex(Mutex::eMutexTypeRecursive);
 //        Mutex::Locker locker (g_LogThreadedMutex);
 
-        // Add a sequence ID if requested
-        if (m_options.Test (LLDB_LOG_OPTION_PREPEND_SEQUENCE))
-            header.Printf ("%u ", ++g_sequence_id);
+        const uint32_t log_options = m_options.Get();
+        const uint32_t sequence_id = (log_options & LLDB_LOG_OPTION_PREPEND_SEQUENCE) ? LogWriter::GetNextSequenceID() : 0;
+        const uint64_t timestamp_usec = (log_options & LLDB_LOG_OPTION_PREPEND_TIMESTAMP) ? TimeValue::Now().GetAsMicroSecondsSinceJan1_1970() : 0;
+        const char *thread_name_str = NULL;
+        if (log_options & LLDB_LOG_OPTION_PREPEND_THREAD_NAME)
+            thread_name_str = Host::GetThreadName (getpid(), Host::GetCurrentThreadID());
+
+        LogWriter::DumpRecordHeader (header,
+                                     log_options,
+                                     sequence_id,
+                                     timestamp_usec,
+                                     getpid(),
+                                     Host::GetCurrentThreadID(),
+                                     thread_name_str);
 
-        // Timestamp if requested
-        if (m_options.Test (LLDB_LOG_OPTION_PREPEND_TIMESTAMP))
-        {
-            struct timeval tv = TimeValue::Now().GetAsTimeVal();
-            header.Printf ("%9ld.%6.6d ", tv.tv_sec, tv.tv_usec);
-        }
+        header.PrintfVarArg (format, args);
+        m_stream_sp->Printf("%s\n", header.GetData());
+        m_stream_sp->Flush();
+    }
+}
 
-        // Add the process and thread if requested
-        if (m_options.Test (LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD))
-            header.Printf ("[%4.4x/%4.4llx]: ", getpid(), Host::GetCurrentThreadID());
+//----------------------------------------------------------------------
+// Write a log record for logs that have the async or binary options
+// set. Async records are handed off to the LogWriter thread so the
+// logging thread never blocks on the log stream, and binary records
+// capture the arguments instead of formatting them.
+//----------------------------------------------------------------------
+void
+Log::WriteRecordVarArg (const char *format, va_list args)
+{
+    LogWriter &writer = LogWriter::GetSharedInstance();
+    if (m_options.Test (LLDB_LOG_OPTION_ASYNC) && m_writer_stream_idx == UINT32_MAX)
+        m_writer_stream_idx = writer.RegisterStream (m_stream_sp);
 
-        // Add the process and thread if requested
-        if (m_options.Test (LLDB_LOG_OPTION_PREPEND_THREAD_NAME))
-        {
-            const char *thread_name_str = Host::GetThreadName (getpid(), Host::GetCurrentThreadID());
-            if (thread_name_str)
-                header.Printf ("%s ", thread_name_str);
+    const uint32_t log_options = m_options.Get();
+    const uint32_t sequence_id = LogWriter::GetNextSequenceID();
+    const char *record_bytes = NULL;
+    size_t record_length = 0;
 
+    std::vector<uint8_t> binary_record;
+    StreamString text_record;
+    if (log_options & LLDB_LOG_OPTION_BINARY)
+    {
+        va_list args_copy;
+        va_copy (args_copy, args);
+        if (writer.EncodeBinaryRecord (m_writer_stream_idx, sequence_id, log_options, format, args_copy, binary_record))
+        {
+            record_bytes = (const char *)&binary_record[0];
+            record_length = binary_record.size();
         }
+        va_end (args_copy);
+    }
 
-        header.PrintfVarArg (format, args);
-        m_stream_sp->Printf("%s\n", header.GetData());
+    if (record_bytes == NULL)
+    {
+        // Format strings that can't be captured are logged as text
+        const char *thread_name_str = NULL;
+        if (log_options & LLDB_LOG_OPTION_PREPEND_THREAD_NAME)
+            thread_name_str = Host::GetThreadName (getpid(), Host::GetCurrentThreadID());
+        LogWriter::DumpRecordHeader (text_record,
+                                     log_options,
+                                     sequence_id,
+                                     TimeValue::Now().GetAsMicroSecondsSinceJan1_1970(),
+                                     getpid(),
+                                     Host::GetCurrentThreadID(),
+                                     thread_name_str);
+        text_record.PrintfVarArg (format, args);
+        text_record.EOL();
+        record_bytes = text_record.GetData();
+        record_length = text_record.GetSize();
+    }
+
+    if (m_writer_stream_idx != UINT32_MAX)
+    {
+        writer.Enqueue (m_writer_stream_idx, sequence_id, record_bytes, record_length);
+    }
+    else
+    {
+        m_stream_sp->Write (record_bytes, record_length);
         m_stream_sp->Flush();
     }
 }
@@ -248,6 +314,8 @@ Log::FatalError (int err, const char *format, ...)
         PrintfWithFlags (LLDB_LOG_FLAG_ERROR | LLDB_LOG_FLAG_FATAL, "error: %s", arg_msg);
         ::free (arg_msg);
     }
+    if (m_writer_stream_idx != UINT32_MAX)
+        LogWriter::GetSharedInstance().Flush();
     ::exit (err);
 }
 
@@ -430,6 +498,7 @@ void
 Log::Terminate ()
 {
     DisableAllLogChannels (NULL);
+    LogWriter::GetSharedInstance().Terminate();
 }
 
 void
@@ -0,0 +1,1204 @@
+//===-- LogWriter.cpp -------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/LogWriter.h"
+
+// C Includes
+#include <ctype.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// C++ Includes
+#include <algorithm>
+#include <map>
+#include <string>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/DataBuffer.h"
+#include "lldb/Core/DataExtractor.h"
+#include "lldb/Core/Error.h"
+#include "lldb/Core/Log.h"
+#include "lldb/Core/Stream.h"
+#include "lldb/Host/Endian.h"
+#include "lldb/Host/FileSpec.h"
+#include "lldb/Host/Host.h"
+#include "lldb/Host/TimeValue.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+// How often the writer thread drains the ring buffers when nobody is
+// waiting for a flush.
+#define LOG_WRITER_PERIOD_USEC  10000
+
+// Binary log records start with this magic value, which is written in
+// host byte order so the decoder can tell the byte order of the log.
+#define LOG_BINARY_RECORD_MAGIC 0x4c4c4442u // 'LLDB'
+
+// Maximum number of format strings that are tracked per stream so they
+// only need to be written once.
+#define LOG_MAX_FORMATS_PER_STREAM  4096
+
+// Argument type tags for binary log records
+enum
+{
+    eArgSigned      = 'i',  // int64_t
+    eArgUnsigned    = 'u',  // uint64_t
+    eArgDouble      = 'd',  // double
+    eArgString      = 's',  // uint32_t length followed by the bytes
+    eArgNullString  = 'n',  // NULL "char *"
+    eArgPointer     = 'p'   // uint64_t
+};
+
+// Number of format tables a stream can go through before the format
+// indexes wrap around, chosen so a format index is never UINT32_MAX.
+#define LOG_MAX_FORMAT_GENERATIONS  (UINT32_MAX / LOG_MAX_FORMATS_PER_STREAM)
+
+// Format strings that have been written to a stream, indexed by their
+// slot. A slot is claimed with a compare and swap the first time a format
+// is logged. The format index written to the log also encodes the
+// generation of the table, so indexes from different tables never clash.
+struct LogWriter::FormatTable
+{
+    FormatTable (uint32_t g) :
+        generation (g)
+    {
+        ::memset ((void *)formats, 0, sizeof(formats));
+    }
+
+    uint32_t generation;
+    const char * volatile formats[LOG_MAX_FORMATS_PER_STREAM];
+};
+
+struct LogWriter::StreamInfo
+{
+    StreamInfo (const StreamSP &sp) :
+        stream_sp (sp),
+        num_logs (1),
+        format_table (new FormatTable (0)),
+        old_format_tables ()
+    {
+    }
+
+    ~StreamInfo ()
+    {
+        delete format_table;
+        for (size_t i=0; i<old_format_tables.size(); ++i)
+            delete old_format_tables[i];
+    }
+
+    // Start a new format table so every format string gets written out
+    // again. The old table is kept around since other threads might still
+    // be encoding records with it. m_mutex must be locked by the caller.
+    void
+    ResetFormats ()
+    {
+        FormatTable *old_table = format_table;
+        old_format_tables.push_back (old_table);
+        FormatTable *new_table = new FormatTable ((old_table->generation + 1) % LOG_MAX_FORMAT_GENERATIONS);
+        __sync_synchronize();
+        format_table = new_table;
+    }
+
+    // Release the stream once no log is using it anymore. Nobody can be
+    // encoding records for it, so the old format tables can go too. m_mutex
+    // must be locked by the caller.
+    void
+    Clear ()
+    {
+        stream_sp.reset();
+        ResetFormats ();
+        for (size_t i=0; i<old_format_tables.size(); ++i)
+            delete old_format_tables[i];
+        old_format_tables.clear();
+    }
+
+    StreamSP stream_sp;             // Empty if the slot is free
+    uint32_t num_logs;              // Number of logs that registered this stream
+    FormatTable * volatile format_table;
+    std::vector<FormatTable *> old_format_tables;
+};
+
+//----------------------------------------------------------------------
+// A single producer/single consumer ring buffer of log records. Only the
+// thread that owns the ring buffer writes records and advances m_head,
+// and only the thread that holds LogWriter::m_write_mutex reads records
+// and advances m_tail. The head and tail are free running byte counts.
+//----------------------------------------------------------------------
+class LogWriter::RingBuffer
+{
+public:
+    enum
+    {
+        kByteSize = 256 * 1024,             // Must be a power of two
+        kMaxRecordSize = kByteSize / 4
+    };
+
+    struct RecordHeader
+    {
+        uint32_t length;        // Length of the record bytes that follow this header
+        uint32_t stream_idx;    // UINT32_MAX for padding at the end of the buffer
+        uint32_t sequence_id;
+        uint32_t reserved;
+    };
+
+    struct Record
+    {
+        uint32_t sequence_id;
+        uint32_t stream_idx;
+        std::string bytes;
+    };
+
+    RingBuffer () :
+        m_head (0),
+        m_tail (0),
+        m_thread_exited (false)
+    {
+    }
+
+    static uint32_t
+    GetRecordSize (size_t length)
+    {
+        // Keep records 16 byte aligned so there is always room for a
+        // padding header at the end of the buffer.
+        return (sizeof(RecordHeader) + length + 15) & ~15u;
+    }
+
+    bool
+    Write (uint32_t stream_idx, uint32_t sequence_id, const void *bytes, size_t length)
+    {
+        const uint32_t record_size = GetRecordSize (length);
+        uint32_t head = m_head;
+        uint32_t offset = head & (kByteSize - 1);
+        const uint32_t contiguous = kByteSize - offset;
+        const uint32_t needed = record_size + (contiguous < record_size ? contiguous : 0);
+
+        __sync_synchronize();
+        const uint32_t tail = m_tail;
+        if (kByteSize - (head - tail) < needed)
+            return false;
+
+        if (contiguous < record_size)
+        {
+            // Pad out the rest of the buffer and start at the beginning
+            RecordHeader *pad = (RecordHeader *)(m_buffer + offset);
+            pad->length = contiguous - sizeof(RecordHeader);
+            pad->stream_idx = UINT32_MAX;
+            pad->sequence_id = 0;
+            pad->reserved = 0;
+            head += contiguous;
+            offset = 0;
+        }
+
+        RecordHeader *header = (RecordHeader *)(m_buffer + offset);
+        header->length = length;
+        header->stream_idx = stream_idx;
+        header->sequence_id = sequence_id;
+        header->reserved = 0;
+        ::memcpy (header + 1, bytes, length);
+
+        // Make sure the record is visible before the new head
+        __sync_synchronize();
+        m_head = head + record_size;
+        return true;
+    }
+
+    void
+    Read (std::vector<Record> &records)
+    {
+        const uint32_t head = m_head;
+        __sync_synchronize();
+        uint32_t tail = m_tail;
+        while (tail != head)
+        {
+            const RecordHeader *header = (const RecordHeader *)(m_buffer + (tail & (kByteSize - 1)));
+            if (header->stream_idx != UINT32_MAX)
+            {
+                records.push_back (Record());
+                Record &record = records.back();
+                record.sequence_id = header->sequence_id;
+                record.stream_idx = header->stream_idx;
+                record.bytes.assign ((const char *)(header + 1), header->length);
+            }
+            tail += GetRecordSize (header->length);
+        }
+        // Make sure we are done with the bytes before giving them back
+        __sync_synchronize();
+        m_tail = tail;
+    }
+
+    volatile uint32_t m_head;
+    volatile uint32_t m_tail;
+    volatile bool m_thread_exited;
+    uint8_t m_buffer[kByteSize];
+};
+
+static pthread_key_t g_ring_buffer_key;
+static uint32_t g_sequence_id = 0;
+
+static bool
+RecordSequenceLessThan (const LogWriter::RingBuffer::Record *lhs, const LogWriter::RingBuffer::Record *rhs)
+{
+    // Sequence IDs are allowed to wrap around
+    return (int32_t)(lhs->sequence_id - rhs->sequence_id) < 0;
+}
+
+LogWriter &
+LogWriter::GetSharedInstance ()
+{
+    // This object is intentionally leaked so it is still around for any
+    // logging that happens during static destruction.
+    static LogWriter *g_shared_writer = new LogWriter();
+    return *g_shared_writer;
+}
+
+LogWriter::LogWriter () :
+    m_mutex (Mutex::eMutexTypeNormal),
+    m_write_mutex (Mutex::eMutexTypeNormal),
+    m_writer_condition (),
+    m_pass_condition (),
+    m_num_streams (0),
+    m_ring_buffers (),
+    m_writer_thread (LLDB_INVALID_HOST_THREAD),
+    m_pass_count (0),
+    m_flush_requested (false),
+    m_terminating (false)
+{
+    ::memset ((void *)m_streams, 0, sizeof(m_streams));
+    ::pthread_key_create (&g_ring_buffer_key, LogWriter::RingBufferThreadCleanup);
+}
+
+LogWriter::~LogWriter ()
+{
+    Terminate ();
+}
+
+uint32_t
+LogWriter::GetNextSequenceID ()
+{
+    return __sync_add_and_fetch (&g_sequence_id, 1);
+}
+
+uint32_t
+LogWriter::RegisterStream (const StreamSP &stream_sp)
+{
+    if (!stream_sp)
+        return UINT32_MAX;
+
+    Mutex::Locker locker (m_mutex);
+    uint32_t stream_idx;
+    uint32_t free_stream_idx = UINT32_MAX;
+    for (stream_idx = 0; stream_idx < m_num_streams; ++stream_idx)
+    {
+        if (m_streams[stream_idx]->stream_sp == stream_sp)
+            break;
+        if (free_stream_idx == UINT32_MAX && !m_streams[stream_idx]->stream_sp)
+            free_stream_idx = stream_idx;
+    }
+
+    if (stream_idx < m_num_streams)
+    {
+        // A log was enabled on a stream we already know, which might have
+        // been reopened or truncated since, so don't assume any of the
+        // format strings that were written to it are still there.
+        StreamInfo *stream_info = m_streams[stream_idx];
+        ++stream_info->num_logs;
+        stream_info->ResetFormats ();
+    }
+    else if (free_stream_idx != UINT32_MAX)
+    {
+        // Reuse the slot of a stream that was unregistered
+        stream_idx = free_stream_idx;
+        StreamInfo *stream_info = m_streams[stream_idx];
+        stream_info->stream_sp = stream_sp;
+        stream_info->num_logs = 1;
+    }
+    else
+    {
+        if (m_num_streams == kMaxStreams)
+            return UINT32_MAX;
+        m_streams[stream_idx] = new StreamInfo (stream_sp);
+        ++m_num_streams;
+    }
+
+    if (!IS_VALID_LLDB_HOST_THREAD(m_writer_thread))
+        StartWriterThread ();
+    return stream_idx;
+}
+
+void
+LogWriter::UnregisterStream (uint32_t stream_idx)
+{
+    if (stream_idx >= kMaxStreams)
+        return;
+
+    StreamInfo *stream_info;
+    {
+        Mutex::Locker locker (m_mutex);
+        stream_info = m_streams[stream_idx];
+        if (stream_info == NULL || stream_info->num_logs == 0)
+            return;
+        if (--stream_info->num_logs > 0)
+            return;
+    }
+
+    // Write out everything that is still queued for the stream before
+    // letting go of it.
+    Flush ();
+
+    // Holding the write mutex makes sure the writer thread isn't holding
+    // on to the stream either, so it is closed by the time we return.
+    Mutex::Locker write_locker (m_write_mutex);
+    Mutex::Locker locker (m_mutex);
+    // Another log might have registered the stream again while we flushed
+    if (stream_info->num_logs == 0)
+        stream_info->Clear ();
+}
+
+bool
+LogWriter::HasFreeStream ()
+{
+    Mutex::Locker locker (m_mutex);
+    if (m_num_streams < kMaxStreams)
+        return true;
+    for (uint32_t stream_idx = 0; stream_idx < m_num_streams; ++stream_idx)
+    {
+        if (!m_streams[stream_idx]->stream_sp)
+            return true;
+    }
+    return false;
+}
+
+StreamSP
+LogWriter::GetStreamAtIndex (uint32_t stream_idx)
+{
+    StreamSP stream_sp;
+    if (stream_idx < kMaxStreams && m_streams[stream_idx])
+    {
+        Mutex::Locker locker (m_mutex);
+        stream_sp = m_streams[stream_idx]->stream_sp;
+    }
+    return stream_sp;
+}
+
+bool
+LogWriter::StartWriterThread ()
+{
+    // m_mutex must be locked by the caller
+    m_terminating = false;
+    m_writer_thread = Host::ThreadCreate ("<lldb.log.writer>", LogWriter::WriterThread, this, NULL);
+    return IS_VALID_LLDB_HOST_THREAD(m_writer_thread);
+}
+
+LogWriter::RingBuffer *
+LogWriter::GetRingBufferForCurrentThread ()
+{
+    RingBuffer *ring_buffer = (RingBuffer *)::pthread_getspecific (g_ring_buffer_key);
+    if (ring_buffer == NULL)
+    {
+        ring_buffer = new RingBuffer;
+        {
+            Mutex::Locker locker (m_mutex);
+            m_ring_buffers.push_back (ring_buffer);
+        }
+        ::pthread_setspecific (g_ring_buffer_key, ring_buffer);
+    }
+    return ring_buffer;
+}
+
+void
+LogWriter::RingBufferThreadCleanup (void *p)
+{
+    // The ring buffer might still have records in it, so let whoever
+    // drains it next delete it.
+    RingBuffer *ring_buffer = (RingBuffer *)p;
+    __sync_synchronize();
+    ring_buffer->m_thread_exited = true;
+}
+
+void
+LogWriter::Enqueue (uint32_t stream_idx,
+                    uint32_t sequence_id,
+                    const void *bytes,
+                    size_t length)
+{
+    if (length <= RingBuffer::kMaxRecordSize)
+    {
+        RingBuffer *ring_buffer = GetRingBufferForCurrentThread ();
+        if (ring_buffer->Write (stream_idx, sequence_id, bytes, length))
+            return;
+
+        // The ring buffer is full, wait for the writer to make room
+        for (uint32_t i=0; i<16; ++i)
+        {
+            Flush ();
+            if (ring_buffer->Write (stream_idx, sequence_id, bytes, length))
+                return;
+        }
+    }
+
+    // The record is too large for the ring buffer, write it ourselves
+    // after everything before it has been written. Hold the write mutex so
+    // the writer thread isn't writing to the same stream at the same time.
+    Flush ();
+    StreamSP stream_sp (GetStreamAtIndex (stream_idx));
+    if (stream_sp)
+    {
+        Mutex::Locker write_locker (m_write_mutex);
+        stream_sp->Write (bytes, length);
+        stream_sp->Flush ();
+    }
+}
+
+void
+LogWriter::Flush ()
+{
+    Mutex::Locker locker (m_mutex);
+    if (IS_VALID_LLDB_HOST_THREAD(m_writer_thread) && !m_terminating)
+    {
+        // The writer thread never logs to an async log, but guard against
+        // deadlocking if it ever does.
+        if (Host::GetCurrentThread() == m_writer_thread)
+            return;
+
+        // Wait for a full pass that started after we were called
+        const uint32_t pass_count = m_pass_count + 2;
+        while ((int32_t)(m_pass_count - pass_count) < 0 && IS_VALID_LLDB_HOST_THREAD(m_writer_thread))
+        {
+            m_flush_requested = true;
+            m_writer_condition.Signal ();
+            m_pass_condition.Wait (m_mutex);
+        }
+    }
+    else
+    {
+        // There is no writer thread, drain the ring buffers ourselves
+        locker.Unlock ();
+        WriteRecords ();
+    }
+}
+
+void
+LogWriter::Terminate ()
+{
+    lldb::thread_t writer_thread = LLDB_INVALID_HOST_THREAD;
+    {
+        Mutex::Locker locker (m_mutex);
+        if (IS_VALID_LLDB_HOST_THREAD(m_writer_thread) && !m_terminating)
+        {
+            m_terminating = true;
+            writer_thread = m_writer_thread;
+            m_writer_condition.Signal ();
+        }
+    }
+
+    if (IS_VALID_LLDB_HOST_THREAD(writer_thread))
+    {
+        // The writer thread drains all ring buffers one last time
+        Host::ThreadJoin (writer_thread, NULL, NULL);
+        Mutex::Locker locker (m_mutex);
+        m_writer_thread = LLDB_INVALID_HOST_THREAD;
+        m_terminating = false;
+        m_pass_condition.Broadcast ();
+    }
+}
+
+size_t
+LogWriter::WriteRecords ()
+{
+    Mutex::Locker write_locker (m_write_mutex);
+
+    // Take references to the streams along with the ring buffers so a
+    // stream can't be unregistered while we are writing to it.
+    std::vector<RingBuffer *> ring_buffers;
+    std::vector<StreamSP> streams;
+    {
+        Mutex::Locker locker (m_mutex);
+        ring_buffers = m_ring_buffers;
+        streams.resize (m_num_streams);
+        for (uint32_t stream_idx=0; stream_idx<m_num_streams; ++stream_idx)
+            streams[stream_idx] = m_streams[stream_idx]->stream_sp;
+    }
+
+    std::vector<RingBuffer::Record> records;
+    std::vector<RingBuffer *> exited_ring_buffers;
+    std::vector<RingBuffer *>::iterator pos, end = ring_buffers.end();
+    for (pos = ring_buffers.begin(); pos != end; ++pos)
+    {
+        RingBuffer *ring_buffer = *pos;
+        // Check if the thread exited before draining so we don't miss any
+        // records it wrote before exiting.
+        const bool thread_exited = ring_buffer->m_thread_exited;
+        __sync_synchronize();
+        ring_buffer->Read (records);
+        if (thread_exited)
+            exited_ring_buffers.push_back (ring_buffer);
+    }
+
+    if (!exited_ring_buffers.empty())
+    {
+        Mutex::Locker locker (m_mutex);
+        for (pos = exited_ring_buffers.begin(), end = exited_ring_buffers.end(); pos != end; ++pos)
+        {
+            std::vector<RingBuffer *>::iterator ring_pos = std::find (m_ring_buffers.begin(), m_ring_buffers.end(), *pos);
+            if (ring_pos != m_ring_buffers.end())
+                m_ring_buffers.erase (ring_pos);
+            delete *pos;
+        }
+    }
+
+    const size_t num_records = records.size();
+    if (num_records == 0)
+        return 0;
+
+    // Each ring buffer is already in order, but records from different
+    // threads need to be merged by their sequence IDs.
+    std::vector<const RingBuffer::Record *> sorted_records (num_records);
+    for (size_t i=0; i<num_records; ++i)
+        sorted_records[i] = &records[i];
+    std::stable_sort (sorted_records.begin(), sorted_records.end(), RecordSequenceLessThan);
+
+    bool streams_to_flush[kMaxStreams];
+    ::memset (streams_to_flush, 0, sizeof(streams_to_flush));
+    for (size_t i=0; i<num_records; ++i)
+    {
+        const RingBuffer::Record *record = sorted_records[i];
+        if (record->stream_idx < streams.size() && streams[record->stream_idx])
+        {
+            streams[record->stream_idx]->Write (record->bytes.data(), record->bytes.size());
+            streams_to_flush[record->stream_idx] = true;
+        }
+    }
+
+    for (uint32_t stream_idx=0; stream_idx<streams.size(); ++stream_idx)
+    {
+        if (streams_to_flush[stream_idx])
+            streams[stream_idx]->Flush ();
+    }
+    return num_records;
+}
+
+thread_result_t
+LogWriter::WriterThread (thread_arg_t arg)
+{
+    LogWriter *writer = (LogWriter *)arg;
+    bool terminating = false;
+    while (!terminating)
+    {
+        {
+            Mutex::Locker locker (writer->m_mutex);
+            if (!writer->m_flush_requested && !writer->m_terminating)
+            {
+                TimeValue timeout (TimeValue::Now());
+                timeout.OffsetWithMicroSeconds (LOG_WRITER_PERIOD_USEC);
+                writer->m_writer_condition.Wait (writer->m_mutex, &timeout, NULL);
+            }
+            writer->m_flush_requested = false;
+            terminating = writer->m_terminating;
+        }
+
+        writer->WriteRecords ();
+
+        {
+            Mutex::Locker locker (writer->m_mutex);
+            ++writer->m_pass_count;
+            writer->m_pass_condition.Broadcast ();
+        }
+    }
+    return NULL;
+}
+
+//----------------------------------------------------------------------
+// Binary log records
+//
+// Each record is laid out in host byte order as:
+//
+//  uint32_t magic              LOG_BINARY_RECORD_MAGIC
+//  uint32_t length             Number of bytes that follow this field
+//  uint32_t sequence_id
+//  uint32_t log_options
+//  uint64_t timestamp_usec
+//  uint64_t pid
+//  uint64_t tid
+//  uint32_t format_idx         UINT32_MAX if the format isn't indexed
+//  uint32_t format_length      Non-zero if the format string follows
+//  char     format[format_length]
+//  uint32_t thread_name_length
+//  char     thread_name[thread_name_length]
+//  args...                     One type tag byte followed by the value
+//----------------------------------------------------------------------
+template <typename T>
+static void
+AppendValue (std::vector<uint8_t> &record, const T &value)
+{
+    const uint8_t *bytes = (const uint8_t *)&value;
+    record.insert (record.end(), bytes, bytes + sizeof(T));
+}
+
+static void
+AppendBytes (std::vector<uint8_t> &record, const char *bytes, uint32_t length)
+{
+    AppendValue (record, length);
+    record.insert (record.end(), (const uint8_t *)bytes, (const uint8_t *)bytes + length);
+}
+
+static void
+AppendArg (std::vector<uint8_t> &record, uint8_t type, uint64_t value)
+{
+    record.push_back (type);
+    AppendValue (record, value);
+}
+
+bool
+LogWriter::EncodeBinaryRecord (uint32_t stream_idx,
+                               uint32_t sequence_id,
+                               uint32_t log_options,
+                               const char *format,
+                               va_list args,
+                               std::vector<uint8_t> &record)
+{
+    record.clear();
+    if (format == NULL)
+        return false;
+
+    const lldb::pid_t pid = ::getpid();
+    const lldb::tid_t tid = Host::GetCurrentThreadID();
+    const char *thread_name = NULL;
+    if (log_options & LLDB_LOG_OPTION_PREPEND_THREAD_NAME)
+        thread_name = Host::GetThreadName (pid, tid);
+
+    AppendValue (record, (uint32_t)LOG_BINARY_RECORD_MAGIC);
+    AppendValue (record, (uint32_t)0); // Length gets filled in below
+    AppendValue (record, sequence_id);
+    AppendValue (record, log_options);
+    AppendValue (record, (uint64_t)TimeValue::Now().GetAsMicroSecondsSinceJan1_1970());
+    AppendValue (record, (uint64_t)pid);
+    AppendValue (record, (uint64_t)tid);
+
+    // Format strings are usually literals, so we only need to write each
+    // one out once per stream and can refer to it by index after that.
+    uint32_t format_idx = UINT32_MAX;
+    bool write_format = true;
+    if (stream_idx < kMaxStreams && m_streams[stream_idx])
+    {
+        StreamInfo *stream_info = m_streams[stream_idx];
+        FormatTable *format_table = stream_info->format_table;
+        __sync_synchronize();
+        const uint32_t hash = (uint32_t)((uintptr_t)format >> 2) * 2654435761u;
+        for (uint32_t probe = 0; probe < 8; ++probe)
+        {
+            const uint32_t idx = (hash + probe) % LOG_MAX_FORMATS_PER_STREAM;
+            const char *slot_format = format_table->formats[idx];
+            if (slot_format == format)
+            {
+                format_idx = idx;
+                write_format = false;
+                break;
+            }
+            if (slot_format == NULL)
+            {
+                if (__sync_bool_compare_and_swap (&format_table->formats[idx], (const char *)NULL, format))
+                {
+                    format_idx = idx;
+                    break;
+                }
+                if (format_table->formats[idx] == format)
+                {
+                    format_idx = idx;
+                    write_format = false;
+                    break;
+                }
+            }
+        }
+
+        if (format_idx != UINT32_MAX)
+        {
+            format_idx += format_table->generation * LOG_MAX_FORMATS_PER_STREAM;
+            // If the formats were reset while we were looking, the format
+            // string we found might not be in the stream anymore.
+            __sync_synchronize();
+            if (stream_info->format_table != format_table)
+                write_format = true;
+        }
+    }
+    AppendValue (record, format_idx);
+    if (write_format)
+        AppendBytes (record, format, ::strlen (format));
+    else
+        AppendValue (record, (uint32_t)0);
+    AppendBytes (record, thread_name ? thread_name : "", thread_name ? ::strlen (thread_name) : 0);
+
+    // Capture the arguments for each conversion in the format string
+    for (const char *p = format; *p; ++p)
+    {
+        if (*p != '%')
+            continue;
+        ++p;
+        if (*p == '%')
+            continue;
+
+        // Flags
+        while (*p && ::strchr ("-+ #0'", *p))
+            ++p;
+
+        // Field width
+        if (*p == '*')
+        {
+            AppendArg (record, eArgSigned, (int64_t)va_arg (args, int));
+            ++p;
+        }
+        else
+        {
+            while (isdigit(*p))
+                ++p;
+        }
+
+        // Precision
+        bool has_precision = false;
+        int precision = 0;
+        if (*p == '.')
+        {
+            ++p;
+            has_precision = true;
+            if (*p == '*')
+            {
+                precision = va_arg (args, int);
+                AppendArg (record, eArgSigned, (int64_t)precision);
+                // A negative precision is taken as if it was omitted
+                if (precision < 0)
+                    has_precision = false;
+                ++p;
+            }
+            else
+            {
+                while (isdigit(*p))
+                {
+                    precision = precision * 10 + (*p - '0');
+                    ++p;
+                }
+            }
+        }
+
+        // Length modifier
+        char length = '\0';
+        switch (*p)
+        {
+        case 'h':
+            length = 'h';
+            ++p;
+            if (*p == 'h')
+                ++p;
+            break;
+        case 'l':
+            length = 'l';
+            ++p;
+            if (*p == 'l')
+            {
+                length = 'q';
+                ++p;
+            }
+            break;
+        case 'q':
+        case 'j':
+        case 'z':
+        case 't':
+        case 'L':
+            length = *p;
+            ++p;
+            break;
+        }
+
+        switch (*p)
+        {
+        case 'd':
+        case 'i':
+            {
+                int64_t value;
+                switch (length)
+                {
+                case 'l':   value = va_arg (args, long); break;
+                case 'q':   value = va_arg (args, long long); break;
+                case 'j':   value = va_arg (args, intmax_t); break;
+                case 'z':   value = va_arg (args, ssize_t); break;
+                case 't':   value = va_arg (args, ptrdiff_t); break;
+                default:    value = va_arg (args, int); break;
+                }
+                AppendArg (record, eArgSigned, value);
+            }
+            break;
+
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            {
+                uint64_t value;
+                switch (length)
+                {
+                case 'l':   value = va_arg (args, unsigned long); break;
+                case 'q':   value = va_arg (args, unsigned long long); break;
+                case 'j':   value = va_arg (args, uintmax_t); break;
+                case 'z':   value = va_arg (args, size_t); break;
+                case 't':   value = va_arg (args, ptrdiff_t); break;
+                default:    value = va_arg (args, unsigned int); break;
+                }
+                AppendArg (record, eArgUnsigned, value);
+            }
+            break;
+
+        case 'c':
+            if (length == 'l')
+                return false;
+            AppendArg (record, eArgSigned, (int64_t)va_arg (args, int));
+            break;
+
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            {
+                double value;
+                if (length == 'L')
+                    value = va_arg (args, long double);
+                else
+                    value = va_arg (args, double);
+                uint64_t value_bits;
+                ::memcpy (&value_bits, &value, sizeof(value_bits));
+                AppendArg (record, eArgDouble, value_bits);
+            }
+            break;
+
+        case 's':
+            {
+                if (length == 'l')
+                    return false;
+                const char *cstr = va_arg (args, const char *);
+                if (cstr == NULL)
+                {
+                    record.push_back (eArgNullString);
+                }
+                else
+                {
+                    size_t cstr_len;
+                    if (has_precision)
+                    {
+                        const char *nul = (const char *)::memchr (cstr, '\0', precision);
+                        cstr_len = nul ? nul - cstr : precision;
+                    }
+                    else
+                        cstr_len = ::strlen (cstr);
+                    record.push_back (eArgString);
+                    AppendBytes (record, cstr, cstr_len);
+                }
+            }
+            break;
+
+        case 'p':
+            AppendArg (record, eArgPointer, (uint64_t)(uintptr_t)va_arg (args, void *));
+            break;
+
+        default:
+            // Wide characters, "%n" and anything we don't understand get
+            // logged as text.
+            return false;
+        }
+    }
+
+    // Fill in the length of everything after the length field
+    const uint32_t record_length = record.size() - 2 * sizeof(uint32_t);
+    ::memcpy (&record[sizeof(uint32_t)], &record_length, sizeof(record_length));
+    return true;
+}
+
+void
+LogWriter::DumpRecordHeader (Stream &s,
+                             uint32_t log_options,
+                             uint32_t sequence_id,
+                             uint64_t timestamp_usec,
+                             lldb::pid_t pid,
+                             lldb::tid_t tid,
+                             const char *thread_name)
+{
+    // Add a sequence ID if requested
+    if (log_options & LLDB_LOG_OPTION_PREPEND_SEQUENCE)
+        s.Printf ("%u ", sequence_id);
+
+    // Timestamp if requested
+    if (log_options & LLDB_LOG_OPTION_PREPEND_TIMESTAMP)
+        s.Printf ("%9llu.%6.6llu ", (unsigned long long)(timestamp_usec / 1000000), (unsigned long long)(timestamp_usec % 1000000));
+
+    // Add the process and thread if requested
+    if (log_options & LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD)
+        s.Printf ("[%4.4llx/%4.4llx]: ", (unsigned long long)pid, (unsigned long long)tid);
+
+    // Add the thread name if requested
+    if ((log_options & LLDB_LOG_OPTION_PREPEND_THREAD_NAME) && thread_name && thread_name[0])
+        s.Printf ("%s ", thread_name);
+}
+
+//----------------------------------------------------------------------
+// Decode the arguments of a binary record by walking its format string
+// and printing one conversion at a time.
+//----------------------------------------------------------------------
+static bool
+DecodeArgs (const char *format,
+            const DataExtractor &data,
+            uint32_t &offset,
+            const uint32_t end_offset,
+            Stream &strm)
+{
+    const char *p = format;
+    while (*p)
+    {
+        if (*p != '%')
+        {
+            const char *next = ::strchr (p, '%');
+            if (next == NULL)
+                next = p + ::strlen (p);
+            strm.Write (p, next - p);
+            p = next;
+            continue;
+        }
+
+        const char *spec_start = p++;
+        if (*p == '%')
+        {
+            strm.PutChar ('%');
+            ++p;
+            continue;
+        }
+
+        std::string spec ("%");
+        while (*p && ::strchr ("-+ #0'", *p))
+            spec.append (1, *p++);
+
+        // Field width and precision, '*' values were captured as arguments
+        for (int i=0; i<2; ++i)
+        {
+            if (i == 1)
+            {
+                if (*p != '.')
+                    break;
+                spec.append (1, *p++);
+            }
+
+            if (*p == '*')
+            {
+                if (offset >= end_offset || data.GetU8 (&offset) != eArgSigned)
+                    return false;
+                char value_str[32];
+                ::snprintf (value_str, sizeof(value_str), "%lli", (long long)data.GetU64 (&offset));
+                if (i == 1 && value_str[0] == '-')
+                    spec.erase (spec.size() - 1);   // Negative precision means no precision
+                else
+                    spec.append (value_str);
+                ++p;
+            }
+            else
+            {
+                while (isdigit(*p))
+                    spec.append (1, *p++);
+            }
+        }
+
+        // Skip the length modifiers, the values are all 64 bit
+        while (*p && ::strchr ("hlqjztL", *p))
+            ++p;
+
+        const char conversion = *p;
+        if (conversion == '\0')
+            break;
+        ++p;
+
+        if (offset >= end_offset)
+            return false;
+        const uint8_t arg_type = data.GetU8 (&offset);
+        switch (arg_type)
+        {
+        case eArgSigned:
+            if (conversion == 'c')
+                strm.Printf ((spec + "c").c_str(), (int)data.GetU64 (&offset));
+            else
+                strm.Printf ((spec + "lli").c_str(), (long long)data.GetU64 (&offset));
+            break;
+
+        case eArgUnsigned:
+            spec.append ("ll");
+            spec.append (1, conversion);
+            strm.Printf (spec.c_str(), (unsigned long long)data.GetU64 (&offset));
+            break;
+
+        case eArgDouble:
+            {
+                const uint64_t value_bits = data.GetU64 (&offset);
+                double value;
+                ::memcpy (&value, &value_bits, sizeof(value));
+                spec.append (1, conversion);
+                strm.Printf (spec.c_str(), value);
+            }
+            break;
+
+        case eArgString:
+            {
+                const uint32_t length = data.GetU32 (&offset);
+                const char *bytes = (const char *)data.GetData (&offset, length);
+                if (bytes == NULL)
+                    return false;
+                std::string value (bytes, length);
+                spec.append ("s");
+                strm.Printf (spec.c_str(), value.c_str());
+            }
+            break;
+
+        case eArgNullString:
+            spec.append ("s");
+            strm.Printf (spec.c_str(), "(null)");
+            break;
+
+        case eArgPointer:
+            strm.Printf ("0x%llx", (unsigned long long)data.GetU64 (&offset));
+            break;
+
+        default:
+            strm.Printf ("<invalid argument for '%.*s'>", (int)(p - spec_start), spec_start);
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t
+LogWriter::DecodeBinaryLog (const FileSpec &file, Stream &strm, Error &error)
+{
+    DataBufferSP data_sp (file.ReadFileContents (0, SIZE_MAX, &error));
+    if (!data_sp)
+    {
+        if (error.Success())
+            error.SetErrorStringWithFormat ("unable to read '%s'", file.GetFilename().AsCString("<unknown>"));
+        return 0;
+    }
+
+    const uint8_t *bytes = data_sp->GetBytes();
+    const uint32_t byte_size = data_sp->GetByteSize();
+
+    // Figure out the byte order from the first record magic. Records
+    // are then found by looking for the magic as it appears in the file.
+    ByteOrder byte_order = lldb::endian::InlHostByteOrder();
+    const uint32_t magic = LOG_BINARY_RECORD_MAGIC;
+    const uint32_t swapped_magic = ((magic & 0x000000ffu) << 24) |
+                                   ((magic & 0x0000ff00u) <<  8) |
+                                   ((magic & 0x00ff0000u) >>  8) |
+                                   ((magic & 0xff000000u) >> 24);
+    uint32_t magic_bytes = magic;
+    for (uint32_t i=0; i + sizeof(uint32_t) <= byte_size; ++i)
+    {
+        if (::memcmp (bytes + i, &magic, sizeof(magic)) == 0)
+            break;
+        if (::memcmp (bytes + i, &swapped_magic, sizeof(swapped_magic)) == 0)
+        {
+            byte_order = (byte_order == eByteOrderLittle) ? eByteOrderBig : eByteOrderLittle;
+            magic_bytes = swapped_magic;
+            break;
+        }
+    }
+
+    DataExtractor data (data_sp, byte_order, 8);
+
+    // Records can refer to format strings that were written by records
+    // from other threads that ended up later in the file, so gather the
+    // format strings first.
+    typedef std::map<uint32_t, std::string> FormatMap;
+    FormatMap formats;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        uint32_t num_records = 0;
+        uint32_t offset = 0;
+        uint32_t text_start = 0;
+        while (offset + sizeof(uint32_t) <= byte_size)
+        {
+            if (::memcmp (bytes + offset, &magic_bytes, sizeof(magic_bytes)) != 0)
+            {
+                ++offset;
+                continue;
+            }
+
+            const uint32_t record_offset = offset;
+            offset += sizeof(uint32_t);
+            const uint32_t record_length = data.GetU32 (&offset);
+            const uint32_t end_offset = offset + record_length;
+            if (end_offset > byte_size || end_offset < offset)
+            {
+                // Not a valid record, treat the magic bytes as text
+                offset = record_offset + 1;
+                continue;
+            }
+
+            // Copy any text before this record
+            if (pass == 1 && text_start < record_offset)
+                strm.Write (bytes + text_start, record_offset - text_start);
+            text_start = end_offset;
+
+            const uint32_t sequence_id = data.GetU32 (&offset);
+            const uint32_t log_options = data.GetU32 (&offset);
+            const uint64_t timestamp_usec = data.GetU64 (&offset);
+            const lldb::pid_t pid = data.GetU64 (&offset);
+            const lldb::tid_t tid = data.GetU64 (&offset);
+            const uint32_t format_idx = data.GetU32 (&offset);
+            const uint32_t format_length = data.GetU32 (&offset);
+            const char *format_bytes = (const char *)data.GetData (&offset, format_length);
+            const uint32_t thread_name_length = data.GetU32 (&offset);
+            const char *thread_name_bytes = (const char *)data.GetData (&offset, thread_name_length);
+
+            std::string format;
+            if (format_length > 0 && format_bytes)
+            {
+                format.assign (format_bytes, format_length);
+                if (pass == 0 && format_idx != UINT32_MAX)
+                    formats[format_idx] = format;
+            }
+            else
+            {
+                FormatMap::const_iterator pos = formats.find (format_idx);
+                if (pos != formats.end())
+                    format = pos->second;
+            }
+
+            if (pass == 1)
+            {
+                std::string thread_name;
+                if (thread_name_bytes)
+                    thread_name.assign (thread_name_bytes, thread_name_length);
+                DumpRecordHeader (strm, log_options, sequence_id, timestamp_usec, pid, tid, thread_name.c_str());
+                if (format.empty())
+                    strm.Printf ("<missing format string %u>", format_idx);
+                else if (!DecodeArgs (format.c_str(), data, offset, end_offset, strm))
+                    strm.PutCString (" <truncated record>");
+                strm.EOL();
+            }
+            offset = end_offset;
+            ++num_records;
+        }
+
+        if (pass == 1)
+        {
+            if (text_start < byte_size)
+                strm.Write (bytes + text_start, byte_size - text_start);
+            return num_records;
+        }
+    }
+    return 0;
+}
@@ -10,16 +10,20 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/DataBuffer.h"
 #include "lldb/Core/DataBufferHeap.h"
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/RegularExpression.h"
+#include "lldb/Core/Statistics.h"
 #include "lldb/Core/StreamString.h"
 #include "lldb/Core/Timer.h"
 #include "lldb/Host/Host.h"
 #include "lldb/lldb-private-log.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/SymbolFile.h"
 #include "lldb/Symbol/SymbolVendor.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 
@@ -129,6 +133,8 @@ Module::Module (const ModuleSpec &module_spec) :
     m_symfile_ap (),
     m_ast (),
     m_source_mappings (),
+    m_stats (),
+    m_disassembly_cache_ap (),
     m_did_load_objfile (false),
     m_did_load_symbol_vendor (false),
     m_did_parse_uuid (false),
@@ -171,6 +177,8 @@ Module::Module(const FileSpec& file_spec,
     m_symfile_ap (),
     m_ast (),
     m_source_mappings (),
+    m_stats (),
+    m_disassembly_cache_ap (),
     m_did_load_objfile (false),
     m_did_load_symbol_vendor (false),
     m_did_parse_uuid (false),
@@ -591,6 +599,45 @@ Module::FindFunctions (const ConstString &name,
     return sc_list.GetSize() - start_size;
 }
 
+bool
+Module::MightContainFunction (const ConstString &name, uint32_t name_type_mask)
+{
+    // A real lookup is cheap if the symbol file has name indexes
+    SymbolVendor *symbols = GetSymbolVendor ();
+    SymbolFile *symbol_file = symbols ? symbols->GetSymbolFile() : NULL;
+    if (symbol_file == NULL || symbol_file->HasFunctionNameIndex())
+        return true;
+
+    ObjectFile *objfile = GetObjectFile();
+    Symtab *symtab = objfile ? objfile->GetSymtab() : NULL;
+    if (symtab == NULL || symtab->GetNumSymbols() == 0)
+        return true;
+
+    const char *name_cstr = name.GetCString();
+    if (name_cstr == NULL)
+        return false;
+    // Objective C selectors and C++ operators aren't in the base name index
+    if ((name_type_mask & eFunctionNameTypeSelector) ||
+        name_cstr[0] == '-' ||
+        name_cstr[0] == '+' ||
+        ::strstr (name_cstr, "operator"))
+        return true;
+
+    std::vector<uint32_t> symbol_indexes;
+    if (symtab->FindAllSymbolsWithNameAndType (name, eSymbolTypeCode, symbol_indexes) > 0)
+        return true;
+
+    // Demangled names in the symbol table have a parameter list, so
+    // compare the base names instead
+    std::string base_name;
+    if (Symtab::GetFunctionBaseName (name_cstr, base_name))
+    {
+        if (symtab->FindAllCodeSymbolsWithBaseName (ConstString (base_name.c_str()), symbol_indexes) > 0)
+            return true;
+    }
+    return false;
+}
+
 uint32_t
 Module::FindFunctions (const RegularExpression& regex, 
                        bool include_symbols,
@@ -732,6 +779,23 @@ Module::GetSymbolVendor (bool can_create)
     return m_symfile_ap.get();
 }
 
+DisassemblyCache &
+Module::GetDisassemblyCache ()
+{
+    Mutex::Locker locker (m_mutex);
+    if (m_disassembly_cache_ap.get() == NULL)
+        m_disassembly_cache_ap.reset (new DisassemblyCache());
+    return *m_disassembly_cache_ap;
+}
+
+void
+Module::ClearDisassemblyCache ()
+{
+    Mutex::Locker locker (m_mutex);
+    if (m_disassembly_cache_ap.get())
+        m_disassembly_cache_ap->Clear();
+}
+
 void
 Module::SetFileSpecAndObjectName (const FileSpec &file, const ConstString &object_name)
 {
@@ -1208,3 +1272,37 @@ Module::RemapSourceFile (const char *path, std::string &new_path) const
     return m_source_mappings.RemapPath(path, new_path);
 }
 
+void
+Module::DumpStatistics (Stream &s)
+{
+    char path[PATH_MAX];
+    m_file.GetPath (path, sizeof(path));
+    const uint64_t num_symbols = Statistics::Get (m_stats.num_symbols);
+    const uint64_t debug_info_byte_size = Statistics::Get (m_stats.debug_info_byte_size);
+    const uint64_t clang_ast_byte_size = m_ast.GetAllocatedMemory();
+
+    s.PutCString ("{ \"path\": ");
+    Statistics::PutJSONString (s, path);
+    if (!m_object_name.IsEmpty())
+    {
+        s.PutCString (", \"object_name\": ");
+        Statistics::PutJSONString (s, m_object_name.GetCString());
+    }
+    s.PutCString (", \"triple\": ");
+    Statistics::PutJSONString (s, m_arch.GetTriple().str().c_str());
+    s.PutCString (", \"symtab_parse_seconds\": ");
+    Statistics::PutJSONSeconds (s, Statistics::Get (m_stats.symtab_parse_nsec));
+    s.PutCString (", \"symfile_index_seconds\": ");
+    Statistics::PutJSONSeconds (s, Statistics::Get (m_stats.symfile_index_nsec));
+    s.Printf (", \"num_symbols\": %llu", num_symbols);
+    s.Printf (", \"num_dies_parsed\": %llu", Statistics::Get (m_stats.num_dies_parsed));
+    s.Printf (", \"num_types_completed\": %llu", Statistics::Get (m_stats.num_types_completed));
+    s.Printf (", \"num_methods_deferred\": %llu", Statistics::Get (m_stats.num_methods_deferred));
+    s.Printf (", \"num_methods_completed\": %llu", Statistics::Get (m_stats.num_methods_completed));
+    s.Printf (", \"disassembly_cache_hits\": %llu", Statistics::Get (m_stats.num_disassembly_cache_hits));
+    s.Printf (", \"disassembly_cache_misses\": %llu", Statistics::Get (m_stats.num_disassembly_cache_misses));
+    s.Printf (", \"clang_ast_bytes\": %llu", clang_ast_byte_size);
+    s.Printf (", \"memory_used_bytes\": %llu", num_symbols * sizeof(Symbol) + debug_info_byte_size + clang_ast_byte_size);
+    s.PutCString (" }");
+}
+
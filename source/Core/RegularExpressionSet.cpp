@@ -0,0 +1,201 @@
+//===-- RegularExpressionSet.cpp --------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/RegularExpressionSet.h"
+
+// C Includes
+#include <ctype.h>
+#include <string.h>
+
+// C++ Includes
+#include <algorithm>
+
+// Other libraries and framework includes
+// Project includes
+
+using namespace lldb;
+using namespace lldb_private;
+
+RegularExpressionSet::RegularExpressionSet () :
+    m_regexes (),
+    m_trie (1),
+    m_unanchored (),
+    m_always (),
+    m_candidates (),
+    m_unanchored_regex (),
+    m_unanchored_regex_valid (false),
+    m_unanchored_regex_stale (false)
+{
+}
+
+RegularExpressionSet::~RegularExpressionSet ()
+{
+}
+
+void
+RegularExpressionSet::Clear ()
+{
+    m_regexes.clear();
+    m_trie.clear();
+    m_trie.resize(1);
+    m_unanchored.clear();
+    m_always.clear();
+    m_unanchored_regex.Free();
+    m_unanchored_regex_valid = false;
+    m_unanchored_regex_stale = false;
+}
+
+bool
+RegularExpressionSet::GetLiteralPrefix (const RegularExpression &regex, std::string &prefix)
+{
+    prefix.clear();
+    // Only plain extended regular expressions are understood here, and an
+    // alternation anywhere means the anchor might not apply to all of it
+    if (regex.GetCompileFlags() != REG_EXTENDED)
+        return false;
+    const char *re = regex.GetText();
+    if (re == NULL || re[0] != '^' || ::strchr (re, '|'))
+        return false;
+
+    for (const char *p = re + 1; *p; ++p)
+    {
+        const char ch = *p;
+        if (ch == '\\')
+        {
+            // "\." is a literal '.', but escaped letters and digits may
+            // be back references or character classes
+            if (p[1] == '\0' || isalnum(p[1]))
+                break;
+            ++p;
+            prefix.push_back (*p);
+        }
+        else if (::strchr (".[]()*+?{}^$", ch))
+        {
+            // The last literal character is optional if it is followed
+            // by a quantifier that allows zero repetitions
+            if ((ch == '*' || ch == '?' || ch == '{') && !prefix.empty())
+                prefix.erase (prefix.size() - 1);
+            break;
+        }
+        else
+        {
+            prefix.push_back (ch);
+        }
+    }
+    return !prefix.empty();
+}
+
+uint32_t
+RegularExpressionSet::Append (const RegularExpressionSP &regex_sp)
+{
+    const uint32_t regex_idx = m_regexes.size();
+    m_regexes.push_back (regex_sp);
+
+    if (!regex_sp || !regex_sp->IsValid())
+    {
+        // Invalid regular expressions never match, but still take up an
+        // index so they stay in sync with the caller
+        return regex_idx;
+    }
+
+    std::string prefix;
+    if (GetLiteralPrefix (*regex_sp, prefix))
+    {
+        uint32_t node_idx = 0;
+        for (size_t i = 0; i < prefix.size(); ++i)
+        {
+            std::map<char, uint32_t>::const_iterator pos = m_trie[node_idx].children.find (prefix[i]);
+            if (pos != m_trie[node_idx].children.end())
+            {
+                node_idx = pos->second;
+            }
+            else
+            {
+                const uint32_t child_idx = m_trie.size();
+                m_trie.push_back (TrieNode());
+                m_trie[node_idx].children[prefix[i]] = child_idx;
+                node_idx = child_idx;
+            }
+        }
+        m_trie[node_idx].regex_indexes.push_back (regex_idx);
+    }
+    else if (regex_sp->GetCompileFlags() == REG_EXTENDED)
+    {
+        m_unanchored.push_back (regex_idx);
+        m_unanchored_regex_stale = true;
+    }
+    else
+    {
+        m_always.push_back (regex_idx);
+    }
+    return regex_idx;
+}
+
+void
+RegularExpressionSet::CompileUnanchored ()
+{
+    m_unanchored_regex_stale = false;
+    m_unanchored_regex_valid = false;
+    // There is nothing to gain from an alternation of one
+    if (m_unanchored.size() < 2)
+        return;
+
+    std::string alternation;
+    for (size_t i = 0; i < m_unanchored.size(); ++i)
+    {
+        if (i > 0)
+            alternation.push_back ('|');
+        alternation.push_back ('(');
+        alternation.append (m_regexes[m_unanchored[i]]->GetText());
+        alternation.push_back (')');
+    }
+    // If the combined expression doesn't compile (too large, or a back
+    // reference that now refers to the wrong group) every unanchored
+    // regular expression just gets run on its own
+    m_unanchored_regex_valid = m_unanchored_regex.Compile (alternation.c_str(), REG_EXTENDED | REG_NOSUB);
+}
+
+uint32_t
+RegularExpressionSet::FindFirstMatch (const char *s)
+{
+    if (s == NULL)
+        return UINT32_MAX;
+
+    m_candidates.clear();
+    uint32_t node_idx = 0;
+    for (const char *p = s; *p; ++p)
+    {
+        std::map<char, uint32_t>::const_iterator pos = m_trie[node_idx].children.find (*p);
+        if (pos == m_trie[node_idx].children.end())
+            break;
+        node_idx = pos->second;
+        const std::vector<uint32_t> &regex_indexes = m_trie[node_idx].regex_indexes;
+        m_candidates.insert (m_candidates.end(), regex_indexes.begin(), regex_indexes.end());
+    }
+
+    if (!m_unanchored.empty())
+    {
+        if (m_unanchored_regex_stale)
+            CompileUnanchored ();
+        if (!m_unanchored_regex_valid || m_unanchored_regex.Execute (s))
+            m_candidates.insert (m_candidates.end(), m_unanchored.begin(), m_unanchored.end());
+    }
+    m_candidates.insert (m_candidates.end(), m_always.begin(), m_always.end());
+
+    // Each regular expression is in exactly one of the lists above, so
+    // sorting is all it takes to try them in priority order
+    std::sort (m_candidates.begin(), m_candidates.end());
+    for (size_t i = 0; i < m_candidates.size(); ++i)
+    {
+        const uint32_t regex_idx = m_candidates[i];
+        if (m_regexes[regex_idx]->Execute (s))
+            return regex_idx;
+    }
+    return UINT32_MAX;
+}
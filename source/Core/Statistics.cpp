@@ -0,0 +1,53 @@
+//===-- Statistics.cpp ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/Statistics.h"
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Stream.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+void
+Statistics::PutJSONString (Stream &s, const char *cstr)
+{
+    s.PutChar('"');
+    if (cstr)
+    {
+        for (const char *p = cstr; *p; ++p)
+        {
+            const char ch = *p;
+            switch (ch)
+            {
+            case '"':   s.PutCString("\\\""); break;
+            case '\\':  s.PutCString("\\\\"); break;
+            case '\n':  s.PutCString("\\n"); break;
+            case '\r':  s.PutCString("\\r"); break;
+            case '\t':  s.PutCString("\\t"); break;
+            default:
+                if ((unsigned char)ch < 0x20)
+                    s.Printf("\\u%4.4x", (unsigned char)ch);
+                else
+                    s.PutChar(ch);
+                break;
+            }
+        }
+    }
+    s.PutChar('"');
+}
+
+void
+Statistics::PutJSONSeconds (Stream &s, uint64_t nsec)
+{
+    s.Printf("%.9f", nsec / 1000000000.0);
+}
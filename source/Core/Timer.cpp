@@ -8,7 +8,6 @@
 //===----------------------------------------------------------------------===//
 #include "lldb/Core/Timer.h"
 
-#include <map>
 #include <vector>
 #include <algorithm>
 
@@ -16,49 +15,133 @@
 #include "lldb/Host/Mutex.h"
 
 #include <stdio.h>
+#include <string.h>
 
 using namespace lldb_private;
 
 #define TIMER_INDENT_AMOUNT 2
+// The maximum number of distinct timer categories. Any categories past
+// this limit get their times accumulated into a single overflow category.
+#define TIMER_MAX_CATEGORIES 2048
 static bool g_quiet = true;
-uint32_t Timer::g_depth = 0;
 uint32_t Timer::g_display_depth = 0;
 FILE * Timer::g_file = NULL;
 typedef std::vector<Timer *> TimerStack;
-typedef std::map<const char *, uint64_t> CategoryMap;
 static pthread_key_t g_key;
 
+//----------------------------------------------------------------------
+// Per-thread timer state. Only the owning thread pushes and pops timers
+// and adds to the category times, so no locking is needed when a timer
+// is destroyed. Other threads only read (dump) or clear (reset) the
+// category times, which are always accessed atomically.
+//----------------------------------------------------------------------
+class Timer::ThreadData
+{
+public:
+    ThreadData () :
+        stack (),
+        depth (0)
+    {
+        ::memset (category_nsec, 0, sizeof(category_nsec));
+    }
+
+    TimerStack stack;
+    uint32_t depth;
+    uint64_t category_nsec[TIMER_MAX_CATEGORIES + 1];
+};
+
+typedef std::vector<Timer::ThreadData *> ThreadDataList;
+
+//----------------------------------------------------------------------
+// Lock free table of category names. A slot is claimed with a compare
+// and swap the first time a category is seen and never changes after
+// that, so the slot index can be used as a stable category index.
+//----------------------------------------------------------------------
+static const char * volatile g_categories[TIMER_MAX_CATEGORIES];
+
+// Times that were accumulated by threads that have since exited.
+static uint64_t g_exited_thread_category_nsec[TIMER_MAX_CATEGORIES + 1];
+
 static Mutex &
-GetCategoryMutex()
+GetThreadDataMutex()
 {
-    static Mutex g_category_mutex(Mutex::eMutexTypeNormal);
-    return g_category_mutex;
+    static Mutex g_thread_data_mutex(Mutex::eMutexTypeNormal);
+    return g_thread_data_mutex;
 }
 
-static CategoryMap &
-GetCategoryMap()
+static ThreadDataList &
+GetThreadDataList()
 {
-    static CategoryMap g_category_map;
-    return g_category_map;
+    static ThreadDataList g_thread_data_list;
+    return g_thread_data_list;
 }
 
+static uint32_t
+GetCategoryIndex (const char *category)
+{
+    // Categories are almost always string literals (__PRETTY_FUNCTION__),
+    // so the pointer value is used as both the identity and the hash.
+    const uint32_t hash = (uint32_t)((uintptr_t)category >> 2) * 2654435761u;
+    for (uint32_t probe = 0; probe < TIMER_MAX_CATEGORIES; ++probe)
+    {
+        const uint32_t idx = (hash + probe) & (TIMER_MAX_CATEGORIES - 1);
+        const char *slot_category = g_categories[idx];
+        if (slot_category == category)
+            return idx;
+        if (slot_category == NULL)
+        {
+            if (__sync_bool_compare_and_swap (&g_categories[idx], (const char *)NULL, category))
+                return idx;
+            // Another thread claimed this slot first, it might have been
+            // for the same category.
+            if (g_categories[idx] == category)
+                return idx;
+        }
+    }
+    return TIMER_MAX_CATEGORIES;
+}
+
+static const char *
+GetCategoryName (uint32_t idx)
+{
+    if (idx < TIMER_MAX_CATEGORIES)
+        return g_categories[idx];
+    return "<other timer categories>";
+}
 
-static TimerStack *
-GetTimerStackForCurrentThread ()
+static Timer::ThreadData *
+GetThreadDataForCurrentThread ()
 {
-    void *timer_stack = ::pthread_getspecific (g_key);
-    if (timer_stack == NULL)
+    Timer::ThreadData *thread_data = (Timer::ThreadData *)::pthread_getspecific (g_key);
+    if (thread_data == NULL)
     {
-        ::pthread_setspecific (g_key, new TimerStack);
-        timer_stack = ::pthread_getspecific (g_key);
+        thread_data = new Timer::ThreadData;
+        {
+            Mutex::Locker locker (GetThreadDataMutex());
+            GetThreadDataList().push_back (thread_data);
+        }
+        ::pthread_setspecific (g_key, thread_data);
     }
-    return (TimerStack *)timer_stack;
+    return thread_data;
 }
 
-void
+static void
 ThreadSpecificCleanup (void *p)
 {
-    delete (TimerStack *)p;
+    Timer::ThreadData *thread_data = (Timer::ThreadData *)p;
+    Mutex::Locker locker (GetThreadDataMutex());
+    // Keep the times from this thread around so they still get dumped
+    for (uint32_t i=0; i<=TIMER_MAX_CATEGORIES; ++i)
+    {
+        const uint64_t nsec = __sync_fetch_and_add (&thread_data->category_nsec[i], 0);
+        if (nsec)
+            __sync_add_and_fetch (&g_exited_thread_category_nsec[i], nsec);
+    }
+    ThreadDataList &thread_data_list = GetThreadDataList();
+    ThreadDataList::iterator pos = std::find (thread_data_list.begin(), thread_data_list.end(), thread_data);
+    if (pos != thread_data_list.end())
+        thread_data_list.erase (pos);
+    delete thread_data;
 }
 
 void
@@ -77,17 +160,24 @@ Timer::Initialize ()
 
 Timer::Timer (const char *category, const char *format, ...) :
     m_category (category),
+    m_thread_data (NULL),
     m_total_start (),
     m_timer_start (),
     m_total_ticks (0),
     m_timer_ticks (0)
 {
-    if (g_depth++ < g_display_depth)
+    // Timers don't touch any shared or thread specific state unless they
+    // have been enabled, so they can be left in hot code paths.
+    if (g_display_depth == 0)
+        return;
+
+    m_thread_data = GetThreadDataForCurrentThread ();
+    if (m_thread_data->depth++ < g_display_depth)
     {
         if (g_quiet == false)
         {
             // Indent
-            ::fprintf (g_file, "%*s", g_depth * TIMER_INDENT_AMOUNT, "");
+            ::fprintf (g_file, "%*s", m_thread_data->depth * TIMER_INDENT_AMOUNT, "");
             // Print formatted string
             va_list args;
             va_start (args, format);
@@ -100,19 +190,19 @@ Timer::Timer (const char *category, const char *format, ...) :
         TimeValue start_time(TimeValue::Now());
         m_total_start = start_time;
         m_timer_start = start_time;
-        TimerStack *stack = GetTimerStackForCurrentThread ();
-        if (stack)
-        {
-            if (stack->empty() == false)
-                stack->back()->ChildStarted (start_time);
-            stack->push_back(this);
-        }
+        TimerStack &stack = m_thread_data->stack;
+        if (stack.empty() == false)
+            stack.back()->ChildStarted (start_time);
+        stack.push_back(this);
     }
 }
 
 
 Timer::~Timer()
 {
+    if (m_thread_data == NULL)
+        return;
+
     if (m_total_start.IsValid())
     {
         TimeValue stop_time = TimeValue::Now();
@@ -127,14 +217,11 @@ Timer::~Timer()
             m_timer_start.Clear();
         }
 
-        TimerStack *stack = GetTimerStackForCurrentThread ();
-        if (stack)
-        {
-            assert (stack->back() == this);
-            stack->pop_back();
-            if (stack->empty() == false)
-                stack->back()->ChildStopped(stop_time);
-        }
+        TimerStack &stack = m_thread_data->stack;
+        assert (stack.back() == this);
+        stack.pop_back();
+        if (stack.empty() == false)
+            stack.back()->ChildStopped(stop_time);
 
         const uint64_t total_nsec_uint = GetTotalElapsedNanoSeconds();
         const uint64_t timer_nsec_uint = GetTimerElapsedNanoSeconds();
@@ -146,18 +233,19 @@ Timer::~Timer()
 
             ::fprintf (g_file,
                        "%*s%.9f sec (%.9f sec)\n",
-                       (g_depth - 1) *TIMER_INDENT_AMOUNT, "",
+                       (m_thread_data->depth - 1) *TIMER_INDENT_AMOUNT, "",
                        total_nsec / 1000000000.0,
                        timer_nsec / 1000000000.0);
         }
 
         // Keep total results for each category so we can dump results.
-        Mutex::Locker locker (GetCategoryMutex());
-        CategoryMap &category_map = GetCategoryMap();
-        category_map[m_category] += timer_nsec_uint;
+        // Only this thread adds to its category times, but the add is
+        // atomic so it can't race with a reset from another thread.
+        const uint32_t category_idx = GetCategoryIndex (m_category);
+        __sync_add_and_fetch (&m_thread_data->category_nsec[category_idx], timer_nsec_uint);
     }
-    if (g_depth > 0)
-        --g_depth;
+    if (m_thread_data->depth > 0)
+        --m_thread_data->depth;
 }
 
 uint64_t
@@ -210,41 +298,53 @@ Timer::SetDisplayDepth (uint32_t depth)
 }
 
 
-/* binary function predicate:
- * - returns whether a person is less than another person
- */
+typedef std::pair<const char *, uint64_t> CategoryTime;
+
 static bool
-CategoryMapIteratorSortCriterion (const CategoryMap::const_iterator& lhs, const CategoryMap::const_iterator& rhs)
+CategoryTimeSortCriterion (const CategoryTime& lhs, const CategoryTime& rhs)
 {
-    return lhs->second > rhs->second;
+    return lhs.second > rhs.second;
 }
 
 
 void
 Timer::ResetCategoryTimes ()
 {
-    Mutex::Locker locker (GetCategoryMutex());
-    CategoryMap &category_map = GetCategoryMap();
-    category_map.clear();
+    Mutex::Locker locker (GetThreadDataMutex());
+    ThreadDataList &thread_data_list = GetThreadDataList();
+    ThreadDataList::iterator pos, end = thread_data_list.end();
+    for (uint32_t i=0; i<=TIMER_MAX_CATEGORIES; ++i)
+    {
+        __sync_fetch_and_and (&g_exited_thread_category_nsec[i], 0);
+        for (pos = thread_data_list.begin(); pos != end; ++pos)
+            __sync_fetch_and_and (&(*pos)->category_nsec[i], 0);
+    }
 }
 
 void
 Timer::DumpCategoryTimes (Stream *s)
 {
-    Mutex::Locker locker (GetCategoryMutex());
-    CategoryMap &category_map = GetCategoryMap();
-    std::vector<CategoryMap::const_iterator> sorted_iterators;
-    CategoryMap::const_iterator pos, end = category_map.end();
-    for (pos = category_map.begin(); pos != end; ++pos)
+    std::vector<CategoryTime> category_times;
     {
-        sorted_iterators.push_back (pos);
+        // Merge the category times from all threads
+        Mutex::Locker locker (GetThreadDataMutex());
+        ThreadDataList &thread_data_list = GetThreadDataList();
+        ThreadDataList::iterator pos, end = thread_data_list.end();
+        for (uint32_t i=0; i<=TIMER_MAX_CATEGORIES; ++i)
+        {
+            uint64_t nsec = __sync_fetch_and_add (&g_exited_thread_category_nsec[i], 0);
+            for (pos = thread_data_list.begin(); pos != end; ++pos)
+                nsec += __sync_fetch_and_add (&(*pos)->category_nsec[i], 0);
+            if (nsec > 0)
+                category_times.push_back (CategoryTime (GetCategoryName (i), nsec));
+        }
     }
-    std::sort (sorted_iterators.begin(), sorted_iterators.end(), CategoryMapIteratorSortCriterion);
+    std::sort (category_times.begin(), category_times.end(), CategoryTimeSortCriterion);
 
-    const size_t count = sorted_iterators.size();
+    const size_t count = category_times.size();
     for (size_t i=0; i<count; ++i)
     {
-        const double timer_nsec = sorted_iterators[i]->second;
-        s->Printf("%.9f sec for %s\n", timer_nsec / 1000000000.0, sorted_iterators[i]->first);
+        const double timer_nsec = category_times[i].second;
+        s->Printf("%.9f sec for %s\n", timer_nsec / 1000000000.0, category_times[i].first);
     }
 }
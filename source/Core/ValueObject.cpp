@@ -11,8 +11,10 @@
 
 // C Includes
 #include <stdlib.h>
+#include <string.h>
 
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 #include "llvm/Support/raw_ostream.h"
 #include "clang/AST/Type.h"
@@ -85,8 +87,11 @@ ValueObject::ValueObject (ValueObject &parent) :
     m_synthetic_children_sp(),
     m_user_id_of_forced_summary(),
     m_address_type_of_ptr_or_ref_children(eAddressTypeInvalid),
+    m_pointee_data(),
+    m_pointee_data_addr(LLDB_INVALID_ADDRESS),
     m_value_is_valid (false),
     m_value_did_change (false),
+    m_data_did_change (false),
     m_children_count_valid (false),
     m_old_value_valid (false),
     m_is_deref_of_parent (false),
@@ -131,8 +136,11 @@ ValueObject::ValueObject (ExecutionContextScope *exe_scope,
     m_synthetic_children_sp(),
     m_user_id_of_forced_summary(),
     m_address_type_of_ptr_or_ref_children(child_ptr_or_ref_addr_type),
+    m_pointee_data(),
+    m_pointee_data_addr(LLDB_INVALID_ADDRESS),
     m_value_is_valid (false),
     m_value_did_change (false),
+    m_data_did_change (false),
     m_children_count_valid (false),
     m_old_value_valid (false),
     m_is_deref_of_parent (false),
@@ -204,6 +212,8 @@ ValueObject::UpdateValueIfNeeded (DynamicValueType use_dynamic, bool update_form
 
         ClearUserVisibleData();
         
+        ClearPointeeData();
+        
         if (IsInScope())
         {
             const bool value_was_valid = GetValueIsValid();
@@ -211,11 +221,30 @@ ValueObject::UpdateValueIfNeeded (DynamicValueType use_dynamic, bool update_form
             
             m_error.Clear();
 
+            // UpdateValue() may read the new value into the buffer m_data
+            // already uses, so keep a copy of the old bytes to compare
+            // against
+            DataBufferSP previous_data_sp;
+            if (!first_update && value_was_valid && m_data.GetByteSize() > 0)
+                previous_data_sp.reset (new DataBufferHeap (m_data.GetDataStart(), m_data.GetByteSize()));
+
             // Call the pure virtual function to update the value
             bool success = UpdateValue ();
             
             SetValueIsValid (success);
             
+            m_data_did_change = !first_update;
+            if (success && previous_data_sp &&
+                previous_data_sp->GetByteSize() == m_data.GetByteSize() &&
+                ::memcmp (previous_data_sp->GetBytes(), m_data.GetDataStart(), m_data.GetByteSize()) == 0)
+            {
+                m_data_did_change = false;
+                // The value string only depends on the bytes and the format,
+                // so reuse it rather than formatting the value again
+                if (m_old_value_valid && !did_change_formats && !IsDynamic() && !IsSynthetic())
+                    m_value_str = m_old_value_str;
+            }
+            
             if (first_update)
                 SetValueDidChange (false);
             else if (!m_value_did_change && success == false)
@@ -495,6 +524,37 @@ ValueObject::SetValueDidChange (bool value_changed)
     m_value_did_change = value_changed;
 }
 
+bool
+ValueObject::GetDataDidChange ()
+{
+    UpdateValueIfNeeded (false);
+    return m_data_did_change;
+}
+
+size_t
+ValueObject::GetChangedChildren (ValueObjectList &changed_children)
+{
+    if (!UpdateValueIfNeeded (false))
+        return 0;
+    size_t num_changed = 0;
+    const uint32_t num_children = m_children.GetChildrenCount();
+    for (uint32_t idx = 0; idx < num_children; ++idx)
+    {
+        if (!m_children.HasChildAtIndex (idx))
+            continue;
+        ValueObject *child = m_children.GetChildAtIndex (idx);
+        if (child == NULL)
+            continue;
+        child->UpdateValueIfNeeded (false);
+        if (child->m_data_did_change || child->GetValueDidChange())
+        {
+            changed_children.Append (child->GetSP());
+            ++num_changed;
+        }
+    }
+    return num_changed;
+}
+
 ValueObjectSP
 ValueObject::GetChildAtIndex (uint32_t idx, bool can_create)
 {
@@ -584,6 +644,24 @@ ValueObject::GetNumChildren ()
     }
     return m_children.GetChildrenCount();
 }
+
+uint32_t
+ValueObject::GetNumChildren (uint32_t max)
+{
+    UpdateValueIfNeeded();
+    if (!m_children_count_valid)
+    {
+        const uint32_t num_children = CalculateNumChildrenUpTo (max);
+        // A count of exactly max might have been cut short, so don't
+        // remember it as the real number of children
+        if (num_children == max && max != UINT32_MAX)
+            return max;
+        SetNumChildren (num_children);
+    }
+    const uint32_t num_children = m_children.GetChildrenCount();
+    return num_children < max ? num_children : max;
+}
+
 void
 ValueObject::SetNumChildren (uint32_t num_children)
 {
@@ -643,17 +721,17 @@ ValueObject::CreateChildAtIndex (uint32_t idx, bool synthetic_array_member, int3
         if (!child_name_str.empty())
             child_name.SetCString (child_name_str.c_str());
 
-        valobj = new ValueObjectChild (*this,
-                                       clang_ast,
-                                       child_clang_type,
-                                       child_name,
-                                       child_byte_size,
-                                       child_byte_offset,
-                                       child_bitfield_bit_size,
-                                       child_bitfield_bit_offset,
-                                       child_is_base_class,
-                                       child_is_deref_of_parent,
-                                       eAddressTypeInvalid);
+        valobj = new (*this) ValueObjectChild (*this,
+                                               clang_ast,
+                                               child_clang_type,
+                                               child_name,
+                                               child_byte_size,
+                                               child_byte_offset,
+                                               child_bitfield_bit_size,
+                                               child_bitfield_bit_offset,
+                                               child_is_base_class,
+                                               child_is_deref_of_parent,
+                                               eAddressTypeInvalid);
         //if (valobj)
         //    valobj->SetAddressTypeOfChildren(eAddressTypeInvalid);
    }
@@ -1600,6 +1678,143 @@ ValueObject::GetPointerValue (AddressType *address_type)
     return address;
 }
 
+void
+ValueObject::PrefetchChildPointees (uint32_t idx_start, uint32_t idx_end)
+{
+    if (idx_end <= idx_start + 1)
+        return;
+    ProcessSP process_sp (GetProcessSP());
+    if (!process_sp || !process_sp->IsAlive())
+        return;
+
+    Process::LoadRangeList ranges;
+    for (uint32_t idx = idx_start; idx < idx_end; ++idx)
+    {
+        ValueObjectSP child_sp (GetChildAtIndex (idx, true));
+        if (!child_sp || !child_sp->IsPointerType())
+            continue;
+        AddressType address_type = eAddressTypeInvalid;
+        const addr_t pointee_addr = child_sp->GetPointerValue (&address_type);
+        if (address_type != eAddressTypeLoad || pointee_addr == 0 || pointee_addr == LLDB_INVALID_ADDRESS)
+            continue;
+        uint32_t pointee_size = ClangASTType::GetTypeByteSize (child_sp->GetClangAST(),
+                                                               ClangASTType::GetPointeeType (child_sp->GetClangType()));
+        if (pointee_size == 0)
+            pointee_size = 1;
+        ranges.push_back (Process::LoadRange (pointee_addr, pointee_size));
+    }
+    // A single pointee gains nothing over reading it when it is displayed
+    if (ranges.size() > 1)
+        process_sp->PrefetchMemoryRanges (ranges);
+}
+
+bool
+ValueObject::GetDataForMemberChild (int32_t byte_offset,
+                                    uint32_t byte_size,
+                                    DataExtractor &data)
+{
+    if (!UpdateValueIfNeeded(false))
+        return false;
+    
+    // Only values that were read from memory as a whole can be sliced,
+    // scalars and register values are left to the child
+    switch (m_value.GetValueType())
+    {
+    case Value::eValueTypeLoadAddress:
+    case Value::eValueTypeFileAddress:
+    case Value::eValueTypeHostAddress:
+        break;
+    default:
+        return false;
+    }
+    
+    // A child must not point into bytes it doesn't own a reference to
+    if (!m_data.GetSharedDataBuffer())
+        return false;
+    
+    if (byte_offset < 0 || byte_size == 0 ||
+        (uint64_t)byte_offset + byte_size > m_data.GetByteSize())
+        return false;
+    
+    return data.SetData (m_data, byte_offset, byte_size) == byte_size;
+}
+
+// Limit how much memory a single range of pointee children may read, the
+// range comes from the user and may be far larger than the real array
+static const uint64_t g_max_pointee_data_size = 64 * 1024;
+
+bool
+ValueObject::ReadPointeeData (uint32_t idx_start, uint32_t idx_end)
+{
+    ClearPointeeData();
+    
+    // Only synthetic array members of a pointer are laid out one after
+    // the other, a reference has just the one child
+    if (idx_end <= idx_start + 1 || !IsPointerType())
+        return false;
+    
+    ProcessSP process_sp (GetProcessSP());
+    if (!process_sp || !process_sp->IsAlive())
+        return false;
+    
+    AddressType address_type = eAddressTypeInvalid;
+    const addr_t pointer_value = GetPointerValue (&address_type);
+    if (address_type != eAddressTypeLoad || pointer_value == 0 || pointer_value == LLDB_INVALID_ADDRESS)
+        return false;
+    
+    const uint64_t element_size = ClangASTType::GetTypeByteSize (GetClangAST(),
+                                                                 ClangASTType::GetPointeeType (GetClangType()));
+    if (element_size == 0)
+        return false;
+    
+    uint64_t num_elements = idx_end - idx_start;
+    if (num_elements * element_size > g_max_pointee_data_size)
+        num_elements = g_max_pointee_data_size / element_size;
+    if (num_elements <= 1)
+        return false;
+    
+    const addr_t addr = pointer_value + idx_start * element_size;
+    const uint64_t read_size = num_elements * element_size;
+    DataBufferSP buffer_sp (new DataBufferHeap (read_size, 0));
+    Error error;
+    const size_t bytes_read = process_sp->ReadMemory (addr, buffer_sp->GetBytes(), read_size, error);
+    // Keep only whole elements, the members past a short read will read
+    // their own memory and report their own errors
+    const size_t usable_size = bytes_read - bytes_read % element_size;
+    if (usable_size == 0)
+        return false;
+    
+    m_pointee_data.SetByteOrder (process_sp->GetByteOrder());
+    m_pointee_data.SetAddressByteSize (process_sp->GetAddressByteSize());
+    m_pointee_data.SetData (buffer_sp, 0, usable_size);
+    m_pointee_data_addr = addr;
+    return true;
+}
+
+void
+ValueObject::ClearPointeeData ()
+{
+    m_pointee_data.Clear();
+    m_pointee_data_addr = LLDB_INVALID_ADDRESS;
+}
+
+bool
+ValueObject::GetDataForPointeeChild (lldb::addr_t addr,
+                                     uint32_t byte_size,
+                                     DataExtractor &data)
+{
+    if (addr == LLDB_INVALID_ADDRESS || byte_size == 0)
+        return false;
+    
+    if (m_pointee_data_addr != LLDB_INVALID_ADDRESS &&
+        addr >= m_pointee_data_addr &&
+        addr + byte_size <= m_pointee_data_addr + m_pointee_data.GetByteSize())
+    {
+        return data.SetData (m_pointee_data, addr - m_pointee_data_addr, byte_size) == byte_size;
+    }
+    return false;
+}
+
 bool
 ValueObject::SetValueFromCString (const char *value_str, Error& error)
 {
@@ -1889,17 +2104,17 @@ ValueObject::GetSyntheticBitFieldChild (uint32_t from, uint32_t to, bool can_cre
             ValueObjectChild *synthetic_child;
             // We haven't made a synthetic array member for INDEX yet, so
             // lets make one and cache it for any future reference.
-            synthetic_child = new ValueObjectChild(*this,
-                                                      GetClangAST(),
-                                                      GetClangType(),
-                                                      index_const_str,
-                                                      GetByteSize(),
-                                                      0,
-                                                      to-from+1,
-                                                      from,
-                                                      false,
-                                                      false,
-                                                      eAddressTypeInvalid);
+            synthetic_child = new (*this) ValueObjectChild(*this,
+                                                              GetClangAST(),
+                                                              GetClangType(),
+                                                              index_const_str,
+                                                              GetByteSize(),
+                                                              0,
+                                                              to-from+1,
+                                                              from,
+                                                              false,
+                                                              false,
+                                                              eAddressTypeInvalid);
             
             // Cache the value if we got one back...
             if (synthetic_child)
@@ -1970,17 +2185,17 @@ ValueObject::GetSyntheticChildAtOffset(uint32_t offset, const ClangASTType& type
     if (!can_create)
         return ValueObjectSP();
     
-    ValueObjectChild *synthetic_child = new ValueObjectChild(*this,
-                                                             type.GetASTContext(),
-                                                             type.GetOpaqueQualType(),
-                                                             name_const_str,
-                                                             type.GetTypeByteSize(),
-                                                             offset,
-                                                             0,
-                                                             0,
-                                                             false,
-                                                             false,
-                                                             eAddressTypeInvalid);
+    ValueObjectChild *synthetic_child = new (*this) ValueObjectChild(*this,
+                                                                     type.GetASTContext(),
+                                                                     type.GetOpaqueQualType(),
+                                                                     name_const_str,
+                                                                     type.GetTypeByteSize(),
+                                                                     offset,
+                                                                     0,
+                                                                     0,
+                                                                     false,
+                                                                     false,
+                                                                     eAddressTypeInvalid);
     if (synthetic_child)
     {
         AddSyntheticChild(name_const_str, synthetic_child);
@@ -3332,7 +3547,23 @@ DumpValueObject_Impl (Stream &s,
                     ValueObjectSP synth_valobj_sp = valobj->GetSyntheticValue (options.m_use_synthetic);
                     synth_valobj = (synth_valobj_sp ? synth_valobj_sp.get() : valobj);
                     
-                    uint32_t num_children = synth_valobj->GetNumChildren();
+                    // Work out which children will be displayed before counting them,
+                    // counting every element of a huge synthetic container can take
+                    // a very long time
+                    uint32_t children_start = 0;
+                    uint32_t max_num_children = options.m_ignore_cap ? UINT32_MAX : valobj->GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
+                    if (curr_depth == 0)
+                    {
+                        children_start = options.m_children_start;
+                        if (options.m_children_count != UINT32_MAX)
+                            max_num_children = options.m_children_count;
+                    }
+                    uint32_t children_end = UINT32_MAX;
+                    if (max_num_children < UINT32_MAX - children_start)
+                        children_end = children_start + max_num_children;
+                    
+                    // Count one more child than we display to know whether there are more
+                    uint32_t num_children = synth_valobj->GetNumChildren(children_end == UINT32_MAX ? UINT32_MAX : children_end + 1);
                     bool print_dotdotdot = false;
                     if (num_children)
                     {
@@ -3348,19 +3579,22 @@ DumpValueObject_Impl (Stream &s,
                             s.IndentMore();
                         }
                         
-                        uint32_t max_num_children = valobj->GetTargetSP()->GetMaximumNumberOfChildrenToDisplay();
-                        
-                        if (num_children > max_num_children && !options.m_ignore_cap)
+                        if (num_children > children_end)
                         {
-                            num_children = max_num_children;
+                            num_children = children_end;
                             print_dotdotdot = true;
                         }
 
                         ValueObject::DumpValueObjectOptions child_options(options);
-                        child_options.SetFormat().SetSummary().SetRootValueObjectName();
+                        child_options.SetFormat().SetSummary().SetRootValueObjectName().SetChildrenRange();
                         child_options.SetScopeChecked(true)
                         .SetOmitSummaryDepth(child_options.m_omit_summary_depth > 1 ? child_options.m_omit_summary_depth - 1 : 0);
-                        for (uint32_t idx=0; idx<num_children; ++idx)
+                        const uint32_t child_ptr_depth = (is_ptr || is_ref) ? curr_ptr_depth - 1 : curr_ptr_depth;
+                        // Only read ahead what pointer children point to if
+                        // the children will get to show their pointees
+                        if (child_ptr_depth > 0 && curr_depth + 1 < options.m_max_depth)
+                            synth_valobj->PrefetchChildPointees (children_start, num_children);
+                        for (uint32_t idx=children_start; idx<num_children; ++idx)
                         {
                             ValueObjectSP child_sp(synth_valobj->GetChildAtIndex(idx, true));
                             if (child_sp.get())
@@ -3368,7 +3602,7 @@ DumpValueObject_Impl (Stream &s,
                                 DumpValueObject_Impl (s,
                                                       child_sp.get(),
                                                       child_options,
-                                                      (is_ptr || is_ref) ? curr_ptr_depth - 1 : curr_ptr_depth,
+                                                      child_ptr_depth,
                                                       curr_depth + 1);
                             }
                         }
@@ -3550,17 +3784,17 @@ ValueObject::Dereference (Error &error)
             if (!child_name_str.empty())
                 child_name.SetCString (child_name_str.c_str());
 
-            m_deref_valobj = new ValueObjectChild (*this,
-                                                   clang_ast,
-                                                   child_clang_type,
-                                                   child_name,
-                                                   child_byte_size,
-                                                   child_byte_offset,
-                                                   child_bitfield_bit_size,
-                                                   child_bitfield_bit_offset,
-                                                   child_is_base_class,
-                                                   child_is_deref_of_parent,
-                                                   eAddressTypeInvalid);
+            m_deref_valobj = new (*this) ValueObjectChild (*this,
+                                                           clang_ast,
+                                                           child_clang_type,
+                                                           child_name,
+                                                           child_byte_size,
+                                                           child_byte_offset,
+                                                           child_bitfield_bit_size,
+                                                           child_bitfield_bit_offset,
+                                                           child_is_base_class,
+                                                           child_is_deref_of_parent,
+                                                           eAddressTypeInvalid);
         }
     }
 
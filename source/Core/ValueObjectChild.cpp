@@ -128,7 +128,8 @@ ValueObjectChild::UpdateValue ()
             Value::ValueType value_type = parent->GetValue().GetValueType();
             m_value.SetValueType (value_type);
 
-            if (ClangASTContext::IsPointerOrReferenceType (parent->GetClangType()))
+            const bool parent_is_ptr_or_ref = ClangASTContext::IsPointerOrReferenceType (parent->GetClangType());
+            if (parent_is_ptr_or_ref)
             {
                 lldb::addr_t addr = parent->GetPointerValue ();
                 m_value.GetScalar() = addr;
@@ -209,8 +210,28 @@ ValueObjectChild::UpdateValue ()
 
             if (m_error.Success())
             {
-                ExecutionContext exe_ctx (GetExecutionContextRef().Lock());
-                m_error = m_value.GetValueAsData (&exe_ctx, GetClangAST (), m_data, 0, GetModule().get());
+                // Let the parent hand out our data from a read it already
+                // did (for a pointer, a read of the range of members being
+                // fetched) so printing a large array doesn't read memory
+                // once per element
+                bool got_data_from_parent = false;
+                if (parent_is_ptr_or_ref)
+                {
+                    if (m_value.GetValueType() == Value::eValueTypeLoadAddress)
+                        got_data_from_parent = parent->GetDataForPointeeChild (m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS),
+                                                                               m_byte_size,
+                                                                               m_data);
+                }
+                else
+                {
+                    got_data_from_parent = parent->GetDataForMemberChild (m_byte_offset, m_byte_size, m_data);
+                }
+                
+                if (!got_data_from_parent)
+                {
+                    ExecutionContext exe_ctx (GetExecutionContextRef().Lock());
+                    m_error = m_value.GetValueAsData (&exe_ctx, GetClangAST (), m_data, 0, GetModule().get());
+                }
             }
         }
         else
@@ -134,16 +134,16 @@ ValueObjectConstResultImpl::CreateChildAtIndex (uint32_t idx, bool synthetic_arr
         if (!child_name_str.empty())
             child_name.SetCString (child_name_str.c_str());
         
-        valobj = new ValueObjectConstResultChild (*m_impl_backend,
-                                                  clang_ast,
-                                                  child_clang_type,
-                                                  child_name,
-                                                  child_byte_size,
-                                                  child_byte_offset,
-                                                  child_bitfield_bit_size,
-                                                  child_bitfield_bit_offset,
-                                                  child_is_base_class,
-                                                  child_is_deref_of_parent);
+        valobj = new (*m_impl_backend) ValueObjectConstResultChild (*m_impl_backend,
+                                                                    clang_ast,
+                                                                    child_clang_type,
+                                                                    child_name,
+                                                                    child_byte_size,
+                                                                    child_byte_offset,
+                                                                    child_bitfield_bit_size,
+                                                                    child_bitfield_bit_offset,
+                                                                    child_is_base_class,
+                                                                    child_is_deref_of_parent);
         valobj->m_impl.SetLiveAddress(m_live_address+child_byte_offset);
     }
     
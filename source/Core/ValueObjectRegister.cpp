@@ -229,7 +229,7 @@ ValueObjectRegisterSet::CreateChildAtIndex (uint32_t idx, bool synthetic_array_m
     {
         const uint32_t num_children = GetNumChildren();
         if (idx < num_children)
-            valobj = new ValueObjectRegister(*this, m_reg_ctx_sp, m_reg_set->registers[idx]);
+            valobj = new (*this) ValueObjectRegister(*this, m_reg_ctx_sp, m_reg_set->registers[idx]);
     }
     return valobj;
 }
@@ -242,7 +242,7 @@ ValueObjectRegisterSet::GetChildMemberWithName (const ConstString &name, bool ca
     {
         const RegisterInfo *reg_info = m_reg_ctx_sp->GetRegisterInfoByName (name.AsCString());
         if (reg_info != NULL)
-            valobj = new ValueObjectRegister(*this, m_reg_ctx_sp, reg_info->kinds[eRegisterKindLLDB]);
+            valobj = new (*this) ValueObjectRegister(*this, m_reg_ctx_sp, reg_info->kinds[eRegisterKindLLDB]);
     }
     if (valobj)
         return valobj->GetSP();
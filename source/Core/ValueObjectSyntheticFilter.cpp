@@ -61,6 +61,19 @@ ValueObjectSynthetic::CalculateNumChildren()
     return (m_synthetic_children_count = m_synth_filter_ap->CalculateNumChildren());
 }
 
+uint32_t
+ValueObjectSynthetic::CalculateNumChildrenUpTo (uint32_t max)
+{
+    UpdateValueIfNeeded();
+    if (m_synthetic_children_count < UINT32_MAX)
+        return m_synthetic_children_count;
+    const uint32_t num_children = m_synth_filter_ap->CalculateNumChildrenUpTo(max);
+    // Only an exact count can be cached
+    if (num_children != max)
+        m_synthetic_children_count = num_children;
+    return num_children;
+}
+
 clang::ASTContext *
 ValueObjectSynthetic::GetClangASTImpl ()
 {
@@ -27,6 +27,7 @@
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 
@@ -158,6 +159,12 @@ ValueObjectVariable::UpdateValue ()
             if (sc.function)
                 loclist_base_load_addr = sc.function->GetAddressRange().GetBaseAddress().GetLoadAddress (target);
         }
+        // Locals of a frame are usually next to each other on the stack, so
+        // the first variable that gets updated after a stop reads them all
+        StackFrame *frame = exe_ctx.GetFramePtr();
+        if (frame)
+            frame->PrefetchFrameMemory();
+
         Value old_value(m_value);
         if (expr.Evaluate (&exe_ctx, GetClangAST(), NULL, NULL, NULL, loclist_base_load_addr, NULL, m_value, &m_error))
         {
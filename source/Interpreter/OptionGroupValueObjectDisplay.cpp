@@ -43,6 +43,8 @@ g_option_table[] =
     { LLDB_OPT_SET_1, false, "no-summary-depth", 'Y', optional_argument, NULL, 0, eArgTypeCount,     "Set a depth for omitting summary information (default is 1)."},
     { LLDB_OPT_SET_1, false, "raw-output",       'R', no_argument,       NULL, 0, eArgTypeNone,      "Don't use formatting options."},
     { LLDB_OPT_SET_1, false, "show-all-children",'A', no_argument,       NULL, 0, eArgTypeNone,      "Ignore the upper bound on the number of children to show."},
+    { LLDB_OPT_SET_1, false, "child-offset",     'E', required_argument, NULL, 0, eArgTypeCount,     "Index of the first child of the top level values to show (default is zero)."},
+    { LLDB_OPT_SET_1, false, "child-count",      'N', required_argument, NULL, 0, eArgTypeCount,     "Number of children of the top level values to show, starting at the child offset."},
     { 0, false, NULL, 0, 0, NULL, NULL, eArgTypeNone, NULL }
 };
 
@@ -97,6 +99,18 @@ OptionGroupValueObjectDisplay::SetOptionValue (CommandInterpreter &interpreter,
                 error.SetErrorStringWithFormat("invalid pointer depth '%s'", option_arg);
             break;
             
+        case 'E':
+            child_start = Args::StringToUInt32 (option_arg, 0, 0, &success);
+            if (!success)
+                error.SetErrorStringWithFormat("invalid child offset '%s'", option_arg);
+            break;
+            
+        case 'N':
+            child_count = Args::StringToUInt32 (option_arg, UINT32_MAX, 0, &success);
+            if (!success)
+                error.SetErrorStringWithFormat("invalid child count '%s'", option_arg);
+            break;
+            
         case 'Y':
             if (option_arg)
             {
@@ -135,6 +149,8 @@ OptionGroupValueObjectDisplay::OptionParsingStarting (CommandInterpreter &interp
     use_synth         = true;
     be_raw            = false;
     ignore_cap        = false;
+    child_start       = 0;
+    child_count       = UINT32_MAX;
     
     Target *target = interpreter.GetExecutionContext().GetTargetPtr();
     if (target != NULL)
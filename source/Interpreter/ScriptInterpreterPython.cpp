@@ -48,6 +48,7 @@ static ScriptInterpreter::SWIGPythonTypeScriptCallbackFunction g_swig_typescript
 static ScriptInterpreter::SWIGPythonCreateSyntheticProvider g_swig_synthetic_script = NULL;
 static ScriptInterpreter::SWIGPythonCalculateNumChildren g_swig_calc_children = NULL;
 static ScriptInterpreter::SWIGPythonGetChildAtIndex g_swig_get_child_index = NULL;
+static ScriptInterpreter::SWIGPythonGetChildrenInRange g_swig_get_children_range = NULL;
 static ScriptInterpreter::SWIGPythonGetIndexOfChildWithName g_swig_get_index_child = NULL;
 static ScriptInterpreter::SWIGPythonCastPyObjectToSBValue g_swig_cast_to_sbvalue  = NULL;
 static ScriptInterpreter::SWIGPythonUpdateSynthProviderInstance g_swig_update_provider = NULL;
@@ -87,8 +88,10 @@ LLDBSwigPythonCreateSyntheticProvider
  );
 
 
-extern "C" uint32_t       LLDBSwigPython_CalculateNumChildren        (void *implementor);
+extern "C" uint32_t       LLDBSwigPython_CalculateNumChildren        (void *implementor, uint32_t max);
 extern "C" void*          LLDBSwigPython_GetChildAtIndex             (void *implementor, uint32_t idx);
+extern "C" int            LLDBSwigPython_GetChildrenInRange          (void *implementor, uint32_t start, uint32_t count,
+                                                                     std::vector<lldb::ValueObjectSP> &children);
 extern "C" int            LLDBSwigPython_GetIndexOfChildWithName     (void *implementor, const char* child_name);
 extern "C" void*          LLDBSWIGPython_CastPyObjectToSBValue       (void* data);
 extern "C" bool           LLDBSwigPython_UpdateSynthProviderInstance (void* implementor);
@@ -1869,7 +1872,7 @@ ScriptInterpreterPython::PythonInputReaderManager::RunPythonInputReader (lldb::t
 }
 
 uint32_t
-ScriptInterpreterPython::CalculateNumChildren (const lldb::ScriptInterpreterObjectSP& implementor_sp)
+ScriptInterpreterPython::CalculateNumChildren (const lldb::ScriptInterpreterObjectSP& implementor_sp, uint32_t max)
 {
     if (!implementor_sp)
         return 0;
@@ -1887,7 +1890,7 @@ ScriptInterpreterPython::CalculateNumChildren (const lldb::ScriptInterpreterObje
     {
         Locker py_lock(this);
         ForceDisableSyntheticChildren no_synthetics(GetCommandInterpreter().GetDebugger().GetSelectedTarget().get());
-        ret_val = g_swig_calc_children       (implementor);
+        ret_val = g_swig_calc_children       (implementor, max);
     }
     
     return ret_val;
@@ -1932,6 +1935,34 @@ ScriptInterpreterPython::GetChildAtIndex (const lldb::ScriptInterpreterObjectSP&
     return ret_val;
 }
 
+bool
+ScriptInterpreterPython::GetChildrenInRange (const lldb::ScriptInterpreterObjectSP& implementor_sp,
+                                             uint32_t start,
+                                             uint32_t count,
+                                             std::vector<lldb::ValueObjectSP> &children)
+{
+    if (!implementor_sp)
+        return false;
+    
+    void* implementor = implementor_sp->GetObject();
+    
+    if (!implementor)
+        return false;
+    
+    if (!g_swig_get_children_range)
+        return false;
+    
+    int num_children = -1;
+    
+    {
+        Locker py_lock(this);
+        ForceDisableSyntheticChildren no_synthetics(GetCommandInterpreter().GetDebugger().GetSelectedTarget().get());
+        num_children = g_swig_get_children_range (implementor, start, count, children);
+    }
+    
+    return num_children >= 0;
+}
+
 int
 ScriptInterpreterPython::GetIndexOfChildWithName (const lldb::ScriptInterpreterObjectSP& implementor_sp, const char* child_name)
 {
@@ -2180,6 +2211,7 @@ ScriptInterpreterPython::InitializeInterpreter (SWIGInitCallback python_swig_ini
     g_swig_synthetic_script = LLDBSwigPythonCreateSyntheticProvider;
     g_swig_calc_children = LLDBSwigPython_CalculateNumChildren;
     g_swig_get_child_index = LLDBSwigPython_GetChildAtIndex;
+    g_swig_get_children_range = LLDBSwigPython_GetChildrenInRange;
     g_swig_get_index_child = LLDBSwigPython_GetIndexOfChildWithName;
     g_swig_cast_to_sbvalue = LLDBSWIGPython_CastPyObjectToSBValue;
     g_swig_update_provider = LLDBSwigPython_UpdateSynthProviderInstance;
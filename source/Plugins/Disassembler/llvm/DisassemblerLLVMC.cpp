@@ -40,6 +40,18 @@ public:
     {
     }
     
+    // A copy of an instruction another disassembler decoded, without
+    // the strings it may have calculated
+    InstructionLLVMC (DisassemblerLLVMC &disasm,
+                      InstructionLLVMC &rhs) :
+        Instruction(rhs.GetAddress(), rhs.GetAddressClass()),
+        m_is_valid(rhs.m_is_valid),
+        m_disasm(disasm),
+        m_does_branch(eLazyBoolCalculate)
+    {
+        m_opcode = rhs.m_opcode;
+    }
+    
     virtual
     ~InstructionLLVMC ()
     {
@@ -523,6 +535,28 @@ DisassemblerLLVMC::DecodeInstructions (const Address &base_addr,
     return data_cursor - data_offset;
 }
 
+size_t
+DisassemblerLLVMC::CopyInstructions (Disassembler &source)
+{
+    m_instruction_list.Clear();
+    
+    // Only instructions this plug-in decoded can be copied
+    if (!IsValid() || ::strcmp (source.GetPluginName(), GetPluginName()) != 0)
+        return 0;
+    
+    const InstructionList &source_list = source.GetInstructionList();
+    const size_t num_instructions = source_list.GetSize();
+    size_t byte_size = 0;
+    for (size_t i = 0; i < num_instructions; ++i)
+    {
+        InstructionLLVMC *source_inst = static_cast<InstructionLLVMC *>(source_list.GetInstructionAtIndex(i).get());
+        InstructionSP inst_sp (new InstructionLLVMC (*this, *source_inst));
+        m_instruction_list.Append (inst_sp);
+        byte_size += inst_sp->GetOpcode().GetByteSize();
+    }
+    return byte_size;
+}
+
 void
 DisassemblerLLVMC::Initialize()
 {
@@ -54,6 +54,9 @@ public:
                         uint32_t num_instructions,
                         bool append);
     
+    virtual size_t
+    CopyInstructions (lldb_private::Disassembler &source);
+    
     //------------------------------------------------------------------
     // PluginInterface protocol
     //------------------------------------------------------------------
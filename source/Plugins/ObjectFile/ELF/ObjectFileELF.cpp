@@ -1100,6 +1100,9 @@ ObjectFileELF::GetSymtab()
     if (m_symtab_ap.get())
         return m_symtab_ap.get();
 
+    ModuleSP module_sp(GetModule());
+    StatsTimer stats_timer (module_sp ? &module_sp->GetStatistics().symtab_parse_nsec : NULL);
+
     Symtab *symbol_table = new Symtab(this);
     m_symtab_ap.reset(symbol_table);
 
@@ -1133,6 +1136,8 @@ ObjectFileELF::GetSymtab()
         ParseTrampolineSymbols(symbol_table, symbol_id, reloc_header, reloc_id);
     }
 
+    if (module_sp)
+        module_sp->GetStatistics().num_symbols = symbol_table->GetNumSymbols();
     return symbol_table;
 }
 
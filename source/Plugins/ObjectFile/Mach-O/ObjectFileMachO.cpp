@@ -718,10 +718,12 @@ ObjectFileMachO::GetSymtab()
         lldb_private::Mutex::Locker locker(module_sp->GetMutex());
         if (m_symtab_ap.get() == NULL)
         {
+            StatsTimer stats_timer (&module_sp->GetStatistics().symtab_parse_nsec);
             m_symtab_ap.reset(new Symtab(this));
             Mutex::Locker symtab_locker (m_symtab_ap->GetMutex());
             ParseSymtab (true);
             m_symtab_ap->Finalize ();
+            module_sp->GetStatistics().num_symbols = m_symtab_ap->GetNumSymbols();
         }
     }
     return m_symtab_ap.get();
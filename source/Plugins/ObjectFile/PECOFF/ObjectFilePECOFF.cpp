@@ -491,6 +491,7 @@ ObjectFilePECOFF::GetSymtab()
         lldb_private::Mutex::Locker locker(module_sp->GetMutex());
         if (m_symtab_ap.get() == NULL)
         {
+            StatsTimer stats_timer (&module_sp->GetStatistics().symtab_parse_nsec);
             SectionList *sect_list = GetSectionList();
             m_symtab_ap.reset(new Symtab(this));
             Mutex::Locker symtab_locker (m_symtab_ap->GetMutex());
@@ -552,6 +553,7 @@ ObjectFilePECOFF::GetSymtab()
                 }
                 
             }
+            module_sp->GetStatistics().num_symbols = m_symtab_ap->GetNumSymbols();
         }
     }
     return m_symtab_ap.get();
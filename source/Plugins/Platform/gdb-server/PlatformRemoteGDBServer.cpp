@@ -211,6 +211,7 @@ PlatformRemoteGDBServer::ConnectRemote (Args& args)
                 if (m_gdb_client.HandshakeWithServer(&error))
                 {
                     m_gdb_client.QueryNoAckModeSupported();
+                    m_gdb_client.QueryCompressionSupported();
                     m_gdb_client.GetHostInfo();
 #if 0
                     m_gdb_client.TestPacketSpeed(10000);
@@ -484,6 +484,20 @@ ProcessPOSIX::DisableBreakpoint(BreakpointSite *bp_site)
     return DisableSoftwareBreakpoint(bp_site);
 }
 
+size_t
+ProcessPOSIX::EnableBreakpointSites(const BreakpointSiteList::collection &bp_sites,
+                                    std::vector<Error> &errors)
+{
+    return EnableSoftwareBreakpoints(bp_sites, errors);
+}
+
+size_t
+ProcessPOSIX::DisableBreakpointSites(const BreakpointSiteList::collection &bp_sites,
+                                     std::vector<Error> &errors)
+{
+    return DisableSoftwareBreakpoints(bp_sites, errors);
+}
+
 uint32_t
 ProcessPOSIX::UpdateThreadListIfNeeded()
 {
@@ -102,6 +102,14 @@ public:
     virtual lldb_private::Error
     DisableBreakpoint(lldb_private::BreakpointSite *bp_site);
 
+    virtual size_t
+    EnableBreakpointSites(const lldb_private::BreakpointSiteList::collection &bp_sites,
+                          std::vector<lldb_private::Error> &errors);
+
+    virtual size_t
+    DisableBreakpointSites(const lldb_private::BreakpointSiteList::collection &bp_sites,
+                           std::vector<lldb_private::Error> &errors);
+
     virtual uint32_t
     UpdateThreadListIfNeeded();
 
@@ -15,6 +15,8 @@
 #include <string.h>
 
 // C++ Includes
+#include <algorithm>
+
 // Other libraries and framework includes
 #include "lldb/Core/Log.h"
 #include "lldb/Core/StreamFile.h"
@@ -26,6 +28,7 @@
 
 // Project includes
 #include "ProcessGDBRemoteLog.h"
+#include "Utility/PacketCompression.h"
 
 #define DEBUGSERVER_BASENAME    "debugserver"
 
@@ -63,7 +66,7 @@ GDBRemoteCommunication::History::AddPacket (char packet_char,
 }
 
 void
-GDBRemoteCommunication::History::AddPacket (const std::string &src,
+GDBRemoteCommunication::History::AddPacket (const char *src,
                                             uint32_t src_len,
                                             PacketType type,
                                             uint32_t bytes_transmitted)
@@ -72,7 +75,7 @@ GDBRemoteCommunication::History::AddPacket (const std::string &src,
     if (size > 0)
     {
         const uint32_t idx = GetNextIndex();
-        m_packets[idx].packet.assign (src, 0, src_len);
+        m_packets[idx].packet.assign (src, src_len);
         m_packets[idx].type = type;
         m_packets[idx].bytes_transmitted = bytes_transmitted;
         m_packets[idx].packet_idx = m_total_packet_count;
@@ -139,7 +142,18 @@ GDBRemoteCommunication::GDBRemoteCommunication(const char *comm_name,
     m_private_is_running (false),
     m_history (512),
     m_send_acks (true),
-    m_is_platform (is_platform)
+    m_is_platform (is_platform),
+    m_num_packets_sent (0),
+    m_num_packets_received (0),
+    m_num_packet_bytes_sent (0),
+    m_num_packet_bytes_received (0),
+    m_num_packet_bytes_saved (0),
+    m_compression_min_size (0),
+    m_decompress_packets (false),
+    m_recv_bytes (),
+    m_recv_start (0),
+    m_recv_end (0),
+    m_recv_scan_idx (0)
 {
 }
 
@@ -168,6 +182,33 @@ GDBRemoteCommunication::CalculcateChecksum (const char *payload, size_t payload_
     return checksum & 255;
 }
 
+void
+GDBRemoteCommunication::PutEscapedBinaryData (Stream &strm, const void *src, size_t src_len)
+{
+    const uint8_t *bytes = (const uint8_t *)src;
+    for (size_t i = 0; i < src_len; ++i)
+    {
+        const uint8_t byte = bytes[i];
+        switch (byte)
+        {
+            // '*' starts a run length encoding and NUL would end the
+            // packet data for stubs that treat the payload as a C string
+            case '#':
+            case '$':
+            case '}':
+            case '*':
+            case '\0':
+                strm.PutChar ('}');
+                strm.PutChar (byte ^ 0x20);
+                break;
+
+            default:
+                strm.PutChar (byte);
+                break;
+        }
+    }
+}
+
 size_t
 GDBRemoteCommunication::SendAck ()
 {
@@ -206,6 +247,23 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
 {
     if (IsConnected())
     {
+        // Once the other end asked for compression every payload gets a
+        // prefix saying whether it is compressed, and large payloads are
+        // sent compressed
+        std::string framed_payload;
+        if (m_compression_min_size > 0)
+        {
+            if (payload_length < m_compression_min_size ||
+                !CompressPayload (payload, payload_length, framed_payload))
+            {
+                framed_payload.reserve (payload_length + 1);
+                framed_payload.push_back ('N');
+                framed_payload.append (payload, payload_length);
+            }
+            payload = framed_payload.data();
+            payload_length = framed_payload.size();
+        }
+
         StreamString packet(0, 4, eByteOrderBig);
 
         packet.PutChar('$');
@@ -228,8 +286,9 @@ GDBRemoteCommunication::SendPacketNoLock (const char *payload, size_t payload_le
             log->Printf ("<%4zu> send packet: %.*s", bytes_written, (int)packet.GetSize(), packet.GetData());
         }
 
-        m_history.AddPacket (packet.GetString(), packet.GetSize(), History::ePacketTypeSend, bytes_written);
-
+        m_history.AddPacket (packet.GetData(), packet.GetSize(), History::ePacketTypeSend, bytes_written);
+        Statistics::Increment (m_num_packets_sent);
+        Statistics::Increment (m_num_packet_bytes_sent, bytes_written);
 
         if (bytes_written == packet.GetSize())
         {
@@ -282,7 +341,6 @@ GDBRemoteCommunication::WaitForNotRunningPrivate (const TimeValue *timeout_ptr)
 size_t
 GDBRemoteCommunication::WaitForPacketWithTimeoutMicroSecondsNoLock (StringExtractorGDBRemote &packet, uint32_t timeout_usec)
 {
-    uint8_t buffer[8192];
     Error error;
 
     LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS | GDBR_LOG_VERBOSE));
@@ -295,11 +353,24 @@ GDBRemoteCommunication::WaitForPacketWithTimeoutMicroSecondsNoLock (StringExtrac
     while (IsConnected() && !timed_out)
     {
         lldb::ConnectionStatus status = eConnectionStatusNoConnection;
-        size_t bytes_read = Read (buffer, sizeof(buffer), timeout_usec, status, &error);
+
+        // Read straight into the end of the receive buffer. Only the thread
+        // that holds the sequence mutex reads packets, so the buffer can't
+        // change while we are blocked in Read().
+        uint8_t *dst;
+        size_t dst_len;
+        {
+            Mutex::Locker locker(m_bytes_mutex);
+            PrepareReceiveBuffer ();
+            dst = &m_recv_bytes[m_recv_end];
+            dst_len = m_recv_bytes.size() - m_recv_end;
+        }
+        size_t bytes_read = Read (dst, dst_len, timeout_usec, status, &error);
         
         if (log)
-            log->Printf ("%s: Read (buffer, (sizeof(buffer), timeout_usec = 0x%x, status = %s, error = %s) => bytes_read = %zu",
+            log->Printf ("%s: Read (buffer, %zu, timeout_usec = 0x%x, status = %s, error = %s) => bytes_read = %zu",
                          __PRETTY_FUNCTION__,
+                         dst_len,
                          timeout_usec, 
                          Communication::ConnectionStatusAsCString (status),
                          error.AsCString(), 
@@ -307,7 +378,11 @@ GDBRemoteCommunication::WaitForPacketWithTimeoutMicroSecondsNoLock (StringExtrac
 
         if (bytes_read > 0)
         {
-            if (CheckForPacket (buffer, bytes_read, packet))
+            {
+                Mutex::Locker locker(m_bytes_mutex);
+                m_recv_end += bytes_read;
+            }
+            if (CheckForPacket (NULL, 0, packet))
                 return packet.GetStringRef().size();
         }
         else
@@ -334,6 +409,112 @@ GDBRemoteCommunication::WaitForPacketWithTimeoutMicroSecondsNoLock (StringExtrac
     return 0;
 }
 
+bool
+GDBRemoteCommunication::CompressPayload (const char *payload, size_t payload_length, std::string &compressed_payload)
+{
+    std::string compressed_data;
+    if (!PacketCompression::Compress ((const uint8_t *)payload, payload_length, compressed_data))
+        return false;
+
+    StreamString strm;
+    strm.Printf ("C%zx:", payload_length);
+    PutEscapedBinaryData (strm, compressed_data.data(), compressed_data.size());
+    // Escaping can eat up what compression saved
+    if (strm.GetSize() >= payload_length)
+        return false;
+
+    compressed_payload.swap (strm.GetString());
+    Statistics::Increment (m_num_packet_bytes_saved, payload_length - compressed_payload.size());
+
+    LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+    if (log)
+        log->Printf ("compressed packet payload from %zu to %zu bytes", payload_length, compressed_payload.size());
+    return true;
+}
+
+bool
+GDBRemoteCommunication::DecompressPacket (StringExtractorGDBRemote &packet)
+{
+    LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_PACKETS));
+
+    std::string &payload = packet.GetStringRef();
+    if (!payload.empty() && payload[0] == 'N')
+    {
+        payload.erase (0, 1);
+        return true;
+    }
+    if (payload.empty() || payload[0] != 'C')
+    {
+        if (log)
+            log->Printf ("error: packet without a compression prefix: '%.*s'", (int)std::min<size_t> (payload.size(), 32), payload.c_str());
+        return false;
+    }
+
+    packet.SetFilePos (1);
+    const uint64_t uncompressed_length = packet.GetHexMaxU64 (false, UINT64_MAX);
+    if (uncompressed_length == UINT64_MAX || packet.GetChar() != ':')
+    {
+        if (log)
+            log->Printf ("error: invalid compressed packet header: '%.*s'", (int)std::min<size_t> (payload.size(), 32), payload.c_str());
+        return false;
+    }
+
+    std::string compressed_data;
+    compressed_data.reserve (packet.GetBytesLeft());
+    for (size_t idx = packet.GetFilePos(); idx < payload.size(); ++idx)
+    {
+        if (payload[idx] == '}' && idx + 1 < payload.size())
+            compressed_data.push_back (payload[++idx] ^ 0x20);
+        else
+            compressed_data.push_back (payload[idx]);
+    }
+
+    std::string uncompressed;
+    if (!PacketCompression::Decompress ((const uint8_t *)compressed_data.data(), compressed_data.size(), uncompressed_length, uncompressed))
+    {
+        if (log)
+            log->Printf ("error: failed to decompress a packet of %zu bytes", payload.size());
+        return false;
+    }
+
+    if (log)
+        log->Printf ("decompressed packet payload from %zu to %zu bytes", payload.size(), uncompressed.size());
+    if (uncompressed.size() > payload.size())
+        Statistics::Increment (m_num_packet_bytes_saved, uncompressed.size() - payload.size());
+    payload.swap (uncompressed);
+    return true;
+}
+
+void
+GDBRemoteCommunication::PrepareReceiveBuffer ()
+{
+    // Large reads mean a big memory read response arrives in a few
+    // system calls instead of one for every 8K
+    static const size_t k_min_read_size = 64 * 1024;
+
+    if (m_recv_start == m_recv_end)
+    {
+        // Everything was consumed, start over at the front
+        m_recv_start = m_recv_end = m_recv_scan_idx = 0;
+    }
+
+    if (m_recv_bytes.size() - m_recv_end >= k_min_read_size)
+        return;
+
+    if (m_recv_start > 0)
+    {
+        // Only a partial packet is left, move it to the front
+        const size_t bytes_left = m_recv_end - m_recv_start;
+        ::memmove (&m_recv_bytes[0], &m_recv_bytes[m_recv_start], bytes_left);
+        m_recv_scan_idx = m_recv_scan_idx > m_recv_start ? m_recv_scan_idx - m_recv_start : 0;
+        m_recv_start = 0;
+        m_recv_end = bytes_left;
+    }
+
+    if (m_recv_bytes.size() - m_recv_end < k_min_read_size)
+        m_recv_bytes.resize (std::max<size_t> (m_recv_bytes.size() * 2, m_recv_end + k_min_read_size));
+}
+
 bool
 GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, StringExtractorGDBRemote &packet)
 {
@@ -353,21 +534,24 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
                          (uint32_t)src_len, 
                          src);
         }
-        m_bytes.append ((const char *)src, src_len);
+        if (m_recv_bytes.size() - m_recv_end < src_len)
+            m_recv_bytes.resize (m_recv_end + src_len);
+        ::memcpy (&m_recv_bytes[m_recv_end], src, src_len);
+        m_recv_end += src_len;
     }
 
-    // Parse up the packets into gdb remote packets
-    if (!m_bytes.empty())
+    // Parse up the packets into gdb remote packets. The packets are framed
+    // in place and only the payload is copied out into "packet".
+    while (m_recv_start < m_recv_end)
     {
-        // end_idx must be one past the last valid packet byte. Start
-        // it off with an invalid value that is the same as the current
-        // index.
+        const char *bytes = (const char *)&m_recv_bytes[m_recv_start];
+        const size_t bytes_len = m_recv_end - m_recv_start;
         size_t content_start = 0;
         size_t content_length = 0;
         size_t total_length = 0;
         size_t checksum_idx = std::string::npos;
 
-        switch (m_bytes[0])
+        switch (bytes[0])
         {
             case '+':       // Look for ack
             case '-':       // Look for cancel
@@ -378,24 +562,33 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
             case '$':
                 // Look for a standard gdb packet?
                 {
-                    size_t hash_pos = m_bytes.find('#');
-                    if (hash_pos != std::string::npos)
+                    // Bytes before m_recv_scan_idx were already searched when
+                    // an earlier read only brought in part of this packet
+                    const size_t scan_start = std::max<size_t> (m_recv_scan_idx, m_recv_start + 1) - m_recv_start;
+                    const char *hash = (const char *)::memchr (bytes + scan_start, '#', bytes_len - scan_start);
+                    if (hash == NULL)
+                    {
+                        m_recv_scan_idx = m_recv_end;
+                        packet.Clear();
+                        return false;
+                    }
+                    const size_t hash_pos = hash - bytes;
+                    if (hash_pos + 2 < bytes_len)
                     {
-                        if (hash_pos + 2 < m_bytes.size())
-                        {
-                            checksum_idx = hash_pos + 1;
-                            // Skip the dollar sign
-                            content_start = 1; 
-                            // Don't include the # in the content or the $ in the content length
-                            content_length = hash_pos - 1;  
-                            
-                            total_length = hash_pos + 3; // Skip the # and the two hex checksum bytes
-                        }
-                        else
-                        {
-                            // Checksum bytes aren't all here yet
-                            content_length = std::string::npos;
-                        }
+                        checksum_idx = hash_pos + 1;
+                        // Skip the dollar sign
+                        content_start = 1; 
+                        // Don't include the # in the content or the $ in the content length
+                        content_length = hash_pos - 1;  
+                        
+                        total_length = hash_pos + 3; // Skip the # and the two hex checksum bytes
+                    }
+                    else
+                    {
+                        // Checksum bytes aren't all here yet
+                        m_recv_scan_idx = m_recv_start + hash_pos;
+                        packet.Clear();
+                        return false;
                     }
                 }
                 break;
@@ -403,109 +596,92 @@ GDBRemoteCommunication::CheckForPacket (const uint8_t *src, size_t src_len, Stri
             default:
                 {
                     // We have an unexpected byte and we need to flush all bad 
-                    // data that is in m_bytes, so we need to find the first
+                    // data that is in the buffer, so we need to find the first
                     // byte that is a '+' (ACK), '-' (NACK), \x03 (CTRL+C interrupt),
                     // or '$' character (start of packet header) or of course,
-                    // the end of the data in m_bytes...
-                    const size_t bytes_len = m_bytes.size();
-                    bool done = false;
-                    uint32_t idx;
-                    for (idx = 1; !done && idx < bytes_len; ++idx)
+                    // the end of the data in the buffer...
+                    size_t idx;
+                    for (idx = 1; idx < bytes_len; ++idx)
                     {
-                        switch (m_bytes[idx])
-                        {
-                        case '+':
-                        case '-':
-                        case '\x03':
-                        case '$':
-                            done = true;
-                            break;
-                                
-                        default:
+                        const char ch = bytes[idx];
+                        if (ch == '+' || ch == '-' || ch == '\x03' || ch == '$')
                             break;
-                        }
                     }
                     if (log)
-                        log->Printf ("GDBRemoteCommunication::%s tossing %u junk bytes: '%.*s'",
-                                     __FUNCTION__, idx, idx, m_bytes.c_str());
-                    m_bytes.erase(0, idx);
+                        log->Printf ("GDBRemoteCommunication::%s tossing %zu junk bytes: '%.*s'",
+                                     __FUNCTION__, idx, (int)idx, bytes);
+                    m_recv_start += idx;
                 }
-                break;
+                continue;
         }
 
-        if (content_length == std::string::npos)
-        {
-            packet.Clear();
-            return false;
-        }
-        else if (total_length > 0)
+        // We have a valid packet...
+        assert (content_length <= bytes_len);
+        assert (total_length <= bytes_len);
+        assert (content_length <= total_length);
+        
+        bool success = true;
+        
+        if (log)
         {
-
-            // We have a valid packet...
-            assert (content_length <= m_bytes.size());
-            assert (total_length <= m_bytes.size());
-            assert (content_length <= total_length);
-            
-            bool success = true;
-            std::string &packet_str = packet.GetStringRef();
-            
+            // If logging was just enabled and we have history, then dump out what
+            // we have to the log so we get the historical context. The Dump() call that
+            // logs all of the packet will set a boolean so that we don't dump this more
+            // than once
+            if (!m_history.DidDumpToLog ())
+                m_history.Dump (log.get());
             
-            if (log)
-            {
-                // If logging was just enabled and we have history, then dump out what
-                // we have to the log so we get the historical context. The Dump() call that
-                // logs all of the packet will set a boolean so that we don't dump this more
-                // than once
-                if (!m_history.DidDumpToLog ())
-                    m_history.Dump (log.get());
-                
-                log->Printf ("<%4zu> read packet: %.*s", total_length, (int)(total_length), m_bytes.c_str());
-            }
+            log->Printf ("<%4zu> read packet: %.*s", total_length, (int)(total_length), bytes);
+        }
 
-            m_history.AddPacket (m_bytes.c_str(), total_length, History::ePacketTypeRecv, total_length);
+        m_history.AddPacket (bytes, total_length, History::ePacketTypeRecv, total_length);
+        Statistics::Increment (m_num_packets_received);
+        Statistics::Increment (m_num_packet_bytes_received, total_length);
 
-            packet_str.assign (m_bytes, content_start, content_length);
-            
-            if (m_bytes[0] == '$')
+        if (bytes[0] == '$')
+        {
+            assert (checksum_idx < bytes_len);
+            if (::isxdigit (bytes[checksum_idx+0]) || 
+                ::isxdigit (bytes[checksum_idx+1]))
             {
-                assert (checksum_idx < m_bytes.size());
-                if (::isxdigit (m_bytes[checksum_idx+0]) || 
-                    ::isxdigit (m_bytes[checksum_idx+1]))
+                if (GetSendAcks ())
                 {
-                    if (GetSendAcks ())
+                    const char packet_checksum_cstr[3] = { bytes[checksum_idx], bytes[checksum_idx+1], '\0' };
+                    char packet_checksum = strtol (packet_checksum_cstr, NULL, 16);
+                    char actual_checksum = CalculcateChecksum (bytes + content_start, content_length);
+                    success = packet_checksum == actual_checksum;
+                    if (!success)
                     {
-                        const char *packet_checksum_cstr = &m_bytes[checksum_idx];
-                        char packet_checksum = strtol (packet_checksum_cstr, NULL, 16);
-                        char actual_checksum = CalculcateChecksum (packet_str.c_str(), packet_str.size());
-                        success = packet_checksum == actual_checksum;
-                        if (!success)
-                        {
-                            if (log)
-                                log->Printf ("error: checksum mismatch: %.*s expected 0x%2.2x, got 0x%2.2x", 
-                                             (int)(total_length), 
-                                             m_bytes.c_str(),
-                                             (uint8_t)packet_checksum,
-                                             (uint8_t)actual_checksum);
-                        }
-                        // Send the ack or nack if needed
-                        if (!success)
-                            SendNack();
-                        else
-                            SendAck();
+                        if (log)
+                            log->Printf ("error: checksum mismatch: %.*s expected 0x%2.2x, got 0x%2.2x", 
+                                         (int)(total_length), 
+                                         bytes,
+                                         (uint8_t)packet_checksum,
+                                         (uint8_t)actual_checksum);
                     }
-                }
-                else
-                {
-                    success = false;
-                    if (log)
-                        log->Printf ("error: invalid checksum in packet: '%s'\n", m_bytes.c_str());
+                    // Send the ack or nack if needed
+                    if (!success)
+                        SendNack();
+                    else
+                        SendAck();
                 }
             }
-            
-            m_bytes.erase(0, total_length);
-            packet.SetFilePos(0);
-            return success;
+            else
+            {
+                success = false;
+                if (log)
+                    log->Printf ("error: invalid checksum in packet: '%.*s'\n", (int)(total_length), bytes);
+            }
         }
+
+        // This is the only copy of the payload, it reuses the storage the
+        // packet already has
+        packet.GetStringRef().assign (bytes + content_start, content_length);
+        m_recv_start += total_length;
+        if (success && m_decompress_packets && bytes[0] == '$')
+            success = DecompressPacket (packet);
+        packet.SetFilePos(0);
+        return success;
     }
     packet.Clear();
     return false;
@@ -14,12 +14,14 @@
 // C++ Includes
 #include <list>
 #include <string>
+#include <vector>
 
 // Other libraries and framework includes
 // Project includes
 #include "lldb/lldb-public.h"
 #include "lldb/Core/Communication.h"
 #include "lldb/Core/Listener.h"
+#include "lldb/Core/Statistics.h"
 #include "lldb/Host/Mutex.h"
 #include "lldb/Host/Predicate.h"
 #include "lldb/Host/TimeValue.h"
@@ -58,6 +60,15 @@ public:
     CalculcateChecksum (const char *payload,
                         size_t payload_length);
 
+    //------------------------------------------------------------------
+    // Append binary data to a packet, escaping the bytes that can't
+    // appear in a packet as is done for 'x' and 'X' packets.
+    //------------------------------------------------------------------
+    static void
+    PutEscapedBinaryData (lldb_private::Stream &strm,
+                          const void *src,
+                          size_t src_len);
+
     bool
     GetSequenceMutex (lldb_private::Mutex::Locker& locker, const char *failure_message = NULL);
 
@@ -115,6 +126,40 @@ public:
 
     void
     DumpHistory(lldb_private::Stream &strm);
+
+    //------------------------------------------------------------------
+    // Packet counters for "statistics dump"
+    //------------------------------------------------------------------
+    uint64_t
+    GetNumPacketsSent () const
+    {
+        return lldb_private::Statistics::Get (m_num_packets_sent);
+    }
+
+    uint64_t
+    GetNumPacketsReceived () const
+    {
+        return lldb_private::Statistics::Get (m_num_packets_received);
+    }
+
+    uint64_t
+    GetNumPacketBytesSent () const
+    {
+        return lldb_private::Statistics::Get (m_num_packet_bytes_sent);
+    }
+
+    uint64_t
+    GetNumPacketBytesReceived () const
+    {
+        return lldb_private::Statistics::Get (m_num_packet_bytes_received);
+    }
+
+    // Bytes that compressed packets didn't have to send
+    uint64_t
+    GetNumPacketBytesSaved () const
+    {
+        return lldb_private::Statistics::Get (m_num_packet_bytes_saved);
+    }
     
 protected:
 
@@ -165,7 +210,7 @@ protected:
                    PacketType type,
                    uint32_t bytes_transmitted);
         void
-        AddPacket (const std::string &src,
+        AddPacket (const char *src,
                    uint32_t src_len,
                    PacketType type,
                    uint32_t bytes_transmitted);
@@ -238,6 +283,29 @@ protected:
     bool
     WaitForNotRunningPrivate (const lldb_private::TimeValue *timeout_ptr);
 
+    //------------------------------------------------------------------
+    // Once compression is enabled every packet payload starts with a
+    // prefix that plain payloads (binary memory reads included) can't be
+    // mistaken for: "N" followed by the uncompressed payload, or
+    // "C<uncompressed size in hex>:" followed by the binary escaped
+    // output of PacketCompression::Compress(). DecompressPacket()
+    // removes either prefix and fails for packets that have neither.
+    //------------------------------------------------------------------
+    bool
+    CompressPayload (const char *payload,
+                     size_t payload_length,
+                     std::string &compressed_payload);
+
+    bool
+    DecompressPacket (StringExtractorGDBRemote &packet);
+
+    //------------------------------------------------------------------
+    // Make room at the end of m_recv_bytes for the next read.
+    // m_bytes_mutex must be locked.
+    //------------------------------------------------------------------
+    void
+    PrepareReceiveBuffer ();
+
     //------------------------------------------------------------------
     // Classes that inherit from GDBRemoteCommunication can see and modify these
     //------------------------------------------------------------------
@@ -254,6 +322,23 @@ protected:
     bool m_is_platform; // Set to true if this class represents a platform,
                         // false if this class represents a debug session for
                         // a single process
+    uint64_t m_num_packets_sent;
+    uint64_t m_num_packets_received;
+    uint64_t m_num_packet_bytes_sent;
+    uint64_t m_num_packet_bytes_received;
+    uint64_t m_num_packet_bytes_saved;
+    uint32_t m_compression_min_size;    // Compress sent payloads at least this long, zero if compression is off
+    bool m_decompress_packets;          // Set if the other end frames the packets it sends for compression
+
+    //------------------------------------------------------------------
+    // Bytes that were received but not handed out as packets yet are in
+    // m_recv_bytes[m_recv_start, m_recv_end). Packets are framed in place
+    // and consumed bytes are only reclaimed before the next read.
+    //------------------------------------------------------------------
+    std::vector<uint8_t> m_recv_bytes;
+    size_t m_recv_start;
+    size_t m_recv_end;
+    size_t m_recv_scan_idx; // Searching for the '#' of a partial packet resumes here
     
 
 
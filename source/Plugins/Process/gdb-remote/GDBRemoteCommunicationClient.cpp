@@ -49,6 +49,10 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient(bool is_platform) :
     m_supports_alloc_dealloc_memory (eLazyBoolCalculate),
     m_supports_memory_region_info  (eLazyBoolCalculate),
     m_supports_watchpoint_support_info  (eLazyBoolCalculate),
+    m_supports_x (eLazyBoolCalculate),
+    m_supports_X (eLazyBoolCalculate),
+    m_supports_qMultiMemRead (eLazyBoolCalculate),
+    m_supports_qMultiBreakpoint (eLazyBoolCalculate),
     m_supports_qProcessInfoPID (true),
     m_supports_qfProcessInfo (true),
     m_supports_qUserName (true),
@@ -116,6 +120,29 @@ GDBRemoteCommunicationClient::QueryNoAckModeSupported ()
     }
 }
 
+void
+GDBRemoteCommunicationClient::QueryCompressionSupported ()
+{
+    m_decompress_packets = false;
+
+    const char *min_size_cstr = getenv ("LLDB_GDB_REMOTE_COMPRESSION");
+    if (min_size_cstr == NULL)
+        return;
+    const uint32_t min_size = Args::StringToUInt32 (min_size_cstr, 0, 0);
+    if (min_size == 0)
+        return;
+
+    char packet[64];
+    const int packet_len = ::snprintf (packet, sizeof(packet), "QEnableCompression:minsize:%u;", min_size);
+    assert (packet_len < sizeof(packet));
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse(packet, packet_len, response, false))
+    {
+        if (response.IsOKResponse())
+            m_decompress_packets = true;
+    }
+}
+
 void
 GDBRemoteCommunicationClient::GetListThreadsInStopReplySupported ()
 {
@@ -146,6 +173,11 @@ GDBRemoteCommunicationClient::ResetDiscoverableSettings()
     m_qHostInfo_is_valid = eLazyBoolCalculate;
     m_supports_alloc_dealloc_memory = eLazyBoolCalculate;
     m_supports_memory_region_info = eLazyBoolCalculate;
+    m_supports_x = eLazyBoolCalculate;
+    m_supports_X = eLazyBoolCalculate;
+    m_supports_qMultiMemRead = eLazyBoolCalculate;
+    m_supports_qMultiBreakpoint = eLazyBoolCalculate;
+    m_decompress_packets = false;
 
     m_supports_qProcessInfoPID = true;
     m_supports_qfProcessInfo = true;
@@ -176,6 +208,59 @@ GDBRemoteCommunicationClient::GetThreadSuffixSupported ()
     }
     return m_supports_thread_suffix;
 }
+
+bool
+GDBRemoteCommunicationClient::GetBinaryMemoryReadSupported ()
+{
+    if (m_supports_x == eLazyBoolCalculate)
+    {
+        // This can be probed while the process is running, so only
+        // decide once the stub actually answered
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse("x0,0", response, true))
+            m_supports_x = response.IsOKResponse() ? eLazyBoolYes : eLazyBoolNo;
+    }
+    return m_supports_x == eLazyBoolYes;
+}
+
+bool
+GDBRemoteCommunicationClient::GetBinaryMemoryWriteSupported ()
+{
+    if (m_supports_X == eLazyBoolCalculate)
+    {
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse("X0,0:", response, true))
+            m_supports_X = response.IsOKResponse() ? eLazyBoolYes : eLazyBoolNo;
+    }
+    return m_supports_X == eLazyBoolYes;
+}
+
+bool
+GDBRemoteCommunicationClient::GetMultiMemReadSupported ()
+{
+    if (m_supports_qMultiMemRead == eLazyBoolCalculate)
+    {
+        // A request without any ranges is answered with "OK"
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse("qMultiMemRead:", response, true))
+            m_supports_qMultiMemRead = response.IsOKResponse() ? eLazyBoolYes : eLazyBoolNo;
+    }
+    return m_supports_qMultiMemRead == eLazyBoolYes;
+}
+
+bool
+GDBRemoteCommunicationClient::GetMultiBreakpointSupported ()
+{
+    if (m_supports_qMultiBreakpoint == eLazyBoolCalculate)
+    {
+        // A request without any breakpoints is answered with "OK"
+        StringExtractorGDBRemote response;
+        if (SendPacketAndWaitForResponse("qMultiBreakpoint:", response, true))
+            m_supports_qMultiBreakpoint = response.IsOKResponse() ? eLazyBoolYes : eLazyBoolNo;
+    }
+    return m_supports_qMultiBreakpoint == eLazyBoolYes;
+}
+
 bool
 GDBRemoteCommunicationClient::GetVContSupported (char flavor)
 {
@@ -74,6 +74,82 @@ public:
     void
     GetListThreadsInStopReplySupported ();
 
+    //------------------------------------------------------------------
+    // Ask the server to compress large responses. Compression costs CPU
+    // time on both ends and only pays off on slow connections, so it is
+    // only requested when the LLDB_GDB_REMOTE_COMPRESSION environment
+    // variable is set to the smallest response size to compress.
+    //------------------------------------------------------------------
+    void
+    QueryCompressionSupported ();
+
+    //------------------------------------------------------------------
+    // The 'x' and 'X' packets read and write memory as binary data
+    // instead of hex, which halves the size of the packets. Support is
+    // probed with zero length requests the first time they are needed.
+    //------------------------------------------------------------------
+    bool
+    GetBinaryMemoryReadSupported ();
+
+    bool
+    GetBinaryMemoryWriteSupported ();
+
+    // Called when a stub that accepted the probe rejects a real request
+    void
+    DisableBinaryMemoryRead ()
+    {
+        m_supports_x = lldb_private::eLazyBoolNo;
+    }
+
+    void
+    DisableBinaryMemoryWrite ()
+    {
+        m_supports_X = lldb_private::eLazyBoolNo;
+    }
+
+    //------------------------------------------------------------------
+    // The "qMultiMemRead" packet reads many ranges of memory with one
+    // round trip:
+    //
+    //  qMultiMemRead:<addr>,<len>;<addr>,<len>;...
+    //
+    // The reply has the number of bytes read for each range in hex,
+    // followed by the binary escaped bytes of all ranges:
+    //
+    //  <len>,<len>,...;<data>
+    //
+    // A reply with a length for each range, none larger than the range,
+    // and exactly that much data is the only kind that is accepted.
+    //------------------------------------------------------------------
+    bool
+    GetMultiMemReadSupported ();
+
+    void
+    DisableMultiMemRead ()
+    {
+        m_supports_qMultiMemRead = lldb_private::eLazyBoolNo;
+    }
+
+    //------------------------------------------------------------------
+    // The "qMultiBreakpoint" packet inserts and removes many software
+    // breakpoints with one round trip. Each entry is a "Z0" or "z0"
+    // packet without its type byte repeated:
+    //
+    //  qMultiBreakpoint:Z<addr>,<kind>;z<addr>,<kind>;...
+    //
+    // The reply has the result of each entry, in order:
+    //
+    //  OK;E09;...
+    //------------------------------------------------------------------
+    bool
+    GetMultiBreakpointSupported ();
+
+    void
+    DisableMultiBreakpoint ()
+    {
+        m_supports_qMultiBreakpoint = lldb_private::eLazyBoolNo;
+    }
+
     bool
     SendAsyncSignal (int signo);
 
@@ -358,6 +434,10 @@ protected:
     lldb_private::LazyBool m_supports_alloc_dealloc_memory;
     lldb_private::LazyBool m_supports_memory_region_info;
     lldb_private::LazyBool m_supports_watchpoint_support_info;
+    lldb_private::LazyBool m_supports_x;
+    lldb_private::LazyBool m_supports_X;
+    lldb_private::LazyBool m_supports_qMultiMemRead;
+    lldb_private::LazyBool m_supports_qMultiBreakpoint;
 
     bool
         m_supports_qProcessInfoPID:1,
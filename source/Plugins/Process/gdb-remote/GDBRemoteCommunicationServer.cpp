@@ -160,6 +160,9 @@ GDBRemoteCommunicationServer::GetPacketAndSendResponse (uint32_t timeout_usec,
 
             case StringExtractorGDBRemote::eServerPacketType_QStartNoAckMode:
                 return Handle_QStartNoAckMode (packet);
+
+            case StringExtractorGDBRemote::eServerPacketType_QEnableCompression:
+                return Handle_QEnableCompression (packet);
         }
         return true;
     }
@@ -832,3 +835,25 @@ GDBRemoteCommunicationServer::Handle_QStartNoAckMode (StringExtractorGDBRemote &
     m_send_acks = false;
     return true;
 }
+
+bool
+GDBRemoteCommunicationServer::Handle_QEnableCompression (StringExtractorGDBRemote &packet)
+{
+    // "QEnableCompression:minsize:<decimal>;" asks for all responses of
+    // at least minsize bytes to be compressed
+    packet.SetFilePos(::strlen ("QEnableCompression:"));
+    uint32_t min_size = 0;
+    std::string key, value;
+    while (packet.GetNameColonValue(key, value))
+    {
+        if (key.compare("minsize") == 0)
+            min_size = Args::StringToUInt32 (value.c_str(), 0, 0);
+    }
+    if (min_size == 0)
+        return SendErrorResponse (1);
+
+    // Send response first so it isn't compressed
+    SendOKResponse ();
+    m_compression_min_size = min_size;
+    return true;
+}
@@ -128,6 +128,9 @@ protected:
     bool
     Handle_QStartNoAckMode (StringExtractorGDBRemote &packet);
 
+    bool
+    Handle_QEnableCompression (StringExtractorGDBRemote &packet);
+
     bool
     Handle_QSetSTDIN (StringExtractorGDBRemote &packet);
 
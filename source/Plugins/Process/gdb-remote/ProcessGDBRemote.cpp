@@ -177,7 +177,8 @@ ProcessGDBRemote::ProcessGDBRemote(Target& target, Listener &listener) :
     m_addr_to_mmap_size (),
     m_thread_create_bp_sp (),
     m_waiting_for_attach (false),
-    m_destroy_tried_resuming (false)
+    m_destroy_tried_resuming (false),
+    m_suspended_threads_stayed_stopped (false)
 {
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncThreadShouldExit,   "async thread should exit");
     m_async_broadcaster.SetEventName (eBroadcastBitAsyncContinue,           "async thread continue");
@@ -727,6 +728,7 @@ ProcessGDBRemote::ConnectToDebugserver (const char *connect_url)
     }
     m_gdb_comm.ResetDiscoverableSettings();
     m_gdb_comm.QueryNoAckModeSupported ();
+    m_gdb_comm.QueryCompressionSupported ();
     m_gdb_comm.GetThreadSuffixSupported ();
     m_gdb_comm.GetListThreadsInStopReplySupported ();
     m_gdb_comm.GetHostInfo ();
@@ -1016,6 +1018,11 @@ ProcessGDBRemote::DoResume ()
         }
         else
             continue_packet_error = true;
+
+        // Only a vCont packet names exactly which threads should run, we
+        // can't be sure what the remote GDB server does with suspended
+        // threads for the simple packets below.
+        m_suspended_threads_stayed_stopped = !continue_packet_error;
         
         if (continue_packet_error)
         {
@@ -1225,13 +1232,57 @@ ProcessGDBRemote::UpdateThreadList (ThreadList &old_thread_list, ThreadList &new
 
     if (num_thread_ids > 0)
     {
-        for (size_t i=0; i<num_thread_ids; ++i)
+        // Most stops don't create or destroy any threads, so first check if
+        // the thread IDs are the same as last time so we can reuse all of
+        // the threads without having to search the old thread list.
+        const uint32_t num_old_threads = old_thread_list.GetSize(false);
+        bool same_thread_ids = num_old_threads == num_thread_ids;
+        for (uint32_t i=0; same_thread_ids && i<num_old_threads; ++i)
+        {
+            if (old_thread_list.GetThreadAtIndex (i, false)->GetID() != m_thread_ids[i])
+                same_thread_ids = false;
+        }
+
+        if (same_thread_ids)
+        {
+            for (uint32_t i=0; i<num_old_threads; ++i)
+                new_thread_list.AddThread (old_thread_list.GetThreadAtIndex (i, false));
+        }
+        else
         {
-            tid_t tid = m_thread_ids[i];
-            ThreadSP thread_sp (old_thread_list.FindThreadByID (tid, false));
-            if (!thread_sp)
-                thread_sp.reset (new ThreadGDBRemote (shared_from_this(), tid));
-            new_thread_list.AddThread(thread_sp);
+            typedef std::map<lldb::tid_t, ThreadSP> ThreadIDMap;
+            ThreadIDMap old_threads;
+            for (uint32_t i=0; i<num_old_threads; ++i)
+            {
+                ThreadSP old_thread_sp (old_thread_list.GetThreadAtIndex (i, false));
+                old_threads[old_thread_sp->GetID()] = old_thread_sp;
+            }
+
+            uint32_t num_new_threads = 0;
+            for (size_t i=0; i<num_thread_ids; ++i)
+            {
+                tid_t tid = m_thread_ids[i];
+                ThreadSP thread_sp;
+                ThreadIDMap::iterator pos = old_threads.find (tid);
+                if (pos != old_threads.end())
+                {
+                    thread_sp = pos->second;
+                    old_threads.erase (pos);
+                }
+                else
+                {
+                    thread_sp.reset (new ThreadGDBRemote (shared_from_this(), tid));
+                    ++num_new_threads;
+                }
+                new_thread_list.AddThread(thread_sp);
+            }
+
+            if (log)
+                log->Printf ("ProcessGDBRemote::%s (pid = %llu) %u threads created, %u threads exited",
+                             __FUNCTION__,
+                             GetID(),
+                             num_new_threads,
+                             (uint32_t)old_threads.size());
         }
     }
 
@@ -1877,6 +1928,17 @@ ProcessGDBRemote::GetImageInfoAddress()
     return m_gdb_comm.GetShlibInfoAddr();
 }
 
+void
+ProcessGDBRemote::GetStatistics (ProcessStatistics &stats)
+{
+    Process::GetStatistics (stats);
+    stats.packets_sent = m_gdb_comm.GetNumPacketsSent();
+    stats.packets_received = m_gdb_comm.GetNumPacketsReceived();
+    stats.packet_bytes_sent = m_gdb_comm.GetNumPacketBytesSent();
+    stats.packet_bytes_received = m_gdb_comm.GetNumPacketBytesReceived();
+    stats.packet_bytes_saved = m_gdb_comm.GetNumPacketBytesSaved();
+}
+
 //------------------------------------------------------------------
 // Process Memory
 //------------------------------------------------------------------
@@ -1891,15 +1953,28 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
         size = m_max_memory_size;
     }
 
+    // A binary reply to a read of a few bytes could look just like an
+    // "OK" or "Exx" response. Those reads gain nothing from the binary
+    // encoding anyway, so they keep using the 'm' packet.
+    const bool binary_read = size > 3 && m_gdb_comm.GetBinaryMemoryReadSupported();
     char packet[64];
-    const int packet_len = ::snprintf (packet, sizeof(packet), "m%llx,%zx", (uint64_t)addr, size);
+    const int packet_len = ::snprintf (packet, sizeof(packet), "%c%llx,%zx", binary_read ? 'x' : 'm', (uint64_t)addr, size);
     assert (packet_len + 1 < sizeof(packet));
     StringExtractorGDBRemote response;
     if (m_gdb_comm.SendPacketAndWaitForResponse(packet, packet_len, response, true))
     {
+        if (binary_read && response.IsUnsupportedResponse())
+        {
+            // The stub answered the probe but not a real read, go back
+            // to hex encoded reads for good
+            m_gdb_comm.DisableBinaryMemoryRead();
+            return DoReadMemory (addr, buf, size, error);
+        }
         if (response.IsNormalResponse())
         {
             error.Clear();
+            if (binary_read)
+                return response.GetEscapedBinaryData(buf, size);
             return response.GetHexBytes(buf, size, '\xdd');
         }
         else if (response.IsErrorResponse())
@@ -1916,6 +1991,131 @@ ProcessGDBRemote::DoReadMemory (addr_t addr, void *buf, size_t size, Error &erro
     return 0;
 }
 
+size_t
+ProcessGDBRemote::DoReadMemoryRanges (const LoadRangeList &ranges, uint8_t *buf, std::vector<size_t> &bytes_read, Error &error)
+{
+    if (!m_gdb_comm.GetMultiMemReadSupported())
+        return Process::DoReadMemoryRanges (ranges, buf, bytes_read, error);
+
+    // Keep each reply down to a sane size, ranges that are larger than
+    // this on their own are read with DoReadMemory()
+    const size_t max_batch_bytes = 16 * m_max_memory_size;
+    const size_t max_batch_ranges = 128;
+
+    size_t total_bytes_read = 0;
+    uint8_t *bytes = buf;
+    size_t idx = 0;
+    while (idx < ranges.size())
+    {
+        size_t end_idx = idx;
+        size_t batch_bytes = 0;
+        while (end_idx < ranges.size() &&
+               end_idx - idx < max_batch_ranges &&
+               batch_bytes + ranges[end_idx].GetByteSize() <= max_batch_bytes)
+        {
+            batch_bytes += ranges[end_idx].GetByteSize();
+            ++end_idx;
+        }
+
+        if (end_idx == idx)
+        {
+            LoadRangeList single_range (1, ranges[idx]);
+            std::vector<size_t> single_bytes_read (1, 0);
+            total_bytes_read += Process::DoReadMemoryRanges (single_range, bytes, single_bytes_read, error);
+            bytes_read[idx] = single_bytes_read[0];
+            bytes += ranges[idx].GetByteSize();
+            ++idx;
+            continue;
+        }
+
+        StreamString packet;
+        packet.PutCString ("qMultiMemRead:");
+        for (size_t i = idx; i < end_idx; ++i)
+            packet.Printf ("%s%llx,%llx", i > idx ? ";" : "", ranges[i].GetRangeBase(), ranges[i].GetByteSize());
+
+        StringExtractorGDBRemote response;
+        if (!m_gdb_comm.SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true))
+        {
+            error.SetErrorStringWithFormat("failed to send packet: '%s'", packet.GetData());
+            break;
+        }
+
+        bool read_ranges_separately = false;
+        if (response.IsUnsupportedResponse())
+        {
+            // The stub answered the probe but not a real read
+            read_ranges_separately = true;
+        }
+        else if (response.IsNormalResponse())
+        {
+            // Get the lengths first since they tell us how much of the
+            // binary data belongs to each range. Once a length is wrong
+            // there is no telling where the data of the following ranges
+            // starts, so anything unexpected rejects the whole reply.
+            std::vector<size_t> lengths;
+            bool malformed = false;
+            for (size_t i = idx; !malformed && i < end_idx; ++i)
+            {
+                const uint64_t length = response.GetHexMaxU64 (false, UINT64_MAX);
+                const char separator = response.GetChar();
+                const char expected_separator = (i + 1 < end_idx) ? ',' : ';';
+                if (length == UINT64_MAX || length > ranges[i].GetByteSize() || separator != expected_separator)
+                    malformed = true;
+                else
+                    lengths.push_back (length);
+            }
+
+            uint8_t *range_bytes = bytes;
+            for (size_t i = idx; !malformed && i < end_idx; ++i)
+            {
+                const size_t length = lengths[i - idx];
+                if (length > 0 && response.GetEscapedBinaryData (range_bytes, length) != length)
+                    malformed = true;
+                range_bytes += ranges[i].GetByteSize();
+            }
+            if (!malformed && response.GetBytesLeft() > 0)
+                malformed = true;
+
+            if (malformed)
+            {
+                LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet (GDBR_LOG_MEMORY));
+                if (log)
+                    log->Printf ("ProcessGDBRemote::DoReadMemoryRanges malformed response to '%s', reading ranges separately", packet.GetData());
+                read_ranges_separately = true;
+            }
+            else
+            {
+                for (size_t i = idx; i < end_idx; ++i)
+                {
+                    bytes_read[i] = lengths[i - idx];
+                    total_bytes_read += bytes_read[i];
+                }
+            }
+        }
+
+        if (read_ranges_separately)
+        {
+            // Don't trust this stub with another multi-range read, read
+            // the remaining ranges one at a time from now on
+            m_gdb_comm.DisableMultiMemRead();
+            LoadRangeList remaining_ranges (ranges.begin() + idx, ranges.end());
+            std::vector<size_t> remaining_bytes_read (remaining_ranges.size(), 0);
+            total_bytes_read += Process::DoReadMemoryRanges (remaining_ranges, bytes, remaining_bytes_read, error);
+            std::copy (remaining_bytes_read.begin(), remaining_bytes_read.end(), bytes_read.begin() + idx);
+            return total_bytes_read;
+        }
+
+        if (response.IsErrorResponse())
+            error.SetErrorStringWithFormat("gdb remote returned an error: %s", response.GetStringRef().c_str());
+        else if (!response.IsNormalResponse())
+            error.SetErrorStringWithFormat("unexpected response to '%s': '%s'", packet.GetData(), response.GetStringRef().c_str());
+
+        bytes += batch_bytes;
+        idx = end_idx;
+    }
+    return total_bytes_read;
+}
+
 size_t
 ProcessGDBRemote::DoWriteMemory (addr_t addr, const void *buf, size_t size, Error &error)
 {
@@ -1927,12 +2127,26 @@ ProcessGDBRemote::DoWriteMemory (addr_t addr, const void *buf, size_t size, Erro
         size = m_max_memory_size;
     }
 
+    const bool binary_write = m_gdb_comm.GetBinaryMemoryWriteSupported();
     StreamString packet;
-    packet.Printf("M%llx,%zx:", addr, size);
-    packet.PutBytesAsRawHex8(buf, size, lldb::endian::InlHostByteOrder(), lldb::endian::InlHostByteOrder());
+    if (binary_write)
+    {
+        packet.Printf("X%llx,%zx:", addr, size);
+        GDBRemoteCommunication::PutEscapedBinaryData (packet, buf, size);
+    }
+    else
+    {
+        packet.Printf("M%llx,%zx:", addr, size);
+        packet.PutBytesAsRawHex8(buf, size, lldb::endian::InlHostByteOrder(), lldb::endian::InlHostByteOrder());
+    }
     StringExtractorGDBRemote response;
     if (m_gdb_comm.SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true))
     {
+        if (binary_write && response.IsUnsupportedResponse())
+        {
+            m_gdb_comm.DisableBinaryMemoryWrite();
+            return DoWriteMemory (addr, buf, size, error);
+        }
         if (response.IsOKResponse())
         {
             error.Clear();
@@ -2168,6 +2382,216 @@ ProcessGDBRemote::DisableBreakpoint (BreakpointSite *bp_site)
     return error;
 }
 
+void
+ProcessGDBRemote::SendMultiBreakpointPackets (bool insert,
+                                              const BreakpointSiteList::collection &bp_sites,
+                                              std::vector<bool> &results)
+{
+    results.assign (bp_sites.size(), false);
+    const size_t max_batch_sites = 256;
+    size_t idx = 0;
+    while (idx < bp_sites.size())
+    {
+        const size_t end_idx = std::min<size_t> (idx + max_batch_sites, bp_sites.size());
+        StreamString packet;
+        packet.PutCString ("qMultiBreakpoint:");
+        for (size_t i = idx; i < end_idx; ++i)
+            packet.Printf ("%s%c%llx,%x",
+                           i > idx ? ";" : "",
+                           insert ? 'Z' : 'z',
+                           bp_sites[i]->GetLoadAddress(),
+                           (uint32_t)bp_sites[i]->GetByteSize());
+
+        StringExtractorGDBRemote response;
+        if (!m_gdb_comm.SendPacketAndWaitForResponse(packet.GetData(), packet.GetSize(), response, true))
+            return;
+
+        if (response.IsUnsupportedResponse())
+        {
+            // The stub answered the probe but not a real request, the
+            // remaining sites will be set one at a time from now on
+            m_gdb_comm.DisableMultiBreakpoint();
+            return;
+        }
+
+        // The reply has one "OK" or "Exx" per site, separated by ';'
+        const std::string &reply = response.GetStringRef();
+        size_t entry_start = 0;
+        for (size_t i = idx; i < end_idx && entry_start <= reply.size(); ++i)
+        {
+            size_t entry_end = reply.find (';', entry_start);
+            if (entry_end == std::string::npos)
+                entry_end = reply.size();
+            results[i] = reply.compare (entry_start, entry_end - entry_start, "OK") == 0;
+            entry_start = entry_end + 1;
+        }
+        idx = end_idx;
+    }
+}
+
+size_t
+ProcessGDBRemote::EnableBreakpointSites (const BreakpointSiteList::collection &bp_sites, std::vector<Error> &errors)
+{
+    LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+    const size_t num_sites = bp_sites.size();
+    errors.clear();
+    errors.resize (num_sites);
+
+    // Sites that prefer hardware breakpoints are enabled one at a time, the
+    // rest are inserted by the stub if it can, and written into memory
+    // otherwise.
+    BreakpointSiteList::collection software_sites;
+    std::vector<size_t> software_site_indexes;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        BreakpointSite *bp_site = bp_sites[i].get();
+        if (bp_site->IsEnabled())
+            continue;
+        if (bp_site->HardwarePreferred())
+        {
+            errors[i] = EnableBreakpoint (bp_site);
+            continue;
+        }
+        // This also fills in the byte size of the breakpoint site
+        GetSoftwareBreakpointTrapOpcode (bp_site);
+        software_sites.push_back (bp_sites[i]);
+        software_site_indexes.push_back (i);
+    }
+
+    BreakpointSiteList::collection memory_sites;
+    std::vector<size_t> memory_site_indexes;
+    if (!software_sites.empty() && m_gdb_comm.SupportsGDBStoppointPacket (eBreakpointSoftware))
+    {
+        std::vector<bool> inserted (software_sites.size(), false);
+        if (m_gdb_comm.GetMultiBreakpointSupported())
+            SendMultiBreakpointPackets (true, software_sites, inserted);
+
+        for (size_t i = 0; i < software_sites.size(); ++i)
+        {
+            BreakpointSite *bp_site = software_sites[i].get();
+            if (inserted[i])
+            {
+                bp_site->SetEnabled(true);
+                bp_site->SetType (BreakpointSite::eExternal);
+            }
+            else if (m_gdb_comm.GetMultiBreakpointSupported())
+            {
+                // The stub couldn't insert this one, just like
+                // EnableBreakpoint() does, write the trap into memory
+                memory_sites.push_back (software_sites[i]);
+                memory_site_indexes.push_back (software_site_indexes[i]);
+            }
+            else
+            {
+                errors[software_site_indexes[i]] = EnableBreakpoint (bp_site);
+            }
+        }
+    }
+    else
+    {
+        memory_sites.swap (software_sites);
+        memory_site_indexes.swap (software_site_indexes);
+    }
+
+    if (!memory_sites.empty())
+    {
+        std::vector<Error> memory_errors;
+        EnableSoftwareBreakpoints (memory_sites, memory_errors);
+        for (size_t i = 0; i < memory_sites.size(); ++i)
+            errors[memory_site_indexes[i]] = memory_errors[i];
+    }
+
+    size_t num_enabled = 0;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        if (errors[i].Success())
+            ++num_enabled;
+    }
+    if (log)
+        log->Printf ("ProcessGDBRemote::EnableBreakpointSites () enabled %llu of %llu sites",
+                     (uint64_t)num_enabled,
+                     (uint64_t)num_sites);
+    return num_enabled;
+}
+
+size_t
+ProcessGDBRemote::DisableBreakpointSites (const BreakpointSiteList::collection &bp_sites, std::vector<Error> &errors)
+{
+    LogSP log (ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_BREAKPOINTS));
+    const size_t num_sites = bp_sites.size();
+    errors.clear();
+    errors.resize (num_sites);
+
+    // Traps we wrote into memory are restored a page at a time, and
+    // breakpoints the stub inserted are removed with as few packets as
+    // possible.
+    BreakpointSiteList::collection memory_sites;
+    std::vector<size_t> memory_site_indexes;
+    BreakpointSiteList::collection external_sites;
+    std::vector<size_t> external_site_indexes;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        BreakpointSite *bp_site = bp_sites[i].get();
+        if (!bp_site->IsEnabled())
+            continue;
+        switch (bp_site->GetType())
+        {
+        case BreakpointSite::eSoftware:
+            memory_sites.push_back (bp_sites[i]);
+            memory_site_indexes.push_back (i);
+            break;
+
+        case BreakpointSite::eExternal:
+            if (m_gdb_comm.GetMultiBreakpointSupported())
+            {
+                GetSoftwareBreakpointTrapOpcode (bp_site);
+                external_sites.push_back (bp_sites[i]);
+                external_site_indexes.push_back (i);
+                break;
+            }
+            errors[i] = DisableBreakpoint (bp_site);
+            break;
+
+        case BreakpointSite::eHardware:
+            errors[i] = DisableBreakpoint (bp_site);
+            break;
+        }
+    }
+
+    if (!external_sites.empty())
+    {
+        std::vector<bool> removed;
+        SendMultiBreakpointPackets (false, external_sites, removed);
+        for (size_t i = 0; i < external_sites.size(); ++i)
+        {
+            if (removed[i])
+                external_sites[i]->SetEnabled(false);
+            else
+                errors[external_site_indexes[i]] = DisableBreakpoint (external_sites[i].get());
+        }
+    }
+
+    if (!memory_sites.empty())
+    {
+        std::vector<Error> memory_errors;
+        DisableSoftwareBreakpoints (memory_sites, memory_errors);
+        for (size_t i = 0; i < memory_sites.size(); ++i)
+            errors[memory_site_indexes[i]] = memory_errors[i];
+    }
+
+    size_t num_disabled = 0;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        if (errors[i].Success())
+            ++num_disabled;
+    }
+    if (log)
+        log->Printf ("ProcessGDBRemote::DisableBreakpointSites () disabled %llu of %llu sites",
+                     (uint64_t)num_disabled,
+                     (uint64_t)num_sites);
+    return num_disabled;
+}
+
 // Pre-requisite: wp != NULL.
 static GDBStoppointType
 GetGDBStoppointType (Watchpoint *wp)
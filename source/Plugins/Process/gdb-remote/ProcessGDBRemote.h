@@ -161,12 +161,21 @@ public:
     virtual lldb::addr_t
     GetImageInfoAddress();
 
+    virtual void
+    GetStatistics (lldb_private::ProcessStatistics &stats);
+
     //------------------------------------------------------------------
     // Process Memory
     //------------------------------------------------------------------
     virtual size_t
     DoReadMemory (lldb::addr_t addr, void *buf, size_t size, lldb_private::Error &error);
 
+    virtual size_t
+    DoReadMemoryRanges (const LoadRangeList &ranges,
+                        uint8_t *buf,
+                        std::vector<size_t> &bytes_read,
+                        lldb_private::Error &error);
+
     virtual size_t
     DoWriteMemory (lldb::addr_t addr, const void *buf, size_t size, lldb_private::Error &error);
 
@@ -195,6 +204,14 @@ public:
     virtual lldb_private::Error
     DisableBreakpoint (lldb_private::BreakpointSite *bp_site);
 
+    virtual size_t
+    EnableBreakpointSites (const lldb_private::BreakpointSiteList::collection &bp_sites,
+                           std::vector<lldb_private::Error> &errors);
+
+    virtual size_t
+    DisableBreakpointSites (const lldb_private::BreakpointSiteList::collection &bp_sites,
+                            std::vector<lldb_private::Error> &errors);
+
     //----------------------------------------------------------------------
     // Process Watchpoints
     //----------------------------------------------------------------------
@@ -284,6 +301,11 @@ protected:
     void
     BuildDynamicRegisterInfo (bool force);
 
+    void
+    SendMultiBreakpointPackets (bool insert,
+                                const lldb_private::BreakpointSiteList::collection &bp_sites,
+                                std::vector<bool> &results);
+
     void
     SetLastStopPacket (const StringExtractorGDBRemote &response)
     {
@@ -322,6 +344,7 @@ protected:
     lldb::BreakpointSP m_thread_create_bp_sp;
     bool m_waiting_for_attach;
     bool m_destroy_tried_resuming;
+    bool m_suspended_threads_stayed_stopped; // True if the last resume used vCont so threads that weren't resumed didn't run
     
     bool
     StartAsyncThread ();
@@ -354,6 +377,17 @@ protected:
     lldb_private::Error
     ConnectToDebugserver (const char *host_port);
 
+    //------------------------------------------------------------------
+    /// Returns true if the remote GDB server was told exactly which
+    /// threads to resume (with a vCont packet) for the last resume, so
+    /// threads that were suspended are known not to have run.
+    //------------------------------------------------------------------
+    bool
+    GetSuspendedThreadsStayedStopped () const
+    {
+        return m_suspended_threads_stayed_stopped;
+    }
+
     const char *
     GetDispatchQueueNameForThread (lldb::addr_t thread_dispatch_qaddr,
                                    std::string &dispatch_queue_name);
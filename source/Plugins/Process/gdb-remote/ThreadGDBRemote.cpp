@@ -36,7 +36,8 @@ ThreadGDBRemote::ThreadGDBRemote (const ProcessSP &process_sp, lldb::tid_t tid)
     Thread(process_sp, tid),
     m_thread_name (),
     m_dispatch_queue_name (),
-    m_thread_dispatch_qaddr (LLDB_INVALID_ADDRESS)
+    m_thread_dispatch_qaddr (LLDB_INVALID_ADDRESS),
+    m_resumed (true)
 {
     ProcessGDBRemoteLog::LogIf(GDBR_LOG_THREAD, "%p: ThreadGDBRemote::ThreadGDBRemote (pid = %i, tid = 0x%4.4x)", 
                                this, 
@@ -83,7 +84,12 @@ ThreadGDBRemote::GetQueueName ()
 bool
 ThreadGDBRemote::WillResume (StateType resume_state)
 {
-    ClearStackFrames();
+    // Threads that stay suspended keep their stack frames so they don't
+    // have to be unwound again after the next stop. RefreshStateAfterStop()
+    // clears them if it turns out the thread might have run anyway.
+    m_resumed = (resume_state == eStateRunning || resume_state == eStateStepping);
+    if (m_resumed)
+        ClearStackFrames();
     // Call the Thread::WillResume first. If we stop at a signal, the stop info
     // class for signal will set the resume signal that we need below. The signal
     // stuff obeys the Process::UnixSignal defaults. 
@@ -130,6 +136,24 @@ ThreadGDBRemote::WillResume (StateType resume_state)
 void
 ThreadGDBRemote::RefreshStateAfterStop()
 {
+    ProcessSP process_sp (GetProcess());
+    if (!m_resumed && process_sp)
+    {
+        ProcessGDBRemote *gdb_process = static_cast<ProcessGDBRemote *>(process_sp.get());
+        if (gdb_process->GetSuspendedThreadsStayedStopped())
+        {
+            // This thread didn't run, so its registers and stack frames are
+            // the same as they were at the last stop and it has no stop
+            // reason. Mark them as current for this stop so we don't ask the
+            // remote GDB server for any of them again.
+            GetRegisterContext()->SetStopID (process_sp->GetStopID());
+            SetStopInfo (StopInfoSP());
+            return;
+        }
+        // We can't tell if the thread ran, so don't trust the frames we kept
+        ClearStackFrames();
+    }
+
     // Invalidate all registers in our register context. We don't set "force" to
     // true because the stop reply packet might have had some register values
     // that were expedited and these will already be copied into the register
@@ -94,6 +94,7 @@ protected:
     std::string m_thread_name;
     std::string m_dispatch_queue_name;
     lldb::addr_t m_thread_dispatch_qaddr;
+    bool m_resumed; // True if this thread was told to run or step for the last resume
     //------------------------------------------------------------------
     // Member variables.
     //------------------------------------------------------------------
@@ -139,6 +139,14 @@ DWARFCompileUnit::ClearDIEs(bool keep_compile_unit_die)
         m_die_array.swap(tmp_array);
         if (keep_compile_unit_die)
             m_die_array.push_back(tmp_array.front());
+
+        ModuleSP module_sp (m_dwarf2Data->GetObjectFile()->GetModule());
+        if (module_sp)
+        {
+            const size_t num_freed_dies = tmp_array.size() - m_die_array.size();
+            Statistics::Decrement (module_sp->GetStatistics().debug_info_byte_size,
+                                   num_freed_dies * sizeof(DWARFDebugInfoEntry));
+        }
     }
 }
 
@@ -283,6 +291,16 @@ DWARFCompileUnit::ExtractDIEsIfNeeded (bool cu_die_only)
         DWARFDebugInfoEntry::collection exact_size_die_array (m_die_array.begin(), m_die_array.end());
         exact_size_die_array.swap (m_die_array);
     }
+
+    ModuleSP module_sp (m_dwarf2Data->GetObjectFile()->GetModule());
+    if (module_sp)
+    {
+        const size_t num_new_dies = m_die_array.size() - initial_die_array_size;
+        ModuleStatistics &stats = module_sp->GetStatistics();
+        Statistics::Increment (stats.num_dies_parsed, num_new_dies);
+        Statistics::Increment (stats.debug_info_byte_size, num_new_dies * sizeof(DWARFDebugInfoEntry));
+    }
+
     LogSP log (LogChannelDWARF::GetLogIfAll (DWARF_LOG_DEBUG_INFO | DWARF_LOG_VERBOSE));
     if (log)
     {
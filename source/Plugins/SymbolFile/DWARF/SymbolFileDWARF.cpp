@@ -297,7 +297,9 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFile* objfile) :
     m_using_apple_tables (false),
     m_supports_DW_AT_APPLE_objc_complete_type (eLazyBoolCalculate),
     m_ranges(),
-    m_unique_ast_type_map ()
+    m_unique_ast_type_map (),
+    m_deferred_method_dies (),
+    m_resolving_deferred_methods_type (NULL)
 {
 }
 
@@ -340,6 +342,7 @@ SymbolFileDWARF::GetClangASTContext ()
             new ClangExternalASTSourceCallbacks (SymbolFileDWARF::CompleteTagDecl,
                                                  SymbolFileDWARF::CompleteObjCInterfaceDecl,
                                                  SymbolFileDWARF::FindExternalVisibleDeclsByName,
+                                                 SymbolFileDWARF::FindExternalLexicalDecls,
                                                  SymbolFileDWARF::LayoutRecordType,
                                                  this));
         ast.SetExternalSource (ast_source_ap);
@@ -1907,6 +1910,8 @@ SymbolFileDWARF::ParseChildMembers
             break;
 
         default:
+            // Nested types and everything else are left alone, a nested
+            // type is only parsed once something refers to it
             break;
         }
     }
@@ -2047,6 +2052,10 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t clang_type
     // clang::ExternalASTSource queries for this type.
     ClangASTContext::SetHasExternalStorage (clang_type, false);
 
+    ModuleSP module_sp (GetObjectFile()->GetModule());
+    if (module_sp)
+        Statistics::Increment (module_sp->GetStatistics().num_types_completed);
+
     DWARFDebugInfo* debug_info = DebugInfo();
 
     DWARFCompileUnit *dwarf_cu = debug_info->GetCompileUnitContainingDIE (die->GetOffset()).get();
@@ -2135,9 +2144,30 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t clang_type
                     size_t num_functions = member_function_dies.Size();                
                     if (num_functions > 0)
                     {
+                        // Only the C++ methods clang needs to lay out and copy
+                        // the class are added now. The rest are added when all
+                        // the members of the class are walked or when one of
+                        // them is needed, see ResolveDeferredMethods(). Fields
+                        // can't be deferred like this: clang lays out the record
+                        // as soon as it is completed, and sizeof and the field
+                        // offsets have to match layout_info.
+                        const char *class_name = NULL;
+                        if (class_language != eLanguageTypeObjC && ClangASTContext::IsCXXClassType (clang_type))
+                            class_name = die->GetName (this, dwarf_cu);
+                        DIEArray deferred_method_dies;
                         for (size_t i=0; i<num_functions; ++i)
                         {
-                            ResolveType(dwarf_cu, member_function_dies.GetDIEPtrAtIndex(i));
+                            const DWARFDebugInfoEntry *method_die = member_function_dies.GetDIEPtrAtIndex(i);
+                            if (class_name && CanDeferMethod (dwarf_cu, class_name, method_die))
+                                deferred_method_dies.push_back (method_die->GetOffset());
+                            else
+                                ResolveType(dwarf_cu, method_die);
+                        }
+                        if (!deferred_method_dies.empty())
+                        {
+                            if (module_sp)
+                                Statistics::Increment (module_sp->GetStatistics().num_methods_deferred, deferred_method_dies.size());
+                            m_deferred_method_dies[clang_type_no_qualifiers].swap (deferred_method_dies);
                         }
                     }
                     
@@ -2239,6 +2269,15 @@ SymbolFileDWARF::ResolveClangOpaqueTypeDefinition (lldb::clang_type_t clang_type
             
             ast.CompleteTagDeclarationDefinition (clang_type);
             
+            if (m_deferred_method_dies.count (clang_type_no_qualifiers))
+            {
+                // Have clang ask for the deferred methods when something
+                // walks all the members of the class
+                clang::CXXRecordDecl *cxx_record_decl = clang::QualType::getFromOpaquePtr(clang_type)->getAsCXXRecordDecl();
+                if (cxx_record_decl)
+                    cxx_record_decl->setHasExternalLexicalStorage (true);
+            }
+
             if (!layout_info.field_offsets.empty())
             {
                 if (type)
@@ -2591,6 +2630,8 @@ SymbolFileDWARF::Index ()
     Timer scoped_timer (__PRETTY_FUNCTION__,
                         "SymbolFileDWARF::Index (%s)",
                         GetObjectFile()->GetFileSpec().GetFilename().AsCString());
+    ModuleSP module_sp (GetObjectFile()->GetModule());
+    StatsTimer stats_timer (module_sp ? &module_sp->GetStatistics().symfile_index_nsec : NULL);
 
     DWARFDebugInfo* debug_info = DebugInfo();
     if (debug_info)
@@ -3144,6 +3185,13 @@ SymbolFileDWARF::FunctionDieMatchesPartialName (const DWARFDebugInfoEntry* die,
     return true;
 }
 
+bool
+SymbolFileDWARF::HasFunctionNameIndex ()
+{
+    // The accelerator tables are used instead of our own indexes
+    return m_using_apple_tables || m_indexed;
+}
+
 uint32_t
 SymbolFileDWARF::FindFunctions (const ConstString &name, 
                                 const lldb_private::ClangNamespaceDecl *namespace_decl, 
@@ -4950,6 +4998,76 @@ SymbolFileDWARF::FindDefinitionTypeForDWARFDeclContext (const DWARFDeclContext &
     return type_sp;
 }
 
+bool
+SymbolFileDWARF::CanDeferMethod (DWARFCompileUnit *dwarf_cu,
+                                 const char *class_name,
+                                 const DWARFDebugInfoEntry *method_die)
+{
+    // Virtual methods make the class dynamic, and constructors, destructors,
+    // conversion functions and operators change how clang copies and
+    // converts the class, so all of those have to be there when the class
+    // is completed
+    if (method_die->GetAttributeValueAsUnsigned (this, dwarf_cu, DW_AT_virtuality, 0) != 0)
+        return false;
+    if (method_die->GetAttributeValueAsUnsigned (this, dwarf_cu, DW_AT_artificial, 0) != 0)
+        return false;
+    const char *method_name = method_die->GetName (this, dwarf_cu);
+    if (method_name == NULL || method_name[0] == '~' || ::strncmp (method_name, "operator", 8) == 0)
+        return false;
+    // Constructors are named after the class without its template arguments
+    const char *template_args = ::strchr (class_name, '<');
+    const size_t class_name_len = template_args ? template_args - class_name : ::strlen (class_name);
+    if (::strncmp (method_name, class_name, class_name_len) == 0 &&
+        (method_name[class_name_len] == '\0' || method_name[class_name_len] == '<'))
+        return false;
+    return true;
+}
+
+bool
+SymbolFileDWARF::ResolveDeferredMethods (lldb::clang_type_t clang_type)
+{
+    clang_type_t clang_type_no_qualifiers = ClangASTType::RemoveFastQualifiers(clang_type);
+    ClangTypeToDIEArray::iterator pos = m_deferred_method_dies.find (clang_type_no_qualifiers);
+    if (pos == m_deferred_method_dies.end())
+        return false;
+    // Take the DIEs out of the map first, resolving the methods can resolve
+    // other classes and add to it
+    DIEArray method_die_offsets;
+    method_die_offsets.swap (pos->second);
+    m_deferred_method_dies.erase (pos);
+
+    clang::CXXRecordDecl *cxx_record_decl = clang::QualType::getFromOpaquePtr(clang_type)->getAsCXXRecordDecl();
+    if (cxx_record_decl)
+        cxx_record_decl->setHasExternalLexicalStorage (false);
+
+    LogSP log (LogChannelDWARF::GetLogIfAny(DWARF_LOG_DEBUG_INFO|DWARF_LOG_TYPE_COMPLETION));
+    if (log)
+        GetObjectFile()->GetModule()->LogMessage (log.get(),
+                                                  "SymbolFileDWARF::ResolveDeferredMethods (clang_type = %p) adding %u methods",
+                                                  clang_type,
+                                                  (uint32_t)method_die_offsets.size());
+
+    // ParseType() only adds methods to classes that are being defined, so
+    // let it know this class is taking methods too
+    const clang_type_t prev_resolving_type = m_resolving_deferred_methods_type;
+    m_resolving_deferred_methods_type = clang_type_no_qualifiers;
+    DWARFDebugInfo* debug_info = DebugInfo();
+    DWARFCompileUnit* method_cu = NULL;
+    const size_t num_methods = method_die_offsets.size();
+    for (size_t i=0; i<num_methods; ++i)
+    {
+        const DWARFDebugInfoEntry *method_die = debug_info->GetDIEPtrWithCompileUnitHint (method_die_offsets[i], &method_cu);
+        if (method_die)
+            ResolveType (method_cu, method_die);
+    }
+    m_resolving_deferred_methods_type = prev_resolving_type;
+
+    ModuleSP module_sp (GetObjectFile()->GetModule());
+    if (module_sp)
+        Statistics::Increment (module_sp->GetStatistics().num_methods_completed, num_methods);
+    return true;
+}
+
 bool
 SymbolFileDWARF::CopyUniqueClassMethodTypes (Type *class_type,
                                              DWARFCompileUnit* src_cu,
@@ -4966,6 +5084,7 @@ SymbolFileDWARF::CopyUniqueClassMethodTypes (Type *class_type,
     // parsed so we can then unique those types to their equivalent counterparts
     // in "dst_cu" and "dst_class_die"
     class_type->GetClangFullType();
+    ResolveDeferredMethods (class_type->GetClangForwardType());
 
     const DWARFDebugInfoEntry *src_die;
     const DWARFDebugInfoEntry *dst_die;
@@ -6057,7 +6176,8 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                         clang_type_t class_opaque_type = class_type->GetClangForwardType();
                                         if (ClangASTContext::IsCXXClassType (class_opaque_type))
                                         {
-                                            if (ClangASTContext::IsBeingDefined (class_opaque_type))
+                                            if (ClangASTContext::IsBeingDefined (class_opaque_type) ||
+                                                ClangASTType::RemoveFastQualifiers (class_opaque_type) == m_resolving_deferred_methods_type)
                                             {
                                                 // Neither GCC 4.2 nor clang++ currently set a valid accessibility
                                                 // in the DWARF for C++ methods... Default to public for now...
@@ -6118,6 +6238,10 @@ SymbolFileDWARF::ParseType (const SymbolContext& sc, DWARFCompileUnit* dwarf_cu,
                                                 // using the clang::ExternalASTSource protocol which will parse all 
                                                 // base classes and all methods (including the method for this DIE).
                                                 class_type->GetClangFullType();
+                                                
+                                                // If the class was already complete, the method for this DIE
+                                                // may have been deferred
+                                                ResolveDeferredMethods (class_opaque_type);
 
                                                 // The type for this DIE should have been filled in the function call above
                                                 type_ptr = m_die_to_type[die];
@@ -7180,6 +7304,20 @@ SymbolFileDWARF::FindExternalVisibleDeclsByName (void *baton,
     }
 }
 
+void
+SymbolFileDWARF::FindExternalLexicalDecls (void *baton,
+                                           const clang::DeclContext *decl_context)
+{
+    const clang::CXXRecordDecl *cxx_record_decl = llvm::dyn_cast<clang::CXXRecordDecl>(decl_context);
+    if (cxx_record_decl)
+    {
+        SymbolFileDWARF *symbol_file_dwarf = (SymbolFileDWARF *)baton;
+        clang_type_t clang_type = symbol_file_dwarf->GetClangASTContext().GetTypeForDecl (const_cast<clang::CXXRecordDecl *>(cxx_record_decl));
+        if (clang_type)
+            symbol_file_dwarf->ResolveDeferredMethods (clang_type);
+    }
+}
+
 bool 
 SymbolFileDWARF::LayoutRecordType (void *baton, 
                                    const clang::RecordDecl *record_decl,
@@ -115,6 +115,7 @@ public:
     virtual uint32_t        FindGlobalVariables(const lldb_private::RegularExpression& regex, bool append, uint32_t max_matches, lldb_private::VariableList& variables);
     virtual uint32_t        FindFunctions(const lldb_private::ConstString &name, const lldb_private::ClangNamespaceDecl *namespace_decl, uint32_t name_type_mask, bool include_inlines, bool append, lldb_private::SymbolContextList& sc_list);
     virtual uint32_t        FindFunctions(const lldb_private::RegularExpression& regex, bool include_inlines, bool append, lldb_private::SymbolContextList& sc_list);
+    virtual bool            HasFunctionNameIndex ();
     virtual uint32_t        FindTypes (const lldb_private::SymbolContext& sc, const lldb_private::ConstString &name, const lldb_private::ClangNamespaceDecl *namespace_decl, bool append, uint32_t max_matches, lldb_private::TypeList& types);
     virtual lldb_private::TypeList *
                             GetTypeList ();
@@ -142,6 +143,10 @@ public:
                                     clang::DeclarationName Name,
                                     llvm::SmallVectorImpl <clang::NamedDecl *> *results);
 
+    static void
+    FindExternalLexicalDecls (void *baton,
+                              const clang::DeclContext *DC);
+
     static bool 
     LayoutRecordType (void *baton, 
                       const clang::RecordDecl *record_decl,
@@ -159,6 +164,18 @@ public:
                       llvm::DenseMap <const clang::CXXRecordDecl *, clang::CharUnits> &base_offsets,
                       llvm::DenseMap <const clang::CXXRecordDecl *, clang::CharUnits> &vbase_offsets);
 
+    //------------------------------------------------------------------
+    /// Add the methods that were left out when the class \a clang_type
+    /// was completed. Only methods are deferred, fields are needed for
+    /// the layout of the class and nested types are never added when
+    /// their parent is completed.
+    ///
+    /// @return
+    ///     True if this symbol file had deferred methods for the class.
+    //------------------------------------------------------------------
+    bool
+    ResolveDeferredMethods (lldb::clang_type_t clang_type);
+
     struct LayoutInfo
     {
         LayoutInfo () :
@@ -525,6 +542,11 @@ protected:
                            const DWARFDebugInfoEntry *class_die,
                            const lldb_private::ConstString &selector);
 
+    bool
+    CanDeferMethod (DWARFCompileUnit *dwarf_cu,
+                    const char *class_name,
+                    const DWARFDebugInfoEntry *method_die);
+
     bool
     CopyUniqueClassMethodTypes (lldb_private::Type *class_type,
                                 DWARFCompileUnit* src_cu,
@@ -581,6 +603,7 @@ protected:
     typedef llvm::DenseMap<const DWARFDebugInfoEntry *, lldb::clang_type_t> DIEToClangType;
     typedef llvm::DenseMap<lldb::clang_type_t, const DWARFDebugInfoEntry *> ClangTypeToDIE;
     typedef llvm::DenseMap<const clang::RecordDecl *, LayoutInfo> RecordDeclToLayoutMap;
+    typedef llvm::DenseMap<lldb::clang_type_t, DIEArray> ClangTypeToDIEArray;
     DIEToDeclContextMap m_die_to_decl_ctx;
     DeclContextToDIEMap m_decl_ctx_to_die;
     DIEToTypePtr m_die_to_type;
@@ -588,6 +611,8 @@ protected:
     DIEToClangType m_forward_decl_die_to_clang_type;
     ClangTypeToDIE m_forward_decl_clang_type_to_die;
     RecordDeclToLayoutMap m_record_decl_to_layout_map;
+    ClangTypeToDIEArray m_deferred_method_dies;             // Method DIEs of completed classes that haven't been added yet
+    lldb::clang_type_t m_resolving_deferred_methods_type;  // The class ResolveDeferredMethods() is adding methods to
 };
 
 #endif  // SymbolFileDWARF_SymbolFileDWARF_h_
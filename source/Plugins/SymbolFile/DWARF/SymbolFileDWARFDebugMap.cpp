@@ -9,6 +9,8 @@
 
 #include "SymbolFileDWARFDebugMap.h"
 
+#include "clang/AST/DeclCXX.h"
+
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/PluginManager.h"
@@ -84,6 +86,7 @@ SymbolFileDWARFDebugMap::InitializeObject()
         new ClangExternalASTSourceCallbacks (SymbolFileDWARFDebugMap::CompleteTagDecl,
                                              SymbolFileDWARFDebugMap::CompleteObjCInterfaceDecl,
                                              NULL,
+                                             SymbolFileDWARFDebugMap::FindExternalLexicalDecls,
                                              SymbolFileDWARFDebugMap::LayoutRecordType,
                                              this));
 
@@ -961,6 +964,21 @@ SymbolFileDWARFDebugMap::FindFunctions (const RegularExpression& regex, bool inc
     return sc_list.GetSize() - initial_size;
 }
 
+bool
+SymbolFileDWARFDebugMap::HasFunctionNameIndex ()
+{
+    // FindFunctions() looks in every object file, so it is only cheap if
+    // none of them has to index its DWARF first
+    uint32_t oso_idx = 0;
+    SymbolFileDWARF *oso_dwarf;
+    while ((oso_dwarf = GetSymbolFileByOSOIndex (oso_idx++)) != NULL)
+    {
+        if (!oso_dwarf->HasFunctionNameIndex())
+            return false;
+    }
+    return true;
+}
+
 TypeSP
 SymbolFileDWARFDebugMap::FindDefinitionTypeForDWARFDeclContext (const DWARFDeclContext &die_decl_ctx)
 {
@@ -1170,6 +1188,28 @@ SymbolFileDWARFDebugMap::CompleteObjCInterfaceDecl (void *baton, clang::ObjCInte
     }
 }
 
+void
+SymbolFileDWARFDebugMap::FindExternalLexicalDecls (void *baton, const clang::DeclContext *decl_context)
+{
+    const clang::CXXRecordDecl *cxx_record_decl = llvm::dyn_cast<clang::CXXRecordDecl>(decl_context);
+    if (cxx_record_decl)
+    {
+        SymbolFileDWARFDebugMap *symbol_file_dwarf = (SymbolFileDWARFDebugMap *)baton;
+        clang_type_t clang_type = symbol_file_dwarf->GetClangASTContext().GetTypeForDecl (const_cast<clang::CXXRecordDecl *>(cxx_record_decl));
+        if (clang_type)
+        {
+            // The deferred methods are kept by the DWARF file that completed
+            // the class
+            SymbolFileDWARF *oso_dwarf;
+            for (uint32_t oso_idx = 0; ((oso_dwarf = symbol_file_dwarf->GetSymbolFileByOSOIndex (oso_idx)) != NULL); ++oso_idx)
+            {
+                if (oso_dwarf->ResolveDeferredMethods (clang_type))
+                    return;
+            }
+        }
+    }
+}
+
 bool 
 SymbolFileDWARFDebugMap::LayoutRecordType (void *baton, 
                                            const clang::RecordDecl *record_decl,
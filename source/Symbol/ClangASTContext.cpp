@@ -478,6 +478,16 @@ ClangASTContext::RemoveExternalSource ()
     }
 }
 
+size_t
+ClangASTContext::GetAllocatedMemory () const
+{
+    // Don't use getASTContext() here, asking how big the AST is shouldn't
+    // create one
+    if (m_ast_ap.get() == NULL)
+        return 0;
+    return m_ast_ap->getASTAllocatedMemory() + m_ast_ap->getSideTableAllocatedMemory();
+}
+
 
 
 ASTContext *
@@ -7,9 +7,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "clang/AST/ASTContext.h"
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclObjC.h"
+#include "clang/AST/Expr.h"
 #include "lldb/Core/Log.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Symbol/ClangASTContext.h"
@@ -28,7 +30,54 @@ ClangASTImporter::CopyType (clang::ASTContext *dst_ast,
     MinionSP minion_sp (GetMinion(dst_ast, src_ast));
     
     if (minion_sp)
-        return minion_sp->Import(type);
+    {
+        // Every shared library has its own copy of common types such as
+        // std::string. If an identical type was already imported from
+        // another AST, map this one onto it rather than importing and
+        // completing it again.
+        TypeIdentity identity;
+        TagDecl *from_tag_decl = GetUnderlyingTagDecl(type);
+        const bool has_identity = from_tag_decl && GetTypeIdentity(from_tag_decl, identity);
+        ASTContextMetadataSP context_md;
+        
+        if (has_identity)
+        {
+            context_md = GetContextMetadata(dst_ast);
+            
+            TypeIdentityMap::iterator pos = context_md->m_imported_types.find(identity);
+            
+            // The minion remembers the mapping, so it only needs to be
+            // made (and counted) the first time this type is copied
+            if (pos != context_md->m_imported_types.end() &&
+                GetDeclOrigin(pos->second).decl != from_tag_decl &&
+                context_md->m_reused_tag_decls.insert(from_tag_decl).second)
+            {
+                lldb::LogSP log(lldb_private::GetLogIfAllCategoriesSet (LIBLLDB_LOG_EXPRESSIONS));
+                
+                if (log)
+                    log->Printf("    [ClangASTImporter] Reusing (%sDecl*)%p for identical type %s (from (Decl*)%p)",
+                                pos->second->getDeclKindName(),
+                                pos->second,
+                                identity.name.GetCString(),
+                                from_tag_decl);
+                
+                minion_sp->ASTImporter::Imported(from_tag_decl, pos->second);
+                ++m_num_reused_types;
+            }
+        }
+        
+        QualType result = minion_sp->Import(type);
+        
+        if (has_identity && !result.isNull())
+        {
+            TagDecl *to_tag_decl = GetUnderlyingTagDecl(result);
+            
+            if (to_tag_decl)
+                context_md->m_imported_types.insert(std::make_pair(identity, to_tag_decl));
+        }
+        
+        return result;
+    }
     
     return QualType();
 }
@@ -83,13 +132,20 @@ ClangASTImporter::DeportType (clang::ASTContext *dst_ctx,
                               clang::ASTContext *src_ctx,
                               lldb::clang_type_t type)
 {
-    lldb::clang_type_t result = CopyType(dst_ctx, src_ctx, type);
+    MinionSP minion_sp (GetMinion (dst_ctx, src_ctx));
     
-    if (!result)
+    if (!minion_sp)
         return NULL;
     
+    // Deported types get a definition of their own, so unlike CopyType()
+    // this never reuses an identical type imported from another AST
     QualType qual_type = QualType::getFromOpaquePtr(type);
     
+    lldb::clang_type_t result = minion_sp->Import(qual_type).getAsOpaquePtr();
+    
+    if (!result)
+        return NULL;
+    
     if (const TagType *tag_type = qual_type->getAs<TagType>())
     {
         TagDecl *tag_decl = tag_type->getDecl();
@@ -98,8 +154,6 @@ ClangASTImporter::DeportType (clang::ASTContext *dst_ctx,
         
         if (tag_decl)
         {
-            MinionSP minion_sp (GetMinion (dst_ctx, src_ctx));
-
             minion_sp->ImportDefinitionTo(result_tag_decl, tag_decl);
             
             ASTContextMetadataSP to_context_md = GetContextMetadata(dst_ctx);
@@ -345,6 +399,20 @@ ClangASTImporter::ForgetSource (clang::ASTContext *dst_ast, clang::ASTContext *s
  
     md->m_minions.erase(src_ast);
     
+    // Imported types that can only be completed from src_ast can't be
+    // reused any more
+    for (TypeIdentityMap::iterator iter = md->m_imported_types.begin();
+         iter != md->m_imported_types.end();
+         )
+    {
+        OriginMap::iterator origin_iter = md->m_origins.find(iter->second);
+        
+        if (origin_iter != md->m_origins.end() && origin_iter->second.ctx == src_ast)
+            md->m_imported_types.erase(iter++);
+        else
+            ++iter;
+    }
+    
     for (OriginMap::iterator iter = md->m_origins.begin();
          iter != md->m_origins.end();
          )
@@ -356,6 +424,105 @@ ClangASTImporter::ForgetSource (clang::ASTContext *dst_ast, clang::ASTContext *s
     }
 }
 
+clang::TagDecl *
+ClangASTImporter::GetUnderlyingTagDecl (clang::QualType type)
+{
+    if (type.isNull())
+        return NULL;
+    
+    // Look through typedefs, pointers, references and arrays so that a
+    // variable of type "const Foo *" still finds "Foo"
+    const clang::Type *type_ptr = type.getCanonicalType().getTypePtr();
+    
+    while (1)
+    {
+        if (const PointerType *pointer_type = dyn_cast<PointerType>(type_ptr))
+            type_ptr = pointer_type->getPointeeType().getCanonicalType().getTypePtr();
+        else if (const ReferenceType *reference_type = dyn_cast<ReferenceType>(type_ptr))
+            type_ptr = reference_type->getPointeeType().getCanonicalType().getTypePtr();
+        else if (const ArrayType *array_type = dyn_cast<ArrayType>(type_ptr))
+            type_ptr = array_type->getElementType().getCanonicalType().getTypePtr();
+        else
+            break;
+    }
+    
+    if (const TagType *tag_type = dyn_cast<TagType>(type_ptr))
+        return tag_type->getDecl();
+    
+    return NULL;
+}
+
+// 64 bit FNV-1a, which is plenty to tell the layouts of types with the
+// same name and size apart
+static uint64_t
+HashTypeString (uint64_t hash, const std::string &s)
+{
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+        hash ^= (uint8_t)s[i];
+        hash *= 1099511628211ull;
+    }
+    // Separate the strings so that "ab" + "c" and "a" + "bc" differ
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+bool
+ClangASTImporter::GetTypeIdentity (clang::TagDecl *decl, TypeIdentity &identity)
+{
+    // Only complete types can be compared, and anonymous types may well
+    // have the same members as another anonymous type without being the
+    // same type
+    if (decl == NULL || !decl->isCompleteDefinition() || !decl->getIdentifier())
+        return false;
+    
+    ASTContext &ast = decl->getASTContext();
+    QualType tag_qual_type = ast.getTagDeclType(decl);
+    
+    uint64_t hash = 14695981039346656037ull;
+    
+    if (RecordDecl *record_decl = dyn_cast<RecordDecl>(decl))
+    {
+        if (CXXRecordDecl *cxx_record_decl = dyn_cast<CXXRecordDecl>(record_decl))
+        {
+            for (CXXRecordDecl::base_class_iterator base_pos = cxx_record_decl->bases_begin(), base_end = cxx_record_decl->bases_end();
+                 base_pos != base_end;
+                 ++base_pos)
+            {
+                if (base_pos->isVirtual())
+                    hash = HashTypeString (hash, "virtual");
+                hash = HashTypeString (hash, base_pos->getType().getCanonicalType().getAsString());
+            }
+        }
+        
+        for (RecordDecl::field_iterator field_pos = record_decl->field_begin(), field_end = record_decl->field_end();
+             field_pos != field_end;
+             ++field_pos)
+        {
+            hash = HashTypeString (hash, field_pos->getNameAsString());
+            hash = HashTypeString (hash, field_pos->getType().getCanonicalType().getAsString());
+            if (field_pos->isBitField())
+                hash = HashTypeString (hash, field_pos->getBitWidth()->EvaluateKnownConstInt(ast).toString(10));
+        }
+    }
+    else if (EnumDecl *enum_decl = dyn_cast<EnumDecl>(decl))
+    {
+        for (EnumDecl::enumerator_iterator enum_pos = enum_decl->enumerator_begin(), enum_end = enum_decl->enumerator_end();
+             enum_pos != enum_end;
+             ++enum_pos)
+        {
+            hash = HashTypeString (hash, enum_pos->getNameAsString());
+            hash = HashTypeString (hash, enum_pos->getInitVal().toString(10));
+        }
+    }
+    
+    identity.name.SetCString (tag_qual_type.getCanonicalType().getAsString().c_str());
+    identity.byte_size = ast.getTypeSize(tag_qual_type) / 8;
+    identity.layout_hash = hash;
+    return true;
+}
+
 ClangASTImporter::MapCompleter::~MapCompleter ()
 {
     return;
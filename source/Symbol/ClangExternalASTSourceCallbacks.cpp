@@ -121,6 +121,26 @@ ClangExternalASTSourceCallbacks::FindExternalVisibleDeclsByName
     return DeclContext::lookup_result();
 }
 
+clang::ExternalLoadResult 
+ClangExternalASTSourceCallbacks::FindExternalLexicalDecls (const clang::DeclContext *decl_ctx,
+                                                           bool (*isKindWeWant)(clang::Decl::Kind),
+                                                           llvm::SmallVectorImpl<clang::Decl*> &decls)
+{
+    // Symbol files may complete a record without its methods and add them
+    // when something walks all the members of the record. Walks that only
+    // want the fields (RecordDecl::field_begin()) leave the methods alone.
+    if (m_callback_find_lexical && (isKindWeWant == NULL || isKindWeWant (clang::Decl::CXXMethod)))
+    {
+        // The members are added to the decl context directly, so there is
+        // nothing left for clang to add
+        m_callback_find_lexical (m_callback_baton, decl_ctx);
+        return clang::ELR_AlreadyLoaded;
+    }
+    // Other than that, iterating through an entire lexical context isn't
+    // something the debugger should ever need to do.
+    return clang::ELR_Failure;
+}
+
 void
 ClangExternalASTSourceCallbacks::CompleteType (TagDecl *tag_decl)
 {
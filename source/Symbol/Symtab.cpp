@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <string.h>
 #include <map>
 
 #include "lldb/Core/Module.h"
@@ -26,9 +27,11 @@ Symtab::Symtab(ObjectFile *objfile) :
     m_symbols (),
     m_addr_indexes (),
     m_name_to_index (),
+    m_basename_to_index (),
     m_mutex (Mutex::eMutexTypeRecursive),
     m_addr_indexes_computed (false),
-    m_name_indexes_computed (false)
+    m_name_indexes_computed (false),
+    m_basename_indexes_computed (false)
 {
 }
 
@@ -60,10 +63,12 @@ Symtab::AddSymbol(const Symbol& symbol)
     // when calling this function to avoid performance issues.
     uint32_t symbol_idx = m_symbols.size();
     m_name_to_index.Clear();
+    m_basename_to_index.Clear();
     m_addr_indexes.clear();
     m_symbols.push_back(symbol);
     m_addr_indexes_computed = false;
     m_name_indexes_computed = false;
+    m_basename_indexes_computed = false;
     return symbol_idx;
 }
 
@@ -326,6 +331,87 @@ Symtab::InitNameIndexes()
     }
 }
 
+bool
+Symtab::GetFunctionBaseName (const char *name, std::string &base_name)
+{
+    base_name.clear();
+    if (name == NULL || name[0] == '\0')
+        return false;
+
+    // The parameter list starts at the first '(' outside of any template
+    // arguments, the base name at the last "::" before it
+    const char *base_start = name;
+    const char *base_end = NULL;
+    int template_depth = 0;
+    const char *p;
+    for (p = name; *p; ++p)
+    {
+        if (*p == '<')
+            ++template_depth;
+        else if (*p == '>')
+            --template_depth;
+        else if (template_depth == 0)
+        {
+            if (*p == '(')
+            {
+                base_end = p;
+                break;
+            }
+            if (p[0] == ':' && p[1] == ':')
+                base_start = p + 2;
+        }
+    }
+    if (base_end == NULL)
+        base_end = p;
+
+    // Drop the template arguments of function templates
+    const char *template_start = (const char *)::memchr (base_start, '<', base_end - base_start);
+    if (template_start)
+        base_end = template_start;
+
+    if (base_start >= base_end)
+        return false;
+    base_name.assign (base_start, base_end - base_start);
+    return true;
+}
+
+void
+Symtab::InitBaseNameIndexes ()
+{
+    // Protected function, no need to lock mutex...
+    if (!m_basename_indexes_computed)
+    {
+        m_basename_indexes_computed = true;
+        Timer scoped_timer (__PRETTY_FUNCTION__, "%s", __PRETTY_FUNCTION__);
+        std::string base_name;
+        const size_t count = m_symbols.size();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Symbol *symbol = &m_symbols[i];
+            if (symbol->GetType() != eSymbolTypeCode)
+                continue;
+            const char *demangled = symbol->GetMangled().GetDemangledName().GetCString();
+            if (GetFunctionBaseName (demangled, base_name))
+                m_basename_to_index.Append (ConstString (base_name.c_str()).GetCString(), i);
+        }
+        m_basename_to_index.Sort();
+        m_basename_to_index.SizeToFit();
+    }
+}
+
+size_t
+Symtab::FindAllCodeSymbolsWithBaseName (const ConstString &base_name, std::vector<uint32_t>& symbol_indexes)
+{
+    Mutex::Locker locker (m_mutex);
+
+    if (!m_basename_indexes_computed)
+        InitBaseNameIndexes();
+
+    if (base_name)
+        m_basename_to_index.GetValues (base_name.GetCString(), symbol_indexes);
+    return symbol_indexes.size();
+}
+
 void
 Symtab::AppendSymbolNamesToMap (const IndexCollection &indexes, 
                                 bool add_demangled,
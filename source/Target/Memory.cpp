@@ -10,6 +10,7 @@
 #include "lldb/Target/Memory.h"
 // C Includes
 // C++ Includes
+#include <algorithm>
 // Other libraries and framework includes
 // Project includes
 #include "lldb/Core/DataBufferHeap.h"
@@ -201,6 +202,113 @@ MemoryCache::Read (addr_t addr,
     return dst_len - bytes_left;
 }
 
+size_t
+MemoryCache::Prefetch (addr_t addr, size_t size, Error &error)
+{
+    if (size == 0)
+        return 0;
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+    addr_t start_addr = addr - (addr % cache_line_byte_size);
+    addr_t end_addr = addr + size;
+    if (end_addr % cache_line_byte_size)
+        end_addr += cache_line_byte_size - (end_addr % cache_line_byte_size);
+
+    Mutex::Locker locker (m_mutex);
+
+    // Don't read lines we already have at either end again
+    while (start_addr < end_addr && m_cache.find (start_addr) != m_cache.end())
+        start_addr += cache_line_byte_size;
+    while (end_addr > start_addr && m_cache.find (end_addr - cache_line_byte_size) != m_cache.end())
+        end_addr -= cache_line_byte_size;
+    if (start_addr >= end_addr)
+        return 0;
+
+    for (addr_t curr_addr = start_addr; curr_addr < end_addr; curr_addr += cache_line_byte_size)
+    {
+        if (m_invalid_ranges.FindEntryThatContains (curr_addr))
+            return 0;
+    }
+
+    DataBufferHeap buffer (end_addr - start_addr, 0);
+    const size_t bytes_read = m_process.ReadMemoryFromInferior (start_addr,
+                                                                buffer.GetBytes(),
+                                                                buffer.GetByteSize(),
+                                                                error);
+    // Only whole lines are added, a partial line at the end is left for
+    // Read() which knows how to deal with short lines
+    const size_t num_lines = bytes_read / cache_line_byte_size;
+    for (size_t i = 0; i < num_lines; ++i)
+    {
+        const addr_t line_addr = start_addr + i * cache_line_byte_size;
+        if (m_cache.find (line_addr) == m_cache.end())
+            m_cache[line_addr] = DataBufferSP (new DataBufferHeap (buffer.GetBytes() + i * cache_line_byte_size,
+                                                                   cache_line_byte_size));
+    }
+    return bytes_read;
+}
+
+size_t
+MemoryCache::PrefetchRanges (const std::vector<Range<addr_t, addr_t> > &ranges, Error &error)
+{
+    typedef Range<addr_t, addr_t> LineRange;
+    const uint32_t cache_line_byte_size = m_cache_line_byte_size;
+
+    Mutex::Locker locker (m_mutex);
+
+    // Find all lines that aren't cached yet
+    std::vector<addr_t> missing_lines;
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+        const addr_t size = ranges[i].GetByteSize();
+        if (size == 0)
+            continue;
+        const addr_t start_addr = ranges[i].GetRangeBase() - (ranges[i].GetRangeBase() % cache_line_byte_size);
+        const addr_t end_addr = ranges[i].GetRangeEnd();
+        for (addr_t line_addr = start_addr; line_addr < end_addr; line_addr += cache_line_byte_size)
+        {
+            if (m_invalid_ranges.FindEntryThatContains (line_addr))
+                break;
+            if (m_cache.find (line_addr) == m_cache.end())
+                missing_lines.push_back (line_addr);
+        }
+    }
+    if (missing_lines.empty())
+        return 0;
+
+    // Read runs of adjacent lines as one range
+    std::sort (missing_lines.begin(), missing_lines.end());
+    missing_lines.erase (std::unique (missing_lines.begin(), missing_lines.end()), missing_lines.end());
+    std::vector<LineRange> line_ranges;
+    for (size_t i = 0; i < missing_lines.size(); ++i)
+    {
+        if (!line_ranges.empty() && line_ranges.back().GetRangeEnd() == missing_lines[i])
+            line_ranges.back().SetByteSize (line_ranges.back().GetByteSize() + cache_line_byte_size);
+        else
+            line_ranges.push_back (LineRange (missing_lines[i], cache_line_byte_size));
+    }
+
+    DataBufferHeap buffer (missing_lines.size() * cache_line_byte_size, 0);
+    std::vector<size_t> bytes_read;
+    const size_t total_bytes_read = m_process.ReadMemoryRangesFromInferior (line_ranges,
+                                                                           buffer.GetBytes(),
+                                                                           bytes_read,
+                                                                           error);
+    // As in Prefetch() only whole lines are added
+    const uint8_t *bytes = buffer.GetBytes();
+    for (size_t i = 0; i < line_ranges.size(); ++i)
+    {
+        const size_t num_lines = bytes_read[i] / cache_line_byte_size;
+        for (size_t j = 0; j < num_lines; ++j)
+        {
+            const addr_t line_addr = line_ranges[i].GetRangeBase() + j * cache_line_byte_size;
+            if (m_cache.find (line_addr) == m_cache.end())
+                m_cache[line_addr] = DataBufferSP (new DataBufferHeap (bytes + j * cache_line_byte_size,
+                                                                       cache_line_byte_size));
+        }
+        bytes += line_ranges[i].GetByteSize();
+    }
+    return total_bytes_read;
+}
 
 
 AllocatedBlock::AllocatedBlock (lldb::addr_t addr, 
@@ -9,6 +9,8 @@
 
 #include "lldb/Target/Process.h"
 
+#include <algorithm>
+
 #include "lldb/lldb-private-log.h"
 
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
@@ -799,6 +801,9 @@ Process::Process(Target &target, Listener &listener) :
     m_image_tokens (),
     m_listener (listener),
     m_breakpoint_site_list (),
+    m_breakpoint_site_batch_depth (0),
+    m_batched_sites_to_enable (),
+    m_batched_sites_to_remove (),
     m_dynamic_checkers_ap (),
     m_unix_signals (),
     m_abi_sp (),
@@ -808,6 +813,7 @@ Process::Process(Target &target, Listener &listener) :
     m_stdout_data (),
     m_stderr_data (),
     m_memory_cache (*this),
+    m_stats (),
     m_allocated_memory_cache (*this),
     m_should_detach (false),
     m_next_event_action_ap(),
@@ -1698,6 +1704,14 @@ Process::CreateBreakpointSite (const BreakpointLocationSP &owner, bool use_hardw
             bp_site_sp.reset (new BreakpointSite (&m_breakpoint_site_list, owner, load_addr, LLDB_INVALID_THREAD_ID, use_hardware));
             if (bp_site_sp)
             {
+                if (m_breakpoint_site_batch_depth > 0)
+                {
+                    // EndBreakpointSiteBatch() enables this site along with
+                    // all the other sites created in this batch.
+                    owner->SetBreakpointSite (bp_site_sp);
+                    m_batched_sites_to_enable.push_back (bp_site_sp);
+                    return m_breakpoint_site_list.Add (bp_site_sp);
+                }
                 if (EnableBreakpoint (bp_site_sp.get()).Success())
                 {
                     owner->SetBreakpointSite (bp_site_sp);
@@ -1717,11 +1731,133 @@ Process::RemoveOwnerFromBreakpointSite (lldb::user_id_t owner_id, lldb::user_id_
     uint32_t num_owners = bp_site_sp->RemoveOwner (owner_id, owner_loc_id);
     if (num_owners == 0)
     {
+        if (m_breakpoint_site_batch_depth > 0)
+        {
+            m_batched_sites_to_remove.push_back (bp_site_sp);
+            return;
+        }
         DisableBreakpoint(bp_site_sp.get());
         m_breakpoint_site_list.RemoveByAddress(bp_site_sp->GetLoadAddress());
     }
 }
 
+size_t
+Process::EnableBreakpointSites (const BreakpointSiteList::collection &bp_sites, std::vector<Error> &errors)
+{
+    const size_t num_sites = bp_sites.size();
+    errors.clear();
+    errors.resize (num_sites);
+    size_t num_enabled = 0;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        errors[i] = EnableBreakpoint (bp_sites[i].get());
+        if (errors[i].Success())
+            ++num_enabled;
+    }
+    return num_enabled;
+}
+
+size_t
+Process::DisableBreakpointSites (const BreakpointSiteList::collection &bp_sites, std::vector<Error> &errors)
+{
+    const size_t num_sites = bp_sites.size();
+    errors.clear();
+    errors.resize (num_sites);
+    size_t num_disabled = 0;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        errors[i] = DisableBreakpoint (bp_sites[i].get());
+        if (errors[i].Success())
+            ++num_disabled;
+    }
+    return num_disabled;
+}
+
+void
+Process::BeginBreakpointSiteBatch ()
+{
+    ++m_breakpoint_site_batch_depth;
+}
+
+void
+Process::EndBreakpointSiteBatch ()
+{
+    assert (m_breakpoint_site_batch_depth > 0);
+    if (--m_breakpoint_site_batch_depth > 0)
+        return;
+
+    LogSP log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    BreakpointSiteList::collection batched_sites;
+    BreakpointSiteList::collection bp_sites;
+    std::vector<lldb::addr_t> addrs_to_remove;
+    std::vector<Error> errors;
+    BreakpointSiteList::collection::const_iterator pos, end;
+
+    // Enable the new sites that still have owners
+    batched_sites.swap (m_batched_sites_to_enable);
+    for (pos = batched_sites.begin(), end = batched_sites.end(); pos != end; ++pos)
+    {
+        if ((*pos)->GetNumberOfOwners() > 0 && !(*pos)->IsEnabled())
+            bp_sites.push_back (*pos);
+    }
+    if (!bp_sites.empty())
+    {
+        EnableBreakpointSites (bp_sites, errors);
+        for (size_t i = 0; i < bp_sites.size(); ++i)
+        {
+            if (errors[i].Success())
+                continue;
+            BreakpointSite *bp_site = bp_sites[i].get();
+            if (log)
+                log->Printf ("Process::EndBreakpointSiteBatch () failed to enable site %d at 0x%llx: %s",
+                             bp_site->GetID(),
+                             (uint64_t)bp_site->GetLoadAddress(),
+                             errors[i].AsCString());
+            // Leave the owners without a site, as if CreateBreakpointSite()
+            // had failed for them
+            BreakpointSiteSP no_site_sp;
+            const uint32_t num_owners = bp_site->GetNumberOfOwners();
+            for (uint32_t owner_idx = 0; owner_idx < num_owners; ++owner_idx)
+                bp_site->GetOwnerAtIndex (owner_idx)->SetBreakpointSite (no_site_sp);
+            addrs_to_remove.push_back (bp_site->GetLoadAddress());
+        }
+    }
+
+    // Disable and remove the sites that are still without owners. A site
+    // can lose its last owner more than once in a batch.
+    batched_sites.clear();
+    batched_sites.swap (m_batched_sites_to_remove);
+    std::sort (batched_sites.begin(), batched_sites.end());
+    batched_sites.erase (std::unique (batched_sites.begin(), batched_sites.end()), batched_sites.end());
+    bp_sites.clear();
+    for (pos = batched_sites.begin(), end = batched_sites.end(); pos != end; ++pos)
+    {
+        if ((*pos)->GetNumberOfOwners() > 0)
+            continue;
+        if ((*pos)->IsEnabled())
+            bp_sites.push_back (*pos);
+        addrs_to_remove.push_back ((*pos)->GetLoadAddress());
+    }
+    if (!bp_sites.empty())
+    {
+        DisableBreakpointSites (bp_sites, errors);
+        if (log)
+        {
+            for (size_t i = 0; i < bp_sites.size(); ++i)
+            {
+                if (errors[i].Fail())
+                    log->Printf ("Process::EndBreakpointSiteBatch () failed to disable site %d at 0x%llx: %s",
+                                 bp_sites[i]->GetID(),
+                                 (uint64_t)bp_sites[i]->GetLoadAddress(),
+                                 errors[i].AsCString());
+            }
+        }
+    }
+
+    if (!addrs_to_remove.empty())
+        m_breakpoint_site_list.RemoveByAddresses (addrs_to_remove);
+}
+
 
 size_t
 Process::RemoveBreakpointOpcodesFromBuffer (addr_t bp_addr, size_t size, uint8_t *buf) const
@@ -1730,15 +1866,15 @@ Process::RemoveBreakpointOpcodesFromBuffer (addr_t bp_addr, size_t size, uint8_t
     addr_t intersect_addr;
     size_t intersect_size;
     size_t opcode_offset;
-    size_t idx;
-    BreakpointSiteSP bp_sp;
-    BreakpointSiteList bp_sites_in_range;
+    BreakpointSiteList::collection bp_sites_in_range;
 
-    if (m_breakpoint_site_list.FindInRange (bp_addr, bp_addr + size, bp_sites_in_range))
+    if (m_breakpoint_site_list.FindInRange (bp_addr, bp_addr + size, bp_sites_in_range) > 0)
     {
-        for (idx = 0; (bp_sp = bp_sites_in_range.GetByIndex(idx)); ++idx)
+        BreakpointSiteList::collection::const_iterator pos, end = bp_sites_in_range.end();
+        for (pos = bp_sites_in_range.begin(); pos != end; ++pos)
         {
-            if (bp_sp->GetType() == BreakpointSite::eSoftware)
+            const BreakpointSiteSP &bp_sp = *pos;
+            if (bp_sp->GetType() == BreakpointSite::eSoftware && bp_sp->IsEnabled())
             {
                 if (bp_sp->IntersectsRange(bp_addr, size, &intersect_addr, &intersect_size, &opcode_offset))
                 {
@@ -1938,6 +2074,249 @@ Process::DisableSoftwareBreakpoint (BreakpointSite *bp_site)
 
 }
 
+// Batched software breakpoints read and write memory one page at a time
+// so that a page that can't be written only fails the sites on it.
+static const addr_t g_breakpoint_batch_page_size = 4096;
+
+// Gathers the sites in sorted_sites (sorted by load address) that start
+// on the same page as sorted_sites[group_start], and returns the index
+// one past the last of them along with the memory range they cover.
+static size_t
+GetBreakpointBatchPageGroup (const BreakpointSiteList::collection &bp_sites,
+                             const std::vector<std::pair<addr_t, size_t> > &sorted_sites,
+                             size_t group_start,
+                             addr_t &range_addr,
+                             size_t &range_size)
+{
+    const addr_t page_mask = ~(g_breakpoint_batch_page_size - 1);
+    const addr_t page_addr = sorted_sites[group_start].first & page_mask;
+    range_addr = sorted_sites[group_start].first;
+    addr_t range_end = range_addr;
+    size_t group_end;
+    for (group_end = group_start; group_end < sorted_sites.size(); ++group_end)
+    {
+        const addr_t bp_addr = sorted_sites[group_end].first;
+        if ((bp_addr & page_mask) != page_addr)
+            break;
+        range_end = std::max<addr_t> (range_end, bp_addr + bp_sites[sorted_sites[group_end].second]->GetByteSize());
+    }
+    range_size = range_end - range_addr;
+    return group_end;
+}
+
+size_t
+Process::EnableSoftwareBreakpoints (const BreakpointSiteList::collection &bp_sites, std::vector<Error> &errors)
+{
+    LogSP log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    const size_t num_sites = bp_sites.size();
+    errors.clear();
+    errors.resize (num_sites);
+
+    // Pair each site that needs a trap with its index in bp_sites and sort
+    // them by address
+    std::vector<std::pair<addr_t, size_t> > sorted_sites;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        BreakpointSite *bp_site = bp_sites[i].get();
+        const addr_t bp_addr = bp_site->GetLoadAddress();
+        if (bp_site->IsEnabled())
+            continue;
+        if (bp_addr == LLDB_INVALID_ADDRESS)
+            errors[i].SetErrorString("BreakpointSite contains an invalid load address.");
+        else if (GetSoftwareBreakpointTrapOpcode(bp_site) == 0)
+            errors[i].SetErrorStringWithFormat ("Process::GetSoftwareBreakpointTrapOpcode() returned zero, unable to get breakpoint trap for address 0x%llx", bp_addr);
+        else if (bp_site->GetTrapOpcodeBytes() == NULL)
+            errors[i].SetErrorString ("BreakpointSite doesn't contain a valid breakpoint trap opcode.");
+        else
+            sorted_sites.push_back (std::make_pair (bp_addr, i));
+    }
+    std::sort (sorted_sites.begin(), sorted_sites.end());
+
+    std::vector<uint8_t> saved_bytes;
+    std::vector<uint8_t> trap_bytes;
+    std::vector<uint8_t> verify_bytes;
+    size_t group_start = 0;
+    while (group_start < sorted_sites.size())
+    {
+        addr_t range_addr;
+        size_t range_size;
+        const size_t group_end = GetBreakpointBatchPageGroup (bp_sites, sorted_sites, group_start, range_addr, range_size);
+        const char *error_cstr = NULL;
+        Error error;
+
+        // Save the original opcodes by reading them all at once
+        saved_bytes.resize (range_size);
+        if (DoReadMemory (range_addr, &saved_bytes[0], range_size, error) == range_size)
+        {
+            trap_bytes = saved_bytes;
+            for (size_t i = group_start; i < group_end; ++i)
+            {
+                BreakpointSite *bp_site = bp_sites[sorted_sites[i].second].get();
+                const size_t offset = sorted_sites[i].first - range_addr;
+                ::memcpy (bp_site->GetSavedOpcodeBytes(), &saved_bytes[offset], bp_site->GetByteSize());
+                ::memcpy (&trap_bytes[offset], bp_site->GetTrapOpcodeBytes(), bp_site->GetByteSize());
+            }
+
+            // Write the software breakpoints in place of the original opcodes
+            if (DoWriteMemory (range_addr, &trap_bytes[0], range_size, error) == range_size)
+            {
+                verify_bytes.resize (range_size);
+                if (DoReadMemory (range_addr, &verify_bytes[0], range_size, error) == range_size)
+                {
+                    for (size_t i = group_start; i < group_end; ++i)
+                    {
+                        BreakpointSite *bp_site = bp_sites[sorted_sites[i].second].get();
+                        const size_t offset = sorted_sites[i].first - range_addr;
+                        if (::memcmp (bp_site->GetTrapOpcodeBytes(), &verify_bytes[offset], bp_site->GetByteSize()) == 0)
+                        {
+                            bp_site->SetEnabled(true);
+                            bp_site->SetType (BreakpointSite::eSoftware);
+                        }
+                        else
+                            errors[sorted_sites[i].second].SetErrorString("failed to verify the breakpoint trap in memory.");
+                    }
+                }
+                else
+                    error_cstr = "Unable to read memory to verify breakpoint trap.";
+            }
+            else
+                error_cstr = "Unable to write breakpoint trap to memory.";
+        }
+        else
+            error_cstr = "Unable to read memory at breakpoint address.";
+
+        if (error_cstr)
+        {
+            for (size_t i = group_start; i < group_end; ++i)
+                errors[sorted_sites[i].second].SetErrorString (error_cstr);
+        }
+        if (log)
+            log->Printf ("Process::EnableSoftwareBreakpoints () %u sites in [0x%llx-0x%llx)%s%s",
+                         (uint32_t)(group_end - group_start),
+                         (uint64_t)range_addr,
+                         (uint64_t)(range_addr + range_size),
+                         error_cstr ? " -- FAILED: " : "",
+                         error_cstr ? error_cstr : "");
+        group_start = group_end;
+    }
+
+    size_t num_enabled = 0;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        if (errors[i].Success())
+            ++num_enabled;
+    }
+    return num_enabled;
+}
+
+size_t
+Process::DisableSoftwareBreakpoints (const BreakpointSiteList::collection &bp_sites, std::vector<Error> &errors)
+{
+    LogSP log(lldb_private::GetLogIfAnyCategoriesSet (LIBLLDB_LOG_BREAKPOINTS));
+    const size_t num_sites = bp_sites.size();
+    errors.clear();
+    errors.resize (num_sites);
+
+    std::vector<std::pair<addr_t, size_t> > sorted_sites;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        BreakpointSite *bp_site = bp_sites[i].get();
+        if (bp_site->IsHardware())
+            errors[i].SetErrorString("Breakpoint site is a hardware breakpoint.");
+        else if (bp_site->IsEnabled() && bp_site->GetByteSize() > 0)
+            sorted_sites.push_back (std::make_pair (bp_site->GetLoadAddress(), i));
+    }
+    std::sort (sorted_sites.begin(), sorted_sites.end());
+
+    std::vector<uint8_t> curr_bytes;
+    std::vector<uint8_t> restore_bytes;
+    std::vector<uint8_t> verify_bytes;
+    std::vector<bool> break_op_found;
+    size_t group_start = 0;
+    while (group_start < sorted_sites.size())
+    {
+        addr_t range_addr;
+        size_t range_size;
+        const size_t group_end = GetBreakpointBatchPageGroup (bp_sites, sorted_sites, group_start, range_addr, range_size);
+        const char *error_cstr = NULL;
+        Error error;
+
+        // Read the breakpoint opcodes
+        curr_bytes.resize (range_size);
+        if (DoReadMemory (range_addr, &curr_bytes[0], range_size, error) == range_size)
+        {
+            // Restore the saved opcodes where the breakpoint opcodes are still
+            // in memory
+            restore_bytes = curr_bytes;
+            break_op_found.assign (group_end - group_start, false);
+            bool any_break_op_found = false;
+            for (size_t i = group_start; i < group_end; ++i)
+            {
+                BreakpointSite *bp_site = bp_sites[sorted_sites[i].second].get();
+                const size_t offset = sorted_sites[i].first - range_addr;
+                if (::memcmp (&curr_bytes[offset], bp_site->GetTrapOpcodeBytes(), bp_site->GetByteSize()) == 0)
+                {
+                    ::memcpy (&restore_bytes[offset], bp_site->GetSavedOpcodeBytes(), bp_site->GetByteSize());
+                    break_op_found[i - group_start] = true;
+                    any_break_op_found = true;
+                }
+                // Otherwise we check below if the original opcode has
+                // already been restored
+            }
+
+            if (any_break_op_found && DoWriteMemory (range_addr, &restore_bytes[0], range_size, error) != range_size)
+            {
+                error_cstr = "Memory write failed when restoring original opcode.";
+            }
+            else
+            {
+                // Verify that our original opcodes made it back to the inferior
+                verify_bytes.resize (range_size);
+                if (DoReadMemory (range_addr, &verify_bytes[0], range_size, error) == range_size)
+                {
+                    for (size_t i = group_start; i < group_end; ++i)
+                    {
+                        BreakpointSite *bp_site = bp_sites[sorted_sites[i].second].get();
+                        const size_t offset = sorted_sites[i].first - range_addr;
+                        if (::memcmp (bp_site->GetSavedOpcodeBytes(), &verify_bytes[offset], bp_site->GetByteSize()) == 0)
+                            bp_site->SetEnabled(false);
+                        else if (break_op_found[i - group_start])
+                            errors[sorted_sites[i].second].SetErrorString("Failed to restore original opcode.");
+                        else
+                            errors[sorted_sites[i].second].SetErrorString("Original breakpoint trap is no longer in memory.");
+                    }
+                }
+                else
+                    error_cstr = "Failed to read memory to verify that breakpoint trap was restored.";
+            }
+        }
+        else
+            error_cstr = "Unable to read memory that should contain the breakpoint trap.";
+
+        if (error_cstr)
+        {
+            for (size_t i = group_start; i < group_end; ++i)
+                errors[sorted_sites[i].second].SetErrorString (error_cstr);
+        }
+        if (log)
+            log->Printf ("Process::DisableSoftwareBreakpoints () %u sites in [0x%llx-0x%llx)%s%s",
+                         (uint32_t)(group_end - group_start),
+                         (uint64_t)range_addr,
+                         (uint64_t)(range_addr + range_size),
+                         error_cstr ? " -- FAILED: " : "",
+                         error_cstr ? error_cstr : "");
+        group_start = group_end;
+    }
+
+    size_t num_disabled = 0;
+    for (size_t i = 0; i < num_sites; ++i)
+    {
+        if (errors[i].Success())
+            ++num_disabled;
+    }
+    return num_disabled;
+}
+
 // Comment out line below to disable memory caching, overriding the process setting
 // target.process.disable-memory-cache
 #define ENABLE_MEMORY_CACHING
@@ -1986,6 +2365,53 @@ Process::ReadMemory (addr_t addr, void *buf, size_t size, Error &error)
         return ReadMemoryFromInferior (addr, buf, size, error);
     }
 }
+
+size_t
+Process::PrefetchMemory (addr_t addr, size_t size)
+{
+    if (GetDisableMemoryCache())
+        return 0;
+    Error error;
+    return m_memory_cache.Prefetch (addr, size, error);
+}
+
+size_t
+Process::PrefetchMemoryRanges (const LoadRangeList &ranges)
+{
+    if (GetDisableMemoryCache())
+        return 0;
+    Error error;
+    return m_memory_cache.PrefetchRanges (ranges, error);
+}
+
+size_t
+Process::ReadMemoryRanges (const LoadRangeList &ranges, void *buf, std::vector<size_t> &bytes_read, Error &error)
+{
+    if (GetDisableMemoryCache())
+        return ReadMemoryRangesFromInferior (ranges, buf, bytes_read, error);
+
+    // Get all the missing cache lines with one batch of reads, after
+    // which every range is read from the cache
+    m_memory_cache.PrefetchRanges (ranges, error);
+
+    bytes_read.assign (ranges.size(), 0);
+    uint8_t *bytes = (uint8_t *)buf;
+    size_t total_bytes_read = 0;
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+        const size_t size = ranges[i].GetByteSize();
+        if (size > 0)
+        {
+            Error range_error;
+            bytes_read[i] = m_memory_cache.Read (ranges[i].GetRangeBase(), bytes, size, range_error);
+            total_bytes_read += bytes_read[i];
+            if (range_error.Fail())
+                error = range_error;
+        }
+        bytes += size;
+    }
+    return total_bytes_read;
+}
     
 size_t
 Process::ReadCStringFromMemory (addr_t addr, std::string &out_str, Error &error)
@@ -2080,6 +2506,9 @@ Process::ReadMemoryFromInferior (addr_t addr, void *buf, size_t size, Error &err
             break;
     }
 
+    Statistics::Increment (m_stats.memory_read_count);
+    Statistics::Increment (m_stats.memory_bytes_read, bytes_read);
+
     // Replace any software breakpoint opcodes that fall into this range back
     // into "buf" before we return
     if (bytes_read > 0)
@@ -2087,6 +2516,56 @@ Process::ReadMemoryFromInferior (addr_t addr, void *buf, size_t size, Error &err
     return bytes_read;
 }
 
+size_t
+Process::DoReadMemoryRanges (const LoadRangeList &ranges, uint8_t *buf, std::vector<size_t> &bytes_read, Error &error)
+{
+    size_t total_bytes_read = 0;
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+        const addr_t addr = ranges[i].GetRangeBase();
+        const size_t size = ranges[i].GetByteSize();
+        size_t range_bytes_read = 0;
+        while (range_bytes_read < size)
+        {
+            const size_t curr_bytes_read = DoReadMemory (addr + range_bytes_read,
+                                                         buf + range_bytes_read,
+                                                         size - range_bytes_read,
+                                                         error);
+            if (curr_bytes_read == 0)
+                break;
+            range_bytes_read += curr_bytes_read;
+        }
+        bytes_read[i] = range_bytes_read;
+        total_bytes_read += range_bytes_read;
+        buf += size;
+    }
+    return total_bytes_read;
+}
+
+size_t
+Process::ReadMemoryRangesFromInferior (const LoadRangeList &ranges, void *buf, std::vector<size_t> &bytes_read, Error &error)
+{
+    bytes_read.assign (ranges.size(), 0);
+    if (buf == NULL || ranges.empty())
+        return 0;
+
+    uint8_t *bytes = (uint8_t *)buf;
+    const size_t total_bytes_read = DoReadMemoryRanges (ranges, bytes, bytes_read, error);
+
+    Statistics::Increment (m_stats.memory_read_count);
+    Statistics::Increment (m_stats.memory_bytes_read, total_bytes_read);
+
+    // Replace any software breakpoint opcodes that fall into the ranges
+    // back into "buf" before we return
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+        if (bytes_read[i] > 0)
+            RemoveBreakpointOpcodesFromBuffer (ranges[i].GetRangeBase(), bytes_read[i], bytes);
+        bytes += ranges[i].GetByteSize();
+    }
+    return total_bytes_read;
+}
+
 uint64_t
 Process::ReadUnsignedIntegerFromMemory (lldb::addr_t vm_addr, size_t integer_byte_size, uint64_t fail_value, Error &error)
 {
@@ -2137,9 +2616,39 @@ Process::WriteMemoryPrivate (addr_t addr, const void *buf, size_t size, Error &e
         if (curr_bytes_written == curr_size || curr_bytes_written == 0)
             break;
     }
+    Statistics::Increment (m_stats.memory_write_count);
+    Statistics::Increment (m_stats.memory_bytes_written, bytes_written);
     return bytes_written;
 }
 
+void
+Process::GetStatistics (ProcessStatistics &stats)
+{
+    stats.memory_read_count = Statistics::Get (m_stats.memory_read_count);
+    stats.memory_bytes_read = Statistics::Get (m_stats.memory_bytes_read);
+    stats.memory_write_count = Statistics::Get (m_stats.memory_write_count);
+    stats.memory_bytes_written = Statistics::Get (m_stats.memory_bytes_written);
+}
+
+void
+Process::DumpStatistics (Stream &s)
+{
+    ProcessStatistics stats;
+    GetStatistics (stats);
+    s.Printf ("{ \"pid\": %llu", GetID());
+    s.Printf (", \"stop_count\": %u", GetStopID());
+    s.Printf (", \"memory_read_count\": %llu", stats.memory_read_count);
+    s.Printf (", \"memory_bytes_read\": %llu", stats.memory_bytes_read);
+    s.Printf (", \"memory_write_count\": %llu", stats.memory_write_count);
+    s.Printf (", \"memory_bytes_written\": %llu", stats.memory_bytes_written);
+    s.Printf (", \"packets_sent\": %llu", stats.packets_sent);
+    s.Printf (", \"packets_received\": %llu", stats.packets_received);
+    s.Printf (", \"packet_bytes_sent\": %llu", stats.packet_bytes_sent);
+    s.Printf (", \"packet_bytes_received\": %llu", stats.packet_bytes_received);
+    s.Printf (", \"packet_bytes_saved\": %llu", stats.packet_bytes_saved);
+    s.PutCString (" }");
+}
+
 size_t
 Process::WriteMemory (addr_t addr, const void *buf, size_t size, Error &error)
 {
@@ -2156,25 +2665,27 @@ Process::WriteMemory (addr_t addr, const void *buf, size_t size, Error &error)
     // (enabled software breakpoints) any software traps (breakpoints) that we
     // may have placed in our tasks memory.
 
-    BreakpointSiteList::collection::const_iterator iter = m_breakpoint_site_list.GetMap()->lower_bound (addr);
-    BreakpointSiteList::collection::const_iterator end =  m_breakpoint_site_list.GetMap()->end();
-
-    if (iter == end || iter->second->GetLoadAddress() > addr + size)
+    BreakpointSiteList::collection bp_sites_in_range;
+    if (m_breakpoint_site_list.FindInRange (addr, addr + size, bp_sites_in_range) == 0)
         return WriteMemoryPrivate (addr, buf, size, error);
 
-    BreakpointSiteList::collection::const_iterator pos;
+    BreakpointSiteList::collection::const_iterator pos, end = bp_sites_in_range.end();
     size_t bytes_written = 0;
     addr_t intersect_addr = 0;
     size_t intersect_size = 0;
     size_t opcode_offset = 0;
     const uint8_t *ubuf = (const uint8_t *)buf;
 
-    for (pos = iter; pos != end; ++pos)
+    for (pos = bp_sites_in_range.begin(); pos != end; ++pos)
     {
-        BreakpointSiteSP bp;
-        bp = pos->second;
+        const BreakpointSiteSP &bp = *pos;
 
-        assert(bp->IntersectsRange(addr, size, &intersect_addr, &intersect_size, &opcode_offset));
+        // Sites that haven't been enabled yet (see BeginBreakpointSiteBatch())
+        // don't have their saved opcode filled in
+        if (!bp->IsEnabled())
+            continue;
+        if (!bp->IntersectsRange(addr, size, &intersect_addr, &intersect_size, &opcode_offset))
+            continue;
         assert(addr <= intersect_addr && intersect_addr < addr + size);
         assert(addr < intersect_addr + intersect_size && intersect_addr + intersect_size <= addr + size);
         assert(opcode_offset + intersect_size <= bp->GetByteSize());
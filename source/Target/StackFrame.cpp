@@ -57,6 +57,7 @@ StackFrame::StackFrame (const ThreadSP &thread_sp,
     m_frame_base_error (),
     m_variable_list_sp (),
     m_variable_list_value_objects (),
+    m_prefetch_stop_id (UINT32_MAX),
     m_disassembly ()
 {
     if (sc_ptr != NULL)
@@ -85,6 +86,7 @@ StackFrame::StackFrame (const ThreadSP &thread_sp,
     m_frame_base_error (),
     m_variable_list_sp (),
     m_variable_list_value_objects (),
+    m_prefetch_stop_id (UINT32_MAX),
     m_disassembly ()
 {
     if (sc_ptr != NULL)
@@ -120,6 +122,7 @@ StackFrame::StackFrame (const ThreadSP &thread_sp,
     m_frame_base_error (),
     m_variable_list_sp (),
     m_variable_list_value_objects (),
+    m_prefetch_stop_id (UINT32_MAX),
     m_disassembly ()
 {
     if (sc_ptr != NULL)
@@ -1146,6 +1149,34 @@ StackFrame::TrackGlobalVariable (const VariableSP &variable_sp, DynamicValueType
     return valobj_sp;
 }
 
+void
+StackFrame::PrefetchFrameMemory ()
+{
+    // Frames bigger than this most likely have large arrays on the stack
+    // which are better read on demand
+    static const addr_t k_max_prefetch_size = 64 * 1024;
+
+    ThreadSP thread_sp (GetThread());
+    if (!thread_sp)
+        return;
+    ProcessSP process_sp (thread_sp->GetProcess());
+    if (!process_sp)
+        return;
+    const uint32_t stop_id = process_sp->GetStopID();
+    if (m_prefetch_stop_id == stop_id)
+        return;
+    m_prefetch_stop_id = stop_id;
+
+    RegisterContextSP reg_ctx_sp (GetRegisterContext());
+    if (!reg_ctx_sp)
+        return;
+    const addr_t sp = reg_ctx_sp->GetSP (LLDB_INVALID_ADDRESS);
+    const addr_t cfa = m_id.GetCallFrameAddress();
+    if (sp == LLDB_INVALID_ADDRESS || cfa == LLDB_INVALID_ADDRESS || cfa <= sp || cfa - sp > k_max_prefetch_size)
+        return;
+    process_sp->PrefetchMemory (sp, cfa - sp);
+}
+
 bool
 StackFrame::IsInlined ()
 {
@@ -19,6 +19,7 @@
 #include "lldb/Breakpoint/BreakpointResolverFileRegex.h"
 #include "lldb/Breakpoint/BreakpointResolverName.h"
 #include "lldb/Breakpoint/Watchpoint.h"
+#include "lldb/Core/DataVisualization.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Event.h"
 #include "lldb/Core/Log.h"
@@ -76,7 +77,8 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch, const lldb::Plat
     m_stop_hooks (),
     m_stop_hook_next_id (0),
     m_suppress_stop_hooks (false),
-    m_suppress_synthetic_value(false)
+    m_suppress_synthetic_value(false),
+    m_stats ()
 {
     SetEventName (eBroadcastBitBreakpointChanged, "breakpoint-changed");
     SetEventName (eBroadcastBitModulesLoaded, "modules-loaded");
@@ -1029,7 +1031,13 @@ Target::ModuleUpdated (ModuleSP &old_module_sp, ModuleSP &new_module_sp)
 void
 Target::ModulesDidLoad (ModuleList &module_list)
 {
-    m_breakpoint_list.UpdateBreakpoints (module_list, true);
+    {
+        // Enable the sites of all breakpoints that resolve in these modules
+        // with one call into the process plug-in
+        ProcessSP process_sp (m_process_sp);
+        Process::BreakpointSiteBatch site_batch (process_sp.get());
+        m_breakpoint_list.UpdateBreakpoints (module_list, true);
+    }
     // TODO: make event data that packages up the module_list
     BroadcastEvent (eBroadcastBitModulesLoaded, NULL);
 }
@@ -1037,11 +1045,25 @@ Target::ModulesDidLoad (ModuleList &module_list)
 void
 Target::ModulesDidUnload (ModuleList &module_list)
 {
-    m_breakpoint_list.UpdateBreakpoints (module_list, false);
+    {
+        ProcessSP process_sp (m_process_sp);
+        Process::BreakpointSiteBatch site_batch (process_sp.get());
+        m_breakpoint_list.UpdateBreakpoints (module_list, false);
+    }
 
     // Remove the images from the target image list
     m_images.Remove(module_list);
 
+    // Modules stay shared after they are unloaded, don't let them hold
+    // on to instructions that are unlikely to be needed again
+    const size_t num_modules = module_list.GetSize();
+    for (size_t i = 0; i < num_modules; ++i)
+    {
+        ModuleSP module_sp (module_list.GetModuleAtIndex (i));
+        if (module_sp)
+            module_sp->ClearDisassemblyCache();
+    }
+
     // TODO: make event data that packages up the module_list
     BroadcastEvent (eBroadcastBitModulesUnloaded, NULL);
 }
@@ -1662,6 +1684,8 @@ Target::EvaluateExpression
     if (expr_cstr == NULL || expr_cstr[0] == '\0')
         return execution_results;
 
+    StatsTimer stats_timer (&m_stats.expression_nsec);
+
     // We shouldn't run stop hooks in expressions.
     // Be sure to reset this if you return anywhere within this function.
     bool old_suppress_value = m_suppress_stop_hooks;
@@ -1786,10 +1810,55 @@ Target::EvaluateExpression
     }
     
     m_suppress_stop_hooks = old_suppress_value;
+
+    Statistics::Increment (m_stats.expression_count);
+    if (execution_results != eExecutionCompleted)
+        Statistics::Increment (m_stats.expression_failure_count);
     
     return execution_results;
 }
 
+void
+Target::DumpStatistics (Stream &s)
+{
+    char path[PATH_MAX];
+    path[0] = '\0';
+    Module *exe_module = GetExecutableModulePointer();
+    if (exe_module)
+        exe_module->GetFileSpec().GetPath (path, sizeof(path));
+
+    s.PutCString ("{\n  \"target\": { \"executable\": ");
+    Statistics::PutJSONString (s, path);
+    s.Printf (", \"expression_count\": %llu", Statistics::Get (m_stats.expression_count));
+    s.Printf (", \"expression_failure_count\": %llu", Statistics::Get (m_stats.expression_failure_count));
+    s.PutCString (", \"expression_seconds\": ");
+    Statistics::PutJSONSeconds (s, Statistics::Get (m_stats.expression_nsec));
+    s.Printf (", \"imported_types_reused\": %llu", m_ast_importer_ap.get() ? m_ast_importer_ap->GetNumReusedTypes() : 0);
+    s.PutCString (" },\n  \"process\": ");
+    if (m_process_sp)
+        m_process_sp->DumpStatistics (s);
+    else
+        s.PutCString ("null");
+    s.PutCString (",\n  \"modules\": [");
+    const uint32_t num_modules = m_images.GetSize();
+    bool first_module = true;
+    for (uint32_t i=0; i<num_modules; ++i)
+    {
+        ModuleSP module_sp (m_images.GetModuleAtIndex(i));
+        if (module_sp)
+        {
+            s.PutCString (first_module ? "\n    " : ",\n    ");
+            first_module = false;
+            module_sp->DumpStatistics (s);
+        }
+    }
+    s.Printf ("\n  ],\n  \"formatter_cache_hits\": %llu", DataVisualization::GetFormatCacheHits());
+    s.Printf (",\n  \"formatter_cache_misses\": %llu", DataVisualization::GetFormatCacheMisses());
+    s.PutCString (",\n  \"python_formatters\": ");
+    DataVisualization::DumpScriptedFormatterStatistics (s);
+    s.Printf (",\n  \"const_string_pool_bytes\": %llu\n}\n", (uint64_t)ConstString::StaticMemorySize());
+}
+
 lldb::addr_t
 Target::GetCallableLoadAddress (lldb::addr_t load_addr, AddressClass addr_class) const
 {
@@ -2175,6 +2244,7 @@ Target::SettingsController::CreateInstanceSettings (const char *instance_name)
 #define TSC_MAX_CHILDREN        "max-children-count"
 #define TSC_MAX_STRLENSUMMARY   "max-string-summary-length"
 #define TSC_PLATFORM_AVOID      "breakpoints-use-platform-avoid-list"
+#define TSC_SYMBOL_PREFILTER    "breakpoints-prefilter-with-symbols"
 #define TSC_RUN_ARGS            "run-args"
 #define TSC_ENV_VARS            "env-vars"
 #define TSC_INHERIT_ENV         "inherit-env"
@@ -2255,6 +2325,13 @@ GetSettingNameForPlatformAvoid ()
     return g_const_string;
 }
 
+static const ConstString &
+GetSettingNameForSymbolPrefilter ()
+{
+    static ConstString g_const_string (TSC_SYMBOL_PREFILTER);
+    return g_const_string;
+}
+
 const ConstString &
 GetSettingNameForRunArgs ()
 {
@@ -2368,6 +2445,7 @@ TargetInstanceSettings::TargetInstanceSettings
     m_max_children_display(256),
     m_max_strlen_length(1024),
     m_breakpoints_use_platform_avoid (true, true),
+    m_breakpoints_prefilter_with_symbols (false, false),
     m_run_args (),
     m_env_vars (),
     m_input_path (),
@@ -2408,6 +2486,7 @@ TargetInstanceSettings::TargetInstanceSettings (const TargetInstanceSettings &rh
     m_max_children_display (rhs.m_max_children_display),
     m_max_strlen_length (rhs.m_max_strlen_length),
     m_breakpoints_use_platform_avoid (rhs.m_breakpoints_use_platform_avoid),
+    m_breakpoints_prefilter_with_symbols (rhs.m_breakpoints_prefilter_with_symbols),
     m_run_args (rhs.m_run_args),
     m_env_vars (rhs.m_env_vars),
     m_input_path (rhs.m_input_path),
@@ -2444,6 +2523,7 @@ TargetInstanceSettings::operator= (const TargetInstanceSettings &rhs)
         m_max_children_display = rhs.m_max_children_display;
         m_max_strlen_length = rhs.m_max_strlen_length;
         m_breakpoints_use_platform_avoid = rhs.m_breakpoints_use_platform_avoid;
+        m_breakpoints_prefilter_with_symbols = rhs.m_breakpoints_prefilter_with_symbols;
         m_run_args = rhs.m_run_args;
         m_env_vars = rhs.m_env_vars;
         m_input_path = rhs.m_input_path;
@@ -2643,6 +2723,10 @@ TargetInstanceSettings::UpdateInstanceSettingsVariable (const ConstString &var_n
     {
         err = UserSettingsController::UpdateBooleanOptionValue (value, op, m_breakpoints_use_platform_avoid);
     }
+    else if (var_name == GetSettingNameForSymbolPrefilter ())
+    {
+        err = UserSettingsController::UpdateBooleanOptionValue (value, op, m_breakpoints_prefilter_with_symbols);
+    }
     else if (var_name == GetSettingNameForRunArgs())
     {
         UserSettingsController::UpdateStringArrayVariable (op, index_value, m_run_args, value, err);
@@ -2761,6 +2845,13 @@ TargetInstanceSettings::GetInstanceSettingsValue (const SettingEntry &entry,
         else
             value.AppendString ("false");
     }
+    else if (var_name == GetSettingNameForSymbolPrefilter())
+    {
+        if (m_breakpoints_prefilter_with_symbols)
+            value.AppendString ("true");
+        else
+            value.AppendString ("false");
+    }
     else if (var_name == GetSettingNameForRunArgs())
     {
         if (m_run_args.GetArgumentCount() > 0)
@@ -2918,6 +3009,7 @@ Target::SettingsController::instance_settings_table[] =
     { TSC_MAX_CHILDREN      , eSetVarTypeInt    , "256"         , NULL,                  true,  false, "Maximum number of children to expand in any level of depth." },
     { TSC_MAX_STRLENSUMMARY , eSetVarTypeInt    , "1024"        , NULL,                  true,  false, "Maximum number of characters to show when using %s in summary strings." },
     { TSC_PLATFORM_AVOID    , eSetVarTypeBoolean, "true"        , NULL,                  false, false, "Consult the platform module avoid list when setting non-module specific breakpoints." },
+    { TSC_SYMBOL_PREFILTER  , eSetVarTypeBoolean, "false"       , NULL,                  false, false, "When setting breakpoints by function name, skip the debug information of modules whose symbol table doesn't have the name, unless the debug information has accelerator tables or is already indexed. Functions that only exist inlined in such modules are not found." },
     { TSC_RUN_ARGS          , eSetVarTypeArray  , NULL          , NULL,                  false,  false,  "A list containing all the arguments to be passed to the executable when it is run." },
     { TSC_ENV_VARS          , eSetVarTypeDictionary, NULL       , NULL,                  false,  false,  "A list of all the environment variables to be passed to the executable's environment, and their values." },
     { TSC_INHERIT_ENV       , eSetVarTypeBoolean, "true"        , NULL,                  false,  false,  "Inherit the environment from the process that is running LLDB." },
@@ -589,22 +589,20 @@ ThreadList::Update (ThreadList &rhs)
         // but the thread won't be of much use. Using std::weak_ptr
         // for all backward references (such as a thread to a process)
         // will eventually solve this issue for us, but for now, we
-        // need to work around the issue
+        // need to work around the issue. The alive thread IDs are sorted
+        // so this stays fast for processes with lots of threads.
+        std::vector<lldb::tid_t> alive_tids;
+        alive_tids.reserve (m_threads.size());
+        collection::iterator pos, end = m_threads.end();
+        for (pos = m_threads.begin(); pos != end; ++pos)
+            alive_tids.push_back ((*pos)->GetID());
+        std::sort (alive_tids.begin(), alive_tids.end());
+
         collection::iterator rhs_pos, rhs_end = rhs.m_threads.end();
         for (rhs_pos = rhs.m_threads.begin(); rhs_pos != rhs_end; ++rhs_pos)
         {
             const lldb::tid_t tid = (*rhs_pos)->GetID();
-            bool thread_is_alive = false;
-            const uint32_t num_threads = m_threads.size();
-            for (uint32_t idx = 0; idx < num_threads; ++idx)
-            {
-                if (m_threads[idx]->GetID() == tid)
-                {
-                    thread_is_alive = true;
-                    break;
-                }
-            }
-            if (!thread_is_alive)
+            if (!std::binary_search (alive_tids.begin(), alive_tids.end(), tid))
                 (*rhs_pos)->DestroyThread();
         }        
     }
@@ -0,0 +1,166 @@
+//===-- PacketCompression.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Utility/PacketCompression.h"
+
+// C Includes
+#include <string.h>
+
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+
+static const size_t k_min_match = 4;
+static const size_t k_max_offset = 0xffff;
+// LZ4 decoders rely on the last 5 bytes of a block being literals and on
+// the last match starting at least 12 bytes before the end of the block
+static const size_t k_last_literals = 5;
+static const size_t k_match_start_limit = 12;
+static const uint32_t k_hash_bits = 12;
+static const uint32_t k_no_position = 0xffffffff;
+
+static inline uint32_t
+Read32 (const uint8_t *p)
+{
+    uint32_t value;
+    ::memcpy (&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint32_t
+HashSequence (uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - k_hash_bits);
+}
+
+static void
+PutExtendedLength (std::string &dst, size_t length)
+{
+    while (length >= 255)
+    {
+        dst.push_back ((char)255);
+        length -= 255;
+    }
+    dst.push_back ((char)length);
+}
+
+static bool
+GetExtendedLength (const uint8_t *src, size_t src_len, size_t &idx, size_t &length)
+{
+    uint8_t byte;
+    do
+    {
+        if (idx >= src_len)
+            return false;
+        byte = src[idx++];
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+// A match_len of zero writes the last sequence which only has literals
+static void
+PutSequence (std::string &dst, const uint8_t *literals, size_t literal_len, size_t match_len, size_t offset)
+{
+    const size_t match_code = match_len ? match_len - k_min_match : 0;
+    const uint8_t token = (literal_len < 15 ? literal_len : 15) << 4 | (match_code < 15 ? match_code : 15);
+    dst.push_back ((char)token);
+    if (literal_len >= 15)
+        PutExtendedLength (dst, literal_len - 15);
+    dst.append ((const char *)literals, literal_len);
+    if (match_len)
+    {
+        dst.push_back ((char)(offset & 0xff));
+        dst.push_back ((char)(offset >> 8));
+        if (match_code >= 15)
+            PutExtendedLength (dst, match_code - 15);
+    }
+}
+
+bool
+PacketCompression::Compress (const uint8_t *src, size_t src_len, std::string &dst)
+{
+    dst.clear();
+    // A match can't start at the first byte, so nothing shorter than this
+    // can be compressed
+    if (src_len <= k_match_start_limit)
+        return false;
+
+    // Position of the last four byte sequence seen with each hash
+    uint32_t positions[1 << k_hash_bits];
+    for (size_t i = 0; i < sizeof(positions)/sizeof(positions[0]); ++i)
+        positions[i] = k_no_position;
+
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + k_match_start_limit <= src_len)
+    {
+        const uint32_t sequence = Read32 (src + pos);
+        const uint32_t hash = HashSequence (sequence);
+        const uint32_t candidate = positions[hash];
+        positions[hash] = pos;
+        if (candidate != k_no_position && pos - candidate <= k_max_offset && Read32 (src + candidate) == sequence)
+        {
+            size_t match_len = k_min_match;
+            while (pos + match_len < src_len - k_last_literals && src[candidate + match_len] == src[pos + match_len])
+                ++match_len;
+            PutSequence (dst, src + anchor, pos - anchor, match_len, pos - candidate);
+            pos += match_len;
+            anchor = pos;
+            if (dst.size() >= src_len)
+                return false;
+        }
+        else
+        {
+            ++pos;
+        }
+    }
+    PutSequence (dst, src + anchor, src_len - anchor, 0, 0);
+    return dst.size() < src_len;
+}
+
+bool
+PacketCompression::Decompress (const uint8_t *src, size_t src_len, size_t dst_len, std::string &dst)
+{
+    dst.clear();
+    dst.reserve (dst_len);
+    size_t idx = 0;
+    while (idx < src_len)
+    {
+        const uint8_t token = src[idx++];
+        size_t literal_len = token >> 4;
+        if (literal_len == 15 && !GetExtendedLength (src, src_len, idx, literal_len))
+            return false;
+        if (literal_len > src_len - idx || literal_len > dst_len - dst.size())
+            return false;
+        dst.append ((const char *)src + idx, literal_len);
+        idx += literal_len;
+
+        // The last sequence doesn't have a match
+        if (idx == src_len)
+            break;
+
+        if (src_len - idx < 2)
+            return false;
+        const size_t offset = src[idx] | (src[idx + 1] << 8);
+        idx += 2;
+        size_t match_len = token & 0xf;
+        if (match_len == 15 && !GetExtendedLength (src, src_len, idx, match_len))
+            return false;
+        match_len += k_min_match;
+        if (offset == 0 || offset > dst.size() || match_len > dst_len - dst.size())
+            return false;
+
+        // A match can overlap the bytes it produces, so copy a byte at a time
+        const size_t match_start = dst.size() - offset;
+        for (size_t i = 0; i < match_len; ++i)
+            dst.push_back (dst[match_start + i]);
+    }
+    return dst.size() == dst_len;
+}
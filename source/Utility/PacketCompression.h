@@ -0,0 +1,52 @@
+//===-- PacketCompression.h -------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef utility_PacketCompression_h_
+#define utility_PacketCompression_h_
+
+// C Includes
+// C++ Includes
+#include <string>
+#include <stdint.h>
+#include <stddef.h>
+
+// Other libraries and framework includes
+// Project includes
+
+//----------------------------------------------------------------------
+// A small and fast LZ77 compressor for gdb remote protocol payloads,
+// shared by lldb and debugserver.
+//
+// The compressed data is a list of sequences, each made of a token
+// byte, a run of literal bytes, a two byte little endian offset and a
+// match length. The high nibble of the token is the number of literal
+// bytes and the low nibble is the match length minus four, a nibble of
+// 15 means that more length bytes follow, each of which is added to the
+// length until one that isn't 255. The last sequence only has literal
+// bytes. This is the LZ4 block format, and Compress() follows its end of
+// block rules (the last five bytes are literals and the last match starts
+// at least twelve bytes before the end), so data can be checked with any
+// LZ4 implementation.
+//----------------------------------------------------------------------
+class PacketCompression
+{
+public:
+    // Compress src_len bytes from src into dst. Returns false, and leaves
+    // dst in an unspecified state, if the compressed data wouldn't be any
+    // smaller than the input.
+    static bool
+    Compress (const uint8_t *src, size_t src_len, std::string &dst);
+
+    // Decompress src_len bytes from src into dst which must end up being
+    // exactly dst_len bytes long. Returns false for malformed input.
+    static bool
+    Decompress (const uint8_t *src, size_t src_len, size_t dst_len, std::string &dst);
+};
+
+#endif  // utility_PacketCompression_h_
@@ -84,6 +84,7 @@ StringExtractorGDBRemote::GetServerPacketType () const
         {
         case 'E':
             if (PACKET_STARTS_WITH ("QEnvironment:"))           return eServerPacketType_QEnvironment; 
+            else if (PACKET_STARTS_WITH ("QEnableCompression:")) return eServerPacketType_QEnableCompression;
             break;
 
         case 'S':
@@ -180,3 +181,24 @@ StringExtractorGDBRemote::GetError ()
     }
     return 0;
 }
+
+size_t
+StringExtractorGDBRemote::GetEscapedBinaryData (void *dst_void, size_t dst_len)
+{
+    uint8_t *dst = (uint8_t*)dst_void;
+    size_t bytes_extracted = 0;
+    const size_t packet_size = m_packet.size();
+    while (bytes_extracted < dst_len && m_index < packet_size)
+    {
+        uint8_t byte = m_packet[m_index++];
+        if (byte == 0x7d)
+        {
+            // An escape character must always be followed by the escaped byte
+            if (m_index >= packet_size)
+                break;
+            byte = m_packet[m_index++] ^ 0x20;
+        }
+        dst[bytes_extracted++] = byte;
+    }
+    return bytes_extracted;
+}
@@ -63,7 +63,8 @@ public:
         eServerPacketType_QSetSTDOUT,
         eServerPacketType_QSetSTDERR,
         eServerPacketType_QSetWorkingDir,
-        eServerPacketType_QStartNoAckMode
+        eServerPacketType_QStartNoAckMode,
+        eServerPacketType_QEnableCompression
     };
     
     ServerPacketType
@@ -98,6 +99,12 @@ public:
     // digits. Otherwise the error encoded in XX is returned.
     uint8_t
     GetError();
+
+    // Decode binary data that was escaped with '}' as is done in replies
+    // to 'x' packets. Returns the number of bytes that were decoded, which
+    // is less than dst_len if the packet runs out of data.
+    size_t
+    GetEscapedBinaryData (void *dst, size_t dst_len);
 };
 
 #endif  // utility_StringExtractorGDBRemote_h_
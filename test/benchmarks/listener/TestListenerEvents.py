@@ -0,0 +1,61 @@
+"""Test how fast a listener delivers events queued by many broadcasters."""
+
+import os, sys
+import unittest2
+import lldb
+from lldbbench import *
+
+class ListenerEventsBench(BenchBase):
+
+    mydir = os.path.join("benchmarks", "listener")
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.num_broadcasters = 100
+        self.num_events = 50
+
+        self.count = lldb.bmIterationCount
+        if self.count <= 0:
+            self.count = 10
+
+    @benchmarks_test
+    def test_run_listener_events_bench(self):
+        """Flood a listener with events from many broadcasters and fetch them by broadcaster and type."""
+        print
+        self.run_listener_events_bench(self.count)
+        print "lldb listener events benchmark:", self.stopwatch
+
+    def run_listener_events_bench(self, count):
+        listener = lldb.SBListener("bench listener")
+        broadcasters = []
+        for i in range(self.num_broadcasters):
+            broadcaster = lldb.SBBroadcaster("bench broadcaster %d" % i)
+            listener.StartListeningForEvents(broadcaster, 0x3)
+            broadcasters.append(broadcaster)
+
+        # Reset the stopwatch now.
+        self.stopwatch.reset()
+        for i in range(count):
+            with self.stopwatch:
+                for j in range(self.num_events):
+                    for broadcaster in broadcasters:
+                        broadcaster.BroadcastEventByType(0x1 << (j % 2))
+
+                # Drain the queue starting with the broadcaster whose events
+                # were queued last, one event type at a time.
+                event = lldb.SBEvent()
+                num_events = 0
+                for broadcaster in reversed(broadcasters):
+                    for event_type in [0x2, 0x1]:
+                        while listener.GetNextEventForBroadcasterWithType(broadcaster, event_type, event):
+                            num_events += 1
+
+            self.assertTrue(num_events == self.num_broadcasters * self.num_events,
+                            "all events were delivered")
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,74 @@
+"""
+Test that a breakpoint with many locations enables and disables all of its
+breakpoint sites, which are batched into one call to the process plug-in.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class BatchedBreakpointSitesTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "breakpoint", "batched_sites")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test enabling and disabling the sites of a breakpoint with many locations."""
+        self.buildDsym()
+        self.batched_sites_test()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test enabling and disabling the sites of a breakpoint with many locations."""
+        self.buildDwarf()
+        self.batched_sites_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def batched_sites_test(self):
+        """Test enabling and disabling the sites of a breakpoint with many locations."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -r ^batch_func_", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: regex = '^batch_func_', locations = 64")
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line, BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 2: file ='main.c', line = %d, locations = 1" % self.line)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # All the sites were enabled when the executable was loaded.
+        self.expect("breakpoint list -f", "All locations are resolved",
+            substrs = ["1: regex = '^batch_func_', locations = 64, resolved = 64"])
+
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'batch_func_00', 'stop reason = breakpoint 1.'])
+
+        self.runCmd("process continue")
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'batch_func_01', 'stop reason = breakpoint 1.'])
+
+        # Disabling the breakpoint removes all of its traps at once, so the
+        # next stop is in main().
+        self.runCmd("breakpoint disable 1")
+        self.runCmd("process continue")
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'main.c:%d' % self.line, 'stop reason = breakpoint 2.'])
+
+        # Nothing in the batched functions was changed by the traps.
+        self.expect("frame variable total", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['(int) total = 64'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
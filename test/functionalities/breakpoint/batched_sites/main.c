@@ -0,0 +1,147 @@
+#include <stdio.h>
+
+// Every batch_func_NN() gets a location from one regular expression
+// breakpoint, so their breakpoint sites are all enabled in one batch.
+#define BATCH_FUNC(n) \
+int \
+batch_func_##n (int x) \
+{ \
+    return x + 1; \
+}
+
+BATCH_FUNC(00)
+BATCH_FUNC(01)
+BATCH_FUNC(02)
+BATCH_FUNC(03)
+BATCH_FUNC(04)
+BATCH_FUNC(05)
+BATCH_FUNC(06)
+BATCH_FUNC(07)
+BATCH_FUNC(08)
+BATCH_FUNC(09)
+BATCH_FUNC(10)
+BATCH_FUNC(11)
+BATCH_FUNC(12)
+BATCH_FUNC(13)
+BATCH_FUNC(14)
+BATCH_FUNC(15)
+BATCH_FUNC(16)
+BATCH_FUNC(17)
+BATCH_FUNC(18)
+BATCH_FUNC(19)
+BATCH_FUNC(20)
+BATCH_FUNC(21)
+BATCH_FUNC(22)
+BATCH_FUNC(23)
+BATCH_FUNC(24)
+BATCH_FUNC(25)
+BATCH_FUNC(26)
+BATCH_FUNC(27)
+BATCH_FUNC(28)
+BATCH_FUNC(29)
+BATCH_FUNC(30)
+BATCH_FUNC(31)
+BATCH_FUNC(32)
+BATCH_FUNC(33)
+BATCH_FUNC(34)
+BATCH_FUNC(35)
+BATCH_FUNC(36)
+BATCH_FUNC(37)
+BATCH_FUNC(38)
+BATCH_FUNC(39)
+BATCH_FUNC(40)
+BATCH_FUNC(41)
+BATCH_FUNC(42)
+BATCH_FUNC(43)
+BATCH_FUNC(44)
+BATCH_FUNC(45)
+BATCH_FUNC(46)
+BATCH_FUNC(47)
+BATCH_FUNC(48)
+BATCH_FUNC(49)
+BATCH_FUNC(50)
+BATCH_FUNC(51)
+BATCH_FUNC(52)
+BATCH_FUNC(53)
+BATCH_FUNC(54)
+BATCH_FUNC(55)
+BATCH_FUNC(56)
+BATCH_FUNC(57)
+BATCH_FUNC(58)
+BATCH_FUNC(59)
+BATCH_FUNC(60)
+BATCH_FUNC(61)
+BATCH_FUNC(62)
+BATCH_FUNC(63)
+
+int
+main (int argc, char const *argv[])
+{
+    int total = 0;
+    total = batch_func_00 (total);
+    total = batch_func_01 (total);
+    total = batch_func_02 (total);
+    total = batch_func_03 (total);
+    total = batch_func_04 (total);
+    total = batch_func_05 (total);
+    total = batch_func_06 (total);
+    total = batch_func_07 (total);
+    total = batch_func_08 (total);
+    total = batch_func_09 (total);
+    total = batch_func_10 (total);
+    total = batch_func_11 (total);
+    total = batch_func_12 (total);
+    total = batch_func_13 (total);
+    total = batch_func_14 (total);
+    total = batch_func_15 (total);
+    total = batch_func_16 (total);
+    total = batch_func_17 (total);
+    total = batch_func_18 (total);
+    total = batch_func_19 (total);
+    total = batch_func_20 (total);
+    total = batch_func_21 (total);
+    total = batch_func_22 (total);
+    total = batch_func_23 (total);
+    total = batch_func_24 (total);
+    total = batch_func_25 (total);
+    total = batch_func_26 (total);
+    total = batch_func_27 (total);
+    total = batch_func_28 (total);
+    total = batch_func_29 (total);
+    total = batch_func_30 (total);
+    total = batch_func_31 (total);
+    total = batch_func_32 (total);
+    total = batch_func_33 (total);
+    total = batch_func_34 (total);
+    total = batch_func_35 (total);
+    total = batch_func_36 (total);
+    total = batch_func_37 (total);
+    total = batch_func_38 (total);
+    total = batch_func_39 (total);
+    total = batch_func_40 (total);
+    total = batch_func_41 (total);
+    total = batch_func_42 (total);
+    total = batch_func_43 (total);
+    total = batch_func_44 (total);
+    total = batch_func_45 (total);
+    total = batch_func_46 (total);
+    total = batch_func_47 (total);
+    total = batch_func_48 (total);
+    total = batch_func_49 (total);
+    total = batch_func_50 (total);
+    total = batch_func_51 (total);
+    total = batch_func_52 (total);
+    total = batch_func_53 (total);
+    total = batch_func_54 (total);
+    total = batch_func_55 (total);
+    total = batch_func_56 (total);
+    total = batch_func_57 (total);
+    total = batch_func_58 (total);
+    total = batch_func_59 (total);
+    total = batch_func_60 (total);
+    total = batch_func_61 (total);
+    total = batch_func_62 (total);
+    total = batch_func_63 (total);
+    printf ("total = %d\n", total); // Set break point at this line.
+    return 0;
+}
@@ -0,0 +1,91 @@
+"""
+Test that breakpoints that are matched to newly loaded modules by their
+function names and source files get the same locations as a search of
+every module.
+"""
+
+import os, time
+import unittest2
+import lldb
+import lldbutil
+from lldbtest import *
+
+class BreakpointModuleKeyIndexTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "breakpoint", "module_key_index")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test breakpoint locations in a library that gets loaded after the breakpoints were set."""
+        self.buildDsym()
+        self.module_key_index_test()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test breakpoint locations in a library that gets loaded after the breakpoints were set."""
+        self.buildDwarf()
+        self.module_key_index_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.main_line = line_number('main.c', '// Set break point in main.c at this line.')
+        self.other_line = line_number('other.c', '// Set break point in other.c at this line.')
+
+    def create_breakpoints(self, target):
+        """Create one breakpoint of each kind, returning them with the number of locations each should have."""
+        return [
+            # In both modules
+            (target.BreakpointCreateByName('common_function'), 2),
+            # Only in libother
+            (target.BreakpointCreateByName('other_function'), 1),
+            (target.BreakpointCreateByLocation('other.c', self.other_line), 1),
+            # Only in a.out
+            (target.BreakpointCreateByName('main_function'), 1),
+            (target.BreakpointCreateByLocation('main.c', self.main_line), 1),
+            # In no module at all
+            (target.BreakpointCreateByName('no_such_function'), 0),
+            (target.BreakpointCreateByLocation('no_such_file.c', 1), 0),
+        ]
+
+    def module_key_index_test(self):
+        """Test breakpoint locations in a library that gets loaded after the breakpoints were set."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        # Set the breakpoints before libother is loaded into the process
+        breakpoints = self.create_breakpoints(target)
+        for (bkpt, num_locations) in breakpoints:
+            self.assertTrue(bkpt, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, os.getcwd())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        # By the time any of the breakpoints is hit, libother is loaded
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread != None, "There should be a thread stopped due to breakpoint")
+
+        # Breakpoints created now search every module
+        fresh_breakpoints = self.create_breakpoints(target)
+
+        for ((bkpt, num_locations), (fresh_bkpt, fresh_num_locations)) in zip(breakpoints, fresh_breakpoints):
+            self.assertTrue(bkpt.GetNumLocations() == num_locations,
+                            "Breakpoint %d has %d locations, expected %d" % (bkpt.GetID(), bkpt.GetNumLocations(), num_locations))
+            self.assertTrue(bkpt.GetNumLocations() == fresh_bkpt.GetNumLocations(),
+                            "Breakpoint %d has the same locations as breakpoint %d" % (bkpt.GetID(), fresh_bkpt.GetID()))
+            for i in range(bkpt.GetNumLocations()):
+                load_addr = bkpt.GetLocationAtIndex(i).GetLoadAddress()
+                self.assertTrue(fresh_bkpt.FindLocationByAddress(load_addr),
+                                "Breakpoint %d location at 0x%x is also in breakpoint %d" % (bkpt.GetID(), load_addr, fresh_bkpt.GetID()))
+
+        process.Kill()
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
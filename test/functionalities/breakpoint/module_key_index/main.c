@@ -0,0 +1,24 @@
+#include <stdio.h>
+
+extern int other_function (int i);
+
+// Same name as the function in libother, so a breakpoint on it has a
+// location in both modules
+static int
+common_function (int i)
+{
+    return i - 1;
+}
+
+int
+main_function (int i)
+{
+    return common_function (i) * 3; // Set break point in main.c at this line.
+}
+
+int
+main (int argc, char const *argv[])
+{
+    printf ("%d\n", other_function (argc) + main_function (argc));
+    return 0;
+}
@@ -0,0 +1,11 @@
+int
+common_function (int i)
+{
+    return i + 1; // Set break point in other.c at this line.
+}
+
+int
+other_function (int i)
+{
+    return common_function (i) * 2;
+}
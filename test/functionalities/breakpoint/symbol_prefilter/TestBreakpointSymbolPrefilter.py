@@ -0,0 +1,94 @@
+"""
+Test that name breakpoints still resolve when modules are prefiltered
+with their symbol tables.
+"""
+
+import os, time
+import json
+import unittest2
+import lldb
+from lldbtest import *
+
+class BreakpointSymbolPrefilterTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "breakpoint", "symbol_prefilter")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym(self):
+        """Test name breakpoints with target.breakpoints-prefilter-with-symbols enabled."""
+        self.buildDsym()
+        self.symbol_prefilter_test()
+
+    @dwarf_test
+    def test_with_dwarf(self):
+        """Test name breakpoints with target.breakpoints-prefilter-with-symbols enabled."""
+        self.buildDwarf()
+        self.symbol_prefilter_test()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside Foo::bar().
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def get_module_statistics(self, name):
+        """Return the statistics of the first module whose file name starts with name, or None."""
+        self.runCmd("statistics dump")
+        stats = json.loads(self.res.GetOutput())
+        matches = [m for m in stats["modules"] if os.path.basename(m["path"]).startswith(name)]
+        if len(matches) == 0:
+            return None
+        return matches[0]
+
+    def symbol_prefilter_test(self):
+        """Test name breakpoints with target.breakpoints-prefilter-with-symbols enabled."""
+        self.runCmd("settings set target.breakpoints-prefilter-with-symbols true")
+        self.addTearDownHook(
+            lambda: self.runCmd("settings set target.breakpoints-prefilter-with-symbols false"))
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        # A base name has to be matched against the demangled symbol names.
+        self.expect("breakpoint set -n bar", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: name = 'bar', locations = 1")
+
+        # So does a qualified name.
+        self.expect("breakpoint set -n ns::Foo::bar", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 2: name = 'ns::Foo::bar', locations = 1")
+
+        self.expect("breakpoint set -n plain_function", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 3: name = 'plain_function', locations = 1")
+
+        self.expect("breakpoint set -n no_such_function", BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 4: name = 'no_such_function', locations = 0 (pending)")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The first stop is in plain_function().
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'plain_function', 'stop reason = breakpoint'])
+
+        # The breakpoints were resolved in libother when it was loaded, but
+        # none of the names are in its symbol table, so its debug info
+        # should not have been indexed or parsed.
+        other_stats = self.get_module_statistics("libother")
+        self.assertTrue(other_stats != None, "libother was loaded")
+        self.assertTrue(other_stats["symfile_index_seconds"] == 0,
+                        "libother's debug info was not indexed")
+        self.assertTrue(other_stats["num_dies_parsed"] == 0,
+                        "No DIEs were parsed for libother")
+
+        self.runCmd("process continue")
+
+        # Then both breakpoints on Foo::bar() are hit.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'main.cpp:%d' % self.line, 'stop reason = breakpoint'])
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
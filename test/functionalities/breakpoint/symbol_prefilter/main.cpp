@@ -0,0 +1,31 @@
+#include <stdio.h>
+
+extern int other_function (int i);
+
+namespace ns {
+    class Foo
+    {
+    public:
+        int bar (int i);
+    };
+
+    int
+    Foo::bar (int i)
+    {
+        return i + 1; // Set break point at this line.
+    }
+}
+
+extern "C" int
+plain_function (int i)
+{
+    return i * 2;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    ns::Foo foo;
+    printf ("%d\n", foo.bar (plain_function (other_function (argc))));
+    return 0;
+}
@@ -0,0 +1,7 @@
+// A library with debug information but none of the functions the test
+// sets breakpoints on, so the prefilter should skip its debug info.
+int
+other_function (int i)
+{
+    return i + 3;
+}
@@ -3,6 +3,7 @@ Test lldb data formatter subsystem.
 """
 
 import os, time
+import json
 import unittest2
 import lldb
 from lldbtest import *
@@ -203,6 +204,24 @@ class PythonSynthDataFormatterTestCase(TestBase):
         self.expect("frame variable f00_1", matching=False,
                 substrs = ['fake_a = '])
 
+        # a provider can hand back a whole range of children in one call
+        self.runCmd("script from fooBatchedSynthProvider import *")
+        self.runCmd("type synth add -l fooBatchedSynthProvider foo")
+
+        self.expect("frame variable f00_1",
+                    substrs = ['[0] = 280',
+                               '[1] = 1',
+                               '[9] = 17'])
+
+        # the time spent running the provider is reported per class
+        self.runCmd("statistics dump")
+        stats = json.loads(self.res.GetOutput())
+        providers = [f for f in stats["python_formatters"] if f["name"] == "fooBatchedSynthProvider"]
+        self.assertTrue(len(providers) == 1)
+        self.assertTrue(providers[0]["python_calls"] > 0)
+
+        self.runCmd("type synth delete foo")
+
     def rdar10960550_formatter_commands(self):
         """Test that synthetic children persist stoppoints."""
         self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
@@ -0,0 +1,17 @@
+import lldb
+class fooBatchedSynthProvider:
+	def __init__(self, valobj, dict):
+		self.valobj = valobj;
+		self.int_type = valobj.GetType().GetBasicType(lldb.eBasicTypeInt)
+	def num_children(self):
+		return 18;
+	def get_child_range(self, start, count):
+		# all the members come out of a single copy of the bytes of foo
+		values = self.valobj.CreateValuesFromData(self.valobj.GetData(), self.int_type)
+		return [values.GetValueAtIndex(i) for i in range(start, min(start + count, values.GetSize()))]
+	def get_child_at_index(self, index):
+		return self.valobj.CreateChildAtOffset("[" + str(index) + "]", 4 * index, self.int_type);
+	def get_child_index(self, name):
+		return int(name.lstrip("[").rstrip("]"));
+	def update(self):
+		return True
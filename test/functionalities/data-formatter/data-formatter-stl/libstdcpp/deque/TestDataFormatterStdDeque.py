@@ -0,0 +1,101 @@
+"""
+Test lldb data formatter subsystem.
+"""
+
+import os, time
+import unittest2
+import lldb
+from lldbtest import *
+
+class StdDequeDataFormatterTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "data-formatter", "data-formatter-stl", "libstdcpp", "deque")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym_and_run_command(self):
+        """Test the built-in std::deque and std::set synthetic children."""
+        self.buildDsym()
+        self.data_formatter_commands()
+
+    @dwarf_test
+    def test_with_dwarf_and_run_command(self):
+        """Test the built-in std::deque and std::set synthetic children."""
+        self.buildDwarf()
+        self.data_formatter_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line numbers to break at.
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+        self.line2 = line_number('main.cpp', '// Set second break point at this line.')
+
+    def data_formatter_commands(self):
+        """Test the built-in std::deque and std::set synthetic children."""
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.cpp -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: file ='main.cpp', line = %d" %
+                        self.line)
+        self.expect("breakpoint set -f main.cpp -l %d" % self.line2,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 2: file ='main.cpp', line = %d" %
+                        self.line2)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        # This is the function to remove the custom formats in order to have a
+        # clean slate for the next test case.
+        def cleanup():
+            self.runCmd('type format clear', check=False)
+            self.runCmd('type summary clear', check=False)
+            self.runCmd('type filter clear', check=False)
+            self.runCmd('type synth clear', check=False)
+            self.runCmd("settings set target.max-children-count 256", check=False)
+
+        # Execute the cleanup function during test case tear down.
+        self.addTearDownHook(cleanup)
+
+        # The built-in synthetic children don't need Python classes
+        self.expect("type synth list -w gnu-libstdc",
+                    substrs = ['std::deque synthetic children',
+                               'std::map synthetic children'])
+
+        self.expect("frame variable numbers_deque",
+                    substrs = ['size=0'])
+        self.expect("frame variable words",
+                    substrs = ['size=0'])
+
+        self.runCmd("continue")
+
+        # The elements span several blocks and the first one doesn't start
+        # at the beginning of its block
+        self.expect("frame variable numbers_deque",
+                    substrs = ['size=1000',
+                               '[0] = 0',
+                               '[1] = 1',
+                               '[2] = 2',
+                               '[3] = 3'])
+        self.expect("frame variable numbers_deque[129]",
+                    substrs = ['129'])
+        self.expect("frame variable numbers_deque[999]",
+                    substrs = ['999'])
+
+        self.expect("frame variable words",
+                    substrs = ['size=3',
+                               '[0] = "goofy"',
+                               '[1] = "is"',
+                               '[2] = "smart"'])
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,25 @@
+#include <deque>
+#include <set>
+#include <string>
+
+typedef std::deque<int> int_deque;
+typedef std::set<std::string> string_set;
+
+int main()
+{
+    int_deque numbers_deque;
+    string_set words;
+    
+    numbers_deque.push_back(1); // Set break point at this line.
+    numbers_deque.push_back(2);
+    numbers_deque.push_front(0);
+    
+    for (int i = 3; i < 1000; i++)
+        numbers_deque.push_back(i);
+    
+    words.insert("goofy");
+    words.insert("is");
+    words.insert("smart");
+    
+    return 0; // Set second break point at this line.
+}
@@ -0,0 +1,91 @@
+"""
+Test that disassembling the same code twice reuses the instructions the
+first disassembly decoded, and prints the same output.
+"""
+
+import os, time
+import json
+import unittest2
+import lldb
+from lldbtest import *
+
+class DisassemblyCacheTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "disassembly_cache")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_disassembly_cache_with_dsym(self):
+        """Test that a second disassembly is a cache hit with the same output."""
+        self.buildDsym()
+        self.disassembly_cache()
+
+    @dwarf_test
+    def test_disassembly_cache_with_dwarf(self):
+        """Test that a second disassembly is a cache hit with the same output."""
+        self.buildDwarf()
+        self.disassembly_cache()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def get_exe_statistics(self):
+        self.runCmd("statistics dump")
+        stats = json.loads(self.res.GetOutput())
+        exe_stats = [m for m in stats["modules"] if m["path"].endswith("a.out")]
+        self.assertTrue(len(exe_stats) == 1)
+        return exe_stats[0]
+
+    def disassemble(self, command):
+        self.runCmd(command)
+        output = self.res.GetOutput()
+        self.assertTrue(len(output) > 0, "'%s' printed instructions" % command)
+        return output
+
+    def disassembly_cache(self):
+        """Test that a second disassembly is a cache hit with the same output."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: file ='main.c', line = %d, locations = 1" %
+                        self.line)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint'])
+
+        before = self.get_exe_statistics()
+        first = self.disassemble("disassemble -n square")
+        after_first = self.get_exe_statistics()
+        self.assertTrue(after_first["disassembly_cache_misses"] > before["disassembly_cache_misses"],
+                        "The first disassembly was decoded")
+
+        second = self.disassemble("disassemble -n square")
+        after_second = self.get_exe_statistics()
+        self.assertTrue(after_second["disassembly_cache_hits"] == after_first["disassembly_cache_hits"] + 1,
+                        "The second disassembly was copied from the cache")
+        self.assertTrue(first == second, "Cached instructions print the same as decoded ones")
+
+        # Instructions copied from the cache calculate their operands and
+        # comments for the current frame: the call to square gets
+        # symbolicated and the pc is marked in both disassemblies of main.
+        first = self.disassemble("disassemble -f")
+        second = self.disassemble("disassemble -f")
+        self.assertTrue(first == second, "Cached instructions print the same as decoded ones")
+        self.assertTrue('square' in second, "The call to square is symbolicated")
+        self.assertTrue('->' in second, "The pc is marked")
+
+        self.runCmd("process kill")
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
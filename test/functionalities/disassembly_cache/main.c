@@ -0,0 +1,15 @@
+#include <stdio.h>
+
+int
+square (int x)
+{
+    return x * x;
+}
+
+int
+main (int argc, char const *argv[])
+{
+    int value = square (argc);
+    printf ("value = %d\n", value); // Set break point at this line.
+    return 0;
+}
@@ -0,0 +1,262 @@
+#!/usr/bin/env python
+
+"""
+A fake gdb remote stub that serves a stopped process with one thread and
+a small memory image, for testing how lldb talks to stubs that behave in
+specific ways.
+
+Usage: FakeGDBServer.py <log file> [options]
+
+  --compression=none|supported
+      Whether QEnableCompression is answered with "OK".
+  --multimem=none|good|overreport|short
+      Whether the qMultiMemRead probe is answered with "OK", and whether
+      the lengths in the replies are correct, larger than requested, or
+      are missing the last range.
+
+Every packet received is written to the log file, one per line, and a
+line "compressed reply" is written for every reply sent compressed.
+"""
+
+import socket
+import sys
+
+# Memory served at 0x1000: bytes that start with 'C' and include every
+# character that needs escaping, so a binary reply to a read of this
+# address looks like a compressed packet to a stub that gets it wrong.
+C_BYTES_ADDR = 0x1000
+C_BYTES = bytearray('C0:}#$*\x00' + ''.join(chr(i) for i in range(256)))
+
+# Memory served at 0x2000: a long run of repeating bytes that compresses
+# well.
+REPEAT_ADDR = 0x2000
+REPEAT_BYTES = bytearray(''.join(chr(ord('a') + i % 7) for i in range(0x1000)))
+
+# Memory served at 0x8000: four pointers to 'struct point' objects at
+# 0x9000, 0xa000, 0xb000 and 0xc000, each with x = 1..4 and y = x * 10.
+POINTERS_ADDR = 0x8000
+POINTEE_ADDRS = [0x9000, 0xa000, 0xb000, 0xc000]
+
+
+def le_bytes(value, size):
+    return bytearray(chr((value >> (8 * i)) & 0xff) for i in range(size))
+
+
+def build_memory():
+    memory = bytearray(0x10000)
+    memory[C_BYTES_ADDR:C_BYTES_ADDR + len(C_BYTES)] = C_BYTES
+    memory[REPEAT_ADDR:REPEAT_ADDR + len(REPEAT_BYTES)] = REPEAT_BYTES
+    for i, addr in enumerate(POINTEE_ADDRS):
+        memory[POINTERS_ADDR + 8 * i:POINTERS_ADDR + 8 * (i + 1)] = le_bytes(addr, 8)
+        memory[addr:addr + 8] = le_bytes(i + 1, 4) + le_bytes((i + 1) * 10, 4)
+    return memory
+
+
+def read_memory(memory, addr, length):
+    # Everything outside of the image reads as zeros
+    data = bytearray(length)
+    if addr < len(memory):
+        chunk = memory[addr:addr + length]
+        data[:len(chunk)] = chunk
+    return data
+
+
+def escape_binary(data):
+    out = bytearray()
+    for byte in bytearray(data):
+        if chr(byte) in '#$}*\x00':
+            out.append(ord('}'))
+            out.append(byte ^ 0x20)
+        else:
+            out.append(byte)
+    return out
+
+
+def lz4_put_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz4_put_sequence(out, literals, match_len, offset):
+    match_code = match_len - 4 if match_len else 0
+    out.append(min(len(literals), 15) << 4 | min(match_code, 15))
+    if len(literals) >= 15:
+        lz4_put_length(out, len(literals) - 15)
+    out.extend(literals)
+    if match_len:
+        out.append(offset & 0xff)
+        out.append(offset >> 8)
+        if match_code >= 15:
+            lz4_put_length(out, match_code - 15)
+
+
+def lz4_compress(src):
+    """Compress src in the LZ4 block format lldb's PacketCompression reads."""
+    src = bytearray(src)
+    out = bytearray()
+    positions = {}
+    anchor = 0
+    pos = 0
+    while pos + 4 <= len(src):
+        sequence = str(src[pos:pos + 4])
+        candidate = positions.get(sequence)
+        positions[sequence] = pos
+        if candidate is not None and pos - candidate <= 0xffff:
+            match_len = 4
+            while pos + match_len < len(src) and src[candidate + match_len] == src[pos + match_len]:
+                match_len += 1
+            lz4_put_sequence(out, src[anchor:pos], match_len, pos - candidate)
+            pos += match_len
+            anchor = pos
+        else:
+            pos += 1
+    lz4_put_sequence(out, src[anchor:], 0, 0)
+    return out
+
+
+class FakeGDBServer:
+
+    def __init__(self, log, options):
+        self.log = log
+        self.compression = options.get('compression', 'none')
+        self.multimem = options.get('multimem', 'none')
+        self.memory = build_memory()
+        self.send_acks = True
+        self.compression_min_size = 0
+
+    def log_line(self, line):
+        self.log.write(line + '\n')
+        self.log.flush()
+
+    def frame(self, payload):
+        # Once compression was enabled every reply needs a prefix
+        payload = bytearray(payload)
+        if self.compression_min_size == 0:
+            return payload
+        if len(payload) >= self.compression_min_size:
+            compressed = bytearray('C%x:' % len(payload)) + escape_binary(lz4_compress(payload))
+            if len(compressed) < len(payload):
+                self.log_line('compressed reply')
+                return compressed
+        return bytearray('N') + payload
+
+    def send(self, conn, payload):
+        payload = self.frame(payload)
+        checksum = sum(payload) & 0xff
+        conn.sendall(str(bytearray('$') + payload + bytearray('#%2.2x' % checksum)))
+
+    def multi_mem_read(self, args):
+        if not args:
+            return 'OK' if self.multimem != 'none' else ''
+        if self.multimem == 'none':
+            return ''
+        lengths = []
+        data = bytearray()
+        for range_str in args.split(';'):
+            addr, length = [int(x, 16) for x in range_str.split(',')]
+            lengths.append(length)
+            data += escape_binary(read_memory(self.memory, addr, length))
+        if self.multimem == 'overreport':
+            # Claim four more bytes for the first range than were asked for
+            lengths[0] += 4
+        elif self.multimem == 'short' and len(lengths) > 1:
+            lengths.pop()
+        return bytearray(','.join('%x' % l for l in lengths) + ';') + data
+
+    def handle(self, packet):
+        if packet == 'QStartNoAckMode':
+            return 'OK'
+        if packet.startswith('QEnableCompression:'):
+            if self.compression != 'supported':
+                return ''
+            min_size = int(packet.split('minsize:')[1].rstrip(';'))
+            # The "OK" itself goes out before compression is turned on
+            return ('OK', min_size)
+        if packet == 'qHostInfo':
+            triple = ''.join('%2.2x' % ord(c) for c in 'x86_64-unknown-unknown')
+            return 'triple:%s;endian:little;ptrsize:8;' % triple
+        if packet == 'qC':
+            return 'QC1'
+        if packet == '?':
+            return 'T02thread:1;'
+        if packet == 'qfThreadInfo':
+            return 'm1'
+        if packet == 'qsThreadInfo':
+            return 'l'
+        if packet == 'qRegisterInfo0':
+            return 'name:pc;bitsize:64;offset:0;encoding:uint;format:hex;set:General Purpose Registers;generic:pc;'
+        if packet.startswith('qRegisterInfo'):
+            return 'E45'
+        if packet.startswith('H'):
+            return 'OK'
+        if packet.startswith('p') or packet.startswith('g'):
+            return '0000000000000000'
+        if packet == 'x0,0':
+            return 'OK'
+        if packet.startswith('x'):
+            addr, length = [int(x, 16) for x in packet[1:].split(',')]
+            return escape_binary(read_memory(self.memory, addr, length))
+        if packet.startswith('m'):
+            addr, length = [int(x, 16) for x in packet[1:].split(',')]
+            return ''.join('%2.2x' % b for b in read_memory(self.memory, addr, length))
+        if packet.startswith('qMultiMemRead:'):
+            return self.multi_mem_read(packet[len('qMultiMemRead:'):])
+        if packet == 'k':
+            return 'X09'
+        return ''
+
+    def serve(self, conn):
+        buf = ''
+        while True:
+            data = conn.recv(4096)
+            if not data:
+                return
+            buf += data
+            while buf:
+                if buf[0] != '$':
+                    # Acks, nacks and interrupts
+                    buf = buf[1:]
+                    continue
+                end = buf.find('#')
+                if end < 0 or len(buf) < end + 3:
+                    break
+                packet = buf[1:end]
+                buf = buf[end + 3:]
+                if self.send_acks:
+                    conn.sendall('+')
+                self.log_line(packet)
+                reply = self.handle(packet)
+                min_size = 0
+                if isinstance(reply, tuple):
+                    reply, min_size = reply
+                self.send(conn, reply)
+                if packet == 'QStartNoAckMode':
+                    self.send_acks = False
+                if min_size:
+                    self.compression_min_size = min_size
+                if packet == 'k':
+                    return
+
+
+def main():
+    options = {}
+    for arg in sys.argv[2:]:
+        name, value = arg[2:].split('=')
+        options[name] = value
+    log = open(sys.argv[1], 'w')
+
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    s.bind(('localhost', 0))
+    s.listen(1)
+    sys.stdout.write('Listening on localhost:%d\n' % s.getsockname()[1])
+    sys.stdout.flush()
+    conn, addr = s.accept()
+    FakeGDBServer(log, options).serve(conn)
+    conn.close()
+    log.close()
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,171 @@
+"""
+Test compression of gdb remote packets, requested with the
+LLDB_GDB_REMOTE_COMPRESSION environment variable.
+"""
+
+import os, time
+import re
+import unittest2
+import lldb
+import lldbutil
+import pexpect
+from lldbtest import *
+
+class GDBRemoteCompressionTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "gdb_remote_client")
+
+    def test_compression_not_supported(self):
+        """Test that replies which start with 'C' are left alone when the stub doesn't compress."""
+        self.set_compression_min_size('16')
+        (process, log_path) = self.connect_to_fake_server('--compression=none')
+
+        # The stub was asked, but said no
+        self.assertTrue('QEnableCompression:minsize:16;' in self.read_server_log(log_path))
+        self.check_fake_server_memory(process)
+
+        process.Kill()
+        self.assertFalse('compressed reply' in self.read_server_log(log_path))
+
+    def test_compression_supported(self):
+        """Test that compressed and uncompressed replies both decode once the stub compresses."""
+        self.set_compression_min_size('16')
+        (process, log_path) = self.connect_to_fake_server('--compression=supported')
+
+        self.check_fake_server_memory(process)
+
+        process.Kill()
+        self.assertTrue('compressed reply' in self.read_server_log(log_path))
+
+    def test_compression_not_requested(self):
+        """Test that compression is only requested when the environment variable is set."""
+        self.set_compression_min_size(None)
+        (process, log_path) = self.connect_to_fake_server('--compression=supported')
+
+        self.check_fake_server_memory(process)
+
+        process.Kill()
+        server_log = self.read_server_log(log_path)
+        self.assertFalse('QEnableCompression' in server_log)
+        self.assertFalse('compressed reply' in server_log)
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_debugserver_round_trip_with_dsym(self):
+        """Test reading memory through compressed debugserver replies."""
+        self.buildDsym()
+        self.debugserver_round_trip()
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dwarf_test
+    def test_debugserver_round_trip_with_dwarf(self):
+        """Test reading memory through compressed debugserver replies."""
+        self.buildDwarf()
+        self.debugserver_round_trip()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+        # Put the environment variable back the way it was.
+        old_min_size = os.environ.get('LLDB_GDB_REMOTE_COMPRESSION')
+        def restore_min_size():
+            self.set_compression_min_size(old_min_size)
+        self.addTearDownHook(restore_min_size)
+
+    def set_compression_min_size(self, min_size):
+        if min_size is None:
+            if 'LLDB_GDB_REMOTE_COMPRESSION' in os.environ:
+                del os.environ['LLDB_GDB_REMOTE_COMPRESSION']
+        else:
+            os.environ['LLDB_GDB_REMOTE_COMPRESSION'] = min_size
+
+    def read_server_log(self, log_path):
+        # The fake server flushes each line as soon as it is written
+        with open(log_path) as f:
+            return f.read()
+
+    def connect_to_fake_server(self, *options):
+        """Start FakeGDBServer.py with options and connect a process to it."""
+        log_path = os.path.join(os.getcwd(), self.testMethodName + '.log')
+        fakeserver = pexpect.spawn('./FakeGDBServer.py', [log_path] + list(options))
+        if self.TraceOn():
+            fakeserver.logfile_read = sys.stdout
+        def shutdown_fakeserver():
+            fakeserver.close()
+            if os.path.exists(log_path):
+                os.remove(log_path)
+        self.addTearDownHook(shutdown_fakeserver)
+
+        fakeserver.expect(r'Listening on localhost:(\d+)')
+        port = int(fakeserver.match.group(1))
+
+        target = self.dbg.CreateTarget('')
+        self.assertTrue(target, VALID_TARGET)
+        listener = lldb.SBListener('fake gdb server listener')
+        error = lldb.SBError()
+        process = target.ConnectRemote(listener, 'connect://localhost:%d' % port, 'gdb-remote', error)
+        self.assertTrue(error.Success() and process, PROCESS_IS_VALID)
+
+        event = lldb.SBEvent()
+        listener.WaitForEvent(5, event)
+        self.assertTrue(process.GetState() == lldb.eStateStopped, PROCESS_STOPPED)
+        return (process, log_path)
+
+    def check_fake_server_memory(self, process):
+        """Read the memory image of FakeGDBServer.py."""
+        error = lldb.SBError()
+        # Binary data that starts with 'C' and needs escaping
+        expected = 'C0:}#$*\x00' + ''.join(chr(i) for i in range(256))
+        data = process.ReadMemory(0x1000, len(expected), error)
+        self.assertTrue(error.Success(), "Read memory at 0x1000")
+        self.assertTrue(data == expected, "Memory at 0x1000 matches")
+
+        # A read that is long enough to be compressed
+        expected = ''.join(chr(ord('a') + i % 7) for i in range(0x1000))
+        data = process.ReadMemory(0x2000, len(expected), error)
+        self.assertTrue(error.Success(), "Read memory at 0x2000")
+        self.assertTrue(data == expected, "Memory at 0x2000 matches")
+
+    def debugserver_round_trip(self):
+        """Read a buffer that starts with 'C' through compressed debugserver replies."""
+        self.set_compression_min_size('64')
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, os.getcwd())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread != None, "There should be a thread stopped due to breakpoint")
+        frame0 = thread.GetFrameAtIndex(0)
+
+        buffer_addr = frame0.FindVariable('g_buffer').GetLoadAddress()
+        self.assertTrue(buffer_addr != lldb.LLDB_INVALID_ADDRESS)
+
+        # Read it in pieces of different sizes so that some replies are too
+        # short to be compressed
+        expected = 'C0:}' + ''.join(chr(ord('a') + i % 7) for i in range(4, 8192))
+        error = lldb.SBError()
+        for size in [4, 63, 64, 1000, 8192]:
+            data = process.ReadMemory(buffer_addr, size, error)
+            self.assertTrue(error.Success(), "Read %d bytes of g_buffer" % size)
+            self.assertTrue(data == expected[:size], "%d bytes of g_buffer match" % size)
+
+        self.runCmd("statistics dump")
+        self.assertTrue(re.search(r'"packet_bytes_saved": [1-9]', self.res.GetOutput()),
+                        "Some replies were compressed")
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,170 @@
+"""
+Test reading several ranges of memory with one qMultiMemRead packet, and
+falling back to reading them one at a time when the stub gets it wrong.
+"""
+
+import os, time
+import re
+import unittest2
+import lldb
+import pexpect
+from lldbtest import *
+
+class GDBRemoteMultiMemReadTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "gdb_remote_client")
+
+    # The pointers FakeGDBServer.py serves at this address, and what they
+    # point to
+    pointers_addr = 0x8000
+    pointee_addrs = [0x9000, 0xa000, 0xb000, 0xc000]
+
+    @dwarf_test
+    def test_multi_mem_read(self):
+        """Test that the pointees of an array of pointers are read with one packet."""
+        self.buildDwarf()
+        (process, log_path) = self.connect_to_fake_server('--multimem=good')
+
+        self.check_pointees(process)
+
+        process.Kill()
+        server_log = self.read_server_log(log_path)
+        # The probe comes first, then the ranges as <addr>,<len> pairs
+        self.assertTrue(re.search(r'^qMultiMemRead:$', server_log, re.MULTILINE))
+        self.assertTrue(re.search(self.multi_mem_read_pattern(), server_log, re.MULTILINE),
+                        "The pointees were read with one qMultiMemRead packet")
+        self.assertFalse(self.read_separately(server_log), "No pointee was read on its own")
+
+    @dwarf_test
+    def test_multi_mem_read_not_supported(self):
+        """Test that ranges are read one at a time when the stub has no qMultiMemRead."""
+        self.buildDwarf()
+        (process, log_path) = self.connect_to_fake_server('--multimem=none')
+
+        self.check_pointees(process)
+
+        process.Kill()
+        server_log = self.read_server_log(log_path)
+        self.assertFalse(re.search(self.multi_mem_read_pattern(), server_log, re.MULTILINE),
+                         "Ranges aren't sent to a stub that didn't answer the probe")
+        self.assertTrue(self.read_separately(server_log), "Every pointee was read on its own")
+
+    @dwarf_test
+    def test_multi_mem_read_pointees_not_shown(self):
+        """Test that pointees aren't read ahead when the display won't show them."""
+        self.buildDwarf()
+        (process, log_path) = self.connect_to_fake_server('--multimem=good')
+
+        # No pointer depth, and a pointer depth with the pointers at the
+        # maximum depth
+        stream = lldb.SBStream()
+        self.assertTrue(self.get_fake_ptrs(process).GetDescription(stream))
+        self.runCmd("memory read --type point_ptrs_t 0x%x" % self.pointers_addr)
+        self.runCmd("memory read --type point_ptrs_t --ptr-depth 1 --depth 1 0x%x" % self.pointers_addr)
+
+        process.Kill()
+        server_log = self.read_server_log(log_path)
+        self.assertFalse(re.search(self.multi_mem_read_pattern(), server_log, re.MULTILINE),
+                         "Pointees that aren't displayed weren't read")
+
+    @dwarf_test
+    def test_multi_mem_read_overreported_length(self):
+        """Test that a reply with a length larger than requested is rejected."""
+        self.buildDwarf()
+        self.check_fallback('--multimem=overreport')
+
+    @dwarf_test
+    def test_multi_mem_read_missing_length(self):
+        """Test that a reply with fewer lengths than ranges is rejected."""
+        self.buildDwarf()
+        self.check_fallback('--multimem=short')
+
+    def read_server_log(self, log_path):
+        # The fake server flushes each line as soon as it is written
+        with open(log_path) as f:
+            return f.read()
+
+    def connect_to_fake_server(self, *options):
+        """Start FakeGDBServer.py with options and connect a process for a.out to it."""
+        log_path = os.path.join(os.getcwd(), self.testMethodName + '.log')
+        fakeserver = pexpect.spawn('./FakeGDBServer.py', [log_path] + list(options))
+        if self.TraceOn():
+            fakeserver.logfile_read = sys.stdout
+        def shutdown_fakeserver():
+            fakeserver.close()
+            if os.path.exists(log_path):
+                os.remove(log_path)
+        self.addTearDownHook(shutdown_fakeserver)
+
+        fakeserver.expect(r'Listening on localhost:(\d+)')
+        port = int(fakeserver.match.group(1))
+
+        # a.out only provides the types, the memory is FakeGDBServer.py's
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        listener = lldb.SBListener('fake gdb server listener')
+        error = lldb.SBError()
+        process = target.ConnectRemote(listener, 'connect://localhost:%d' % port, 'gdb-remote', error)
+        self.assertTrue(error.Success() and process, PROCESS_IS_VALID)
+
+        event = lldb.SBEvent()
+        listener.WaitForEvent(5, event)
+        self.assertTrue(process.GetState() == lldb.eStateStopped, PROCESS_STOPPED)
+        return (process, log_path)
+
+    def get_fake_ptrs(self, process):
+        """Get a value for the pointer array FakeGDBServer.py serves."""
+        target = process.GetTarget()
+        ptrs = target.FindGlobalVariables('g_point_ptrs', 1).GetValueAtIndex(0)
+        self.assertTrue(ptrs.IsValid(), "Found g_point_ptrs")
+        fake_ptrs = ptrs.CreateValueFromAddress('fake_ptrs', self.pointers_addr, ptrs.GetType())
+        self.assertTrue(fake_ptrs.IsValid(), "Created the value of the fake pointers")
+        return fake_ptrs
+
+    def check_pointees(self, process):
+        """Display the pointer array FakeGDBServer.py serves and check the pointees."""
+        # Displaying the array with its pointees prefetches what its
+        # pointers point to
+        self.expect("memory read --type point_ptrs_t --ptr-depth 1 0x%x" % self.pointers_addr,
+                    substrs = ['x = 1', 'y = 40'])
+
+        fake_ptrs = self.get_fake_ptrs(process)
+        for i in range(len(self.pointee_addrs)):
+            ptr = fake_ptrs.GetChildAtIndex(i)
+            self.assertTrue(ptr.GetValueAsUnsigned() == self.pointee_addrs[i], "fake_ptrs[%d] is right" % i)
+            pointee = ptr.Dereference()
+            self.assertTrue(pointee.GetChildMemberWithName('x').GetValueAsSigned() == i + 1,
+                            "fake_ptrs[%d]->x is right" % i)
+            self.assertTrue(pointee.GetChildMemberWithName('y').GetValueAsSigned() == (i + 1) * 10,
+                            "fake_ptrs[%d]->y is right" % i)
+
+    def check_fallback(self, option):
+        """Check that a malformed reply makes lldb read each range on its own."""
+        (process, log_path) = self.connect_to_fake_server(option)
+
+        self.check_pointees(process)
+
+        process.Kill()
+        server_log = self.read_server_log(log_path)
+        self.assertTrue(re.search(self.multi_mem_read_pattern(), server_log, re.MULTILINE),
+                        "The pointees were requested with one qMultiMemRead packet")
+        self.assertTrue(self.read_separately(server_log),
+                        "The malformed reply was rejected and each pointee read on its own")
+
+    def multi_mem_read_pattern(self):
+        # Every pointee is in a cache line of its own
+        ranges = ';'.join('%x,([0-9a-f]+)' % addr for addr in self.pointee_addrs)
+        return '^qMultiMemRead:' + ranges + '$'
+
+    def read_separately(self, server_log):
+        for addr in self.pointee_addrs:
+            if not re.search(r'^[xm]%x,' % addr, server_log, re.MULTILINE):
+                return False
+        return True
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
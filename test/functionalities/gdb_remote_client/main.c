@@ -0,0 +1,31 @@
+#include <stdio.h>
+
+// Starts like a compressed gdb remote packet and repeats, so reading it
+// exercises both plain binary replies and compressed ones.
+unsigned char g_buffer[8192];
+
+// Gives the tests a type for an array of pointers to structures, whose
+// pointees are read with one multi-range read.
+struct point
+{
+    int x;
+    int y;
+};
+typedef struct point *point_ptrs_t[4];
+struct point g_points[4];
+point_ptrs_t g_point_ptrs;
+
+int main (int argc, char const *argv[])
+{
+    size_t i;
+    for (i = 0; i < sizeof(g_buffer); ++i)
+        g_buffer[i] = i < 4 ? "C0:}"[i] : 'a' + i % 7;
+    for (i = 0; i < 4; ++i)
+    {
+        g_points[i].x = i + 1;
+        g_points[i].y = (i + 1) * 10;
+        g_point_ptrs[i] = &g_points[i];
+    }
+    printf ("%c %d\n", g_buffer[0], g_point_ptrs[3]->y); // Set break point at this line.
+    return 0;
+}
@@ -3,6 +3,7 @@ Test that breakpoint by symbol name works correctly with dynamic libs.
 """
 
 import os, time
+import json
 import re
 import unittest2
 import lldb
@@ -180,6 +181,63 @@ class LoadUnloadTestCase(TestBase):
 
         self.runCmd("process continue")
 
+    def test_disassembly_cache_after_unload(self):
+        """Test that unloading a dylib drops the instructions cached for it."""
+
+        # Invoke the default build rule.
+        self.buildDefault()
+
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: file ='main.c', line = %d" %
+                        self.line)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        index = self.process_load("liba.dylib")
+
+        # The second disassembly is copied from the cache.
+        self.runCmd("disassemble -n a_function")
+        first = self.res.GetOutput()
+        self.runCmd("disassemble -n a_function")
+        self.assertTrue(self.res.GetOutput() == first, "Cached instructions print the same as decoded ones")
+        liba_stats = self.get_module_statistics("liba.dylib")
+        self.assertTrue(liba_stats["disassembly_cache_hits"] > 0)
+        hits_before_unload = liba_stats["disassembly_cache_hits"]
+
+        self.expect("process unload %s" % index, "liba.dylib unloaded correctly",
+            patterns = ["Unloading .* with index %s.*ok" % index])
+        self.assertTrue(self.get_module_statistics("liba.dylib") is None)
+
+        # After loading the dylib again its code has to be decoded again.
+        self.process_load("liba.dylib")
+        self.runCmd("disassemble -n a_function")
+        self.assertTrue('a_function' in self.res.GetOutput())
+        liba_stats = self.get_module_statistics("liba.dylib")
+        self.assertTrue(liba_stats["disassembly_cache_hits"] <= hits_before_unload,
+                        "The instructions cached before the unload were dropped")
+
+        self.runCmd("process kill")
+
+    def process_load(self, dylib_name):
+        """Load dylib_name with 'process load' and return its image index."""
+        self.expect("process load %s" % dylib_name, "%s loaded correctly" % dylib_name,
+            patterns = ['Loading "%s".*ok' % dylib_name,
+                        'Image [0-9]+ loaded'])
+        return re.search("Image ([0-9]+) loaded", self.res.GetOutput()).group(1)
+
+    def get_module_statistics(self, name):
+        """Return the statistics of the loaded module called name, or None."""
+        self.runCmd("statistics dump")
+        stats = json.loads(self.res.GetOutput())
+        matches = [m for m in stats["modules"] if m["path"].endswith(name)]
+        if len(matches) == 0:
+            return None
+        return matches[0]
+
     def test_load_unload(self):
         """Test breakpoint by name works correctly with dlopen'ing."""
 
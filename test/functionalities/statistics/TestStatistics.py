@@ -0,0 +1,107 @@
+"""
+Test the 'statistics dump' command and SBTarget.GetStatistics().
+"""
+
+import os, time
+import json
+import unittest2
+import lldb
+from lldbtest import *
+
+class StatisticsTestCase(TestBase):
+
+    mydir = os.path.join("functionalities", "statistics")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_statistics_with_dsym(self):
+        """Test that statistics are reported as JSON for the target, process and modules."""
+        self.buildDsym()
+        self.statistics_command()
+
+    @dwarf_test
+    def test_statistics_with_dwarf(self):
+        """Test that statistics are reported as JSON for the target, process and modules."""
+        self.buildDwarf()
+        self.statistics_command()
+
+    @python_api_test
+    @dwarf_test
+    def test_statistics_api_with_dwarf(self):
+        """Test that SBTarget.GetStatistics() returns JSON."""
+        self.buildDwarf()
+        self.statistics_api()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def get_statistics(self):
+        self.runCmd("statistics dump")
+        return json.loads(self.res.GetOutput())
+
+    def statistics_command(self):
+        """Test that statistics are reported as JSON for the target, process and modules."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        stats = self.get_statistics()
+        self.assertTrue(stats["process"] is None)
+        self.assertTrue(stats["target"]["expression_count"] == 0)
+        self.assertTrue(stats["target"]["executable"].endswith("a.out"))
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+            startstr = "Breakpoint created: 1: file ='main.c', line = %d, locations = 1" %
+                        self.line)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped', 'stop reason = breakpoint'])
+
+        self.expect("expression value", substrs = ['(int)'])
+
+        # 'argc' and 'value' have the same type, so the formatters found for
+        # the first are reused for the second.
+        self.expect("frame variable argc value", substrs = ['(int) argc', '(int) value'])
+
+        stats = self.get_statistics()
+        self.assertTrue(stats["target"]["expression_count"] == 1)
+        self.assertTrue(stats["target"]["expression_seconds"] > 0)
+        self.assertTrue(stats["process"]["stop_count"] > 0)
+        self.assertTrue(stats["process"]["memory_bytes_read"] > 0)
+        self.assertTrue(stats["formatter_cache_hits"] > 0)
+
+        # Setting a file and line breakpoint parsed the debug info of a.out.
+        exe_stats = [m for m in stats["modules"] if m["path"].endswith("a.out")]
+        self.assertTrue(len(exe_stats) == 1)
+        self.assertTrue(exe_stats[0]["num_symbols"] > 0)
+        self.assertTrue(exe_stats[0]["num_dies_parsed"] > 0)
+        self.assertTrue(exe_stats[0]["memory_used_bytes"] > 0)
+
+    def statistics_api(self):
+        """Test that SBTarget.GetStatistics() returns JSON."""
+        exe = os.path.join(os.getcwd(), "a.out")
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        stream = lldb.SBStream()
+        self.assertTrue(target.GetStatistics(stream))
+        stats = json.loads(stream.GetData())
+        self.assertTrue(stats["target"]["executable"].endswith("a.out"))
+        self.assertTrue(len(stats["modules"]) > 0)
+
+        # An invalid target has no statistics.
+        self.assertFalse(lldb.SBTarget().GetStatistics(lldb.SBStream()))
+
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
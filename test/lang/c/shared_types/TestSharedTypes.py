@@ -0,0 +1,67 @@
+"""Test that a type defined in both the executable and a shared library is only imported once by expressions."""
+
+import os, time
+import json
+import unittest2
+import lldb
+from lldbtest import *
+
+class SharedTypesTestCase(TestBase):
+
+    mydir = os.path.join("lang", "c", "shared_types")
+
+    @dsym_test
+    def test_expr_with_dsym(self):
+        """Test that identical types from two modules share one imported type"""
+        self.buildDsym()
+        self.expr()
+
+    @dwarf_test
+    def test_expr_with_dwarf(self):
+        """Test that identical types from two modules share one imported type"""
+        self.buildDwarf()
+        self.expr()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set breakpoint 0 here.')
+
+    def expr(self):
+        """Test that identical types from two modules share one imported type"""
+        exe = os.path.join(os.getcwd(), "a.out")
+        self.runCmd("file " + exe, CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.c -l %d" % self.line, BREAKPOINT_CREATED,
+            startstr = "Breakpoint created")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # The stop reason of the thread should be breakpoint.
+        self.expect("thread list", STOPPED_DUE_TO_BREAKPOINT,
+            substrs = ['stopped',
+                       'stop reason = breakpoint'])
+
+        # 'main_point' has the executable's struct point and 'lib_point'
+        # has the shared library's.
+        self.expect("expression -- main_point.x + lib_point.x",
+            startstr = "(int) $0 = 4")
+
+        self.runCmd("statistics dump")
+        stats = json.loads(self.res.GetOutput())
+        num_reused = stats["target"]["imported_types_reused"]
+        self.assertTrue(num_reused > 0)
+
+        # Copying the same types again doesn't count them again.
+        self.expect("expression -- main_point.y + lib_point.y",
+            startstr = "(int) $1 = ")
+        self.runCmd("statistics dump")
+        stats = json.loads(self.res.GetOutput())
+        self.assertTrue(stats["target"]["imported_types_reused"] == num_reused)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,13 @@
+#include <stdio.h>
+#include "point.h"
+
+int 
+main ()
+{
+  struct point main_point = { 1, 2 };
+  struct point *lib_point_ptr = GetLibPoint();
+  // Set breakpoint 0 here.
+  printf ("%d %d\n", main_point.x, lib_point_ptr->x);
+
+  return 0;
+}
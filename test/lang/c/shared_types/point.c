@@ -0,0 +1,9 @@
+#include "point.h"
+
+struct point lib_point = { 3, 4 };
+
+struct point *
+GetLibPoint ()
+{
+  return &lib_point;
+}
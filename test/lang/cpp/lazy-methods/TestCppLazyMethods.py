@@ -0,0 +1,73 @@
+"""
+Test that C++ methods which are left out when a class is completed are
+still available to expressions.
+"""
+
+import os, time
+import json
+import unittest2
+import lldb
+from lldbtest import *
+
+class CppLazyMethodsTestCase(TestBase):
+
+    mydir = os.path.join("lang", "cpp", "lazy-methods")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @dsym_test
+    def test_with_dsym_and_run_command(self):
+        """Test calling deferred C++ methods from expressions."""
+        self.buildDsym()
+        self.lazy_methods_commands()
+
+    @dwarf_test
+    def test_with_dwarf_and_run_command(self):
+        """Test calling deferred C++ methods from expressions."""
+        self.buildDwarf()
+        self.lazy_methods_commands()
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break inside main().
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def get_exe_statistics(self):
+        self.runCmd("statistics dump")
+        stats = json.loads(self.res.GetOutput())
+        exe_stats = [m for m in stats["modules"] if m["path"].endswith("a.out")]
+        self.assertTrue(len(exe_stats) == 1)
+        return exe_stats[0]
+
+    def lazy_methods_commands(self):
+        """Test calling deferred C++ methods from expressions."""
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        self.expect("breakpoint set -f main.cpp -l %d" % self.line,
+                    BREAKPOINT_CREATED,
+                    startstr = "Breakpoint created")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        # Showing the fields of the class doesn't need its methods.
+        self.expect("frame variable counter",
+            substrs = ['m_count = 11'])
+
+        exe_stats = self.get_exe_statistics()
+        self.assertTrue(exe_stats["num_methods_deferred"] > 0)
+        self.assertTrue(exe_stats["clang_ast_bytes"] > 0)
+
+        # Expressions get all the methods.
+        self.expect("expression -- counter.Get()",
+            startstr = "(int) $0 = 11")
+        self.expect("expression -- counter.Twice()",
+            startstr = "(int) $1 = 22")
+
+        exe_stats = self.get_exe_statistics()
+        self.assertTrue(exe_stats["num_methods_completed"] > 0)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
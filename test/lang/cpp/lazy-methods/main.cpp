@@ -0,0 +1,44 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+class Counter
+{
+public:
+    Counter (int start) : m_count (start) {}
+
+    int
+    Get () const
+    {
+        return m_count;
+    }
+
+    void
+    Add (int amount)
+    {
+        m_count += amount;
+    }
+
+    int
+    Twice () const
+    {
+        return 2 * m_count;
+    }
+
+private:
+    int m_count;
+};
+
+int
+main (int argc, char const *argv[])
+{
+    Counter counter (argc);
+    counter.Add (10);
+    int twice = counter.Twice ();
+    return counter.Get () + twice; // Set break point at this line.
+}
@@ -89,6 +89,56 @@ class LogTestCase(TestBase):
         if not success:
             self.fail (err_msg)
 
+    def test_async_binary_log (self):
+        """Test that async binary logs can be converted back to text with 'log decode'."""
+        log_file = os.path.join (os.getcwd(), "lldb-commands-binary-log.txt")
+
+        if (os.path.exists (log_file)):
+            os.remove (log_file)
+
+        self.runCmd ("log enable lldb commands --async --binary -f " + log_file)
+
+        self.runCmd ("command alias bp breakpoint")
+
+        self.runCmd ("log disable lldb")
+
+        self.assertTrue (os.path.isfile (log_file))
+
+        self.expect ("log decode " + log_file,
+                     substrs = [ "Processing command: command alias bp breakpoint",
+                                 "HandleCommand, revised_command_line: 'command alias bp breakpoint'",
+                                 "HandleCommand, command succeeded" ])
+        os.remove (log_file)
+
+    def test_async_log_streams_are_released (self):
+        """Test that async log files are closed when their log is disabled, so async logging keeps working."""
+        # Both Darwin and Linux list the open file descriptors in /dev/fd
+        num_open_files = len (os.listdir ("/dev/fd"))
+
+        # More than the 64 streams the log writer can have at the same time
+        for i in range (70):
+            log_file = os.path.join (os.getcwd(), "lldb-async-log-%d.txt" % i)
+            if (os.path.exists (log_file)):
+                os.remove (log_file)
+
+            self.runCmd ("log enable lldb commands --async -f " + log_file)
+            self.assertFalse ("Too many async logs" in self.res.GetError(),
+                              "Log %d is written asynchronously" % i)
+
+            self.runCmd ("command alias bp%d breakpoint" % i)
+
+            self.runCmd ("log disable lldb")
+
+            f = open (log_file)
+            log_contents = f.read()
+            f.close ()
+            os.remove (log_file)
+            self.assertTrue ("Processing command: command alias bp%d breakpoint" % i in log_contents,
+                             "Log %d was written out when it was disabled" % i)
+
+        self.assertTrue (len (os.listdir ("/dev/fd")) <= num_open_files,
+                         "The log files were closed")
+
 
 if __name__ == '__main__':
     import atexit
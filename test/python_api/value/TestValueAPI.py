@@ -68,10 +68,24 @@ class ValueAPITestCase(TestBase):
         self.assertTrue(days_of_week.GetNumChildren() == 7, VALID_VARIABLE)
         self.DebugSBValue(days_of_week)
 
+        # The count can be capped, a cap above the real count changes nothing.
+        self.assertTrue(days_of_week.GetNumChildren(3) == 3, VALID_VARIABLE)
+        self.assertTrue(days_of_week.GetNumChildren(7) == 7, VALID_VARIABLE)
+        self.assertTrue(days_of_week.GetNumChildren(100) == 7, VALID_VARIABLE)
+
+        # Children can also be fetched a page at a time.
+        page = days_of_week.GetChildrenInRange(5, 4)
+        self.assertTrue(page.GetSize() == 2, VALID_VARIABLE)
+        self.assertTrue(page.GetValueAtIndex(0).GetSummary() == '"Friday"', VALID_VARIABLE)
+
         # Get global variable 'weekdays'.
         list = target.FindGlobalVariables('weekdays', 1)
         weekdays = list.GetValueAtIndex(0)
         self.assertTrue(weekdays, VALID_VARIABLE)
+        # A capped count before the children were ever counted must not
+        # be remembered as the real count.
+        self.assertTrue(weekdays.GetNumChildren(2) == 2, VALID_VARIABLE)
+        self.assertTrue(weekdays.GetNumChildren(10) == 5, VALID_VARIABLE)
         self.assertTrue(weekdays.GetNumChildren() == 5, VALID_VARIABLE)
         self.DebugSBValue(weekdays)
 
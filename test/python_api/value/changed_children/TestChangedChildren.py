@@ -0,0 +1,89 @@
+"""
+Test SBValue.GetChangedChildren() after stepping over a store to one member.
+"""
+
+import os, time
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class ChangedChildrenAPITestCase(TestBase):
+
+    mydir = os.path.join("python_api", "value", "changed_children")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    @dsym_test
+    def test_changed_children_with_dsym(self):
+        """Exercise the SBValue::GetChangedChildren API."""
+        d = {'EXE': self.exe_name}
+        self.buildDsym(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.changed_children_api(self.exe_name)
+
+    @python_api_test
+    @dwarf_test
+    def test_changed_children_with_dwarf(self):
+        """Exercise the SBValue::GetChangedChildren API."""
+        d = {'EXE': self.exe_name}
+        self.buildDwarf(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.changed_children_api(self.exe_name)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # We'll use the test method name as the exe_name.
+        self.exe_name = self.testMethodName
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def changed_children_api(self, exe_name):
+        """Check that only the member that was stored to is reported as changed."""
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, os.getcwd())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread != None, "There should be a thread stopped due to breakpoint")
+        frame0 = thread.GetFrameAtIndex(0)
+
+        pt = frame0.FindVariable("pt")
+        self.assertTrue(pt.IsValid(), "Got the SBValue for pt")
+        # Fetch the children and their values so that they are checked
+        # after the step.
+        for i in range(pt.GetNumChildren()):
+            self.assertTrue(pt.GetChildAtIndex(i).IsValid())
+            self.assertTrue(pt.GetChildAtIndex(i).GetValue() != None)
+        self.assertTrue(pt.GetChildMemberWithName('y').GetValue() == '2', "pt.y starts out as 2")
+
+        thread.StepOver()
+
+        # The value strings must be formatted from the new bytes, not
+        # reused from before the step.
+        self.assertTrue(pt.GetChildMemberWithName('y').GetValue() == '20', "pt.y displays its new value")
+        self.assertTrue(pt.GetChildMemberWithName('y').GetValueDidChange(), "pt.y is marked as changed")
+        self.assertTrue(pt.GetChildMemberWithName('x').GetValue() == '1', "pt.x still displays 1")
+        self.assertFalse(pt.GetChildMemberWithName('x').GetValueDidChange(), "pt.x is not marked as changed")
+        self.expect("frame variable pt.y", VARIABLES_DISPLAYED_CORRECTLY,
+            substrs = ['20'])
+
+        changed = pt.GetChangedChildren()
+        self.assertTrue(changed.GetSize() == 1, "Exactly one child of pt changed")
+        self.assertTrue(changed.GetValueAtIndex(0).GetName() == 'y', "The changed child is pt.y")
+        self.assertTrue(changed.GetValueAtIndex(0).GetValueAsSigned() == 20, "pt.y has its new value")
+
+        process.Kill()
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,18 @@
+#include <stdio.h>
+
+struct point
+{
+    int x;
+    int y;
+    int z;
+};
+
+int main (int argc, char const *argv[])
+{
+    struct point pt = { 1, 2, 3 };
+    int counter = 0;
+    pt.y = 20; // Set break point at this line.
+    counter++;
+    printf ("%d %d %d %d\n", pt.x, pt.y, pt.z, counter);
+    return 0;
+}
@@ -0,0 +1,112 @@
+"""
+Test that the members of a pointer fetched as a range, which share one
+memory read, have the same values as memory read directly.
+"""
+
+import os, time
+import struct
+import unittest2
+import lldb, lldbutil
+from lldbtest import *
+
+class PointeeChildrenAPITestCase(TestBase):
+
+    mydir = os.path.join("python_api", "value", "pointee_children")
+
+    @unittest2.skipUnless(sys.platform.startswith("darwin"), "requires Darwin")
+    @python_api_test
+    @dsym_test
+    def test_pointee_children_with_dsym(self):
+        """Test the members of a pointer displayed as a range."""
+        d = {'EXE': self.exe_name}
+        self.buildDsym(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.pointee_children(self.exe_name)
+
+    @python_api_test
+    @dwarf_test
+    def test_pointee_children_with_dwarf(self):
+        """Test the members of a pointer displayed as a range."""
+        d = {'EXE': self.exe_name}
+        self.buildDwarf(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        self.pointee_children(self.exe_name)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # We'll use the test method name as the exe_name.
+        self.exe_name = self.testMethodName
+        # Find the line number to break inside main().
+        self.line = line_number('main.c', '// Set break point at this line.')
+
+    def pointee_children(self, exe_name):
+        """Compare the members of a pointer fetched as a range with direct reads."""
+        exe = os.path.join(os.getcwd(), exe_name)
+
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        breakpoint = target.BreakpointCreateByLocation('main.c', self.line)
+        self.assertTrue(breakpoint, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(None, None, os.getcwd())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        thread = lldbutil.get_stopped_thread(process, lldb.eStopReasonBreakpoint)
+        self.assertTrue(thread != None, "There should be a thread stopped due to breakpoint")
+        frame0 = thread.GetFrameAtIndex(0)
+
+        # This is how you clean up after the test, so the summaries don't
+        # leak into other tests.
+        def cleanup():
+            self.runCmd('type summary clear', check=False)
+        self.addTearDownHook(cleanup)
+
+        # Fetching a range of members reads their memory once
+        self.runCmd("type summary add --summary-string \"${var[0-7].y}\" \"point *\"")
+        self.expect("frame variable points",
+            substrs = ['[0,1,4,9,16,25,36,49]'])
+
+        points = frame0.FindVariable('points')
+        self.assertTrue(points.IsValid(), "Got the SBValue for points")
+        self.check_members(process, points, 8)
+
+        # A range that doesn't start at the pointer itself
+        self.runCmd("type summary add --summary-string \"${var[2-4].x}\" \"point *\"")
+        self.expect("frame variable points",
+            substrs = ['[2,3,4]'])
+
+        # The members must not keep data from before the step
+        thread.StepOver()
+        self.runCmd("type summary add --summary-string \"${var[0-7].y}\" \"point *\"")
+        self.expect("frame variable points",
+            substrs = ['[0,1,4,100,16,25,36,49]'])
+        self.check_members(process, frame0.FindVariable('points'), 8)
+
+        process.Kill()
+
+    def check_members(self, process, points, count):
+        """Check members [0, count) of points against the memory they live in."""
+        if process.GetByteOrder() == lldb.eByteOrderLittle:
+            layout = '<ii'
+        else:
+            layout = '>ii'
+        base = points.GetValueAsUnsigned()
+        error = lldb.SBError()
+        data = process.ReadMemory(base, count * 8, error)
+        self.assertTrue(error.Success(), "Read the memory points points to")
+        for i in range(count):
+            (x, y) = struct.unpack(layout, data[i * 8:(i + 1) * 8])
+            member = points.GetChildAtIndex(i, lldb.eNoDynamicValues, True)
+            self.assertTrue(member.IsValid(), "Got member %d of points" % i)
+            self.assertTrue(member.GetChildMemberWithName('x').GetValueAsSigned() == x,
+                            "points[%d].x matches memory" % i)
+            self.assertTrue(member.GetChildMemberWithName('y').GetValueAsSigned() == y,
+                            "points[%d].y matches memory" % i)
+
+if __name__ == '__main__':
+    import atexit
+    lldb.SBDebugger.Initialize()
+    atexit.register(lambda: lldb.SBDebugger.Terminate())
+    unittest2.main()
@@ -0,0 +1,20 @@
+#include <stdio.h>
+
+typedef struct point
+{
+    int x;
+    int y;
+} point;
+
+point g_points[8] = {
+    { 0, 0 }, { 1, 1 }, { 2, 4 }, { 3, 9 },
+    { 4, 16 }, { 5, 25 }, { 6, 36 }, { 7, 49 }
+};
+
+int main (int argc, char const *argv[])
+{
+    point *points = g_points;
+    points[3].y = 100; // Set break point at this line.
+    printf ("%d\n", points[3].y);
+    return 0;
+}
@@ -26,6 +26,7 @@
 #include "RNBContext.h"
 #include "RNBServices.h"
 #include "RNBSocket.h"
+#include "Utility/PacketCompression.h"
 #include "Utility/StringExtractor.h"
 
 #include <iomanip>
@@ -76,6 +77,7 @@ RNBRemote::RNBRemote () :
     m_max_payload_size(DEFAULT_GDB_REMOTE_PROTOCOL_BUFSIZE - 4),
     m_extended_mode(false),
     m_noack_mode(false),
+    m_compression_min_size(0),
     m_use_native_regs (false),
     m_thread_suffix_supported (false),
     m_list_threads_in_stop_reply (false)
@@ -115,6 +117,7 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (ack,                           NULL,                                   NULL, "+", "ACK"));
     t.push_back (Packet (nack,                          NULL,                                   NULL, "-", "!ACK"));
     t.push_back (Packet (read_memory,                   &RNBRemote::HandlePacket_m,             NULL, "m", "Read memory"));
+    t.push_back (Packet (read_memory_binary,            &RNBRemote::HandlePacket_x,             NULL, "x", "Read memory and return binary data"));
     t.push_back (Packet (read_register,                 &RNBRemote::HandlePacket_p,             NULL, "p", "Read one register"));
     t.push_back (Packet (read_general_regs,             &RNBRemote::HandlePacket_g,             NULL, "g", "Read registers"));
     t.push_back (Packet (write_memory,                  &RNBRemote::HandlePacket_M,             NULL, "M", "Write memory"));
@@ -144,8 +147,7 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (vattachname,                   &RNBRemote::HandlePacket_v,             NULL, "vAttachName", "Attach to an existing process by name"));
     t.push_back (Packet (vcont_list_actions,            &RNBRemote::HandlePacket_v,             NULL, "vCont;", "Verbose resume with thread actions"));
     t.push_back (Packet (vcont_list_actions,            &RNBRemote::HandlePacket_v,             NULL, "vCont?", "List valid continue-with-thread-actions actions"));
-    // The X packet doesn't currently work. If/when it does, remove the line above and uncomment out the line below
-//  t.push_back (Packet (write_data_to_memory,          &RNBRemote::HandlePacket_X,             NULL, "X", "Write data to memory"));
+    t.push_back (Packet (write_data_to_memory,          &RNBRemote::HandlePacket_X,             NULL, "X", "Write data to memory"));
 //  t.push_back (Packet (insert_hardware_bp,            &RNBRemote::HandlePacket_UNIMPLEMENTED, NULL, "Z1", "Insert hardware breakpoint"));
 //  t.push_back (Packet (remove_hardware_bp,            &RNBRemote::HandlePacket_UNIMPLEMENTED, NULL, "z1", "Remove hardware breakpoint"));
     t.push_back (Packet (insert_write_watch_bp,         &RNBRemote::HandlePacket_z,             NULL, "Z2", "Insert write watchpoint"));
@@ -172,6 +174,7 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (query_host_info,               &RNBRemote::HandlePacket_qHostInfo,     NULL, "qHostInfo", "Replies with multiple 'key:value;' tuples appended to each other."));
 //  t.push_back (Packet (query_symbol_lookup,           &RNBRemote::HandlePacket_UNIMPLEMENTED, NULL, "qSymbol", "Notify that host debugger is ready to do symbol lookups"));
     t.push_back (Packet (start_noack_mode,              &RNBRemote::HandlePacket_QStartNoAckMode        , NULL, "QStartNoAckMode", "Request that " DEBUGSERVER_PROGRAM_NAME " stop acking remote protocol packets"));
+    t.push_back (Packet (enable_compression,            &RNBRemote::HandlePacket_QEnableCompression     , NULL, "QEnableCompression:", "Request that " DEBUGSERVER_PROGRAM_NAME " compress replies that are at least 'minsize' bytes long"));
     t.push_back (Packet (prefix_reg_packets_with_tid,   &RNBRemote::HandlePacket_QThreadSuffixSupported , NULL, "QThreadSuffixSupported", "Check if thread specifc packets (register packets 'g', 'G', 'p', and 'P') support having the thread ID appended to the end of the command"));
     t.push_back (Packet (set_logging_mode,              &RNBRemote::HandlePacket_QSetLogging            , NULL, "QSetLogging:", "Check if register packets ('g', 'G', 'p', and 'P' support having the thread ID prefix"));
     t.push_back (Packet (set_max_packet_size,           &RNBRemote::HandlePacket_QSetMaxPacketSize      , NULL, "QSetMaxPacketSize:", "Tell " DEBUGSERVER_PROGRAM_NAME " the max sized packet gdb can handle"));
@@ -190,6 +193,8 @@ RNBRemote::CreatePacketTable  ()
     t.push_back (Packet (deallocate_memory,             &RNBRemote::HandlePacket_DeallocateMemory, NULL, "_m", "Deallocate memory in the inferior process."));
     t.push_back (Packet (memory_region_info,            &RNBRemote::HandlePacket_MemoryRegionInfo, NULL, "qMemoryRegionInfo", "Return size and attributes of a memory region that contains the given address"));
     t.push_back (Packet (watchpoint_support_info,       &RNBRemote::HandlePacket_WatchpointSupportInfo, NULL, "qWatchpointSupportInfo", "Return the number of supported hardware watchpoints"));
+    t.push_back (Packet (read_memory_multi,             &RNBRemote::HandlePacket_qMultiMemRead, NULL, "qMultiMemRead:", "Read several ranges of memory and return binary data"));
+    t.push_back (Packet (breakpoint_multi,              &RNBRemote::HandlePacket_qMultiBreakpoint, NULL, "qMultiBreakpoint:", "Insert and remove several software breakpoints"));
 
 }
 
@@ -259,8 +264,17 @@ RNBRemote::SendSTDERRPacket (char *buf, nub_size_t buf_size)
 }
 
 rnb_err_t
-RNBRemote::SendPacket (const std::string &s)
+RNBRemote::SendPacket (const std::string &payload)
 {
+    // Once the debugger asked for compression every payload gets a prefix
+    // saying whether it is compressed, and large payloads are compressed
+    std::string framed;
+    if (m_compression_min_size > 0)
+    {
+        if (payload.size() < m_compression_min_size || !CompressPayload (payload, framed))
+            framed = "N" + payload;
+    }
+    const std::string &s = m_compression_min_size > 0 ? framed : payload;
     DNBLogThreadedIf (LOG_RNB_MAX, "%8d RNBRemote::%s (%s) called", (uint32_t)m_comm.Timer().ElapsedMicroSeconds(true), __FUNCTION__, s.c_str());
     std::string sendpacket = "$" + s + "#";
     int cksum = 0;
@@ -767,18 +781,59 @@ decode_binary_data (const char *str, int len)
 
     while (len--)
     {
-        unsigned char c = *str;
+        unsigned char c = *str++;
         if (c == 0x7d && len > 0)
         {
             len--;
-            str++;
-            c ^= 0x20;
+            c = *str++ ^ 0x20;
         }
         bytes.push_back (c);
     }
     return bytes;
 }
 
+/* Append LEN bytes from BUF to OSTRM using the GDB Remote Protocol binary
+ encoding. Besides '}', '#' and '$', the run length encoding character
+ '*' is escaped so the packet can't be mistaken for a compressed one,
+ and so is the NUL character so that the packet data can be handled as
+ a C string by the other end.  */
+
+void
+append_binary_data (std::ostringstream &ostrm, const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        const uint8_t byte = buf[i];
+        if (byte == 0x7d || byte == '#' || byte == '$' || byte == '*' || byte == '\0')
+        {
+            ostrm << (char) 0x7d;
+            ostrm << (char) (byte ^ 0x20);
+        }
+        else
+        {
+            ostrm << (char) byte;
+        }
+    }
+}
+
+bool
+RNBRemote::CompressPayload (const std::string &payload, std::string &compressed)
+{
+    std::string compressed_data;
+    if (!PacketCompression::Compress ((const uint8_t *)payload.data(), payload.size(), compressed_data))
+        return false;
+
+    std::ostringstream ostrm;
+    ostrm << 'C' << std::hex << payload.size() << ':';
+    append_binary_data (ostrm, (const uint8_t *)compressed_data.data(), compressed_data.size());
+    // Escaping can eat up what compression saved
+    if (ostrm.str().size() >= payload.size())
+        return false;
+    compressed = ostrm.str();
+    DNBLogThreadedIf (LOG_RNB_PACKETS, "compressed packet payload from %zu to %zu bytes", payload.size(), compressed.size());
+    return true;
+}
+
 typedef struct register_map_entry
 {
     uint32_t        gdb_regnum; // gdb register number
@@ -1770,6 +1825,29 @@ RNBRemote::HandlePacket_QStartNoAckMode (const char *p)
     return result;
 }
 
+/* 'QEnableCompression:minsize:<decimal>;'
+ Compress all replies that are at least minsize bytes long with
+ PacketCompression. From then on every reply starts with a prefix:
+ compressed replies look like
+ 'C<uncompressed length in hex>:<binary encoded compressed data>' and
+ all others are sent as 'N<reply>'.  */
+
+rnb_err_t
+RNBRemote::HandlePacket_QEnableCompression (const char *p)
+{
+    const char *min_size_str = strstr (p, "minsize:");
+    if (min_size_str == NULL)
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Missing minsize in QEnableCompression packet");
+    uint32_t min_size = strtoul (min_size_str + strlen ("minsize:"), NULL, 10);
+    if (min_size == 0)
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid minsize in QEnableCompression packet");
+
+    // Send the OK packet before turning compression on
+    rnb_err_t result = SendPacket ("OK");
+    m_compression_min_size = min_size;
+    return result;
+}
+
 
 rnb_err_t
 RNBRemote::HandlePacket_QSetLogging (const char *p)
@@ -2400,6 +2478,59 @@ RNBRemote::HandlePacket_m (const char *p)
     return SendPacket (ostrm.str ());
 }
 
+/* 'x' -- read memory and send the bytes back binary encoded rather than
+ as hex, which halves the size of the reply.  A zero length read is
+ answered with "OK" so that the debugger can find out whether this
+ packet is supported.  */
+
+rnb_err_t
+RNBRemote::HandlePacket_x (const char *p)
+{
+    if (p == NULL || p[0] == '\0' || strlen (p) < 3)
+    {
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Too short x packet");
+    }
+
+    char *c;
+    p++;
+    errno = 0;
+    nub_addr_t addr = strtoull (p, &c, 16);
+    if (errno != 0 && addr == 0)
+    {
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid address in x packet");
+    }
+    if (*c != ',')
+    {
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Comma sep missing in x packet");
+    }
+
+    /* Advance 'p' to the length part of the packet.  */
+    p += (c - p) + 1;
+
+    errno = 0;
+    uint32_t length = strtoul (p, NULL, 16);
+    if (errno != 0 && length == 0)
+    {
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in x packet");
+    }
+    if (length == 0)
+    {
+        return SendPacket ("OK");
+    }
+
+    std::vector<uint8_t> buf (length);
+    int bytes_read = DNBProcessMemoryRead (m_ctx.ProcessID(), addr, length, &buf[0]);
+    if (bytes_read == 0)
+    {
+        return SendPacket ("E08");
+    }
+
+    // As with the 'm' packet, the reply may contain fewer bytes than requested
+    std::ostringstream ostrm;
+    append_binary_data (ostrm, &buf[0], bytes_read);
+    return SendPacket (ostrm.str ());
+}
+
 rnb_err_t
 RNBRemote::HandlePacket_X (const char *p)
 {
@@ -2425,31 +2556,35 @@ RNBRemote::HandlePacket_X (const char *p)
     p += (c - p) + 1;
 
     errno = 0;
-    int length = strtoul (p, NULL, 16);
+    uint32_t length = strtoul (p, &c, 16);
     if (errno != 0 && length == 0)
     {
-        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in m packet");
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in X packet");
+    }
+    if (*c != ':')
+    {
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Missing colon in X packet");
     }
 
-    // I think gdb sends a zero length write request to test whether this
+    // gdb and lldb send a zero length write request to test whether this
     // packet is accepted.
     if (length == 0)
     {
         return SendPacket ("OK");
     }
 
-    std::vector<uint8_t> data = decode_binary_data (c, -1);
-    std::vector<uint8_t>::const_iterator it;
-    uint8_t *buf = (uint8_t *) alloca (data.size ());
-    uint8_t *i = buf;
-    for (it = data.begin (); it != data.end (); ++it)
+    /* Advance 'p' to the data part of the packet.  */
+    p += (c - p) + 1;
+
+    std::vector<uint8_t> data = decode_binary_data (p, -1);
+    if (data.size () != length)
     {
-        *i++ = *it;
+        return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Data length doesn't match the length in X packet");
     }
 
-    nub_size_t wrote = DNBProcessMemoryWrite (m_ctx.ProcessID(), addr, data.size(), buf);
+    nub_size_t wrote = DNBProcessMemoryWrite (m_ctx.ProcessID(), addr, data.size(), &data[0]);
     if (wrote != data.size ())
-        return SendPacket ("E08");
+        return SendPacket ("E09");
     return SendPacket ("OK");
 }
 
@@ -3390,6 +3525,154 @@ RNBRemote::HandlePacket_WatchpointSupportInfo (const char *p)
     return SendPacket (ostrm.str());
 }
 
+rnb_err_t
+RNBRemote::HandlePacket_qMultiMemRead (const char *p)
+{
+    /* Read several ranges of memory with one packet. The reply has the
+       number of bytes read from each range followed by the bytes of all
+       ranges as binary data.
+
+       Examples of use:
+          qMultiMemRead:1000,4;2000,8
+          4,0;<4 bytes of binary data>
+
+          qMultiMemRead:
+          OK                   // this packet is implemented by the remote nub
+    */
+
+    p += sizeof ("qMultiMemRead:") - 1;
+    if (*p == '\0')
+        return SendPacket ("OK");
+
+    const nub_process_t pid = m_ctx.ProcessID();
+    std::ostringstream lengths;
+    std::ostringstream data;
+    std::vector<uint8_t> buf;
+    for (uint32_t range_idx = 0; *p; ++range_idx)
+    {
+        char *c;
+        errno = 0;
+        nub_addr_t addr = strtoull (p, &c, 16);
+        if (errno != 0 && addr == 0)
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid address in qMultiMemRead packet");
+        if (*c != ',')
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Comma sep missing in qMultiMemRead packet");
+        p = c + 1;
+
+        errno = 0;
+        uint32_t length = strtoul (p, &c, 16);
+        if (errno != 0 && length == 0)
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in qMultiMemRead packet");
+        if (*c != ';' && *c != '\0')
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Semicolon sep missing in qMultiMemRead packet");
+        p = *c ? c + 1 : c;
+
+        int bytes_read = 0;
+        if (length > 0)
+        {
+            buf.resize (length);
+            bytes_read = DNBProcessMemoryRead (pid, addr, length, &buf[0]);
+        }
+        if (range_idx > 0)
+            lengths << ',';
+        lengths << std::hex << bytes_read;
+        if (bytes_read > 0)
+            append_binary_data (data, &buf[0], bytes_read);
+    }
+    lengths << ';' << data.str();
+    return SendPacket (lengths.str ());
+}
+
+rnb_err_t
+RNBRemote::HandlePacket_qMultiBreakpoint (const char *p)
+{
+    /* Insert and remove several software breakpoints with one packet.
+       Each entry is handled like a "Z0" or "z0" packet, and the reply
+       has the result of each entry in order.
+
+       Examples of use:
+          qMultiBreakpoint:Z1000,1;Z2000,1;z3000,1
+          OK;OK;E08
+
+          qMultiBreakpoint:
+          OK                   // this packet is implemented by the remote nub
+    */
+
+    p += sizeof ("qMultiBreakpoint:") - 1;
+    if (*p == '\0')
+        return SendPacket ("OK");
+
+    if (!m_ctx.HasValidProcessID())
+        return SendPacket ("E15");
+
+    const nub_process_t pid = m_ctx.ProcessID();
+    std::ostringstream results;
+    for (uint32_t entry_idx = 0; *p; ++entry_idx)
+    {
+        const char packet_cmd = *p++;
+        if (packet_cmd != 'Z' && packet_cmd != 'z')
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid command in qMultiBreakpoint packet");
+
+        char *c;
+        errno = 0;
+        nub_addr_t addr = strtoull (p, &c, 16);
+        if (errno != 0 && addr == 0)
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid address in qMultiBreakpoint packet");
+        if (*c != ',')
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Comma sep missing in qMultiBreakpoint packet");
+        p = c + 1;
+
+        errno = 0;
+        uint32_t byte_size = strtoul (p, &c, 16);
+        if (errno != 0 && byte_size == 0)
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Invalid length in qMultiBreakpoint packet");
+        if (*c != ';' && *c != '\0')
+            return HandlePacket_ILLFORMED (__FILE__, __LINE__, p, "Semicolon sep missing in qMultiBreakpoint packet");
+        p = *c ? c + 1 : c;
+
+        const char *result = "OK";
+        BreakpointMapIter pos = m_breakpoints.find(addr);
+        if (packet_cmd == 'Z')
+        {
+            // Breakpoints are ref counted just like with the Z0 packet
+            if (pos != m_breakpoints.end())
+            {
+                pos->second.Retain();
+            }
+            else
+            {
+                nub_break_t break_id = DNBBreakpointSet (pid, addr, byte_size, false);
+                if (NUB_BREAK_ID_IS_VALID(break_id))
+                    m_breakpoints[addr] = Breakpoint(break_id);
+                else
+                    result = "E09";
+            }
+        }
+        else
+        {
+            if (pos == m_breakpoints.end())
+            {
+                result = "E08";
+            }
+            else
+            {
+                pos->second.Release();
+                if (pos->second.RefCount() == 0)
+                {
+                    if (DNBBreakpointClear (pid, pos->second.BreakID()))
+                        m_breakpoints.erase(pos);
+                    else
+                        result = "E08";
+                }
+            }
+        }
+        if (entry_idx > 0)
+            results << ';';
+        results << result;
+    }
+    return SendPacket (results.str ());
+}
+
 /* 'C sig [;addr]'
  Resume with signal sig, optionally at address addr.  */
 
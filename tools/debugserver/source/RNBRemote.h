@@ -53,6 +53,7 @@ public:
         signal_and_step_inf_one_cycle,  // 'I'
         kill,                           // 'k'
         read_memory,                    // 'm'
+        read_memory_binary,             // 'x'
         write_memory,                   // 'M'
         read_register,                  // 'p'
         write_register,                 // 'P'
@@ -94,6 +95,7 @@ public:
         query_host_info,                // 'qHostInfo'
         pass_signals_to_inferior,       // 'QPassSignals'
         start_noack_mode,               // 'QStartNoAckMode'
+        enable_compression,             // 'QEnableCompression:'
         prefix_reg_packets_with_tid,    // 'QPrefixRegisterPacketsWithThreadID
         set_logging_mode,               // 'QSetLogging:'
         set_max_packet_size,            // 'QSetMaxPacketSize:'
@@ -109,6 +111,8 @@ public:
         set_list_threads_in_stop_reply, // 'QListThreadsInStopReply:'
         memory_region_info,             // 'qMemoryRegionInfo:'
         watchpoint_support_info,        // 'qWatchpointSupportInfo:'
+        read_memory_multi,              // 'qMultiMemRead:'
+        breakpoint_multi,               // 'qMultiBreakpoint:'
         allocate_memory,                // '_M'
         deallocate_memory,              // '_m'
 
@@ -169,6 +173,7 @@ public:
     rnb_err_t HandlePacket_qThreadStopInfo (const char *p);
     rnb_err_t HandlePacket_qHostInfo (const char *p);
     rnb_err_t HandlePacket_QStartNoAckMode (const char *p);
+    rnb_err_t HandlePacket_QEnableCompression (const char *p);
     rnb_err_t HandlePacket_QThreadSuffixSupported (const char *p);
     rnb_err_t HandlePacket_QSetLogging (const char *p);
     rnb_err_t HandlePacket_QSetDisableASLR (const char *p);
@@ -184,6 +189,7 @@ public:
     rnb_err_t HandlePacket_last_signal (const char *p);
     rnb_err_t HandlePacket_m (const char *p);
     rnb_err_t HandlePacket_M (const char *p);
+    rnb_err_t HandlePacket_x (const char *p);
     rnb_err_t HandlePacket_X (const char *p);
     rnb_err_t HandlePacket_g (const char *p);
     rnb_err_t HandlePacket_G (const char *p);
@@ -204,6 +210,8 @@ public:
     rnb_err_t HandlePacket_DeallocateMemory (const char *p);
     rnb_err_t HandlePacket_MemoryRegionInfo (const char *p);
     rnb_err_t HandlePacket_WatchpointSupportInfo (const char *p);
+    rnb_err_t HandlePacket_qMultiMemRead (const char *p);
+    rnb_err_t HandlePacket_qMultiBreakpoint (const char *p);
 
     rnb_err_t HandlePacket_stop_process (const char *p);
 
@@ -278,6 +286,7 @@ protected:
 
     rnb_err_t       GetPacket (std::string &packet_data, RNBRemote::Packet& packet_info, bool wait);
     rnb_err_t       SendPacket (const std::string &);
+    bool            CompressPayload (const std::string &payload, std::string &compressed);
 
     void CreatePacketTable ();
     rnb_err_t GetPacketPayload (std::string &);
@@ -334,6 +343,7 @@ protected:
     uint32_t        m_max_payload_size;  // the maximum sized payload we should send to gdb
     bool            m_extended_mode;   // are we in extended mode?
     bool            m_noack_mode;      // are we in no-ack mode?
+    uint32_t        m_compression_min_size; // compress payloads at least this long, zero if compression is off
     bool            m_use_native_regs; // Use native registers by querying DNB layer for register definitions?
     bool            m_thread_suffix_supported; // Set to true if the 'p', 'P', 'g', and 'G' packets should be prefixed with the thread ID and colon:
                                                                 // "$pRR;thread:TTTT;" instead of "$pRR"
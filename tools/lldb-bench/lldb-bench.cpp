@@ -0,0 +1,477 @@
+//===-- lldb-bench.cpp ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// C Includes
+#include <errno.h>
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+// C++ Includes
+#include <string>
+#include <vector>
+
+// Other libraries and framework includes
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/ConstString.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/Statistics.h"
+#include "lldb/Core/StreamString.h"
+#include "lldb/Host/FileSpec.h"
+#include "lldb/Host/TimeValue.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/SymbolVendor.h"
+#include "lldb/Symbol/Symtab.h"
+#include "lldb/Symbol/TypeList.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+//----------------------------------------------------------------------
+// lldb-bench loads one or more binaries into lldb_private::Module
+// objects without creating a process and times each of the phases that
+// make up symbol loading and lookup. The results are written as JSON so
+// that they can be collected by a regression tracking system.
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// option descriptors for getopt_long()
+//----------------------------------------------------------------------
+
+static struct option g_long_options[] =
+{
+    { "arch",               required_argument,  NULL,               'a' },
+    { "function",           required_argument,  NULL,               'n' },
+    { "type",               required_argument,  NULL,               't' },
+    { "address",            required_argument,  NULL,               'A' },
+    { "symbolicate-count",  required_argument,  NULL,               'c' },
+    { "output",             required_argument,  NULL,               'o' },
+    { "help",               no_argument,        NULL,               'h' },
+    { NULL,                 0,                  NULL,               0   }
+};
+
+static void
+usage (const char *prog_name)
+{
+    fprintf (stderr,
+             "Usage: %s [options] <binary> [<binary> ...]\n"
+             "\n"
+             "  -a, --arch <triple>            Architecture to load from each binary.\n"
+             "  -n, --function <name>          Function name to look up (may be repeated).\n"
+             "  -t, --type <name>              Type name to look up (may be repeated).\n"
+             "  -A, --address <file-addr>      File address to symbolicate (may be repeated).\n"
+             "  -c, --symbolicate-count <n>    Number of code symbol addresses to symbolicate\n"
+             "                                 when no --address options are given (default 1000).\n"
+             "  -o, --output <path>            Write the JSON report to <path> instead of stdout.\n",
+             prog_name);
+}
+
+//----------------------------------------------------------------------
+// Simple stopwatch that reports elapsed nanoseconds using the same
+// clock as lldb_private::Timer.
+//----------------------------------------------------------------------
+class Stopwatch
+{
+public:
+    Stopwatch () :
+        m_start (TimeValue::Now())
+    {
+    }
+
+    uint64_t
+    GetElapsedNanoSeconds () const
+    {
+        return TimeValue::Now() - m_start;
+    }
+
+private:
+    TimeValue m_start;
+};
+
+struct PhaseTime
+{
+    PhaseTime (const char *n, uint64_t nsec) :
+        name (n),
+        elapsed_nsec (nsec)
+    {
+    }
+
+    const char *name;
+    uint64_t elapsed_nsec;
+};
+
+struct ModuleReport
+{
+    ModuleReport () :
+        path (),
+        arch (),
+        loaded (false),
+        num_symbols (0),
+        num_compile_units (0),
+        num_function_matches (0),
+        num_type_matches (0),
+        num_addresses (0),
+        num_addresses_resolved (0),
+        const_string_pool_delta (0),
+        phases ()
+    {
+    }
+
+    std::string path;
+    std::string arch;
+    bool loaded;
+    size_t num_symbols;
+    uint32_t num_compile_units;
+    uint32_t num_function_matches;
+    uint32_t num_type_matches;
+    uint32_t num_addresses;
+    uint32_t num_addresses_resolved;
+    int64_t const_string_pool_delta;
+    std::vector<PhaseTime> phases;
+};
+
+static uint64_t
+GetPeakResidentSetSize ()
+{
+    struct rusage usage;
+    if (::getrusage (RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined (__APPLE__)
+    // Darwin reports ru_maxrss in bytes
+    return usage.ru_maxrss;
+#else
+    // Linux and FreeBSD report ru_maxrss in kilobytes
+    return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+}
+
+static void
+BenchmarkModule (const char *path,
+                 const ArchSpec &arch,
+                 const std::vector<std::string> &function_names,
+                 const std::vector<std::string> &type_names,
+                 const std::vector<addr_t> &addresses,
+                 uint32_t symbolicate_count,
+                 ModuleReport &report)
+{
+    report.path = path;
+    const size_t pool_size_before = ConstString::StaticMemorySize();
+
+    FileSpec file_spec (path, true);
+    ModuleSP module_sp;
+    {
+        Stopwatch sw;
+        module_sp.reset (new Module (ModuleSpec (file_spec, arch)));
+        report.phases.push_back (PhaseTime ("module_create", sw.GetElapsedNanoSeconds()));
+    }
+
+    ObjectFile *objfile = NULL;
+    {
+        // Parses the object file header and section list (ObjectFileELF,
+        // ObjectFileMachO, ...)
+        Stopwatch sw;
+        objfile = module_sp->GetObjectFile();
+        if (objfile)
+            objfile->GetSectionList();
+        report.phases.push_back (PhaseTime ("object_file_parse", sw.GetElapsedNanoSeconds()));
+    }
+
+    if (objfile == NULL)
+        return;
+
+    report.loaded = true;
+    report.arch = module_sp->GetArchitecture().GetTriple().str();
+
+    Symtab *symtab = NULL;
+    {
+        Stopwatch sw;
+        symtab = objfile->GetSymtab();
+        report.phases.push_back (PhaseTime ("symtab_parse", sw.GetElapsedNanoSeconds()));
+    }
+
+    if (symtab)
+    {
+        report.num_symbols = symtab->GetNumSymbols();
+        {
+            // The first name lookup builds the symbol table name index
+            Stopwatch sw;
+            symtab->FindFirstSymbolWithNameAndType (ConstString ("__lldb_bench_no_such_symbol__"),
+                                                    eSymbolTypeAny,
+                                                    Symtab::eDebugAny,
+                                                    Symtab::eVisibilityAny);
+            report.phases.push_back (PhaseTime ("symtab_name_index", sw.GetElapsedNanoSeconds()));
+        }
+        {
+            // The first address lookup builds the symbol table address index
+            Stopwatch sw;
+            symtab->FindSymbolContainingFileAddress (LLDB_INVALID_ADDRESS);
+            report.phases.push_back (PhaseTime ("symtab_address_index", sw.GetElapsedNanoSeconds()));
+        }
+    }
+
+    SymbolVendor *symbols = NULL;
+    {
+        Stopwatch sw;
+        symbols = module_sp->GetSymbolVendor();
+        report.phases.push_back (PhaseTime ("symbol_vendor_create", sw.GetElapsedNanoSeconds()));
+    }
+
+    if (symbols)
+    {
+        report.num_compile_units = module_sp->GetNumCompileUnits();
+        {
+            // The first function lookup forces the symbol file to build its
+            // name indexes (SymbolFileDWARF::Index () when there are no
+            // accelerator tables), so time it separately from the real
+            // lookups below.
+            Stopwatch sw;
+            SymbolContextList sc_list;
+            module_sp->FindFunctions (ConstString ("__lldb_bench_no_such_function__"),
+                                      NULL,
+                                      eFunctionNameTypeAuto,
+                                      false,
+                                      false,
+                                      false,
+                                      sc_list);
+            report.phases.push_back (PhaseTime ("symbol_file_index", sw.GetElapsedNanoSeconds()));
+        }
+    }
+
+    if (!function_names.empty())
+    {
+        Stopwatch sw;
+        for (size_t i=0; i<function_names.size(); ++i)
+        {
+            SymbolContextList sc_list;
+            report.num_function_matches += module_sp->FindFunctions (ConstString (function_names[i].c_str()),
+                                                                     NULL,
+                                                                     eFunctionNameTypeAuto,
+                                                                     true,
+                                                                     true,
+                                                                     false,
+                                                                     sc_list);
+        }
+        report.phases.push_back (PhaseTime ("find_functions", sw.GetElapsedNanoSeconds()));
+    }
+
+    if (!type_names.empty())
+    {
+        Stopwatch sw;
+        SymbolContext sc;
+        for (size_t i=0; i<type_names.size(); ++i)
+        {
+            TypeList type_list;
+            report.num_type_matches += module_sp->FindTypes (sc,
+                                                             ConstString (type_names[i].c_str()),
+                                                             false,
+                                                             UINT32_MAX,
+                                                             type_list);
+        }
+        report.phases.push_back (PhaseTime ("find_types", sw.GetElapsedNanoSeconds()));
+    }
+
+    std::vector<addr_t> file_addrs (addresses);
+    if (file_addrs.empty() && symtab && symbolicate_count > 0)
+    {
+        // No explicit addresses were given, so pick the start addresses
+        // of the first code symbols in the symbol table.
+        const size_t num_symbols = symtab->GetNumSymbols();
+        for (size_t i=0; i<num_symbols && file_addrs.size() < symbolicate_count; ++i)
+        {
+            const Symbol *symbol = symtab->SymbolAtIndex(i);
+            if (symbol && symbol->GetType() == eSymbolTypeCode && symbol->ValueIsAddress())
+                file_addrs.push_back (symbol->GetAddress().GetFileAddress());
+        }
+    }
+
+    if (!file_addrs.empty())
+    {
+        Stopwatch sw;
+        for (size_t i=0; i<file_addrs.size(); ++i)
+        {
+            Address so_addr;
+            if (module_sp->ResolveFileAddress (file_addrs[i], so_addr))
+            {
+                SymbolContext sc;
+                const uint32_t resolve_scope = eSymbolContextFunction |
+                                               eSymbolContextBlock |
+                                               eSymbolContextLineEntry |
+                                               eSymbolContextSymbol;
+                if (module_sp->ResolveSymbolContextForAddress (so_addr, resolve_scope, sc) != 0)
+                    ++report.num_addresses_resolved;
+            }
+        }
+        report.num_addresses = file_addrs.size();
+        report.phases.push_back (PhaseTime ("symbolicate", sw.GetElapsedNanoSeconds()));
+    }
+
+    report.const_string_pool_delta = (int64_t)ConstString::StaticMemorySize() - (int64_t)pool_size_before;
+}
+
+static void
+DumpReport (Stream &s, const std::vector<ModuleReport> &reports)
+{
+    s.PutCString("{\n  \"modules\": [");
+    for (size_t i=0; i<reports.size(); ++i)
+    {
+        const ModuleReport &report = reports[i];
+        s.PutCString(i == 0 ? "\n    {\n" : ",\n    {\n");
+        s.PutCString("      \"path\": ");
+        Statistics::PutJSONString (s, report.path.c_str());
+        s.PutCString(",\n      \"arch\": ");
+        Statistics::PutJSONString (s, report.arch.c_str());
+        s.Printf(",\n      \"loaded\": %s", report.loaded ? "true" : "false");
+        s.Printf(",\n      \"num_symbols\": %llu", (unsigned long long)report.num_symbols);
+        s.Printf(",\n      \"num_compile_units\": %u", report.num_compile_units);
+        s.Printf(",\n      \"num_function_matches\": %u", report.num_function_matches);
+        s.Printf(",\n      \"num_type_matches\": %u", report.num_type_matches);
+        s.Printf(",\n      \"num_addresses\": %u", report.num_addresses);
+        s.Printf(",\n      \"num_addresses_resolved\": %u", report.num_addresses_resolved);
+        s.Printf(",\n      \"const_string_pool_delta_bytes\": %lli", (long long)report.const_string_pool_delta);
+        s.PutCString(",\n      \"phases\": {");
+        uint64_t total_nsec = 0;
+        for (size_t j=0; j<report.phases.size(); ++j)
+        {
+            s.Printf("%s\n        \"%s\": %.9f",
+                     j == 0 ? "" : ",",
+                     report.phases[j].name,
+                     report.phases[j].elapsed_nsec / 1000000000.0);
+            total_nsec += report.phases[j].elapsed_nsec;
+        }
+        s.PutCString("\n      }");
+        s.Printf(",\n      \"total_seconds\": %.9f", total_nsec / 1000000000.0);
+        s.PutCString("\n    }");
+    }
+    s.PutCString("\n  ]");
+    s.Printf(",\n  \"peak_rss_bytes\": %llu", (unsigned long long)GetPeakResidentSetSize());
+    s.Printf(",\n  \"const_string_pool_bytes\": %llu", (unsigned long long)ConstString::StaticMemorySize());
+    s.PutCString("\n}\n");
+}
+
+//----------------------------------------------------------------------
+// main
+//----------------------------------------------------------------------
+int
+main (int argc, char *argv[])
+{
+    const char *prog_name = argv[0];
+    int long_option_index = 0;
+    int ch;
+    ArchSpec arch;
+    std::vector<std::string> function_names;
+    std::vector<std::string> type_names;
+    std::vector<addr_t> addresses;
+    uint32_t symbolicate_count = 1000;
+    const char *output_path = NULL;
+
+    while ((ch = getopt_long(argc, argv, "a:n:t:A:c:o:h", g_long_options, &long_option_index)) != -1)
+    {
+        switch (ch)
+        {
+        case 'a':
+            arch.SetTriple (optarg);
+            if (!arch.IsValid())
+            {
+                fprintf (stderr, "error: invalid architecture '%s'\n", optarg);
+                return 1;
+            }
+            break;
+
+        case 'n':
+            function_names.push_back (optarg);
+            break;
+
+        case 't':
+            type_names.push_back (optarg);
+            break;
+
+        case 'A':
+            {
+                char *end = NULL;
+                errno = 0;
+                const addr_t addr = ::strtoull (optarg, &end, 0);
+                if (errno != 0 || end == optarg || *end != '\0')
+                {
+                    fprintf (stderr, "error: invalid address '%s'\n", optarg);
+                    return 1;
+                }
+                addresses.push_back (addr);
+            }
+            break;
+
+        case 'c':
+            symbolicate_count = ::strtoul (optarg, NULL, 0);
+            break;
+
+        case 'o':
+            output_path = optarg;
+            break;
+
+        case 'h':
+        default:
+            usage (prog_name);
+            return ch == 'h' ? 0 : 1;
+        }
+    }
+
+    // Skip any options we consumed with getopt_long
+    argc -= optind;
+    argv += optind;
+
+    if (argc == 0)
+    {
+        usage (prog_name);
+        return 1;
+    }
+
+    Debugger::Initialize();
+
+    std::vector<ModuleReport> reports;
+    reports.resize (argc);
+    for (int i=0; i<argc; ++i)
+    {
+        BenchmarkModule (argv[i],
+                         arch,
+                         function_names,
+                         type_names,
+                         addresses,
+                         symbolicate_count,
+                         reports[i]);
+        if (!reports[i].loaded)
+            fprintf (stderr, "warning: unable to load object file for '%s'\n", argv[i]);
+    }
+
+    StreamString strm;
+    DumpReport (strm, reports);
+
+    FILE *out = stdout;
+    if (output_path)
+    {
+        out = ::fopen (output_path, "w");
+        if (out == NULL)
+        {
+            const char *errno_str = strerror(errno);
+            fprintf (stderr, "error: failed to open '%s' for writing: %s\n", output_path, errno_str ? errno_str : "unknown error");
+            Debugger::Terminate();
+            return 1;
+        }
+    }
+    ::fwrite (strm.GetData(), 1, strm.GetSize(), out);
+    if (out != stdout)
+        ::fclose (out);
+
+    Debugger::Terminate();
+    return 0;
+}